@@ -0,0 +1,310 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    MODULE NAME= HWIJBIND                                            *
+ *                                                                     *
+ *  Sample C code that binds the members of a response object to the   *
+ *  fields of a record, e.g. status, job-status-code and               *
+ *  job-reason-code of a job to a JOB_STATUS_TYPE. A table of          *
+ *  bindings, built with BIND_FIELD, names the member, the record      *
+ *  field and its type once. The members are picked out in one pass    *
+ *  and written to the record as strings, ints or booleans, whether    *
+ *  the object was parsed or streamed.                                 *
+ *                                                                     *
+ *************************END OF SPECIFICATIONS************************/
+#pragma filetag("IBM-1047")     /* compile in EBCDIC */
+#pragma csect(code, "HWIJBIND") /* name of csect */
+#pragma longName
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <hwtjic.h> /* JSON interface declaration file  */
+#include "hwijprs.h"
+#include "hwijpath.h"
+#include "hwijstrm.h"
+#include "hwijbind.h"
+
+/*
+ * Method: compileSchema
+ *
+ * Compile the path that selects the members of a binding table.
+ *
+ * returns: the schema the caller frees with freeSchema, NULL when the
+ *          table does not fit in a path
+ */
+JSON_SCHEMA_TYPE *compileSchema(const JSON_BINDING_TYPE *fields,
+                                int fieldCount)
+{
+  char pathText[1024] = "{";
+
+  if (fieldCount < 1 || fieldCount > PATH_MAX_FIELDS)
+  {
+    printf("ERROR: a schema binds 1 to %d fields\n", PATH_MAX_FIELDS);
+    return NULL;
+  }
+
+  for (int i = 0; i < fieldCount; i++)
+  {
+    if (strlen(pathText) + strlen(fields[i].name) + 2 > sizeof(pathText))
+    {
+      printf("ERROR: schema field names too long\n");
+      return NULL;
+    }
+    if (i > 0)
+    {
+      strcat(pathText, ",");
+    }
+    strcat(pathText, fields[i].name);
+  }
+  strcat(pathText, "}");
+
+  JSON_SCHEMA_TYPE *schema =
+      (JSON_SCHEMA_TYPE *)calloc(1, sizeof(JSON_SCHEMA_TYPE));
+  if (schema == NULL)
+  {
+    printf("ERROR: unable to allocate storage for schema\n");
+    return NULL;
+  }
+
+  schema->fields = fields;
+  schema->fieldCount = fieldCount;
+  schema->path = compilePath(pathText);
+  if (schema->path == NULL)
+  {
+    free(schema);
+    return NULL;
+  }
+
+  return schema;
+}
+
+/*
+ * Method: freeSchema
+ */
+void freeSchema(JSON_SCHEMA_TYPE *schema)
+{
+  if (schema != NULL)
+  {
+    freePath(schema->path);
+    free(schema);
+  }
+}
+
+/*
+ * Method: storeValue
+ *
+ * Write a value to the record field of its binding, when the JSON
+ * type suits the field. text is the text of a string or number,
+ * boolean the value of a boolean.
+ *
+ * returns: true if the field was set
+ */
+static bool storeValue(const JSON_BINDING_TYPE *field, HWTJ_JTYPE_TYPE type,
+                       JSON_VIEW_TYPE *text, bool boolean, ARENA_TYPE *arena,
+                       void *record)
+{
+  void *target = (char *)record + field->offset;
+
+  switch (field->type)
+  {
+  case BIND_STRING:
+  {
+    if (type != HWTJ_STRING_TYPE)
+    {
+      return false;
+    }
+
+    char *copy = NULL;
+    if (arena != NULL)
+    {
+      copy = arenaString(arena, text->text, text->len);
+    }
+    else if ((copy = (char *)malloc(text->len + 1)) != NULL)
+    {
+      memcpy(copy, text->text, text->len);
+      copy[text->len] = '\0';
+    }
+    *(char **)target = copy;
+    return copy != NULL;
+  }
+
+  case BIND_CHARS:
+  {
+    if (type != HWTJ_STRING_TYPE)
+    {
+      return false;
+    }
+
+    int len = text->len < field->size ? text->len : field->size - 1;
+    memcpy(target, text->text, len);
+    ((char *)target)[len] = '\0';
+    return true;
+  }
+
+  case BIND_INT:
+    if (type != HWTJ_NUMBER_TYPE)
+    {
+      return false;
+    }
+    *(int *)target = view_to_int(text);
+    return true;
+
+  case BIND_INT64:
+    return type == HWTJ_NUMBER_TYPE &&
+           view_to_int64(text, (long long *)target);
+
+  case BIND_UINT64:
+    return type == HWTJ_NUMBER_TYPE &&
+           view_to_uint64(text, (unsigned long long *)target);
+
+  case BIND_DOUBLE:
+    return type == HWTJ_NUMBER_TYPE && view_to_double(text, (double *)target);
+
+  case BIND_BOOL:
+    if (type != HWTJ_BOOLEAN_TYPE)
+    {
+      return false;
+    }
+    *(bool *)target = boolean;
+    return true;
+
+  case BIND_PRESENT:
+    *(bool *)target = true;
+    return true;
+  }
+
+  return false;
+}
+
+/*
+ * Method: bindObject
+ *
+ * Bind the members of a parsed object to the fields of record. Fields
+ * whose member is missing or of another type are left as they are.
+ * Strings are copied to the arena, or malloc'd for the caller to free
+ * when arena is NULL.
+ *
+ * returns: mask of the fields set, -1 when the object could not be
+ *          walked
+ */
+int bindObject(JSON_SCHEMA_TYPE *schema, HWTJ_HANDLE_TYPE object,
+               ARENA_TYPE *arena, void *record)
+{
+  PATH_RESULT_TYPE selected;
+  int bound = 0;
+
+  memset(&selected, 0, sizeof(PATH_RESULT_TYPE));
+  selected.arena = arena;
+
+  if (!selectPath(schema->path, object, &selected) || selected.rowCount != 1)
+  {
+    freePathResult(&selected);
+    return -1;
+  }
+
+  for (int i = 0; i < schema->fieldCount; i++)
+  {
+    PATH_VALUE_TYPE *value = selectedValue(&selected, 0, i);
+    JSON_VIEW_TYPE text = {NULL, 0};
+    int boolean = 0;
+
+    if (!value->found)
+    {
+      continue;
+    }
+
+    if (value->type == HWTJ_STRING_TYPE || value->type == HWTJ_NUMBER_TYPE)
+    {
+      if (!get_view(value->value, arena, &text))
+      {
+        continue;
+      }
+    }
+    else if (value->type == HWTJ_BOOLEAN_TYPE)
+    {
+      boolean = do_get_boolvalue(value->value);
+      if (boolean < 0)
+      {
+        continue;
+      }
+    }
+
+    if (storeValue(&schema->fields[i], value->type, &text, boolean == 1,
+                   arena, record))
+    {
+      bound |= 1 << i;
+    }
+  }
+
+  freePathResult(&selected);
+  return bound;
+}
+
+/*
+ * Method: streamSchema
+ *
+ * Register the members of a schema with a stream, in binding order,
+ * so that bindStreamedEntry can bind the values of each entry.
+ */
+bool streamSchema(STREAM_EXTRACT_TYPE *stream, JSON_SCHEMA_TYPE *schema)
+{
+  for (int i = 0; i < schema->fieldCount; i++)
+  {
+    if (!streamField(stream, schema->fields[i].name))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/*
+ * Method: bindStreamedEntry
+ *
+ * bindObject for the values a stream callback was handed, the stream
+ * having been set up with streamSchema.
+ */
+int bindStreamedEntry(JSON_SCHEMA_TYPE *schema, STREAM_VALUE_TYPE *values,
+                      ARENA_TYPE *arena, void *record)
+{
+  int bound = 0;
+
+  for (int i = 0; i < schema->fieldCount; i++)
+  {
+    if (!values[i].found)
+    {
+      continue;
+    }
+
+    JSON_VIEW_TYPE text = {values[i].text, values[i].len};
+    bool boolean = values[i].type == HWTJ_BOOLEAN_TYPE &&
+                   values[i].len == 4 &&
+                   memcmp(values[i].text, "true", 4) == 0;
+
+    if (storeValue(&schema->fields[i], values[i].type, &text, boolean, arena,
+                   record))
+    {
+      bound |= 1 << i;
+    }
+  }
+
+  return bound;
+}
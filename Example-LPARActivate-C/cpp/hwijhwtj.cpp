@@ -0,0 +1,418 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ ***********************************************************************
+ *                                                                     *
+ *    MODULE NAME= HWIJHWTJ                                            *
+ *                                                                     *
+ *  Sample C code that implements the JSON backend used by hwijprs     *
+ *  with the z/OS JSON parser callable services.                       *
+ *                                                                     *
+ *  See the z/OS MVS Programming: Callable Services for                *
+ *  High-Level Languages publication for more information              *
+ *  regarding the usage of JSON Parser APIs.                           *
+ *                                                                     *
+ *************************END OF SPECIFICATIONS************************/
+#pragma filetag("IBM-1047")     /* compile in EBCDIC */
+#pragma csect(code, "HWIJHWTJ") /* name of csect */
+#pragma longName
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <hwtjic.h> /* JSON interface declaration file  */
+#include "hwijbknd.h"
+
+/* the JSON parser services only exist on z/OS */
+#ifdef __MVS__
+
+/* Used to specify the max work area size to parser init service (hwtjinit). */
+#define MAX_WORKAREA_SIZE 0 /* Zero = No limit (IBM recommended value) */
+
+/* State of one parser, the backend state of a parser context */
+typedef struct
+{
+  /* A parser instance is required for all JSON callable services. */
+  HWTJ_PARSERHANDLE_TYPE parser_instance;
+
+  /* A structure for storing reason codes and error descriptions. */
+  HWTJ_DIAGAREA_TYPE diag_area;
+
+  /* A return code to store the result of each service call. */
+  int jpreturncode;
+
+  /* Receives the member names returned by HWTJGOEN. */
+  char *nameBuffer;
+  int nameBufferLen;
+} HWTJ_PARSER_TYPE;
+
+/*
+ * Method: hwtjInit
+ *
+ * Allocates the state of a parser and initializes its parser_instance.
+ *
+ * Services Used:
+ *
+ *    HWTJINIT: Provides a handle to a parse instance which is then used in
+ *              subsequent service calls. The HWTJINIT service must be invoked
+ *              before invoking any other parsing service.
+ */
+static bool hwtjInit(void **state)
+{
+  HWTJ_PARSER_TYPE *parser =
+      (HWTJ_PARSER_TYPE *)calloc(1, sizeof(HWTJ_PARSER_TYPE));
+
+  *state = parser;
+  if (parser == NULL)
+  {
+    return false;
+  }
+
+  hwtjinit(&parser->jpreturncode,
+           MAX_WORKAREA_SIZE, /* size (in bytes) of the parser work area (input) */
+           parser->parser_instance,
+           &parser->diag_area);
+
+  return parser->jpreturncode == HWTJ_OK;
+}
+
+/*
+ * Method: hwtjParse
+ *
+ * Services Used:
+ *
+ *    HWTJPARS: Builds an internal representation of the specified JSON string.
+ *              This allows efficient search, traversal, and modification of
+ *              the JSON data.
+ *
+ *    USAGE:   HWTJPARS does not make a local copy of the JSON source string.
+ *             Therefore, the caller must ensure that the provided source
+ *             string remains unmodified for the duration of the parser
+ *             instance. If the source string is modified, subsequent service
+ *             calls may result in unexpected behavior.
+ */
+static bool hwtjParse(void *state, const char *text, int textLen)
+{
+  HWTJ_PARSER_TYPE *parser = (HWTJ_PARSER_TYPE *)state;
+
+  hwtjpars(&parser->jpreturncode,
+           parser->parser_instance,
+           (char *)&text, /* JSON text string address(input) */
+           textLen,       /* JSON text string length (input) */
+           &parser->diag_area);
+
+  return parser->jpreturncode == HWTJ_OK;
+}
+
+/*
+ * Method: hwtjSearch
+ *
+ * Services Used:
+ *    HWTJSRCH: Finds a particular name string within the JSON text.
+ */
+static bool hwtjSearch(void *state, HWTJ_HANDLE_TYPE object, const char *name,
+                       HWTJ_HANDLE_TYPE *value)
+{
+  HWTJ_PARSER_TYPE *parser = (HWTJ_PARSER_TYPE *)state;
+
+  hwtjsrch(&parser->jpreturncode,
+           parser->parser_instance,
+           HWTJ_SEARCHTYPE_OBJECT, /* limit the search scope */
+           (char *)&name,          /* search string address */
+           strlen(name),           /* search string length */
+           object,                 /* handle of object to search */
+           0,                      /* starting point of the search */
+           value,                  /* search result handle (output) */
+           &parser->diag_area);
+
+  return parser->jpreturncode == HWTJ_OK;
+}
+
+/*
+ * Method: hwtjGetType
+ *
+ * Services Used:
+ *    HWTJGJST: Gets the JSON type associated with a specified object or entry
+ *              handle.
+ */
+static bool hwtjGetType(void *state, HWTJ_HANDLE_TYPE value,
+                        HWTJ_JTYPE_TYPE *type)
+{
+  HWTJ_PARSER_TYPE *parser = (HWTJ_PARSER_TYPE *)state;
+
+  hwtjgjst(&parser->jpreturncode,
+           parser->parser_instance,
+           value, /* handle to the value whose type to check (input) */
+           type,  /* value type constant returned by hwtjgjst (output) */
+           &parser->diag_area);
+
+  return parser->jpreturncode == HWTJ_OK;
+}
+
+/*
+ * Method: hwtjGetValue
+ *
+ * Services Used:
+ *    HWTJGVAL: Retrieves the value of string or number entry.
+ */
+static bool hwtjGetValue(void *state, HWTJ_HANDLE_TYPE value,
+                         const char **text, int *textLen)
+{
+  HWTJ_PARSER_TYPE *parser = (HWTJ_PARSER_TYPE *)state;
+
+  int value_addr = 0;
+
+  hwtjgval(&parser->jpreturncode,
+           parser->parser_instance,
+           value,       /* handle to a value (input) */
+           &value_addr, /* value address (output) */
+           textLen,     /* returned value length (output) */
+           &parser->diag_area);
+
+  *text = (const char *)value_addr;
+
+  return parser->jpreturncode == HWTJ_OK;
+}
+
+/*
+ * Method: hwtjGetBoolean
+ *
+ * Services Used:
+ *    HWTJGBOV: Retrieves the value of a boolean entry.
+ */
+static int hwtjGetBoolean(void *state, HWTJ_HANDLE_TYPE value)
+{
+  HWTJ_PARSER_TYPE *parser = (HWTJ_PARSER_TYPE *)state;
+
+  HWTJ_BOOLEANVALUE_TYPE hwtj_boolean;
+
+  hwtjgbov(&parser->jpreturncode,
+           parser->parser_instance,
+           value,         /* handle to the value (input) */
+           &hwtj_boolean, /* boolean value returned by hwtjgbov (output) */
+           &parser->diag_area);
+
+  if (parser->jpreturncode != HWTJ_OK)
+  {
+    return -1;
+  }
+  if (hwtj_boolean == HWTJ_TRUE)
+  {
+    return 1;
+  }
+  if (hwtj_boolean == HWTJ_FALSE)
+  {
+    return 0;
+  }
+
+  printf("bool value not recognized\n");
+  return -1;
+}
+
+/*
+ * Method: hwtjGetArrayEntry
+ *
+ * Services Used:
+ *    HWTJGAEN: Retrieves a handle to an array entry.
+ */
+static bool hwtjGetArrayEntry(void *state, HWTJ_HANDLE_TYPE array, int index,
+                              HWTJ_HANDLE_TYPE *entry)
+{
+  HWTJ_PARSER_TYPE *parser = (HWTJ_PARSER_TYPE *)state;
+
+  hwtjgaen(&parser->jpreturncode,
+           parser->parser_instance,
+           array,
+           index,
+           entry,
+           &parser->diag_area);
+
+  return parser->jpreturncode == HWTJ_OK;
+}
+
+/*
+ * Method: hwtjGetEntryCount
+ *
+ * Services Used:
+ *    HWTJGNUE: Retrieves the number of entries of an array or object.
+ */
+static int hwtjGetEntryCount(void *state, HWTJ_HANDLE_TYPE handle)
+{
+  HWTJ_PARSER_TYPE *parser = (HWTJ_PARSER_TYPE *)state;
+
+  int numofentries;
+
+  hwtjgnue(&parser->jpreturncode,
+           parser->parser_instance,
+           handle,
+           &numofentries,
+           &parser->diag_area);
+
+  return parser->jpreturncode == HWTJ_OK ? numofentries : -1;
+}
+
+/*
+ * Method: hwtjGetObjectEntry
+ *
+ * Services Used:
+ *    HWTJGOEN: Retrieves the name and value handle of an object entry.
+ */
+static bool hwtjGetObjectEntry(void *state, HWTJ_HANDLE_TYPE object,
+                               int index, const char **name, int *nameLen,
+                               HWTJ_HANDLE_TYPE *value)
+{
+  HWTJ_PARSER_TYPE *parser = (HWTJ_PARSER_TYPE *)state;
+  int actualNameLen = 0;
+
+  for (;;)
+  {
+    hwtjgoen(&parser->jpreturncode,
+             parser->parser_instance,
+             object,                 /* handle of the object (input) */
+             index,                  /* index of the entry (input) */
+             &parser->nameBuffer,    /* name buffer address (input) */
+             parser->nameBufferLen,  /* name buffer length (input) */
+             value,                  /* value handle (output) */
+             &actualNameLen,         /* length of the name (output) */
+             &parser->diag_area);
+
+    /* retry with a buffer that holds the whole name */
+    if (actualNameLen <= parser->nameBufferLen)
+    {
+      break;
+    }
+
+    char *newBuffer = (char *)realloc(parser->nameBuffer, actualNameLen);
+    if (newBuffer == NULL)
+    {
+      return false;
+    }
+    parser->nameBuffer = newBuffer;
+    parser->nameBufferLen = actualNameLen;
+  }
+
+  *name = parser->nameBuffer;
+  *nameLen = actualNameLen;
+
+  return parser->jpreturncode == HWTJ_OK;
+}
+
+/*
+ * Method: hwtjDisplayError
+ *
+ * A helper method for displaying error diagnostic information.
+ */
+static void hwtjDisplayError(void *state, const char *msg)
+{
+  HWTJ_PARSER_TYPE *parser = (HWTJ_PARSER_TYPE *)state;
+
+  printf("ERROR: %s\n", msg);
+  if (parser == NULL)
+  {
+    return;
+  }
+  printf("Return Code: %d\n", parser->jpreturncode);
+  printf("Reason Code: %d\n", parser->diag_area.ReasonCode);
+  printf("Reason Text: %s\n", parser->diag_area.ReasonDesc);
+}
+
+/*
+ * Method: hwtjTerm
+ *
+ * Performs cleanup by freeing memory used by the parser and invalidating the
+ * parser handle.
+ *
+ * Services Used:
+ *
+ *    HWTJTERM: Terminates a parser instance and frees the storage allocated
+ *              by the parse services.
+ *
+ *    USAGE:    The third parameter to hwtjterm is used to specify the
+ *              behavior of terminate if the parser is determined to be stuck
+ *              in an "in-use" state. IBM recommends using the HWTJ_NOFORCE
+ *              option in most cases. Because a parser instance is only used
+ *              by the thread holding its parser context, the risk of the
+ *              parser getting stuck in an "in-use" state is low. Therefore,
+ *              we provide a value of HWTJ_NOFORCE for the force option.
+ *
+ *    NOTE: Consider enhancing this sample to postpone the call to the
+ *    terminate service when a prior service call resulted in a return code of
+ *    HWTJ_UNEXPECTED_ERROR. This will allow appropriate action to be taken to
+ *    dump the work area storage for subsequent analysis by the IBM support
+ *    center. Once the dump has been taken, terminate can be issued to free the
+ *    storage from the user's address space.
+ */
+static bool hwtjTerm(void *state)
+{
+  HWTJ_PARSER_TYPE *parser = (HWTJ_PARSER_TYPE *)state;
+
+  if (parser == NULL)
+  {
+    return true;
+  }
+
+  /*
+   * On the first attempt, try to terminate with the force option disabled.
+   * This is the IBM recommended value for the force option. If the parser is
+   * in an inuse state, further cleanup processing is done in the following
+   * EVALUATE statement. A parser can be in an INUSE state if a prior service
+   * call encountered an unexpected error that caused it to exit abnormally, or
+   * if the parser-handle is used in a multi-threaded application.
+   */
+  if (parser->jpreturncode != HWTJ_PARSERHANDLE_INUSE)
+  {
+    /* Perform cleanup. */
+    hwtjterm(&parser->jpreturncode, parser->parser_instance, HWTJ_NOFORCE,
+             &parser->diag_area);
+  }
+
+  if (parser->jpreturncode == HWTJ_PARSERHANDLE_INUSE)
+  {
+    hwtjDisplayError(parser, "Unable to perform cleanup.\n "
+                     "Retrying cleanup with HWTJ_FORCE option "
+                     "enabled.");
+
+    /* Attempt to force cleanup. Use with caution as recommended in the
+     * parser documentation
+     */
+    hwtjterm(&parser->jpreturncode, parser->parser_instance, HWTJ_FORCE,
+             &parser->diag_area);
+  }
+
+  bool terminated = parser->jpreturncode == HWTJ_OK;
+  free(parser->nameBuffer);
+  free(parser);
+
+  return terminated;
+}
+
+JSON_BACKEND_TYPE hwtjBackend = {
+    "HWTJ",
+    hwtjInit,
+    hwtjParse,
+    hwtjSearch,
+    hwtjGetType,
+    hwtjGetValue,
+    hwtjGetBoolean,
+    hwtjGetArrayEntry,
+    hwtjGetEntryCount,
+    hwtjGetObjectEntry,
+    hwtjDisplayError,
+    hwtjTerm};
+
+#endif
@@ -0,0 +1,307 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    MODULE NAME= HWIJKIDX                                            *
+ *                                                                     *
+ *  Sample C code for a hash index over the member names of a JSON     *
+ *  object. A backend search walks the members of the object, so       *
+ *  reading k names of an object with n members costs k times n key    *
+ *  compares. Once the same object is searched a second time its       *
+ *  members are hashed in one pass and the following names are found   *
+ *  with a probe or two, whichever JSON backend is in use.             *
+ *                                                                     *
+ *************************END OF SPECIFICATIONS************************/
+#pragma filetag("IBM-1047")     /* compile in EBCDIC */
+#pragma csect(code, "HWIJKIDX") /* name of csect */
+#pragma longName
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <hwtjic.h> /* JSON interface declaration file  */
+#include "hwijbknd.h"
+#include "hwijkidx.h"
+
+/*
+ * Method: hashName
+ *
+ * returns: the FNV-1a hash of len characters of name
+ */
+static unsigned int hashName(const char *name, int len)
+{
+  unsigned int hash = 2166136261u;
+
+  for (int i = 0; i < len; i++)
+  {
+    hash ^= (unsigned char)name[i];
+    hash *= 16777619u;
+  }
+
+  return hash;
+}
+
+/*
+ * Method: findSlot
+ *
+ * returns: the slot holding name, or the free slot ending its probe
+ *          sequence
+ */
+static KEY_SLOT_TYPE *findSlot(KEY_OBJECT_INDEX_TYPE *index, const char *name,
+                               int len, unsigned int hash)
+{
+  int mask = index->slotCount - 1;
+  int i = hash & mask;
+
+  while (index->slots[i].nameOffset >= 0)
+  {
+    KEY_SLOT_TYPE *slot = &index->slots[i];
+    if (slot->hash == hash && slot->nameLen == len &&
+        memcmp(index->names + slot->nameOffset, name, len) == 0)
+    {
+      return slot;
+    }
+    i = (i + 1) & mask;
+  }
+
+  return &index->slots[i];
+}
+
+/*
+ * Method: addMember
+ *
+ * Copy a member name and enter it with its value. A name repeated in
+ * the object keeps its first value, as a linear search finds it.
+ */
+static bool addMember(KEY_OBJECT_INDEX_TYPE *index, const char *name,
+                      int len, HWTJ_HANDLE_TYPE value)
+{
+  unsigned int hash = hashName(name, len);
+  KEY_SLOT_TYPE *slot = findSlot(index, name, len, hash);
+
+  if (slot->nameOffset >= 0)
+  {
+    return true;
+  }
+
+  if (index->namesLen + len > index->namesCapacity)
+  {
+    int capacity = index->namesCapacity > 0 ? index->namesCapacity : 1024;
+    while (capacity < index->namesLen + len)
+    {
+      capacity *= 2;
+    }
+
+    char *names = (char *)realloc(index->names, capacity);
+    if (names == NULL)
+    {
+      return false;
+    }
+    index->names = names;
+    index->namesCapacity = capacity;
+  }
+
+  memcpy(index->names + index->namesLen, name, len);
+  slot->hash = hash;
+  slot->nameOffset = index->namesLen;
+  slot->nameLen = len;
+  slot->value = value;
+  index->namesLen += len;
+
+  return true;
+}
+
+/*
+ * Method: buildKeyIndex
+ *
+ * Hash the members of object. Objects below KEY_INDEX_MIN_MEMBERS,
+ * values that are not objects and objects that cannot be indexed for
+ * lack of storage are left to linear searches.
+ *
+ * returns: true when the index holds the members of object
+ */
+static bool buildKeyIndex(KEY_OBJECT_INDEX_TYPE *index,
+                          JSON_BACKEND_TYPE *backend, void *state,
+                          HWTJ_HANDLE_TYPE object)
+{
+  int count = backend->getEntryCount(state, object);
+
+  index->object = object;
+  index->status = KEY_INDEX_LINEAR;
+  if (count < KEY_INDEX_MIN_MEMBERS)
+  {
+    return false;
+  }
+
+  /* keep the slots at most half full */
+  int slotCount = KEY_INDEX_MIN_MEMBERS * 2;
+  while (slotCount < count * 2)
+  {
+    slotCount *= 2;
+  }
+
+  if (slotCount > index->slotCapacity)
+  {
+    KEY_SLOT_TYPE *slots = (KEY_SLOT_TYPE *)realloc(
+        index->slots, slotCount * sizeof(KEY_SLOT_TYPE));
+    if (slots == NULL)
+    {
+      return false;
+    }
+    index->slots = slots;
+    index->slotCapacity = slotCount;
+  }
+
+  index->slotCount = slotCount;
+  index->namesLen = 0;
+  for (int i = 0; i < slotCount; i++)
+  {
+    index->slots[i].nameOffset = -1;
+  }
+
+  for (int i = 0; i < count; i++)
+  {
+    const char *name;
+    int nameLen;
+    HWTJ_HANDLE_TYPE value;
+
+    if (!backend->getObjectEntry(state, object, i, &name, &nameLen,
+                                 &value) ||
+        !addMember(index, name, nameLen, value))
+    {
+      return false;
+    }
+  }
+
+  index->status = KEY_INDEX_BUILT;
+
+  return true;
+}
+
+/*
+ * Method: findObjectIndex
+ *
+ * returns: the index kept for object, or, when object was not
+ *          searched lately, the unused or least recently searched one
+ *          given up for it
+ */
+static KEY_OBJECT_INDEX_TYPE *findObjectIndex(JSON_KEY_INDEX_TYPE *index,
+                                              HWTJ_HANDLE_TYPE object)
+{
+  KEY_OBJECT_INDEX_TYPE *oldest = &index->objects[0];
+
+  for (int i = 0; i < KEY_INDEX_OBJECTS; i++)
+  {
+    KEY_OBJECT_INDEX_TYPE *candidate = &index->objects[i];
+
+    if (candidate->status != KEY_INDEX_NONE && candidate->object == object)
+    {
+      return candidate;
+    }
+    if (oldest->status != KEY_INDEX_NONE &&
+        (candidate->status == KEY_INDEX_NONE ||
+         candidate->lastUsed < oldest->lastUsed))
+    {
+      oldest = candidate;
+    }
+  }
+
+  oldest->status = KEY_INDEX_NONE;
+  oldest->object = object;
+  return oldest;
+}
+
+/*
+ * Method: keyIndexSearch
+ *
+ * Find name among the members of object like the backend search. The
+ * first search of an object is passed to the backend, a second one of
+ * the same object builds its index, which answers from then on while
+ * the object is among the KEY_INDEX_OBJECTS searched last and until
+ * the text is parsed again.
+ *
+ * returns: true when name was found, value is its handle
+ */
+bool keyIndexSearch(JSON_KEY_INDEX_TYPE *index, JSON_BACKEND_TYPE *backend,
+                    void *state, HWTJ_HANDLE_TYPE object, const char *name,
+                    HWTJ_HANDLE_TYPE *value)
+{
+  if (index->disabled)
+  {
+    return backend->search(state, object, name, value);
+  }
+
+  KEY_OBJECT_INDEX_TYPE *objectIndex = findObjectIndex(index, object);
+  objectIndex->lastUsed = ++index->searches;
+
+  if (objectIndex->status == KEY_INDEX_NONE)
+  {
+    objectIndex->status = KEY_INDEX_SEEN;
+  }
+  else if (objectIndex->status == KEY_INDEX_SEEN &&
+           buildKeyIndex(objectIndex, backend, state, object))
+  {
+    index->builds++;
+  }
+
+  if (objectIndex->status != KEY_INDEX_BUILT)
+  {
+    return backend->search(state, object, name, value);
+  }
+
+  int len = strlen(name);
+  KEY_SLOT_TYPE *slot =
+      findSlot(objectIndex, name, len, hashName(name, len));
+  if (slot->nameOffset < 0)
+  {
+    return false;
+  }
+
+  *value = slot->value;
+
+  return true;
+}
+
+/*
+ * Method: resetKeyIndex
+ *
+ * Forget the indexed objects, called when the text is parsed again as
+ * handles of the old text may be reused. The storage is kept.
+ */
+void resetKeyIndex(JSON_KEY_INDEX_TYPE *index)
+{
+  for (int i = 0; i < KEY_INDEX_OBJECTS; i++)
+  {
+    index->objects[i].status = KEY_INDEX_NONE;
+  }
+}
+
+/*
+ * Method: freeKeyIndex
+ */
+void freeKeyIndex(JSON_KEY_INDEX_TYPE *index)
+{
+  for (int i = 0; i < KEY_INDEX_OBJECTS; i++)
+  {
+    KEY_OBJECT_INDEX_TYPE *objectIndex = &index->objects[i];
+
+    free(objectIndex->slots);
+    free(objectIndex->names);
+    memset(objectIndex, 0, sizeof(KEY_OBJECT_INDEX_TYPE));
+  }
+}
@@ -0,0 +1,791 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ ***********************************************************************
+ *                                                                     *
+ *    MODULE NAME= HWIJNATV                                            *
+ *                                                                     *
+ *  Sample C code that implements the JSON backend used by hwijprs     *
+ *  with a native parser. One pass over the text builds a flat array   *
+ *  of nodes that is reused by the next parse, so steady state         *
+ *  parsing allocates nothing, and every lookup is a local call.       *
+ *                                                                     *
+ *************************END OF SPECIFICATIONS************************/
+#pragma filetag("IBM-1047")     /* compile in EBCDIC */
+#pragma csect(code, "HWIJNATV") /* name of csect */
+#pragma longName
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include <hwtjic.h> /* JSON interface declaration file  */
+#include "hwijbknd.h"
+#include "hwijnatv.h"
+
+static bool parseValue(NATIVE_PARSER_TYPE *parser, int *pos, int depth);
+
+/*
+ * Method: parseFailed
+ *
+ * Record why and where the parse failed.
+ */
+static bool parseFailed(NATIVE_PARSER_TYPE *parser, const char *reason, int pos)
+{
+  parser->error = reason;
+  parser->errorPos = pos;
+  return false;
+}
+
+/*
+ * Method: newNode
+ *
+ * returns: index of a new node, -1 when out of storage
+ */
+static int newNode(NATIVE_PARSER_TYPE *parser, HWTJ_JTYPE_TYPE type, int start)
+{
+  if (parser->nodeCount == parser->nodeCapacity)
+  {
+    int newCapacity =
+        parser->nodeCapacity > 0 ? parser->nodeCapacity * 2 : 1024;
+    NATIVE_NODE_TYPE *newNodes = (NATIVE_NODE_TYPE *)realloc(
+        parser->nodes, newCapacity * sizeof(NATIVE_NODE_TYPE));
+    if (newNodes == NULL)
+    {
+      return -1;
+    }
+    parser->nodes = newNodes;
+    parser->nodeCapacity = newCapacity;
+  }
+
+  NATIVE_NODE_TYPE *node = &parser->nodes[parser->nodeCount];
+  node->type = type;
+  node->start = start;
+  node->len = 0;
+  node->next = 0;
+  node->count = 0;
+  node->flags = 0;
+
+  return parser->nodeCount++;
+}
+
+/*
+ * Method: skipWhitespace
+ *
+ * returns: offset of the next character that is not white space
+ */
+static int skipWhitespace(NATIVE_PARSER_TYPE *parser, int pos)
+{
+  while (pos < parser->len &&
+         (parser->text[pos] == ' ' || parser->text[pos] == '\n' ||
+          parser->text[pos] == '\r' || parser->text[pos] == '\t'))
+  {
+    pos++;
+  }
+  return pos;
+}
+
+/*
+ * Method: parseString
+ *
+ * Scan a string starting at the opening quote.
+ */
+static bool parseString(NATIVE_PARSER_TYPE *parser, int *pos)
+{
+  int p = *pos + 1;
+  int node = newNode(parser, HWTJ_STRING_TYPE, p);
+  if (node < 0)
+  {
+    return parseFailed(parser, "out of storage", *pos);
+  }
+
+  while (p < parser->len && parser->text[p] != '"')
+  {
+    if (parser->text[p] == '\\')
+    {
+      parser->nodes[node].flags |= NATIVE_ESCAPED;
+      if (p + 1 >= parser->len ||
+          strchr("\"\\/bfnrtu", parser->text[p + 1]) == NULL)
+      {
+        return parseFailed(parser, "invalid escape sequence", p);
+      }
+      if (parser->text[p + 1] == 'u')
+      {
+        for (int i = 2; i < 6; i++)
+        {
+          if (p + i >= parser->len ||
+              !isxdigit((unsigned char)parser->text[p + i]))
+          {
+            return parseFailed(parser, "invalid unicode escape", p);
+          }
+        }
+        p += 4;
+      }
+      p++;
+    }
+    p++;
+  }
+
+  if (p >= parser->len)
+  {
+    return parseFailed(parser, "unterminated string", *pos);
+  }
+
+  parser->nodes[node].len = p - parser->nodes[node].start;
+  parser->nodes[node].next = parser->nodeCount;
+  *pos = p + 1;
+
+  return true;
+}
+
+/*
+ * Method: parseNumber
+ *
+ * Scan a number: -?int(.digits)?([eE][+-]?digits)?
+ */
+static bool parseNumber(NATIVE_PARSER_TYPE *parser, int *pos)
+{
+  int p = *pos;
+  int digits;
+
+  if (p < parser->len && parser->text[p] == '-')
+  {
+    p++;
+  }
+
+  digits = p;
+  while (p < parser->len && isdigit((unsigned char)parser->text[p]))
+  {
+    p++;
+  }
+  if (p == digits || (parser->text[digits] == '0' && p - digits > 1))
+  {
+    return parseFailed(parser, "invalid number", *pos);
+  }
+
+  if (p < parser->len && parser->text[p] == '.')
+  {
+    digits = ++p;
+    while (p < parser->len && isdigit((unsigned char)parser->text[p]))
+    {
+      p++;
+    }
+    if (p == digits)
+    {
+      return parseFailed(parser, "invalid number fraction", *pos);
+    }
+  }
+
+  if (p < parser->len && (parser->text[p] == 'e' || parser->text[p] == 'E'))
+  {
+    p++;
+    if (p < parser->len && (parser->text[p] == '+' || parser->text[p] == '-'))
+    {
+      p++;
+    }
+    digits = p;
+    while (p < parser->len && isdigit((unsigned char)parser->text[p]))
+    {
+      p++;
+    }
+    if (p == digits)
+    {
+      return parseFailed(parser, "invalid number exponent", *pos);
+    }
+  }
+
+  int node = newNode(parser, HWTJ_NUMBER_TYPE, *pos);
+  if (node < 0)
+  {
+    return parseFailed(parser, "out of storage", *pos);
+  }
+  parser->nodes[node].len = p - *pos;
+  parser->nodes[node].next = parser->nodeCount;
+  *pos = p;
+
+  return true;
+}
+
+/*
+ * Method: parseLiteral
+ *
+ * Scan true, false or null.
+ */
+static bool parseLiteral(NATIVE_PARSER_TYPE *parser, int *pos,
+                         const char *literal, HWTJ_JTYPE_TYPE type)
+{
+  int len = strlen(literal);
+
+  if (*pos + len > parser->len ||
+      memcmp(parser->text + *pos, literal, len) != 0)
+  {
+    return parseFailed(parser, "unexpected character", *pos);
+  }
+
+  int node = newNode(parser, type, *pos);
+  if (node < 0)
+  {
+    return parseFailed(parser, "out of storage", *pos);
+  }
+  parser->nodes[node].len = len;
+  parser->nodes[node].next = parser->nodeCount;
+  *pos += len;
+
+  return true;
+}
+
+/*
+ * Method: parseContainer
+ *
+ * Scan an object or an array starting at its opening bracket.
+ */
+static bool parseContainer(NATIVE_PARSER_TYPE *parser, int *pos, int depth)
+{
+  bool isObject = parser->text[*pos] == '{';
+  char close = isObject ? '}' : ']';
+
+  if (depth >= NATIVE_MAX_DEPTH)
+  {
+    return parseFailed(parser, "nesting too deep", *pos);
+  }
+
+  int node = newNode(parser, isObject ? HWTJ_OBJECT_TYPE : HWTJ_ARRAY_TYPE,
+                     *pos);
+  if (node < 0)
+  {
+    return parseFailed(parser, "out of storage", *pos);
+  }
+
+  int p = skipWhitespace(parser, *pos + 1);
+  if (p < parser->len && parser->text[p] == close)
+  {
+    p++;
+  }
+  else
+  {
+    for (;;)
+    {
+      if (isObject)
+      {
+        p = skipWhitespace(parser, p);
+        if (p >= parser->len || parser->text[p] != '"')
+        {
+          return parseFailed(parser, "member name expected", p);
+        }
+        if (!parseString(parser, &p))
+        {
+          return false;
+        }
+        p = skipWhitespace(parser, p);
+        if (p >= parser->len || parser->text[p] != ':')
+        {
+          return parseFailed(parser, "':' expected", p);
+        }
+        p++;
+      }
+
+      if (!parseValue(parser, &p, depth + 1))
+      {
+        return false;
+      }
+      parser->nodes[node].count++;
+
+      p = skipWhitespace(parser, p);
+      if (p < parser->len && parser->text[p] == ',')
+      {
+        p++;
+      }
+      else if (p < parser->len && parser->text[p] == close)
+      {
+        p++;
+        break;
+      }
+      else
+      {
+        return parseFailed(parser, isObject ? "',' or '}' expected"
+                                    : "',' or ']' expected",
+                           p);
+      }
+    }
+  }
+
+  parser->nodes[node].len = p - *pos;
+  parser->nodes[node].next = parser->nodeCount;
+  *pos = p;
+
+  return true;
+}
+
+/*
+ * Method: parseValue
+ *
+ * Scan any JSON value.
+ */
+static bool parseValue(NATIVE_PARSER_TYPE *parser, int *pos, int depth)
+{
+  *pos = skipWhitespace(parser, *pos);
+  if (*pos >= parser->len)
+  {
+    return parseFailed(parser, "unexpected end of text", *pos);
+  }
+
+  switch (parser->text[*pos])
+  {
+  case '{':
+  case '[':
+    return parseContainer(parser, pos, depth);
+  case '"':
+    return parseString(parser, pos);
+  case 't':
+    return parseLiteral(parser, pos, "true", HWTJ_BOOLEAN_TYPE);
+  case 'f':
+    return parseLiteral(parser, pos, "false", HWTJ_BOOLEAN_TYPE);
+  case 'n':
+    return parseLiteral(parser, pos, "null", HWTJ_NULL_TYPE);
+  default:
+    return parseNumber(parser, pos);
+  }
+}
+
+/*
+ * Method: unescapeJSON
+ *
+ * Copy the text of a string value, without its quotes, decoding the
+ * backslash escapes. Off z/OS \u escapes are written as UTF-8, on
+ * z/OS they are kept as they are since the text is EBCDIC. out must
+ * hold inLen + 1 bytes, the decoded text is never longer.
+ *
+ * returns: length of the decoded text
+ */
+int unescapeJSON(const char *in, int inLen, char *out)
+{
+  int len = 0;
+
+  for (int i = 0; i < inLen; i++)
+  {
+    if (in[i] != '\\' || i + 1 >= inLen)
+    {
+      out[len++] = in[i];
+      continue;
+    }
+
+    switch (in[++i])
+    {
+    case 'b':
+      out[len++] = '\b';
+      break;
+    case 'f':
+      out[len++] = '\f';
+      break;
+    case 'n':
+      out[len++] = '\n';
+      break;
+    case 'r':
+      out[len++] = '\r';
+      break;
+    case 't':
+      out[len++] = '\t';
+      break;
+    case 'u':
+    {
+      if (i + 4 >= inLen)
+      {
+        out[len++] = in[i];
+        break;
+      }
+#ifdef __MVS__
+      memcpy(out + len, in + i - 1, 6);
+      len += 6;
+      i += 4;
+#else
+      char hex[5];
+      memcpy(hex, in + i + 1, 4);
+      hex[4] = '\0';
+      unsigned long code = strtoul(hex, NULL, 16);
+      i += 4;
+
+      /* a surrogate pair is two escapes */
+      if (code >= 0xD800 && code <= 0xDBFF && i + 6 < inLen &&
+          in[i + 1] == '\\' && in[i + 2] == 'u')
+      {
+        memcpy(hex, in + i + 3, 4);
+        unsigned long low = strtoul(hex, NULL, 16);
+        if (low >= 0xDC00 && low <= 0xDFFF)
+        {
+          code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+          i += 6;
+        }
+      }
+
+      if (code < 0x80)
+      {
+        out[len++] = (char)code;
+      }
+      else if (code < 0x800)
+      {
+        out[len++] = (char)(0xC0 | (code >> 6));
+        out[len++] = (char)(0x80 | (code & 0x3F));
+      }
+      else if (code < 0x10000)
+      {
+        out[len++] = (char)(0xE0 | (code >> 12));
+        out[len++] = (char)(0x80 | ((code >> 6) & 0x3F));
+        out[len++] = (char)(0x80 | (code & 0x3F));
+      }
+      else
+      {
+        out[len++] = (char)(0xF0 | (code >> 18));
+        out[len++] = (char)(0x80 | ((code >> 12) & 0x3F));
+        out[len++] = (char)(0x80 | ((code >> 6) & 0x3F));
+        out[len++] = (char)(0x80 | (code & 0x3F));
+      }
+#endif
+      break;
+    }
+    default: /* " \ / */
+      out[len++] = in[i];
+      break;
+    }
+  }
+
+  out[len] = '\0';
+
+  return len;
+}
+
+/*
+ * Method: unescape
+ *
+ * Decode a string with escapes into scratch.
+ */
+static bool unescape(NATIVE_PARSER_TYPE *parser, NATIVE_NODE_TYPE *node,
+                     const char **text, int *textLen)
+{
+  if (node->len + 1 > parser->scratchCapacity)
+  {
+    char *newScratch = (char *)realloc(parser->scratch, node->len + 1);
+    if (newScratch == NULL)
+    {
+      return false;
+    }
+    parser->scratch = newScratch;
+    parser->scratchCapacity = node->len + 1;
+  }
+
+  *textLen = unescapeJSON(parser->text + node->start, node->len,
+                          parser->scratch);
+  *text = parser->scratch;
+
+  return true;
+}
+
+/*
+ * Method: validHandle
+ *
+ * returns: true if the handle names a node of the last parse
+ */
+static bool validHandle(NATIVE_PARSER_TYPE *parser, HWTJ_HANDLE_TYPE handle)
+{
+  return (int)handle >= 0 && (int)handle < parser->nodeCount;
+}
+
+/*
+ * Method: nativeInit
+ *
+ * A parser owns its nodes and buffers, they are kept from one parse
+ * to the next.
+ */
+static bool nativeInit(void **state)
+{
+  NATIVE_PARSER_TYPE *parser =
+      (NATIVE_PARSER_TYPE *)calloc(1, sizeof(NATIVE_PARSER_TYPE));
+
+  *state = parser;
+  if (parser == NULL)
+  {
+    return false;
+  }
+
+  parser->entryArray = -1;
+  parser->memberObject = -1;
+  return true;
+}
+
+static bool nativeParse(void *state, const char *text, int textLen)
+{
+  NATIVE_PARSER_TYPE *parser = (NATIVE_PARSER_TYPE *)state;
+
+  int pos = 0;
+
+  parser->text = text;
+  parser->len = textLen;
+  parser->nodeCount = 0;
+  parser->entryArray = -1;
+  parser->memberObject = -1;
+  parser->error = NULL;
+
+  if (!parseValue(parser, &pos, 0))
+  {
+    parser->nodeCount = 0;
+    return false;
+  }
+
+  pos = skipWhitespace(parser, pos);
+  if (pos < parser->len)
+  {
+    parser->nodeCount = 0;
+    return parseFailed(parser, "text follows the JSON value", pos);
+  }
+
+  return true;
+}
+
+static bool nativeSearch(void *state, HWTJ_HANDLE_TYPE object, const char *name,
+                         HWTJ_HANDLE_TYPE *value)
+{
+  NATIVE_PARSER_TYPE *parser = (NATIVE_PARSER_TYPE *)state;
+
+  if (!validHandle(parser, object) ||
+      parser->nodes[object].type != HWTJ_OBJECT_TYPE)
+  {
+    return false;
+  }
+
+  int nameLen = strlen(name);
+  int key = object + 1;
+
+  for (int i = 0; i < parser->nodes[object].count; i++)
+  {
+    NATIVE_NODE_TYPE *keyNode = &parser->nodes[key];
+    const char *keyText = parser->text + keyNode->start;
+    int keyLen = keyNode->len;
+
+    if ((keyNode->flags & NATIVE_ESCAPED) &&
+        !unescape(parser, keyNode, &keyText, &keyLen))
+    {
+      return false;
+    }
+
+    if (keyLen == nameLen && memcmp(keyText, name, nameLen) == 0)
+    {
+      *value = key + 1;
+      return true;
+    }
+
+    key = parser->nodes[key + 1].next;
+  }
+
+  return false;
+}
+
+static bool nativeGetType(void *state, HWTJ_HANDLE_TYPE value,
+                          HWTJ_JTYPE_TYPE *type)
+{
+  NATIVE_PARSER_TYPE *parser = (NATIVE_PARSER_TYPE *)state;
+
+  if (!validHandle(parser, value))
+  {
+    return false;
+  }
+
+  *type = parser->nodes[value].type;
+  return true;
+}
+
+static bool nativeGetValue(void *state, HWTJ_HANDLE_TYPE value,
+                           const char **text, int *textLen)
+{
+  NATIVE_PARSER_TYPE *parser = (NATIVE_PARSER_TYPE *)state;
+
+  if (!validHandle(parser, value) ||
+      (parser->nodes[value].type != HWTJ_STRING_TYPE &&
+       parser->nodes[value].type != HWTJ_NUMBER_TYPE))
+  {
+    return false;
+  }
+
+  if (parser->nodes[value].flags & NATIVE_ESCAPED)
+  {
+    return unescape(parser, &parser->nodes[value], text, textLen);
+  }
+
+  *text = parser->text + parser->nodes[value].start;
+  *textLen = parser->nodes[value].len;
+  return true;
+}
+
+static int nativeGetBoolean(void *state, HWTJ_HANDLE_TYPE value)
+{
+  NATIVE_PARSER_TYPE *parser = (NATIVE_PARSER_TYPE *)state;
+
+  if (!validHandle(parser, value) ||
+      parser->nodes[value].type != HWTJ_BOOLEAN_TYPE)
+  {
+    return -1;
+  }
+
+  return parser->text[parser->nodes[value].start] == 't' ? 1 : 0;
+}
+
+/*
+ * Method: nativeGetArrayEntry
+ *
+ * The entry nodes of an array are indexed on the first call for
+ * that array, so walking all entries in order is linear.
+ */
+static bool nativeGetArrayEntry(void *state, HWTJ_HANDLE_TYPE array, int index,
+                                HWTJ_HANDLE_TYPE *entry)
+{
+  NATIVE_PARSER_TYPE *parser = (NATIVE_PARSER_TYPE *)state;
+
+  if (!validHandle(parser, array) ||
+      parser->nodes[array].type != HWTJ_ARRAY_TYPE ||
+      index < 0 || index >= parser->nodes[array].count)
+  {
+    return false;
+  }
+
+  if (parser->entryArray != (int)array)
+  {
+    int count = parser->nodes[array].count;
+    if (count > parser->entryCapacity)
+    {
+      int *newEntries = (int *)realloc(parser->entryNodes, count * sizeof(int));
+      if (newEntries == NULL)
+      {
+        return false;
+      }
+      parser->entryNodes = newEntries;
+      parser->entryCapacity = count;
+    }
+
+    int node = array + 1;
+    for (int i = 0; i < count; i++)
+    {
+      parser->entryNodes[i] = node;
+      node = parser->nodes[node].next;
+    }
+    parser->entryArray = array;
+  }
+
+  *entry = parser->entryNodes[index];
+  return true;
+}
+
+static int nativeGetEntryCount(void *state, HWTJ_HANDLE_TYPE handle)
+{
+  NATIVE_PARSER_TYPE *parser = (NATIVE_PARSER_TYPE *)state;
+
+  if (!validHandle(parser, handle) ||
+      (parser->nodes[handle].type != HWTJ_OBJECT_TYPE &&
+       parser->nodes[handle].type != HWTJ_ARRAY_TYPE))
+  {
+    return -1;
+  }
+
+  return parser->nodes[handle].count;
+}
+
+/*
+ * Method: nativeGetObjectEntry
+ *
+ * A member asked for after the one returned last is found from
+ * there, so walking all members of an object in order is linear.
+ */
+static bool nativeGetObjectEntry(void *state, HWTJ_HANDLE_TYPE object,
+                                 int index, const char **name, int *nameLen,
+                                 HWTJ_HANDLE_TYPE *value)
+{
+  NATIVE_PARSER_TYPE *parser = (NATIVE_PARSER_TYPE *)state;
+
+  if (!validHandle(parser, object) ||
+      parser->nodes[object].type != HWTJ_OBJECT_TYPE ||
+      index < 0 || index >= parser->nodes[object].count)
+  {
+    return false;
+  }
+
+  int key = object + 1;
+  int i = 0;
+
+  if (parser->memberObject == (int)object && index >= parser->memberIndex)
+  {
+    key = parser->memberKey;
+    i = parser->memberIndex;
+  }
+  for (; i < index; i++)
+  {
+    key = parser->nodes[key + 1].next;
+  }
+
+  parser->memberObject = object;
+  parser->memberIndex = index;
+  parser->memberKey = key;
+
+  NATIVE_NODE_TYPE *keyNode = &parser->nodes[key];
+  *value = key + 1;
+
+  if (keyNode->flags & NATIVE_ESCAPED)
+  {
+    return unescape(parser, keyNode, name, nameLen);
+  }
+
+  *name = parser->text + keyNode->start;
+  *nameLen = keyNode->len;
+  return true;
+}
+
+static void nativeDisplayError(void *state, const char *msg)
+{
+  NATIVE_PARSER_TYPE *parser = (NATIVE_PARSER_TYPE *)state;
+
+  printf("ERROR: %s\n", msg);
+  if (parser != NULL && parser->error != NULL)
+  {
+    printf("Reason Text: %s at offset %d\n", parser->error, parser->errorPos);
+  }
+}
+
+static bool nativeTerm(void *state)
+{
+  NATIVE_PARSER_TYPE *parser = (NATIVE_PARSER_TYPE *)state;
+
+  if (parser != NULL)
+  {
+    free(parser->nodes);
+    free(parser->entryNodes);
+    free(parser->scratch);
+    free(parser);
+  }
+
+  return true;
+}
+
+JSON_BACKEND_TYPE nativeBackend = {
+    "NATIVE",
+    nativeInit,
+    nativeParse,
+    nativeSearch,
+    nativeGetType,
+    nativeGetValue,
+    nativeGetBoolean,
+    nativeGetArrayEntry,
+    nativeGetEntryCount,
+    nativeGetObjectEntry,
+    nativeDisplayError,
+    nativeTerm};
@@ -0,0 +1,301 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    MODULE NAME= HWIJNUM                                             *
+ *                                                                     *
+ *  Sample C code that converts the text of JSON numbers to 64 bit     *
+ *  integers and doubles straight from the parsed text, without the    *
+ *  NUL terminated copy atoi, atoll and strtod need. Doubles with at   *
+ *  most 2 ** 53 as mantissa and a small exponent, which covers the    *
+ *  energy and processor usage figures, are computed exactly from      *
+ *  the digits. Longer numbers fall back to strtod.                    *
+ *                                                                     *
+ *************************END OF SPECIFICATIONS************************/
+#pragma filetag("IBM-1047")    /* compile in EBCDIC */
+#pragma csect(code, "HWIJNUM") /* name of csect */
+#pragma longName
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "hwijnum.h"
+
+/* a double represents every integer up to this one */
+#define NUM_EXACT_MANTISSA (1ULL << 53)
+
+static const double powersOfTen[NUM_FAST_EXPONENT + 1] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+/*
+ * Method: isDigit
+ *
+ * '0' to '9' are contiguous in EBCDIC as in ASCII.
+ */
+static bool isDigit(char c)
+{
+  return c >= '0' && c <= '9';
+}
+
+/*
+ * Method: parseDigits
+ *
+ * returns: true when text is one or more digits whose value fits in
+ *          an unsigned 64 bit integer
+ */
+static bool parseDigits(const char *text, int len, unsigned long long *value)
+{
+  unsigned long long number = 0;
+
+  if (len <= 0)
+  {
+    return false;
+  }
+
+  for (int i = 0; i < len; i++)
+  {
+    if (!isDigit(text[i]))
+    {
+      return false;
+    }
+
+    unsigned int digit = text[i] - '0';
+    if (number > (~0ULL - digit) / 10)
+    {
+      return false;
+    }
+    number = number * 10 + digit;
+  }
+
+  *value = number;
+
+  return true;
+}
+
+/*
+ * Method: parseInt64
+ *
+ * returns: true when the len characters of text are a JSON integer
+ *          in the range of a signed 64 bit integer, value is set
+ */
+bool parseInt64(const char *text, int len, long long *value)
+{
+  bool negative = len > 0 && text[0] == '-';
+  unsigned long long magnitude;
+
+  if (!parseDigits(text + negative, len - negative, &magnitude))
+  {
+    return false;
+  }
+
+  if (negative)
+  {
+    if (magnitude > (1ULL << 63))
+    {
+      return false;
+    }
+    *value = magnitude == 0 ? 0 : -(long long)(magnitude - 1) - 1;
+  }
+  else
+  {
+    if (magnitude > (1ULL << 63) - 1)
+    {
+      return false;
+    }
+    *value = (long long)magnitude;
+  }
+
+  return true;
+}
+
+/*
+ * Method: parseUint64
+ *
+ * returns: true when the len characters of text are a JSON integer
+ *          in the range of an unsigned 64 bit integer, value is set
+ */
+bool parseUint64(const char *text, int len, unsigned long long *value)
+{
+  return parseDigits(text, len, value);
+}
+
+/*
+ * Method: slowDouble
+ *
+ * Convert a number the fast path cannot with strtod, from a NUL
+ * terminated copy.
+ */
+static bool slowDouble(const char *text, int len, double *value)
+{
+  char number[64];
+  char *copy = len < (int)sizeof(number) ? number : (char *)malloc(len + 1);
+  char *end = NULL;
+
+  if (copy == NULL)
+  {
+    return false;
+  }
+
+  memcpy(copy, text, len);
+  copy[len] = '\0';
+
+  double converted = strtod(copy, &end);
+  bool complete = end == copy + len;
+
+  if (copy != number)
+  {
+    free(copy);
+  }
+
+  if (!complete || converted == HUGE_VAL || converted == -HUGE_VAL)
+  {
+    return false;
+  }
+
+  *value = converted;
+
+  return true;
+}
+
+/*
+ * Method: parseDouble
+ *
+ * returns: true when the len characters of text are a JSON number
+ *          in the range of a double, value is set to the nearest
+ *          double
+ */
+bool parseDouble(const char *text, int len, double *value)
+{
+  unsigned long long mantissa = 0;
+  int digits = 0;         /* significant digits in mantissa */
+  bool truncated = false; /* nonzero digits past NUM_MAX_DIGITS */
+  int exponent = 0;
+  int i = 0;
+
+  bool negative = len > 0 && text[0] == '-';
+  i += negative;
+
+  /* integer part */
+  int start = i;
+  while (i < len && isDigit(text[i]))
+  {
+    if (digits < NUM_MAX_DIGITS)
+    {
+      mantissa = mantissa * 10 + (text[i] - '0');
+      digits += mantissa != 0;
+    }
+    else
+    {
+      exponent++;
+      truncated = truncated || text[i] != '0';
+    }
+    i++;
+  }
+  if (i == start)
+  {
+    return false;
+  }
+
+  /* fraction */
+  if (i < len && text[i] == '.')
+  {
+    start = ++i;
+    while (i < len && isDigit(text[i]))
+    {
+      if (digits < NUM_MAX_DIGITS)
+      {
+        mantissa = mantissa * 10 + (text[i] - '0');
+        digits += mantissa != 0;
+        exponent--;
+      }
+      else
+      {
+        truncated = truncated || text[i] != '0';
+      }
+      i++;
+    }
+    if (i == start)
+    {
+      return false;
+    }
+  }
+
+  /* exponent */
+  if (i < len && (text[i] == 'e' || text[i] == 'E'))
+  {
+    bool negativeExponent = false;
+    int power = 0;
+
+    i++;
+    if (i < len && (text[i] == '+' || text[i] == '-'))
+    {
+      negativeExponent = text[i] == '-';
+      i++;
+    }
+
+    start = i;
+    while (i < len && isDigit(text[i]))
+    {
+      if (power < 100000)
+      {
+        power = power * 10 + (text[i] - '0');
+      }
+      i++;
+    }
+    if (i == start)
+    {
+      return false;
+    }
+
+    exponent += negativeExponent ? -power : power;
+  }
+
+  if (i != len)
+  {
+    return false;
+  }
+
+  if (mantissa == 0 && !truncated)
+  {
+    *value = negative ? -0.0 : 0.0;
+    return true;
+  }
+
+  if (truncated || mantissa > NUM_EXACT_MANTISSA ||
+      exponent < -NUM_FAST_EXPONENT || exponent > NUM_FAST_EXPONENT)
+  {
+    return slowDouble(text, len, value);
+  }
+
+  /* both operands are exact, so the one rounding is the correct one */
+  double converted = (double)mantissa;
+  if (exponent < 0)
+  {
+    converted /= powersOfTen[-exponent];
+  }
+  else
+  {
+    converted *= powersOfTen[exponent];
+  }
+
+  *value = negative ? -converted : converted;
+
+  return true;
+}
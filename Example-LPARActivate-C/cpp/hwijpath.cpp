@@ -0,0 +1,466 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    MODULE NAME= HWIJPATH                                            *
+ *                                                                     *
+ *  Sample C code that selects values from a parsed response with a    *
+ *  path compiled once, e.g. {status,job-status-code,job-reason-code}  *
+ *  or logical-partitions[*].{name,object-uri}. Each object the path   *
+ *  leads to is walked once, member by member, picking out all the     *
+ *  fields, instead of searching the object again for every field.     *
+ *                                                                     *
+ *************************END OF SPECIFICATIONS************************/
+#pragma filetag("IBM-1047")     /* compile in EBCDIC */
+#pragma csect(code, "HWIJPATH") /* name of csect */
+#pragma longName
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <hwtjic.h> /* JSON interface declaration file  */
+#include "hwijbknd.h"
+#include "hwijprs.h"
+#include "hwijpath.h"
+
+static bool selectFrom(JSON_PARSER_TYPE *parser, JSON_PATH_TYPE *path,
+                       int segment, HWTJ_HANDLE_TYPE object,
+                       PATH_RESULT_TYPE *result);
+
+/*
+ * Method: pathFailed
+ *
+ * Reports a syntax error in a path and frees what was compiled so far.
+ */
+static JSON_PATH_TYPE *pathFailed(JSON_PATH_TYPE *path, const char *pathText,
+                                  const char *reason)
+{
+  printf("ERROR: path %s is not valid, %s\n", pathText, reason);
+  freePath(path);
+  return NULL;
+}
+
+/*
+ * Method: copyName
+ *
+ * returns: a NUL terminated copy of len characters of text
+ */
+static char *copyName(const char *text, int len)
+{
+  char *copy = (char *)malloc(len + 1);
+  if (copy != NULL)
+  {
+    memcpy(copy, text, len);
+    copy[len] = '\0';
+  }
+
+  return copy;
+}
+
+/*
+ * Method: compilePath
+ *
+ * Compiles a path of member names separated by '.', where name[*]
+ * applies the rest of the path to each entry of the array name. The
+ * path ends in the fields to select, either {field,...} or the last
+ * name alone. Names cannot contain '.', ',', '[', '{' or '}'.
+ *
+ * returns: the path the caller frees with freePath, NULL when the
+ *          text is not a valid path
+ */
+JSON_PATH_TYPE *compilePath(const char *pathText)
+{
+  JSON_PATH_TYPE *path = (JSON_PATH_TYPE *)calloc(1, sizeof(JSON_PATH_TYPE));
+  if (path == NULL)
+  {
+    printf("ERROR: unable to allocate storage for path %s\n", pathText);
+    return NULL;
+  }
+
+  const char *pos = pathText;
+
+  while (*pos != '{')
+  {
+    int len = strcspn(pos, ".,[{}");
+    if (len == 0)
+    {
+      return pathFailed(path, pathText, "a name is empty");
+    }
+
+    bool eachEntry = strncmp(pos + len, "[*]", 3) == 0;
+    const char *end = pos + len + (eachEntry ? 3 : 0);
+
+    if (*end == '\0' && !eachEntry)
+    {
+      /* the last name alone is the field */
+      path->fields[0] = copyName(pos, len);
+      path->fieldLens[0] = len;
+      path->fieldCount = 1;
+      if (path->fields[0] == NULL)
+      {
+        return pathFailed(path, pathText, "out of storage");
+      }
+      return path;
+    }
+    if (*end != '.')
+    {
+      return pathFailed(path, pathText, "expected '.' after a name");
+    }
+    if (path->segmentCount == PATH_MAX_SEGMENTS)
+    {
+      return pathFailed(path, pathText, "too many names");
+    }
+
+    PATH_SEGMENT_TYPE *segment = &path->segments[path->segmentCount++];
+    segment->eachEntry = eachEntry;
+    segment->name = copyName(pos, len);
+    if (segment->name == NULL)
+    {
+      return pathFailed(path, pathText, "out of storage");
+    }
+
+    pos = end + 1;
+  }
+
+  /* {field,...} */
+  pos++;
+  for (;;)
+  {
+    int len = strcspn(pos, ".,[{}");
+    if (len == 0)
+    {
+      return pathFailed(path, pathText, "a field is empty");
+    }
+    if (path->fieldCount == PATH_MAX_FIELDS)
+    {
+      return pathFailed(path, pathText, "too many fields");
+    }
+
+    int field = path->fieldCount++;
+    path->fields[field] = copyName(pos, len);
+    path->fieldLens[field] = len;
+    if (path->fields[field] == NULL)
+    {
+      return pathFailed(path, pathText, "out of storage");
+    }
+
+    pos += len;
+    if (*pos == '}')
+    {
+      break;
+    }
+    if (*pos != ',')
+    {
+      return pathFailed(path, pathText, "expected ',' or '}' after a field");
+    }
+    pos++;
+  }
+
+  if (pos[1] != '\0')
+  {
+    return pathFailed(path, pathText, "text follows the fields");
+  }
+
+  return path;
+}
+
+/*
+ * Method: freePath
+ */
+void freePath(JSON_PATH_TYPE *path)
+{
+  if (path == NULL)
+  {
+    return;
+  }
+
+  for (int i = 0; i < path->segmentCount; i++)
+  {
+    free(path->segments[i].name);
+  }
+  for (int i = 0; i < path->fieldCount; i++)
+  {
+    free(path->fields[i]);
+  }
+  free(path);
+}
+
+/*
+ * Method: addRow
+ *
+ * returns: the values of a new row, none of them found yet
+ */
+static PATH_VALUE_TYPE *addRow(PATH_RESULT_TYPE *result)
+{
+  if (result->rowCount == result->rowCapacity)
+  {
+    int capacity = result->rowCapacity == 0 ? 1 : result->rowCapacity * 2;
+    int rowSize = result->fieldCount * sizeof(PATH_VALUE_TYPE);
+    PATH_VALUE_TYPE *values = NULL;
+
+    if (result->arena != NULL)
+    {
+      /* the rows outgrown stay in the arena until it is reset */
+      values = (PATH_VALUE_TYPE *)arenaAlloc(result->arena,
+                                             capacity * rowSize);
+      if (values != NULL && result->rowCount > 0)
+      {
+        memcpy(values, result->values, result->rowCount * rowSize);
+      }
+    }
+    else
+    {
+      values = (PATH_VALUE_TYPE *)realloc(result->values,
+                                          capacity * rowSize);
+    }
+
+    if (values == NULL)
+    {
+      printf("ERROR: unable to allocate storage for selected values\n");
+      return NULL;
+    }
+    result->values = values;
+    result->rowCapacity = capacity;
+  }
+
+  PATH_VALUE_TYPE *row = &result->values[result->rowCount++ *
+                                         result->fieldCount];
+  memset(row, 0, result->fieldCount * sizeof(PATH_VALUE_TYPE));
+
+  return row;
+}
+
+/*
+ * Method: selectFields
+ *
+ * Walks the members of object once, the first member with the name
+ * of a field is its value. The walk stops once every field is found.
+ */
+static bool selectFields(JSON_PARSER_TYPE *parser, JSON_PATH_TYPE *path,
+                         HWTJ_HANDLE_TYPE object, PATH_RESULT_TYPE *result)
+{
+  PATH_VALUE_TYPE *row = addRow(result);
+  if (row == NULL)
+  {
+    return false;
+  }
+
+  JSON_BACKEND_TYPE *backend = parser->backend;
+  int members = backend->getEntryCount(parser->state, object);
+  int missing = path->fieldCount;
+
+  for (int i = 0; i < members && missing > 0; i++)
+  {
+    const char *name;
+    int nameLen;
+    HWTJ_HANDLE_TYPE value;
+
+    if (!backend->getObjectEntry(parser->state, object, i, &name, &nameLen,
+                                 &value))
+    {
+      backend->displayError(parser->state, "Unable to retrieve object entry.");
+      return false;
+    }
+
+    for (int f = 0; f < path->fieldCount; f++)
+    {
+      if (!row[f].found && path->fieldLens[f] == nameLen &&
+          memcmp(path->fields[f], name, nameLen) == 0)
+      {
+        if (!backend->getType(parser->state, value, &row[f].type))
+        {
+          backend->displayError(parser->state, "Unable to retrieve type.");
+          return false;
+        }
+        row[f].value = value;
+        row[f].found = true;
+        missing--;
+        break;
+      }
+    }
+  }
+
+  return true;
+}
+
+/*
+ * Method: selectEntries
+ *
+ * Applies the rest of the path to each object entry of array.
+ */
+static bool selectEntries(JSON_PARSER_TYPE *parser, JSON_PATH_TYPE *path,
+                          int segment, HWTJ_HANDLE_TYPE array,
+                          PATH_RESULT_TYPE *result)
+{
+  JSON_BACKEND_TYPE *backend = parser->backend;
+  int entries = backend->getEntryCount(parser->state, array);
+
+  for (int i = 0; i < entries; i++)
+  {
+    HWTJ_HANDLE_TYPE entry;
+    HWTJ_JTYPE_TYPE type;
+
+    if (!backend->getArrayEntry(parser->state, array, i, &entry) ||
+        !backend->getType(parser->state, entry, &type))
+    {
+      backend->displayError(parser->state, "Unable to retrieve array entry.");
+      return false;
+    }
+
+    if (type == HWTJ_OBJECT_TYPE &&
+        !selectFrom(parser, path, segment, entry, result))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/*
+ * Method: selectFrom
+ *
+ * Follows the path from segment on, starting at object.
+ */
+static bool selectFrom(JSON_PARSER_TYPE *parser, JSON_PATH_TYPE *path,
+                       int segment, HWTJ_HANDLE_TYPE object,
+                       PATH_RESULT_TYPE *result)
+{
+  JSON_BACKEND_TYPE *backend = parser->backend;
+
+  for (; segment < path->segmentCount; segment++)
+  {
+    HWTJ_HANDLE_TYPE value;
+    HWTJ_JTYPE_TYPE type;
+
+    /* a missing member leads nowhere, no rows */
+    if (!backend->search(parser->state, object, path->segments[segment].name,
+                         &value) ||
+        !backend->getType(parser->state, value, &type))
+    {
+      return true;
+    }
+
+    if (path->segments[segment].eachEntry)
+    {
+      return type != HWTJ_ARRAY_TYPE ||
+             selectEntries(parser, path, segment + 1, value, result);
+    }
+    if (type != HWTJ_OBJECT_TYPE)
+    {
+      return true;
+    }
+
+    object = value;
+  }
+
+  return selectFields(parser, path, object, result);
+}
+
+/*
+ * Method: selectPath
+ *
+ * Selects the fields of path from the text last parsed by the current
+ * parser context, following the path from start, e.g. the outermost
+ * object (handle 0). The rows are added to result, which starts out
+ * zeroed, or with only its arena set, and is freed with
+ * freePathResult.
+ *
+ * returns: false when the parsed text could not be walked
+ */
+bool selectPath(JSON_PATH_TYPE *path, HWTJ_HANDLE_TYPE start,
+                PATH_RESULT_TYPE *result)
+{
+  JSON_PARSER_TYPE *parser = current_parser();
+  if (parser == NULL || path == NULL)
+  {
+    return false;
+  }
+
+  if (result->fieldCount != path->fieldCount)
+  {
+    freePathResult(result);
+    result->fieldCount = path->fieldCount;
+  }
+
+  return selectFrom(parser, path, 0, start, result);
+}
+
+/*
+ * Method: selectedValue
+ *
+ * returns: a field of a row of result
+ */
+PATH_VALUE_TYPE *selectedValue(PATH_RESULT_TYPE *result, int row, int field)
+{
+  return &result->values[row * result->fieldCount + field];
+}
+
+/*
+ * Method: selectedString
+ *
+ * returns: a copy of a string or number field the caller frees,
+ *          NULL when the field was missing or of another type
+ */
+char *selectedString(PATH_RESULT_TYPE *result, int row, int field)
+{
+  PATH_VALUE_TYPE *value = selectedValue(result, row, field);
+
+  if (!value->found || (value->type != HWTJ_STRING_TYPE &&
+                        value->type != HWTJ_NUMBER_TYPE))
+  {
+    return NULL;
+  }
+
+  return (char *)do_get_value(&value->value, value->type);
+}
+
+/*
+ * Method: selectedView
+ *
+ * Points view at a string or number field of a row of result without
+ * copying it, see get_view.
+ *
+ * returns: false when the field was missing or of another type
+ */
+bool selectedView(PATH_RESULT_TYPE *result, int row, int field,
+                  HWTJ_JTYPE_TYPE expected_value_type, JSON_VIEW_TYPE *view)
+{
+  PATH_VALUE_TYPE *value = selectedValue(result, row, field);
+
+  return value->found && value->type == expected_value_type &&
+         get_view(value->value, result->arena, view);
+}
+
+/*
+ * Method: freePathResult
+ *
+ * Frees the rows of result, unless they came from its arena, and
+ * leaves it empty for the next select.
+ */
+void freePathResult(PATH_RESULT_TYPE *result)
+{
+  ARENA_TYPE *arena = result->arena;
+
+  if (arena == NULL)
+  {
+    free(result->values);
+  }
+  memset(result, 0, sizeof(PATH_RESULT_TYPE));
+  result->arena = arena;
+}
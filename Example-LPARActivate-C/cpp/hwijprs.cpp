@@ -23,45 +23,201 @@
  *  Sample C code that defines utility like methods for parsing        *
  *  and retrieving various properties from JSON text.                  *
  *                                                                     *
- *  See the z/OS MVS Programming: Callable Services for                *
- *  High-Level Languages publication for more information              *
- *  regarding the usage of JSON Parser APIs.                           *
+ *  The parsing itself is done by the JSON backend selected in         *
+ *  init_parser, see hwijbknd.h.                                       *
  *                                                                     *
  *************************END OF SPECIFICATIONS************************/
 #pragma filetag("IBM-1047")    /* compile in EBCDIC */
 #pragma csect(code, "HWIJPRS") /* name of csect */
 #pragma longName
+#if defined(__MVS__) && !defined(_OPEN_THREADS) && !defined(_UNIX03_THREADS)
+#define _OPEN_THREADS /* thread-specific data for the parser contexts */
+#endif
 #include <stdlib.h>
 #include <unistd.h>
 #include <stdio.h>
 #include <string.h>
 #include <strings.h>
+#include <pthread.h>
 #include <hwtjic.h> /* JSON interface declaration file  */
+#include "hwijbknd.h"
 #include "hwijprs.h"
+#include "hwijnum.h"
 
-/* parser global variables */
-/* Used to specify the max work area size to parser init service (hwtjinit). */
-#define MAX_WORKAREA_SIZE 0 /* Zero = No limit (IBM recommended value) */
+/* the JSON backend selected by init_parser, shared by all threads */
+static JSON_BACKEND_TYPE *jsonBackend = NULL;
 
-/* A parser instance is required for all JSON callable services. */
-HWTJ_PARSERHANDLE_TYPE parser_instance;
+/* JSON_THREAD_PARSERS_TYPE of each thread */
+static pthread_key_t threadParsersKey;
+static pthread_once_t threadParsersOnce = PTHREAD_ONCE_INIT;
 
-/* A structure for storing reason codes and error descriptions. */
-HWTJ_DIAGAREA_TYPE diag_area;
+/*
+ * Method: search_member
+ *
+ * Backend search through the key index of the context, so that many
+ * names read from one object do not each walk its members.
+ */
+static bool search_member(JSON_PARSER_TYPE *parser, HWTJ_HANDLE_TYPE object,
+                          const char *name, HWTJ_HANDLE_TYPE *value)
+{
+  return keyIndexSearch(&parser->keyIndex, parser->backend, parser->state,
+                        object, name, value);
+}
+
+/*
+ * Method: newParser
+ *
+ * Allocate a parser context and initialize its backend state.
+ *
+ * returns: the context, NULL if the backend failed to initialize
+ */
+static JSON_PARSER_TYPE *newParser()
+{
+  JSON_PARSER_TYPE *parser =
+      (JSON_PARSER_TYPE *)calloc(1, sizeof(JSON_PARSER_TYPE));
+  if (parser == NULL)
+  {
+    printf("ERROR: Parser context could not be allocated.\n");
+    return NULL;
+  }
+
+  parser->backend = jsonBackend;
+  if (!jsonBackend->init(&parser->state))
+  {
+    jsonBackend->displayError(parser->state, "Parser initialization failed.");
+    jsonBackend->term(parser->state);
+    free(parser);
+    return NULL;
+  }
 
-/* A return code to store the result of each service call. */
-int jpreturncode;
+  return parser;
+}
 
 /*
- * Method: init_parser
+ * Method: termParser
+ *
+ * Terminate the backend state of a parser context and free it.
+ */
+static bool termParser(JSON_PARSER_TYPE *parser)
+{
+  bool success = parser->backend->term(parser->state);
+
+  freeKeyIndex(&parser->keyIndex);
+  free(parser);
+
+  return success;
+}
+
+/*
+ * Method: termThreadParsers
+ *
+ * Terminate the current and pooled parser contexts of a thread,
+ * also called by the thread key when a thread ends.
+ */
+static bool termThreadParsers(void *data)
+{
+  JSON_THREAD_PARSERS_TYPE *thread = (JSON_THREAD_PARSERS_TYPE *)data;
+  bool success = true;
+
+  if (thread->current != NULL)
+  {
+    success = termParser(thread->current);
+    thread->current = NULL;
+  }
+
+  while (thread->pool != NULL)
+  {
+    JSON_PARSER_TYPE *parser = thread->pool;
+    thread->pool = parser->next;
+    success = termParser(parser) && success;
+  }
+  thread->pooled = 0;
+
+  return success;
+}
+
+/*
+ * Method: freeThreadParsers
+ *
+ * Destructor of the thread key.
+ */
+static void freeThreadParsers(void *data)
+{
+  termThreadParsers(data);
+  free(data);
+}
+
+/*
+ * Method: createThreadParsersKey
+ */
+static void createThreadParsersKey()
+{
+  pthread_key_create(&threadParsersKey, freeThreadParsers);
+}
+
+/*
+ * Method: threadParsers
+ *
+ * The parser contexts of the calling thread, created on first use.
  *
- * Initializes the global parser_instance variable.
+ * returns: NULL when out of storage
+ */
+static JSON_THREAD_PARSERS_TYPE *threadParsers()
+{
+  void *data = NULL;
+
+  pthread_once(&threadParsersOnce, createThreadParsersKey);
+
+#if defined(__MVS__) && !defined(_UNIX03_THREADS)
+  pthread_getspecific(threadParsersKey, &data);
+#else
+  data = pthread_getspecific(threadParsersKey);
+#endif
+
+  if (data == NULL)
+  {
+    data = calloc(1, sizeof(JSON_THREAD_PARSERS_TYPE));
+    if (data != NULL && pthread_setspecific(threadParsersKey, data) != 0)
+    {
+      free(data);
+      data = NULL;
+    }
+  }
+
+  return (JSON_THREAD_PARSERS_TYPE *)data;
+}
+
+/*
+ * Method: current_parser
  *
- * Services Used:
+ * The parser context the helpers work on in the calling thread, one
+ * is acquired the first time a thread uses the helpers.
  *
- *    HWTJINIT: Provides a handle to a parse instance which is then used in
- *              subsequent service calls. The HWTJINIT service must be invoked
- *              before invoking any other parsing service.
+ * returns: NULL when no context could be acquired
+ */
+JSON_PARSER_TYPE *current_parser()
+{
+  JSON_THREAD_PARSERS_TYPE *thread = threadParsers();
+
+  if (thread == NULL)
+  {
+    return NULL;
+  }
+  if (thread->current == NULL)
+  {
+    thread->current = acquire_parser();
+  }
+
+  return thread->current;
+}
+
+/*
+ * Method: init_parser
+ *
+ * Selects the JSON backend named by HWIRSTC1_JSON, HWTJ (the z/OS JSON
+ * parser) by default on z/OS and NATIVE elsewhere, and initializes the
+ * parser context of the calling thread. Call it before other threads
+ * use the helpers, the backend is shared by all of them.
  */
 bool init_parser()
 {
@@ -69,25 +225,142 @@ bool init_parser()
   /* Declare a variable to hold the return value. */
   bool success = false;
 
-  /* Initialize the parser work area and retrieve a handle to a parser
-   * instance.
-   */
-  hwtjinit(&jpreturncode,
-           MAX_WORKAREA_SIZE, /* size (in bytes) of the parser work area (input) */
-           parser_instance,
-           &diag_area);
+#ifdef __MVS__
+  JSON_BACKEND_TYPE *backends[] = {&hwtjBackend, &nativeBackend,
+                                   &indexBackend};
+#else
+  JSON_BACKEND_TYPE *backends[] = {&nativeBackend, &indexBackend};
+#endif
+  int backendCount = sizeof(backends) / sizeof(backends[0]);
 
-  if (jpreturncode == HWTJ_OK)
+  jsonBackend = backends[0];
+
+  char *name = getenv(JSON_BACKEND_ENV);
+  if (name != NULL && name[0] != '\0')
+  {
+    jsonBackend = NULL;
+    for (int i = 0; i < backendCount; i++)
+    {
+      if (strcasecmp(name, backends[i]->name) == 0)
+      {
+        jsonBackend = backends[i];
+      }
+    }
+
+    if (jsonBackend == NULL)
+    {
+      printf("ERROR: JSON backend %s is not available.\n", name);
+      return false;
+    }
+    if (jsonBackend != backends[0])
+    {
+      printf("*>>JSON backend: %s\n", jsonBackend->name);
+    }
+  }
+
+  if (current_parser() != NULL)
   {
     printf("SUCCESS: Parser initialized.\n");
     success = true;
   }
+
+  return success;
+}
+
+/*
+ * Method: acquire_parser
+ *
+ * Take an initialized parser context from the pool of the calling
+ * thread, or initialize a new one when the pool is empty. Pooled
+ * contexts keep their backend state, so reusing one needs no
+ * HWTJINIT. The context is not made current, see use_parser.
+ *
+ * returns: the context, NULL if none could be initialized
+ */
+JSON_PARSER_TYPE *acquire_parser()
+{
+  JSON_THREAD_PARSERS_TYPE *thread = threadParsers();
+
+  if (jsonBackend == NULL || thread == NULL)
+  {
+    return NULL;
+  }
+
+  if (thread->pool != NULL)
+  {
+    JSON_PARSER_TYPE *parser = thread->pool;
+    thread->pool = parser->next;
+    thread->pooled--;
+    parser->next = NULL;
+    return parser;
+  }
+
+  return newParser();
+}
+
+/*
+ * Method: release_parser
+ *
+ * Return a parser context acquired by the calling thread to its pool,
+ * it is terminated when the pool is full.
+ */
+void release_parser(JSON_PARSER_TYPE *parser)
+{
+  JSON_THREAD_PARSERS_TYPE *thread = threadParsers();
+
+  if (parser == NULL)
+  {
+    return;
+  }
+
+  if (thread != NULL && thread->current == parser)
+  {
+    thread->current = NULL;
+  }
+
+  if (thread != NULL && thread->pooled < JSON_PARSER_POOL_MAX &&
+      parser->backend == jsonBackend)
+  {
+    parser->next = thread->pool;
+    thread->pool = parser;
+    thread->pooled++;
+  }
   else
   {
-    display_error("Parser initialization failed.");
+    termParser(parser);
   }
+}
 
-  return success;
+/*
+ * Method: use_parser
+ *
+ * Make parser the context the helpers of the calling thread work on,
+ * e.g. to parse a second document without losing the first one.
+ *
+ * returns: the context that was current, to restore it afterwards
+ */
+JSON_PARSER_TYPE *use_parser(JSON_PARSER_TYPE *parser)
+{
+  JSON_THREAD_PARSERS_TYPE *thread = threadParsers();
+  JSON_PARSER_TYPE *previous = NULL;
+
+  if (thread != NULL)
+  {
+    previous = thread->current;
+    thread->current = parser;
+  }
+
+  return previous;
+}
+
+/*
+ * Method: json_backend_name
+ *
+ * Name of the JSON backend selected by init_parser.
+ */
+const char *json_backend_name()
+{
+  return jsonBackend != NULL ? jsonBackend->name : "none";
 }
 
 /*
@@ -95,17 +368,11 @@ bool init_parser()
  *
  * Parses the sample JSON data.
  *
- * Services Used:
- *
- *    HWTJPARS: Builds an internal representation of the specified JSON string.
- *              This allows efficient search, traversal, and modification of
- *              the JSON data.
- *
- *    USAGE:   HWTJPARS does not make a local copy of the JSON source string.
- *             Therefore, the caller must ensure that the provided source
- *             string remains unmodified for the duration of the parser
- *             instance. If the source string is modified, subsequent service
- *             calls may result in unexpected behavior.
+ *    USAGE:   The backends do not make a local copy of the JSON source
+ *             string. Therefore, the caller must ensure that the provided
+ *             source string remains unmodified until the next parse.
+ *             If the source string is modified, subsequent calls may
+ *             result in unexpected behavior.
  */
 bool parse_json_text(const char *jtext)
 {
@@ -113,17 +380,21 @@ bool parse_json_text(const char *jtext)
   /* Declare a variable to hold the return variable. */
   bool success = false;
 
+  JSON_PARSER_TYPE *parser = current_parser();
+  if (parser == NULL)
+  {
+    return success;
+  }
+
   /* Parse the sample JSON text string. Parse scans the JSON text string and
    * creates an internal representation of the JSON data suitable for search
-   * and create operations.
+   * operations.
    */
-  hwtjpars(&jpreturncode,
-           parser_instance,
-           (char *)&jtext, /* JSON text string address(input) */
-           strlen(jtext),  /* JSON text string length (input) */
-           &diag_area);
+  parser->text = jtext;
+  parser->textLen = strlen(jtext);
+  resetKeyIndex(&parser->keyIndex);
 
-  if (jpreturncode == HWTJ_OK)
+  if (parser->backend->parse(parser->state, jtext, parser->textLen))
   {
     success = true;
   }
@@ -192,16 +463,335 @@ char *find_number(HWTJ_HANDLE_TYPE object, char *search_string)
  *           file.
  *
  * Output: A pointer to the value is returned.
- *
- * Services Used:
- *    HWTJGJST: Gets the JSON type associated with a specified object or entry
- *              handle.
- *    HWTJSRCH: Finds a particular name string within the JSON text.
- *
  */
 void *find_value(HWTJ_HANDLE_TYPE object_to_search, char *name,
                  HWTJ_JTYPE_TYPE expected_value_type)
 {
+  return search_value(object_to_search, name, expected_value_type, false);
+}
+
+/*
+ * Method: find_optional_value
+ *
+ * Same as find_value, but for names that are not always present in the
+ * object (or may be null). A missing name or a value of a different type
+ * returns NULL without printing an error.
+ */
+void *find_optional_value(HWTJ_HANDLE_TYPE object_to_search, char *name,
+                          HWTJ_JTYPE_TYPE expected_value_type)
+{
+  return search_value(object_to_search, name, expected_value_type, true);
+}
+
+/*
+ * Method: find_optional_string
+ *
+ * find_string for an optional name:value pair.
+ */
+char *find_optional_string(HWTJ_HANDLE_TYPE object, char *search_string)
+{
+  return (char *)find_optional_value(object, search_string,
+                                     HWTJ_STRING_TYPE);
+}
+
+/*
+ * Method: find_optional_number
+ *
+ * find_number for an optional name:value pair.
+ */
+char *find_optional_number(HWTJ_HANDLE_TYPE object, char *search_string)
+{
+  return (char *)find_optional_value(object, search_string,
+                                     HWTJ_NUMBER_TYPE);
+}
+
+/*
+ * Method: find_view
+ *
+ * Searches the specified JSON object for a name:value pair of the
+ * expected type, string or number, and points view at the value
+ * without copying it. A missing name or unexpected type is not
+ * reported.
+ *
+ * Input:  - A handle of type object or array.
+ *         - The name to search for.
+ *         - HWTJ_STRING_TYPE or HWTJ_NUMBER_TYPE.
+ *         - An arena for a value that has to be copied, or NULL when
+ *           the view is used before the next value is retrieved.
+ *
+ * Output: true when the value was found, view is valid until the next
+ *         parse or until the arena is reset.
+ */
+bool find_view(HWTJ_HANDLE_TYPE object, char *name,
+               HWTJ_JTYPE_TYPE expected_value_type, ARENA_TYPE *arena,
+               JSON_VIEW_TYPE *view)
+{
+  HWTJ_HANDLE_TYPE value_handle = 0;
+  HWTJ_JTYPE_TYPE entry_type;
+
+  JSON_PARSER_TYPE *parser = current_parser();
+  if (parser == NULL)
+  {
+    return false;
+  }
+
+  return search_member(parser, object, name, &value_handle) &&
+         parser->backend->getType(parser->state, value_handle,
+                                  &entry_type) &&
+         entry_type == expected_value_type &&
+         get_view(value_handle, arena, view);
+}
+
+/*
+ * Method: get_view
+ *
+ * Points view at the text of a string or number value. The backends
+ * return the text in place unless it had to be unescaped, only then
+ * is it copied to the arena.
+ */
+bool get_view(HWTJ_HANDLE_TYPE value_handle, ARENA_TYPE *arena,
+              JSON_VIEW_TYPE *view)
+{
+  JSON_PARSER_TYPE *parser = current_parser();
+  if (parser == NULL)
+  {
+    return false;
+  }
+
+  if (!parser->backend->getValue(parser->state, value_handle, &view->text,
+                                 &view->len))
+  {
+    display_error("Unable to retrieve value.");
+    return false;
+  }
+
+  bool inText = parser->text != NULL && view->text >= parser->text &&
+                view->text + view->len <= parser->text + parser->textLen;
+
+  if (!inText && arena != NULL)
+  {
+    view->text = arenaString(arena, view->text, view->len);
+    return view->text != NULL;
+  }
+
+  return true;
+}
+
+/*
+ * Method: view_equals
+ *
+ * returns: true if the viewed value is text
+ */
+bool view_equals(JSON_VIEW_TYPE *view, const char *text)
+{
+  return (int)strlen(text) == view->len &&
+         memcmp(view->text, text, view->len) == 0;
+}
+
+/*
+ * Method: view_to_int
+ *
+ * returns: the viewed number as an int, as atoi would
+ */
+int view_to_int(JSON_VIEW_TYPE *view)
+{
+  char number[32];
+  int len = view->len < (int)sizeof(number) ? view->len
+                                            : (int)sizeof(number) - 1;
+
+  memcpy(number, view->text, len);
+  number[len] = '\0';
+
+  return atoi(number);
+}
+
+/*
+ * Method: view_to_int64
+ *
+ * returns: true when the viewed number is an integer that fits,
+ *          value is set
+ */
+bool view_to_int64(JSON_VIEW_TYPE *view, long long *value)
+{
+  return parseInt64(view->text, view->len, value);
+}
+
+/*
+ * Method: view_to_uint64
+ *
+ * returns: true when the viewed number is a non-negative integer that
+ *          fits, value is set
+ */
+bool view_to_uint64(JSON_VIEW_TYPE *view, unsigned long long *value)
+{
+  return parseUint64(view->text, view->len, value);
+}
+
+/*
+ * Method: view_to_double
+ *
+ * returns: true when the viewed number is in the range of a double,
+ *          value is set
+ */
+bool view_to_double(JSON_VIEW_TYPE *view, double *value)
+{
+  return parseDouble(view->text, view->len, value);
+}
+
+/*
+ * Method: find_int64
+ *
+ * Searches the specified object for a number member and converts it
+ * in place, without the string copy find_number returns. Nothing is
+ * reported when the member is missing.
+ *
+ * Output: true when name holds an integer that fits, value is set
+ */
+bool find_int64(HWTJ_HANDLE_TYPE object, char *name, long long *value)
+{
+  JSON_VIEW_TYPE view;
+
+  return find_view(object, name, HWTJ_NUMBER_TYPE, NULL, &view) &&
+         view_to_int64(&view, value);
+}
+
+/*
+ * Method: find_uint64
+ *
+ * find_int64 for non-negative integers up to 2 ** 64 - 1.
+ */
+bool find_uint64(HWTJ_HANDLE_TYPE object, char *name,
+                 unsigned long long *value)
+{
+  JSON_VIEW_TYPE view;
+
+  return find_view(object, name, HWTJ_NUMBER_TYPE, NULL, &view) &&
+         view_to_uint64(&view, value);
+}
+
+/*
+ * Method: find_double
+ *
+ * find_int64 for any number, converted to the nearest double.
+ */
+bool find_double(HWTJ_HANDLE_TYPE object, char *name, double *value)
+{
+  JSON_VIEW_TYPE view;
+
+  return find_view(object, name, HWTJ_NUMBER_TYPE, NULL, &view) &&
+         view_to_double(&view, value);
+}
+
+/*
+ * Method: get_number_array
+ *
+ * Common conversion of the entries of a number array used by
+ * get_int64_array and get_double_array. Each entry is converted into
+ * a slot of size bytes of one malloc'd vector.
+ *
+ * returns: the entry count, -1 if the value is not an array or an
+ *          entry is not a number of the wanted range
+ */
+static int get_number_array(HWTJ_HANDLE_TYPE array, int size,
+                            bool (*convert)(JSON_VIEW_TYPE *view,
+                                            void *slot),
+                            void **values)
+{
+  JSON_PARSER_TYPE *parser = current_parser();
+  HWTJ_JTYPE_TYPE type;
+
+  *values = NULL;
+  if (parser == NULL ||
+      !parser->backend->getType(parser->state, array, &type) ||
+      type != HWTJ_ARRAY_TYPE)
+  {
+    return -1;
+  }
+
+  int count = parser->backend->getEntryCount(parser->state, array);
+  char *vector = (char *)malloc(count > 0 ? count * size : 1);
+  if (count < 0 || vector == NULL)
+  {
+    free(vector);
+    return -1;
+  }
+
+  for (int i = 0; i < count; i++)
+  {
+    HWTJ_HANDLE_TYPE entry;
+    JSON_VIEW_TYPE view;
+
+    if (!parser->backend->getArrayEntry(parser->state, array, i, &entry) ||
+        !parser->backend->getType(parser->state, entry, &type) ||
+        type != HWTJ_NUMBER_TYPE ||
+        !parser->backend->getValue(parser->state, entry, &view.text,
+                                   &view.len) ||
+        !convert(&view, vector + i * size))
+    {
+      printf("ERROR: Entry %d of the array is not a number in range.\n", i);
+      free(vector);
+      return -1;
+    }
+  }
+
+  *values = vector;
+
+  return count;
+}
+
+/*
+ * Method: convert_int64
+ */
+static bool convert_int64(JSON_VIEW_TYPE *view, void *slot)
+{
+  return view_to_int64(view, (long long *)slot);
+}
+
+/*
+ * Method: convert_double
+ */
+static bool convert_double(JSON_VIEW_TYPE *view, void *slot)
+{
+  return view_to_double(view, (double *)slot);
+}
+
+/*
+ * Method: get_int64_array
+ *
+ * Converts all entries of a number array, e.g. energy samples, into
+ * one contiguous vector in a single call.
+ *
+ * Input:  - A handle of type array.
+ *
+ * Output: the entry count, -1 on failure. values is set to a malloc'd
+ *         vector the caller frees, also when the array is empty.
+ */
+int get_int64_array(HWTJ_HANDLE_TYPE array, long long **values)
+{
+  return get_number_array(array, sizeof(long long), convert_int64,
+                          (void **)values);
+}
+
+/*
+ * Method: get_double_array
+ *
+ * get_int64_array for numbers converted to doubles.
+ */
+int get_double_array(HWTJ_HANDLE_TYPE array, double **values)
+{
+  return get_number_array(array, sizeof(double), convert_double,
+                          (void **)values);
+}
+
+/*
+ * Method: search_value
+ *
+ * Common search used by find_value and find_optional_value. When quiet
+ * is true, a missing name or unexpected type is not reported.
+ */
+void *search_value(HWTJ_HANDLE_TYPE object_to_search, char *name,
+                   HWTJ_JTYPE_TYPE expected_value_type, bool quiet)
+{
 
   /* Declare a handle to store a pointer to value. */
   void *value_addr = NULL;
@@ -209,38 +799,27 @@ void *find_value(HWTJ_HANDLE_TYPE object_to_search, char *name,
   /* Declare a variable to hold the value if a match is found. */
   HWTJ_HANDLE_TYPE value_handle = 0;
 
+  JSON_PARSER_TYPE *parser = current_parser();
+  if (parser == NULL)
+  {
+    return value_addr;
+  }
+
   /* Search the specified object for the specified name. */
-  hwtjsrch(&jpreturncode,
-           parser_instance,
-           HWTJ_SEARCHTYPE_OBJECT, /* limit the search scope */
-           (char *)&name,          /* search string address */
-           strlen(name),           /* search string length */
-           object_to_search,       /* handle of object to search */
-           0,                      /* starting point of the search */
-           &value_handle,          /* search result handle (output) */
-           &diag_area);
-
-  /* Check that the search found a result. */
-  if (jpreturncode == HWTJ_OK)
-  {
-    /* Declare a variable to hold the entry type returned by hwtjgjst. */
+  if (search_member(parser, object_to_search, name, &value_handle))
+  {
+    /* Declare a variable to hold the entry type. */
     HWTJ_JTYPE_TYPE entry_type;
 
     /* Get the object's type. */
-    hwtjgjst(&jpreturncode,
-             parser_instance,
-             value_handle, /* handle to the value whose type to check (input) */
-             &entry_type,  /* value type constant returned by hwtjgjst (output) */
-             &diag_area);
-
-    if (jpreturncode == HWTJ_OK)
+    if (parser->backend->getType(parser->state, value_handle, &entry_type))
     {
       /* Verify that the returned handle has the expected type. */
       if (entry_type == expected_value_type)
       {
         value_addr = do_get_value(&value_handle, entry_type);
       }
-      else
+      else if (!quiet)
       {
         printf("Error occurred while searching for %s\nThe name was found, "
                "but the value was not of the expected type.\n",
@@ -254,7 +833,7 @@ void *find_value(HWTJ_HANDLE_TYPE object_to_search, char *name,
       display_error("ERROR: Unable to retrieve JSON type.");
     }
   }
-  else
+  else if (!quiet)
   {
     printf("ERROR: Search failed for name \"%s\". "
            "Name was not found in the specified object.\n",
@@ -288,12 +867,6 @@ void *find_value(HWTJ_HANDLE_TYPE object_to_search, char *name,
  *  -1 if value not obtained,
  *   0 if bool is FALSE,
  *   1 if bool is TRUE
- *
- * Services Used:
- *    HWTJGJST: Gets the JSON type associated with a specified object or entry
- *              handle.
- *    HWTJSRCH: Finds a particular name string within the JSON text.
- *
  */
 int find_boolvalue(HWTJ_HANDLE_TYPE object_to_search, char *name)
 {
@@ -306,32 +879,21 @@ int find_boolvalue(HWTJ_HANDLE_TYPE object_to_search, char *name)
   /* Declare a variable to hold the value if a match is found. */
   HWTJ_HANDLE_TYPE value_handle = 0;
 
-  /* Search the specified object for the specified name. */
-  hwtjsrch(&jpreturncode,
-           parser_instance,
-           HWTJ_SEARCHTYPE_OBJECT, /* limit the search scope */
-           (char *)&name,          /* search string address */
-           strlen(name),           /* search string length */
-           object_to_search,       /* handle of object to search */
-           0,                      /* starting point of the search */
-           &value_handle,          /* search result handle (output) */
-           &diag_area);
+  JSON_PARSER_TYPE *parser = current_parser();
+  if (parser == NULL)
+  {
+    return boolResult;
+  }
 
-  /* Check that the search found a result. */
-  if (jpreturncode == HWTJ_OK)
+  /* Search the specified object for the specified name. */
+  if (search_member(parser, object_to_search, name, &value_handle))
   {
 
-    /* Declare a variable to hold the entry type returned by hwtjgjst. */
+    /* Declare a variable to hold the entry type. */
     HWTJ_JTYPE_TYPE entry_type;
 
     /* Get the object's type. */
-    hwtjgjst(&jpreturncode,
-             parser_instance,
-             value_handle, /* handle to the value whose type to check (input) */
-             &entry_type,  /* value type constant returned by hwtjgjst (output) */
-             &diag_area);
-
-    if (jpreturncode == HWTJ_OK)
+    if (parser->backend->getType(parser->state, value_handle, &entry_type))
     {
 
       /* Verify that the returned handle has the expected type. */
@@ -371,48 +933,18 @@ int find_boolvalue(HWTJ_HANDLE_TYPE object_to_search, char *name)
  *  1 if bool is TRUE
  *
  * Input: - A value handle.
- *
- * Services Used:
- *    HWTJGBOV: Retrieves the value of a boolean entry.
  */
 int do_get_boolvalue(HWTJ_HANDLE_TYPE value_handle)
 {
-
-  /* In the case of a boolean value type, the HWTJ_TRUE/HWTJ_FALSE
-   * value is converted to a bool type and the value_addr output
-   * parm is set to the address of the bool value.
-   *
-   * In the case of an object or array type, the value_addr output
-   * parm is set to the address of the object or array handle.
-   */
-
-  /* Declare a variable to store the value returned by hwtjgbov. */
-  HWTJ_BOOLEANVALUE_TYPE hwtj_boolean;
-  int boolResponse = -1; //not found
-
-  /* Retrieve the value and store it in a local variable. */
-  hwtjgbov(&jpreturncode,
-           parser_instance,
-           value_handle,  /* handle to the value (input) */
-           &hwtj_boolean, /* boolean value returned by hwtjgbov (output) */
-           &diag_area);
-
-  if (jpreturncode == HWTJ_OK)
+  JSON_PARSER_TYPE *parser = current_parser();
+  if (parser == NULL)
   {
-    if (hwtj_boolean == HWTJ_TRUE)
-    {
-      boolResponse = 1;
-    }
-    else if (hwtj_boolean == HWTJ_FALSE)
-    {
-      boolResponse = 0;
-    }
-    else
-    {
-      printf("bool value not recognized\n");
-    }
+    return -1;
   }
-  else
+
+  int boolResponse = parser->backend->getBoolean(parser->state, value_handle);
+
+  if (boolResponse == -1)
   {
     display_error("Unable to retrieve boolean value.");
   }
@@ -429,10 +961,6 @@ int do_get_boolvalue(HWTJ_HANDLE_TYPE value_handle)
  * Input: - A value handle.
  *        - A valid entry type as defined in the IBM-provided C interface
  *          definition file.
- *
- * Services Used:
- *    HWTJGVAL: Retrieves the value of string or number entry.
- *    HWTJGBOV: Retrieves the value of a boolean entry.
  */
 void *do_get_value(HWTJ_HANDLE_TYPE *value_handle,
                    HWTJ_JTYPE_TYPE entry_type)
@@ -449,12 +977,9 @@ void *do_get_value(HWTJ_HANDLE_TYPE *value_handle,
    * copied into a new buffer, and the value_addr output parm is
    * set to the address of this buffer.
    *
-   * In the case of a boolean value type, the HWTJ_TRUE/HWTJ_FALSE
-   * value is converted to a bool type and the value_addr output
-   * parm is set to the address of the bool value.
-   *
    * In the case of an object or array type, the value_addr output
-   * parm is set to the address of the object or array handle.
+   * parm is set to the address of a copy of the object or array
+   * handle, the caller frees it like a string.
    */
 
   /* Determine the value type. */
@@ -462,83 +987,44 @@ void *do_get_value(HWTJ_HANDLE_TYPE *value_handle,
       (entry_type == HWTJ_NUMBER_TYPE))
   {
 
-    /* Declare a variable to store the length returned by hwtjgval. */
+    /* Declare variables to store the address and length of the text. */
+    const char *string_value_addr = NULL;
     int value_length = 0;
-    /* Declare a variable to store the address returned by hwtjgval. */
-    int string_value_addr = 0;
-
-    /* Issue hwtjgval to get the address and length of the string. */
-    hwtjgval(&jpreturncode,
-             parser_instance,
-             *value_handle,      /* handle to a value (input) */
-             &string_value_addr, /* value address (output) */
-             &value_length,      /* returned value length (output) */
-             &diag_area);
-
-    if (jpreturncode == HWTJ_OK)
+
+    JSON_PARSER_TYPE *parser = current_parser();
+
+    if (parser != NULL &&
+        parser->backend->getValue(parser->state, *value_handle,
+                                  &string_value_addr, &value_length))
     {
       /* Allocate memory to store a copy of the string + null terminator. */
       value_addr = malloc(value_length + 1);
 
       /* Copy the JSON source text to the local variable. */
-      strncpy((char *)value_addr, (char *)string_value_addr, value_length);
+      memcpy(value_addr, string_value_addr, value_length);
 
       /* Append the null-terminator. */
       ((char *)value_addr)[value_length] = '\0';
-
-      if (entry_type == HWTJ_NUMBER_TYPE)
-      {
-
-        int num_value = 0;
-        int *num_value_ptr = &num_value;
-        HWTJ_VALDESCRIPTOR_TYPE value_desc = 0;
-
-        /* Issue HWTJGNUV to get the binary representation
-                * of the number value.
-                */
-        hwtjgnuv(&jpreturncode,
-                 parser_instance,
-                 *value_handle,
-                 &num_value_ptr,    /* pointer to output buffer */
-                 sizeof(num_value), /* size of output buffer */
-                 &value_desc,       /* indicates 2's comp or BFP */
-                 &diag_area);
-
-        if (jpreturncode == HWTJ_OK)
-        {
-
-          /* Verify that the converted value is an integer type.
-                     This check can be skipped if you are confident that
-                     the numeric data will only be specified as integer
-                     data.
-                    */
-          if (value_desc == HWTJ_INTEGER_VALUE && num_value >= 10)
-          {
-          }
-        }
-        else
-        {
-          display_error("An error occurred in Do_Get_Value. "
-                        "HWTJGNUV failed.");
-        }
-      }
     }
     else
     {
-      printf("logic error, use do_get_boolvalue() for booleans\n");
+      display_error("Unable to retrieve string or number value.");
     }
   }
   else if (entry_type == HWTJ_BOOLEAN_TYPE)
   {
 
-    display_error("Unable to retrieve boolean value.");
+    printf("logic error, use do_get_boolvalue() for booleans\n");
   }
   else if ((entry_type == HWTJ_ARRAY_TYPE) ||
            (entry_type == HWTJ_OBJECT_TYPE))
   {
 
-    /* Store the address of the handle in our return variable. */
-    value_addr = value_handle;
+    value_addr = malloc(sizeof(HWTJ_HANDLE_TYPE));
+    if (value_addr != NULL)
+    {
+      *(HWTJ_HANDLE_TYPE *)value_addr = *value_handle;
+    }
   }
 
   return value_addr;
@@ -562,7 +1048,17 @@ HWTJ_HANDLE_TYPE find_array(HWTJ_HANDLE_TYPE object, char *search_string)
 {
   HWTJ_HANDLE_TYPE *array_handle_addr =
       (HWTJ_HANDLE_TYPE *)find_value(object, search_string, HWTJ_ARRAY_TYPE);
-  return *array_handle_addr;
+
+  /* zero when not found, callers compare the handle against NULL */
+  if (array_handle_addr == NULL)
+  {
+    return 0;
+  }
+
+  HWTJ_HANDLE_TYPE array_handle = *array_handle_addr;
+  free(array_handle_addr);
+
+  return array_handle;
 }
 
 /*
@@ -582,15 +1078,11 @@ HWTJ_HANDLE_TYPE getArrayEntry(HWTJ_HANDLE_TYPE arrayhandle, int arrayindex)
 {
 
   HWTJ_HANDLE_TYPE arrayentryhandle;
-  hwtjgaen(
-      &jpreturncode,
-      parser_instance,
-      arrayhandle,
-      arrayindex,
-      &arrayentryhandle,
-      &diag_area);
+  JSON_PARSER_TYPE *parser = current_parser();
 
-  if (jpreturncode == HWTJ_OK)
+  if (parser != NULL &&
+      parser->backend->getArrayEntry(parser->state, arrayhandle, arrayindex,
+                                     &arrayentryhandle))
   {
     return arrayentryhandle;
   }
@@ -613,16 +1105,12 @@ HWTJ_HANDLE_TYPE getArrayEntry(HWTJ_HANDLE_TYPE arrayhandle, int arrayindex)
 int getnumberOfEntries(HWTJ_HANDLE_TYPE starthandle)
 {
 
-  /* starting point */
-  int numofentries;
-
-  hwtjgnue(&jpreturncode,
-           parser_instance,
-           starthandle,
-           &numofentries,
-           &diag_area);
+  JSON_PARSER_TYPE *parser = current_parser();
+  int numofentries = parser != NULL ? parser->backend->getEntryCount(
+                                          parser->state, starthandle)
+                                    : -1;
 
-  if (jpreturncode == HWTJ_OK)
+  if (numofentries >= 0)
   {
     return numofentries;
   }
@@ -636,28 +1124,9 @@ int getnumberOfEntries(HWTJ_HANDLE_TYPE starthandle)
 /*
  * Method: do_cleanup
  *
- * Performs cleanup by freeing memory used by the parser and invalidating the
- * parser handle.
- *
- * Services Used:
- *
- *    HWTJTERM: Terminates a parser instance and frees the storage allocated
- *              by the parse services.
- *
- *    USAGE:    The third parameter to hwtjterm is used to specify the
- *              behavior of terminate if the parser is determined to be stuck
- *              in an "in-use" state. IBM recommends using the HWTJ_NOFORCE
- *              option in most cases. Because our sample is not multi-threaded,
- *              the risk of the parser getting stuck in an "in-use" state is
- *              low. Therefore, we provide a value of HWTJ_NOFORCE for the
- *              force option.
- *
- *    NOTE: Consider enhancing this sample to postpone the call to the
- *    terminate service when a prior service call resulted in a return code of
- *    HWTJ_UNEXPECTED_ERROR. This will allow appropriate action to be taken to
- *    dump the work area storage for subsequent analysis by the IBM support
- *    center. Once the dump has been taken, terminate can be issued to free the
- *    storage from the user's address space.
+ * Performs cleanup by freeing memory used by the parser contexts of the
+ * calling thread and invalidating their parser handles. Contexts of other
+ * threads are freed when those threads end.
  */
 bool do_cleanup()
 {
@@ -665,49 +1134,19 @@ bool do_cleanup()
   /* Declare a variable to hold the return value. */
   bool success = false;
 
-  /*
-   * On the first attempt, try to terminate with the force option disabled.
-   * This is the IBM recommended value for the force option. If the parser is
-   * in an inuse state, further cleanup processing is done in the following
-   * EVALUATE statement. A parser can be in an INUSE state if a prior service
-   * call encountered an unexpected error that caused it to exit abnormally, or
-   * if the parser-handle is used in a multi-threaded application.
-   */
-  if (jpreturncode != HWTJ_PARSERHANDLE_INUSE)
+  JSON_THREAD_PARSERS_TYPE *thread = threadParsers();
+  if (jsonBackend == NULL || thread == NULL)
   {
-    /* Perform cleanup. */
-    hwtjterm(&jpreturncode, parser_instance, HWTJ_NOFORCE, &diag_area);
+    return success;
   }
 
-  /* Determine whether further cleanup processing is necessary. */
-  switch (jpreturncode)
+  if (termThreadParsers(thread))
   {
-  case HWTJ_OK:
     printf("SUCCESS: Parser work area freed.\n");
     success = true;
-    break;
-  case HWTJ_PARSERHANDLE_INUSE:
-    display_error("Unable to perform cleanup.\n "
-                  "Retrying cleanup with HWTJ_FORCE option enabled.");
-
-    /* Attempt to force cleanup. Use with caution as recommended in the
-       * parser documentation
-       */
-    hwtjterm(&jpreturncode, parser_instance, HWTJ_FORCE, &diag_area);
-
-    /* Check if cleanup was successful. */
-    if (jpreturncode == HWTJ_OK)
-    {
-      printf("SUCCESS: Parser work area freed using force option.\n");
-      success = true;
-    }
-    else
-    {
-      display_error("Unable to perform cleanup with HWTJ_FORCE option "
-                    "enabled.\nCould not free parser work area.");
-    }
-    break;
-  default:
+  }
+  else
+  {
     display_error("Unable to perform cleanup.\n "
                   "Could not free parser work area.");
   }
@@ -722,8 +1161,14 @@ bool do_cleanup()
  */
 void display_error(char *msg)
 {
-  printf("ERROR: %s\n", msg);
-  printf("Return Code: %d\n", jpreturncode);
-  printf("Reason Code: %d\n", diag_area.ReasonCode);
-  printf("Reason Text: %s\n", diag_area.ReasonDesc);
+  JSON_PARSER_TYPE *parser = current_parser();
+
+  if (parser != NULL)
+  {
+    parser->backend->displayError(parser->state, msg);
+  }
+  else
+  {
+    printf("ERROR: %s\n", msg);
+  }
 }
@@ -0,0 +1,1105 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    MODULE NAME= HWIJSIDX                                            *
+ *                                                                     *
+ *  Sample C code that implements the JSON backend used by hwijprs    *
+ *  with a structural index. A first pass classifies the text 64      *
+ *  bytes at a time (SSE2 or AVX2 on x86, one byte at a time         *
+ *  elsewhere) and records the offset of every bracket, colon,        *
+ *  comma, quote and scalar outside of strings. A second pass over    *
+ *  those offsets checks the grammar and pairs the brackets, so       *
+ *  lookups skip whole objects and arrays without reading them.       *
+ *                                                                     *
+ *************************END OF SPECIFICATIONS************************/
+#pragma filetag("IBM-1047")     /* compile in EBCDIC */
+#pragma csect(code, "HWIJSIDX") /* name of csect */
+#pragma longName
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include <hwtjic.h> /* JSON interface declaration file  */
+#include "hwijbknd.h"
+#include "hwijsidx.h"
+
+#if defined(__GNUC__) && defined(__SSE2__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define SIDX_X86
+#include <immintrin.h>
+#endif
+
+static SIDX_CLASSIFY_TYPE chooseClassifier();
+
+/* chosen once when the program starts, shared by all parsers */
+static const char *classifierName = "scalar";
+static SIDX_CLASSIFY_TYPE classify = chooseClassifier();
+
+#ifndef SIDX_X86
+/*
+ * Method: classifyScalar
+ *
+ * Classify a block one byte at a time, where no vector classifier
+ * is built.
+ */
+static void classifyScalar(const char *block, SIDX_MASKS_TYPE *masks)
+{
+  memset(masks, 0, sizeof(SIDX_MASKS_TYPE));
+
+  for (int i = 0; i < SIDX_BLOCK; i++)
+  {
+    unsigned long long bit = 1ULL << i;
+
+    switch (block[i])
+    {
+    case '"':
+      masks->quote |= bit;
+      break;
+    case '\\':
+      masks->backslash |= bit;
+      break;
+    case '{':
+    case '}':
+    case '[':
+    case ']':
+    case ':':
+    case ',':
+      masks->structural |= bit;
+      break;
+    case ' ':
+    case '\t':
+    case '\n':
+    case '\r':
+      masks->whitespace |= bit;
+      break;
+    }
+  }
+}
+#endif
+
+#ifdef SIDX_X86
+/*
+ * Method: classifySSE2
+ *
+ * Classify a block 16 bytes at a time. '[' and '{' (and ']' and
+ * '}') only differ in bit 0x20, so one compare finds both.
+ */
+static void classifySSE2(const char *block, SIDX_MASKS_TYPE *masks)
+{
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i caseBit = _mm_set1_epi8(0x20);
+  const __m128i open = _mm_set1_epi8('{');
+  const __m128i close = _mm_set1_epi8('}');
+  const __m128i colon = _mm_set1_epi8(':');
+  const __m128i comma = _mm_set1_epi8(',');
+  const __m128i space = _mm_set1_epi8(' ');
+  const __m128i tab = _mm_set1_epi8('\t');
+  const __m128i newline = _mm_set1_epi8('\n');
+  const __m128i cr = _mm_set1_epi8('\r');
+
+  memset(masks, 0, sizeof(SIDX_MASKS_TYPE));
+
+  for (int i = 0; i < SIDX_BLOCK; i += 16)
+  {
+    __m128i chunk = _mm_loadu_si128((const __m128i *)(block + i));
+    __m128i folded = _mm_or_si128(chunk, caseBit);
+
+    __m128i structural = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(folded, open),
+                     _mm_cmpeq_epi8(folded, close)),
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, colon),
+                     _mm_cmpeq_epi8(chunk, comma)));
+    __m128i whitespace = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, space),
+                     _mm_cmpeq_epi8(chunk, tab)),
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, newline),
+                     _mm_cmpeq_epi8(chunk, cr)));
+
+    masks->quote |= (unsigned long long)(unsigned int)_mm_movemask_epi8(
+                        _mm_cmpeq_epi8(chunk, quote))
+                    << i;
+    masks->backslash |= (unsigned long long)(unsigned int)_mm_movemask_epi8(
+                            _mm_cmpeq_epi8(chunk, backslash))
+                        << i;
+    masks->structural |=
+        (unsigned long long)(unsigned int)_mm_movemask_epi8(structural) << i;
+    masks->whitespace |=
+        (unsigned long long)(unsigned int)_mm_movemask_epi8(whitespace) << i;
+  }
+}
+
+/*
+ * Method: classifyAVX2
+ *
+ * Classify a block 32 bytes at a time, used when the processor
+ * supports AVX2.
+ */
+__attribute__((target("avx2"))) static void
+classifyAVX2(const char *block, SIDX_MASKS_TYPE *masks)
+{
+  const __m256i quote = _mm256_set1_epi8('"');
+  const __m256i backslash = _mm256_set1_epi8('\\');
+  const __m256i caseBit = _mm256_set1_epi8(0x20);
+  const __m256i open = _mm256_set1_epi8('{');
+  const __m256i close = _mm256_set1_epi8('}');
+  const __m256i colon = _mm256_set1_epi8(':');
+  const __m256i comma = _mm256_set1_epi8(',');
+  const __m256i space = _mm256_set1_epi8(' ');
+  const __m256i tab = _mm256_set1_epi8('\t');
+  const __m256i newline = _mm256_set1_epi8('\n');
+  const __m256i cr = _mm256_set1_epi8('\r');
+
+  memset(masks, 0, sizeof(SIDX_MASKS_TYPE));
+
+  for (int i = 0; i < SIDX_BLOCK; i += 32)
+  {
+    __m256i chunk = _mm256_loadu_si256((const __m256i *)(block + i));
+    __m256i folded = _mm256_or_si256(chunk, caseBit);
+
+    __m256i structural = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(folded, open),
+                        _mm256_cmpeq_epi8(folded, close)),
+        _mm256_or_si256(_mm256_cmpeq_epi8(chunk, colon),
+                        _mm256_cmpeq_epi8(chunk, comma)));
+    __m256i whitespace = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(chunk, space),
+                        _mm256_cmpeq_epi8(chunk, tab)),
+        _mm256_or_si256(_mm256_cmpeq_epi8(chunk, newline),
+                        _mm256_cmpeq_epi8(chunk, cr)));
+
+    masks->quote |= (unsigned long long)(unsigned int)_mm256_movemask_epi8(
+                        _mm256_cmpeq_epi8(chunk, quote))
+                    << i;
+    masks->backslash |=
+        (unsigned long long)(unsigned int)_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(chunk, backslash))
+        << i;
+    masks->structural |=
+        (unsigned long long)(unsigned int)_mm256_movemask_epi8(structural)
+        << i;
+    masks->whitespace |=
+        (unsigned long long)(unsigned int)_mm256_movemask_epi8(whitespace)
+        << i;
+  }
+}
+#endif
+
+/*
+ * Method: chooseClassifier
+ *
+ * returns: the widest classifier the processor supports
+ */
+static SIDX_CLASSIFY_TYPE chooseClassifier()
+{
+#ifdef SIDX_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+  {
+    classifierName = "AVX2";
+    return classifyAVX2;
+  }
+
+  classifierName = "SSE2";
+  return classifySSE2;
+#else
+  return classifyScalar;
+#endif
+}
+
+/*
+ * Method: structuralClassifier
+ *
+ * returns: name of the classifier in use, for the benchmark report
+ */
+const char *structuralClassifier()
+{
+  return classifierName;
+}
+
+/*
+ * Method: lowestBit
+ *
+ * returns: index of the lowest bit set, bits must not be zero
+ */
+static inline int lowestBit(unsigned long long bits)
+{
+#if defined(__GNUC__)
+  return __builtin_ctzll(bits);
+#else
+  int index = 0;
+  while ((bits & 1) == 0)
+  {
+    bits >>= 1;
+    index++;
+  }
+  return index;
+#endif
+}
+
+/*
+ * Method: prefixXor
+ *
+ * Bit i of the result is the xor of bits 0 to i, so between an
+ * opening and a closing quote all bits are set.
+ */
+static inline unsigned long long prefixXor(unsigned long long bits)
+{
+  bits ^= bits << 1;
+  bits ^= bits << 2;
+  bits ^= bits << 4;
+  bits ^= bits << 8;
+  bits ^= bits << 16;
+  bits ^= bits << 32;
+  return bits;
+}
+
+/*
+ * Method: escapedBits
+ *
+ * Mark the characters following a backslash that is not itself
+ * escaped. Backslashes are rare, so they are walked one by one.
+ * carry is set when the last byte of the block escapes the first
+ * byte of the next one.
+ */
+static inline unsigned long long escapedBits(unsigned long long backslash,
+                                             unsigned long long *carry)
+{
+  unsigned long long escaped = *carry;
+
+  *carry = 0;
+  while (backslash != 0)
+  {
+    unsigned long long bit = backslash & (0 - backslash);
+    backslash ^= bit;
+
+    if ((escaped & bit) != 0)
+    {
+      continue;
+    }
+    if (bit == (1ULL << 63))
+    {
+      *carry = 1;
+    }
+    else
+    {
+      escaped |= bit << 1;
+    }
+  }
+
+  return escaped;
+}
+
+/*
+ * Method: parseFailed
+ *
+ * Record why and where the parse failed.
+ */
+static bool parseFailed(SIDX_PARSER_TYPE *parser, const char *reason, int pos)
+{
+  parser->error = reason;
+  parser->errorPos = pos;
+  parser->tokenCount = 0;
+  return false;
+}
+
+/*
+ * Method: growTokens
+ *
+ * Make room for at least one more block of tokens.
+ */
+static bool growTokens(SIDX_PARSER_TYPE *parser)
+{
+  int newCapacity =
+      parser->tokenCapacity > 0 ? parser->tokenCapacity * 2 : 4096;
+
+  int *newPos = (int *)realloc(parser->tokenPos, newCapacity * sizeof(int));
+  if (newPos == NULL)
+  {
+    return false;
+  }
+  parser->tokenPos = newPos;
+
+  int *newMatch =
+      (int *)realloc(parser->tokenMatch, newCapacity * sizeof(int));
+  if (newMatch == NULL)
+  {
+    return false;
+  }
+  parser->tokenMatch = newMatch;
+
+  parser->tokenCapacity = newCapacity;
+  return true;
+}
+
+/*
+ * Method: indexStructurals
+ *
+ * First pass: record the offset of every structural character and
+ * quote outside of strings, and of the first character of every
+ * number, true, false and null.
+ */
+static bool indexStructurals(SIDX_PARSER_TYPE *parser)
+{
+  unsigned long long escapeCarry = 0;
+  unsigned long long inStringCarry = 0;
+  unsigned long long scalarCarry = 0;
+  char padded[SIDX_BLOCK];
+  SIDX_MASKS_TYPE masks;
+
+  parser->tokenCount = 0;
+  parser->escapes = false;
+
+  for (int base = 0; base < parser->len; base += SIDX_BLOCK)
+  {
+    const char *block = parser->text + base;
+
+    /* the last block is padded with white space */
+    if (parser->len - base < SIDX_BLOCK)
+    {
+      memset(padded, ' ', SIDX_BLOCK);
+      memcpy(padded, block, parser->len - base);
+      block = padded;
+    }
+
+    classify(block, &masks);
+    if (masks.backslash != 0)
+    {
+      parser->escapes = true;
+    }
+
+    unsigned long long escaped = escapedBits(masks.backslash, &escapeCarry);
+    unsigned long long quote = masks.quote & ~escaped;
+    unsigned long long inString = prefixXor(quote) ^ inStringCarry;
+    inStringCarry = (inString >> 63) != 0 ? ~0ULL : 0;
+
+    unsigned long long scalar =
+        ~(masks.structural | masks.whitespace | masks.quote) & ~inString;
+    unsigned long long scalarStart = scalar & ~((scalar << 1) | scalarCarry);
+    scalarCarry = scalar >> 63;
+
+    unsigned long long tokens =
+        (masks.structural & ~inString) | quote | scalarStart;
+
+    if (parser->tokenCount + SIDX_BLOCK > parser->tokenCapacity &&
+        !growTokens(parser))
+    {
+      return parseFailed(parser, "out of storage", base);
+    }
+
+    /* count is a local, a store to tokenPos could alias the member */
+    int count = parser->tokenCount;
+    while (tokens != 0)
+    {
+      parser->tokenPos[count++] = base + lowestBit(tokens);
+      tokens &= tokens - 1;
+    }
+    parser->tokenCount = count;
+  }
+
+  if (inStringCarry != 0)
+  {
+    return parseFailed(parser, "unterminated string", parser->len);
+  }
+
+  return true;
+}
+
+/*
+ * Method: isStructural
+ */
+static inline bool isStructural(char c)
+{
+  return c == '{' || c == '}' || c == '[' || c == ']' || c == ':' ||
+         c == ',';
+}
+
+/*
+ * Method: scalarLength
+ *
+ * returns: length of the number or literal starting at pos
+ */
+static int scalarLength(SIDX_PARSER_TYPE *parser, int pos)
+{
+  int end = pos;
+
+  while (end < parser->len && !isStructural(parser->text[end]) &&
+         parser->text[end] != '"' && parser->text[end] != ' ' &&
+         parser->text[end] != '\t' && parser->text[end] != '\n' &&
+         parser->text[end] != '\r')
+  {
+    end++;
+  }
+
+  return end - pos;
+}
+
+/*
+ * Method: validScalar
+ *
+ * Check a number (-?int(.digits)?([eE][+-]?digits)?) or literal.
+ */
+static bool validScalar(SIDX_PARSER_TYPE *parser, int pos)
+{
+  const char *text = parser->text + pos;
+  int len = scalarLength(parser, pos);
+  int i = 0;
+  int digits;
+
+  if ((len == 4 && memcmp(text, "true", 4) == 0) ||
+      (len == 5 && memcmp(text, "false", 5) == 0) ||
+      (len == 4 && memcmp(text, "null", 4) == 0))
+  {
+    return true;
+  }
+
+  if (i < len && text[i] == '-')
+  {
+    i++;
+  }
+  digits = i;
+  while (i < len && isdigit((unsigned char)text[i]))
+  {
+    i++;
+  }
+  if (i == digits || (text[digits] == '0' && i - digits > 1))
+  {
+    return false;
+  }
+
+  if (i < len && text[i] == '.')
+  {
+    digits = ++i;
+    while (i < len && isdigit((unsigned char)text[i]))
+    {
+      i++;
+    }
+    if (i == digits)
+    {
+      return false;
+    }
+  }
+
+  if (i < len && (text[i] == 'e' || text[i] == 'E'))
+  {
+    i++;
+    if (i < len && (text[i] == '+' || text[i] == '-'))
+    {
+      i++;
+    }
+    digits = i;
+    while (i < len && isdigit((unsigned char)text[i]))
+    {
+      i++;
+    }
+    if (i == digits)
+    {
+      return false;
+    }
+  }
+
+  return i == len;
+}
+
+/*
+ * Method: validString
+ *
+ * Check the escapes of the string starting at token t, only called
+ * when the text holds a backslash.
+ */
+static bool validString(SIDX_PARSER_TYPE *parser, int t)
+{
+  int end = parser->tokenPos[t + 1];
+
+  for (int i = parser->tokenPos[t] + 1; i < end; i++)
+  {
+    if (parser->text[i] != '\\')
+    {
+      continue;
+    }
+
+    i++;
+    if (strchr("\"\\/bfnrtu", parser->text[i]) == NULL)
+    {
+      return false;
+    }
+    if (parser->text[i] == 'u')
+    {
+      for (int j = 1; j <= 4; j++)
+      {
+        if (i + j >= end || !isxdigit((unsigned char)parser->text[i + j]))
+        {
+          return false;
+        }
+      }
+      i += 4;
+    }
+  }
+
+  return true;
+}
+
+/*
+ * Method: linkStructurals
+ *
+ * Second pass: check the order of the tokens against the JSON
+ * grammar and pair every opening bracket with its closing one.
+ */
+static bool linkStructurals(SIDX_PARSER_TYPE *parser)
+{
+  /* the members are read into locals, stores to tokenMatch could
+     alias them otherwise */
+  const char *text = parser->text;
+  const int *tokenPos = parser->tokenPos;
+  int *tokenMatch = parser->tokenMatch;
+  int tokenCount = parser->tokenCount;
+  int *stack = parser->stack;
+  int depth = 0;
+  int expect = SIDX_EXPECT_VALUE;
+
+  for (int t = 0; t < tokenCount; t++)
+  {
+    int pos = tokenPos[t];
+    char c = text[pos];
+    bool closed = false;
+    bool ended = false;
+
+    switch (expect)
+    {
+    case SIDX_EXPECT_VALUE:
+    case SIDX_EXPECT_VALUE_OR_CLOSE:
+      if (c == '{' || c == '[')
+      {
+        if (depth == SIDX_MAX_DEPTH)
+        {
+          return parseFailed(parser, "nesting too deep", pos);
+        }
+        stack[depth++] = t;
+        expect = c == '{' ? SIDX_EXPECT_KEY_OR_CLOSE
+                          : SIDX_EXPECT_VALUE_OR_CLOSE;
+      }
+      else if (c == ']' && expect == SIDX_EXPECT_VALUE_OR_CLOSE)
+      {
+        closed = true;
+      }
+      else if (c == '"')
+      {
+        if (parser->escapes && !validString(parser, t))
+        {
+          return parseFailed(parser, "invalid escape sequence", pos);
+        }
+        t++; /* the closing quote is always the next token */
+        ended = true;
+      }
+      else if (isStructural(c) || !validScalar(parser, pos))
+      {
+        return parseFailed(parser, "invalid value", pos);
+      }
+      else
+      {
+        ended = true;
+      }
+      break;
+    case SIDX_EXPECT_KEY:
+    case SIDX_EXPECT_KEY_OR_CLOSE:
+      if (c == '"')
+      {
+        if (parser->escapes && !validString(parser, t))
+        {
+          return parseFailed(parser, "invalid escape sequence", pos);
+        }
+        t++;
+        expect = SIDX_EXPECT_COLON;
+      }
+      else if (c == '}' && expect == SIDX_EXPECT_KEY_OR_CLOSE)
+      {
+        closed = true;
+      }
+      else
+      {
+        return parseFailed(parser, "member name expected", pos);
+      }
+      break;
+    case SIDX_EXPECT_COLON:
+      if (c != ':')
+      {
+        return parseFailed(parser, "':' expected", pos);
+      }
+      expect = SIDX_EXPECT_VALUE;
+      break;
+    case SIDX_EXPECT_COMMA_OR_CLOSE:
+    {
+      bool inObject = text[tokenPos[stack[depth - 1]]] == '{';
+      if (c == ',')
+      {
+        expect = inObject ? SIDX_EXPECT_KEY : SIDX_EXPECT_VALUE;
+      }
+      else if (c == (inObject ? '}' : ']'))
+      {
+        closed = true;
+      }
+      else
+      {
+        return parseFailed(parser, inObject ? "',' or '}' expected"
+                                            : "',' or ']' expected",
+                           pos);
+      }
+      break;
+    }
+    default:
+      return parseFailed(parser, "text follows the JSON value", pos);
+    }
+
+    if (closed)
+    {
+      int open = stack[--depth];
+      tokenMatch[open] = t;
+      tokenMatch[t] = open;
+      ended = true;
+    }
+    if (ended)
+    {
+      expect = depth > 0 ? SIDX_EXPECT_COMMA_OR_CLOSE : SIDX_EXPECT_END;
+    }
+  }
+
+  if (expect != SIDX_EXPECT_END)
+  {
+    return parseFailed(parser, "unexpected end of text", parser->len);
+  }
+
+  return true;
+}
+
+/*
+ * Method: skipValue
+ *
+ * returns: the token following the value starting at token t
+ */
+static inline int skipValue(SIDX_PARSER_TYPE *parser, int t)
+{
+  char c = parser->text[parser->tokenPos[t]];
+
+  if (c == '{' || c == '[')
+  {
+    return parser->tokenMatch[t] + 1;
+  }
+  if (c == '"')
+  {
+    return t + 2;
+  }
+  return t + 1;
+}
+
+/*
+ * Method: validHandle
+ *
+ * returns: true if the handle names a token of the last parse
+ */
+static bool validHandle(SIDX_PARSER_TYPE *parser, HWTJ_HANDLE_TYPE handle)
+{
+  return (int)handle >= 0 && (int)handle < parser->tokenCount;
+}
+
+/*
+ * Method: stringText
+ *
+ * The text of the string starting at token t, decoded into scratch
+ * when it holds escapes.
+ */
+static bool stringText(SIDX_PARSER_TYPE *parser, int t, const char **text,
+                       int *textLen)
+{
+  const char *start = parser->text + parser->tokenPos[t] + 1;
+  int len = parser->tokenPos[t + 1] - parser->tokenPos[t] - 1;
+
+  if (memchr(start, '\\', len) == NULL)
+  {
+    *text = start;
+    *textLen = len;
+    return true;
+  }
+
+  if (len + 1 > parser->scratchCapacity)
+  {
+    char *newScratch = (char *)realloc(parser->scratch, len + 1);
+    if (newScratch == NULL)
+    {
+      return false;
+    }
+    parser->scratch = newScratch;
+    parser->scratchCapacity = len + 1;
+  }
+
+  *textLen = unescapeJSON(start, len, parser->scratch);
+  *text = parser->scratch;
+  return true;
+}
+
+/*
+ * Method: sidxInit
+ *
+ * A parser owns its token arrays and buffers, they are kept from
+ * one parse to the next.
+ */
+static bool sidxInit(void **state)
+{
+  SIDX_PARSER_TYPE *parser =
+      (SIDX_PARSER_TYPE *)calloc(1, sizeof(SIDX_PARSER_TYPE));
+
+  *state = parser;
+  if (parser == NULL)
+  {
+    return false;
+  }
+
+  parser->entryArray = -1;
+  parser->memberObject = -1;
+  return true;
+}
+
+static bool sidxParse(void *state, const char *text, int textLen)
+{
+  SIDX_PARSER_TYPE *parser = (SIDX_PARSER_TYPE *)state;
+
+  parser->text = text;
+  parser->len = textLen;
+  parser->entryArray = -1;
+  parser->memberObject = -1;
+  parser->error = NULL;
+
+  return indexStructurals(parser) && linkStructurals(parser);
+}
+
+/*
+ * Method: sidxSearch
+ *
+ * Walk the members of the object, values are skipped by token
+ * without looking at their text.
+ */
+static bool sidxSearch(void *state, HWTJ_HANDLE_TYPE object, const char *name,
+                       HWTJ_HANDLE_TYPE *value)
+{
+  SIDX_PARSER_TYPE *parser = (SIDX_PARSER_TYPE *)state;
+
+  if (!validHandle(parser, object) ||
+      parser->text[parser->tokenPos[object]] != '{')
+  {
+    return false;
+  }
+
+  int nameLen = strlen(name);
+  int t = object + 1;
+
+  while (parser->text[parser->tokenPos[t]] == '"')
+  {
+    const char *key;
+    int keyLen;
+
+    if (!stringText(parser, t, &key, &keyLen))
+    {
+      return false;
+    }
+
+    /* key, closing quote, colon, value */
+    if (keyLen == nameLen && memcmp(key, name, nameLen) == 0)
+    {
+      *value = t + 3;
+      return true;
+    }
+
+    t = skipValue(parser, t + 3);
+    if (parser->text[parser->tokenPos[t]] != ',')
+    {
+      break;
+    }
+    t++;
+  }
+
+  return false;
+}
+
+static bool sidxGetType(void *state, HWTJ_HANDLE_TYPE value,
+                        HWTJ_JTYPE_TYPE *type)
+{
+  SIDX_PARSER_TYPE *parser = (SIDX_PARSER_TYPE *)state;
+
+  if (!validHandle(parser, value))
+  {
+    return false;
+  }
+
+  switch (parser->text[parser->tokenPos[value]])
+  {
+  case '{':
+    *type = HWTJ_OBJECT_TYPE;
+    break;
+  case '[':
+    *type = HWTJ_ARRAY_TYPE;
+    break;
+  case '"':
+    *type = HWTJ_STRING_TYPE;
+    break;
+  case 't':
+  case 'f':
+    *type = HWTJ_BOOLEAN_TYPE;
+    break;
+  case 'n':
+    *type = HWTJ_NULL_TYPE;
+    break;
+  default:
+    *type = HWTJ_NUMBER_TYPE;
+    break;
+  }
+
+  return true;
+}
+
+static bool sidxGetValue(void *state, HWTJ_HANDLE_TYPE value,
+                         const char **text, int *textLen)
+{
+  SIDX_PARSER_TYPE *parser = (SIDX_PARSER_TYPE *)state;
+
+  HWTJ_JTYPE_TYPE type;
+
+  if (!sidxGetType(parser, value, &type))
+  {
+    return false;
+  }
+
+  if (type == HWTJ_STRING_TYPE)
+  {
+    return stringText(parser, value, text, textLen);
+  }
+  if (type == HWTJ_NUMBER_TYPE)
+  {
+    *text = parser->text + parser->tokenPos[value];
+    *textLen = scalarLength(parser, parser->tokenPos[value]);
+    return true;
+  }
+
+  return false;
+}
+
+static int sidxGetBoolean(void *state, HWTJ_HANDLE_TYPE value)
+{
+  SIDX_PARSER_TYPE *parser = (SIDX_PARSER_TYPE *)state;
+
+  if (!validHandle(parser, value))
+  {
+    return -1;
+  }
+
+  switch (parser->text[parser->tokenPos[value]])
+  {
+  case 't':
+    return 1;
+  case 'f':
+    return 0;
+  default:
+    return -1;
+  }
+}
+
+/*
+ * Method: indexEntries
+ *
+ * Record the entry tokens of an array, so walking all entries in
+ * order is linear.
+ */
+static bool indexEntries(SIDX_PARSER_TYPE *parser, int array)
+{
+  if (parser->entryArray == array)
+  {
+    return true;
+  }
+
+  parser->entryCount = 0;
+
+  int t = array + 1;
+  while (parser->text[parser->tokenPos[t]] != ']')
+  {
+    if (parser->entryCount == parser->entryCapacity)
+    {
+      int newCapacity =
+          parser->entryCapacity > 0 ? parser->entryCapacity * 2 : 256;
+      int *newEntries = (int *)realloc(parser->entryTokens,
+                                       newCapacity * sizeof(int));
+      if (newEntries == NULL)
+      {
+        return false;
+      }
+      parser->entryTokens = newEntries;
+      parser->entryCapacity = newCapacity;
+    }
+
+    parser->entryTokens[parser->entryCount++] = t;
+    t = skipValue(parser, t);
+    if (parser->text[parser->tokenPos[t]] == ',')
+    {
+      t++;
+    }
+  }
+
+  parser->entryArray = array;
+  return true;
+}
+
+static bool sidxGetArrayEntry(void *state, HWTJ_HANDLE_TYPE array, int index,
+                              HWTJ_HANDLE_TYPE *entry)
+{
+  SIDX_PARSER_TYPE *parser = (SIDX_PARSER_TYPE *)state;
+
+  if (!validHandle(parser, array) ||
+      parser->text[parser->tokenPos[array]] != '[' ||
+      !indexEntries(parser, array) || index < 0 ||
+      index >= parser->entryCount)
+  {
+    return false;
+  }
+
+  *entry = parser->entryTokens[index];
+  return true;
+}
+
+static int sidxGetEntryCount(void *state, HWTJ_HANDLE_TYPE handle)
+{
+  SIDX_PARSER_TYPE *parser = (SIDX_PARSER_TYPE *)state;
+
+  if (!validHandle(parser, handle))
+  {
+    return -1;
+  }
+
+  if (parser->text[parser->tokenPos[handle]] == '[')
+  {
+    return indexEntries(parser, handle) ? parser->entryCount : -1;
+  }
+
+  if (parser->text[parser->tokenPos[handle]] == '{')
+  {
+    int count = 0;
+    int t = handle + 1;
+
+    while (parser->text[parser->tokenPos[t]] == '"')
+    {
+      count++;
+      t = skipValue(parser, t + 3);
+      if (parser->text[parser->tokenPos[t]] == ',')
+      {
+        t++;
+      }
+    }
+    return count;
+  }
+
+  return -1;
+}
+
+/*
+ * Method: sidxGetObjectEntry
+ *
+ * A member asked for after the one returned last is found from
+ * there, so walking all members of an object in order is linear.
+ */
+static bool sidxGetObjectEntry(void *state, HWTJ_HANDLE_TYPE object,
+                               int index, const char **name, int *nameLen,
+                               HWTJ_HANDLE_TYPE *value)
+{
+  SIDX_PARSER_TYPE *parser = (SIDX_PARSER_TYPE *)state;
+
+  if (!validHandle(parser, object) ||
+      parser->text[parser->tokenPos[object]] != '{' || index < 0)
+  {
+    return false;
+  }
+
+  int t = object + 1;
+  int i = 0;
+
+  if (parser->memberObject == (int)object && index >= parser->memberIndex)
+  {
+    t = parser->memberToken;
+    i = parser->memberIndex;
+  }
+  else if (parser->text[parser->tokenPos[t]] != '"')
+  {
+    return false; /* no members */
+  }
+
+  /* key, closing quote, colon, value */
+  for (; i < index; i++)
+  {
+    t = skipValue(parser, t + 3);
+    if (parser->text[parser->tokenPos[t]] != ',')
+    {
+      return false;
+    }
+    t++;
+  }
+
+  parser->memberObject = object;
+  parser->memberIndex = index;
+  parser->memberToken = t;
+
+  *value = t + 3;
+  return stringText(parser, t, name, nameLen);
+}
+
+static void sidxDisplayError(void *state, const char *msg)
+{
+  SIDX_PARSER_TYPE *parser = (SIDX_PARSER_TYPE *)state;
+
+  printf("ERROR: %s\n", msg);
+  if (parser != NULL && parser->error != NULL)
+  {
+    printf("Reason Text: %s at offset %d\n", parser->error, parser->errorPos);
+  }
+}
+
+static bool sidxTerm(void *state)
+{
+  SIDX_PARSER_TYPE *parser = (SIDX_PARSER_TYPE *)state;
+
+  if (parser != NULL)
+  {
+    free(parser->tokenPos);
+    free(parser->tokenMatch);
+    free(parser->entryTokens);
+    free(parser->scratch);
+    free(parser);
+  }
+
+  return true;
+}
+
+JSON_BACKEND_TYPE indexBackend = {
+    "INDEX",
+    sidxInit,
+    sidxParse,
+    sidxSearch,
+    sidxGetType,
+    sidxGetValue,
+    sidxGetBoolean,
+    sidxGetArrayEntry,
+    sidxGetEntryCount,
+    sidxGetObjectEntry,
+    sidxDisplayError,
+    sidxTerm};
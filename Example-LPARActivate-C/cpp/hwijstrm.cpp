@@ -0,0 +1,676 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    MODULE NAME= HWIJSTRM                                            *
+ *                                                                     *
+ *  Sample C code that extracts fields from the entries of an array    *
+ *  of a response, e.g. the uri and target name of each element of     *
+ *  "logical-partitions", in one pass over the text. Nothing is        *
+ *  built for the document: each entry is handed to a callback as      *
+ *  soon as it has been scanned, so storage stays the same however     *
+ *  many entries are returned and the caller can stop the scan early.  *
+ *                                                                     *
+ *************************END OF SPECIFICATIONS************************/
+#pragma filetag("IBM-1047")     /* compile in EBCDIC */
+#pragma csect(code, "HWIJSTRM") /* name of csect */
+#pragma longName
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include <hwtjic.h> /* JSON interface declaration file  */
+#include "hwijbknd.h"
+#include "hwijstrm.h"
+
+/* scans the value of a member whose name is key */
+typedef bool (*MEMBER_SCANNER)(STREAM_EXTRACT_TYPE *stream, int depth,
+                               const char *key, int keyLen);
+
+/* scans the entry of an array at index */
+typedef bool (*ENTRY_SCANNER)(STREAM_EXTRACT_TYPE *stream, int depth,
+                              int index);
+
+static bool scanValue(STREAM_EXTRACT_TYPE *stream, int depth,
+                      STREAM_VALUE_TYPE *value);
+
+/*
+ * Method: initStreamExtract
+ *
+ * Prepare the extraction of the entries of the array named
+ * arrayName, a member of the outermost object of the text.
+ */
+void initStreamExtract(STREAM_EXTRACT_TYPE *stream, const char *arrayName,
+                       STREAM_ENTRY_CALLBACK onEntry, void *userData)
+{
+  memset(stream, 0, sizeof(STREAM_EXTRACT_TYPE));
+  stream->arrayName = arrayName;
+  stream->onEntry = onEntry;
+  stream->userData = userData;
+}
+
+/*
+ * Method: streamField
+ *
+ * Register a field wanted from each entry, it is passed to the
+ * callback at the position it was registered in.
+ *
+ * returns: false if STREAM_MAX_FIELDS fields are already registered
+ */
+bool streamField(STREAM_EXTRACT_TYPE *stream, const char *name)
+{
+  if (stream->fieldCount == STREAM_MAX_FIELDS)
+  {
+    return false;
+  }
+
+  stream->fields[stream->fieldCount++] = name;
+  return true;
+}
+
+/*
+ * Method: scanFailed
+ *
+ * Record why and where the scan failed.
+ */
+static bool scanFailed(STREAM_EXTRACT_TYPE *stream, const char *reason)
+{
+  stream->error = reason;
+  stream->errorPos = stream->pos;
+  return false;
+}
+
+/*
+ * Method: skipWhitespace
+ */
+static void skipWhitespace(STREAM_EXTRACT_TYPE *stream)
+{
+  while (stream->pos < stream->len &&
+         (stream->text[stream->pos] == ' ' ||
+          stream->text[stream->pos] == '\n' ||
+          stream->text[stream->pos] == '\r' ||
+          stream->text[stream->pos] == '\t'))
+  {
+    stream->pos++;
+  }
+}
+
+/*
+ * Method: decode
+ *
+ * Decode the escapes of a string into a buffer of the extraction,
+ * grown as needed and reused for the following entries.
+ */
+static bool decode(const char *in, int inLen, char **buffer, int *capacity,
+                   const char **text, int *textLen)
+{
+  if (inLen + 1 > *capacity)
+  {
+    char *newBuffer = (char *)realloc(*buffer, inLen + 1);
+    if (newBuffer == NULL)
+    {
+      return false;
+    }
+    *buffer = newBuffer;
+    *capacity = inLen + 1;
+  }
+
+  *textLen = unescapeJSON(in, inLen, *buffer);
+  *text = *buffer;
+  return true;
+}
+
+/*
+ * Method: scanString
+ *
+ * Scan a string starting at the opening quote.
+ *
+ * output arguments: text without the quotes, still escaped
+ */
+static bool scanString(STREAM_EXTRACT_TYPE *stream, const char **text,
+                       int *textLen, bool *escaped)
+{
+  const char *in = stream->text;
+  int start = ++stream->pos;
+
+  *escaped = false;
+
+  for (;;)
+  {
+    /* run over the plain characters in a local */
+    int pos = stream->pos;
+    while (pos < stream->len && in[pos] != '"' && in[pos] != '\\')
+    {
+      pos++;
+    }
+    stream->pos = pos;
+
+    if (pos >= stream->len || in[pos] == '"')
+    {
+      break;
+    }
+
+    /* a backslash */
+    *escaped = true;
+    stream->pos++;
+    if (stream->pos >= stream->len ||
+        strchr("\"\\/bfnrtu", in[stream->pos]) == NULL)
+    {
+      return scanFailed(stream, "invalid escape sequence");
+    }
+    if (in[stream->pos] == 'u')
+    {
+      for (int i = 1; i <= 4; i++)
+      {
+        if (stream->pos + i >= stream->len ||
+            !isxdigit((unsigned char)in[stream->pos + i]))
+        {
+          return scanFailed(stream, "invalid unicode escape");
+        }
+      }
+      stream->pos += 4;
+    }
+    stream->pos++;
+  }
+
+  if (stream->pos >= stream->len)
+  {
+    return scanFailed(stream, "unterminated string");
+  }
+
+  *text = in + start;
+  *textLen = stream->pos - start;
+  stream->pos++;
+
+  return true;
+}
+
+/*
+ * Method: scanScalar
+ *
+ * Scan a number (-?int(.digits)?([eE][+-]?digits)?) or literal.
+ */
+static bool scanScalar(STREAM_EXTRACT_TYPE *stream, HWTJ_JTYPE_TYPE *type)
+{
+  const char *in = stream->text;
+  int remaining = stream->len - stream->pos;
+  int digits;
+
+  if (remaining >= 4 && memcmp(in + stream->pos, "true", 4) == 0)
+  {
+    *type = HWTJ_BOOLEAN_TYPE;
+    stream->pos += 4;
+    return true;
+  }
+  if (remaining >= 5 && memcmp(in + stream->pos, "false", 5) == 0)
+  {
+    *type = HWTJ_BOOLEAN_TYPE;
+    stream->pos += 5;
+    return true;
+  }
+  if (remaining >= 4 && memcmp(in + stream->pos, "null", 4) == 0)
+  {
+    *type = HWTJ_NULL_TYPE;
+    stream->pos += 4;
+    return true;
+  }
+
+  *type = HWTJ_NUMBER_TYPE;
+
+  if (stream->pos < stream->len && in[stream->pos] == '-')
+  {
+    stream->pos++;
+  }
+  digits = stream->pos;
+  while (stream->pos < stream->len && isdigit((unsigned char)in[stream->pos]))
+  {
+    stream->pos++;
+  }
+  if (stream->pos == digits ||
+      (in[digits] == '0' && stream->pos - digits > 1))
+  {
+    return scanFailed(stream, "invalid value");
+  }
+
+  if (stream->pos < stream->len && in[stream->pos] == '.')
+  {
+    digits = ++stream->pos;
+    while (stream->pos < stream->len &&
+           isdigit((unsigned char)in[stream->pos]))
+    {
+      stream->pos++;
+    }
+    if (stream->pos == digits)
+    {
+      return scanFailed(stream, "invalid number fraction");
+    }
+  }
+
+  if (stream->pos < stream->len &&
+      (in[stream->pos] == 'e' || in[stream->pos] == 'E'))
+  {
+    stream->pos++;
+    if (stream->pos < stream->len &&
+        (in[stream->pos] == '+' || in[stream->pos] == '-'))
+    {
+      stream->pos++;
+    }
+    digits = stream->pos;
+    while (stream->pos < stream->len &&
+           isdigit((unsigned char)in[stream->pos]))
+    {
+      stream->pos++;
+    }
+    if (stream->pos == digits)
+    {
+      return scanFailed(stream, "invalid number exponent");
+    }
+  }
+
+  return true;
+}
+
+/*
+ * Method: scanObject
+ *
+ * Scan an object starting at its opening bracket, the value of
+ * each member is scanned by scanMember.
+ */
+static bool scanObject(STREAM_EXTRACT_TYPE *stream, int depth,
+                       MEMBER_SCANNER scanMember)
+{
+  if (depth >= STREAM_MAX_DEPTH)
+  {
+    return scanFailed(stream, "nesting too deep");
+  }
+
+  stream->pos++;
+  skipWhitespace(stream);
+  if (stream->pos < stream->len && stream->text[stream->pos] == '}')
+  {
+    stream->pos++;
+    return true;
+  }
+
+  for (;;)
+  {
+    const char *key;
+    int keyLen;
+    bool escaped;
+
+    skipWhitespace(stream);
+    if (stream->pos >= stream->len || stream->text[stream->pos] != '"')
+    {
+      return scanFailed(stream, "member name expected");
+    }
+    if (!scanString(stream, &key, &keyLen, &escaped) ||
+        (escaped && !decode(key, keyLen, &stream->key, &stream->keyCapacity,
+                            &key, &keyLen)))
+    {
+      return false;
+    }
+
+    skipWhitespace(stream);
+    if (stream->pos >= stream->len || stream->text[stream->pos] != ':')
+    {
+      return scanFailed(stream, "':' expected");
+    }
+    stream->pos++;
+
+    if (!scanMember(stream, depth + 1, key, keyLen))
+    {
+      return false;
+    }
+
+    skipWhitespace(stream);
+    if (stream->pos < stream->len && stream->text[stream->pos] == ',')
+    {
+      stream->pos++;
+    }
+    else if (stream->pos < stream->len && stream->text[stream->pos] == '}')
+    {
+      stream->pos++;
+      return true;
+    }
+    else
+    {
+      return scanFailed(stream, "',' or '}' expected");
+    }
+  }
+}
+
+/*
+ * Method: scanArray
+ *
+ * Scan an array starting at its opening bracket, each entry is
+ * scanned by scanEntry.
+ */
+static bool scanArray(STREAM_EXTRACT_TYPE *stream, int depth,
+                      ENTRY_SCANNER scanEntry)
+{
+  if (depth >= STREAM_MAX_DEPTH)
+  {
+    return scanFailed(stream, "nesting too deep");
+  }
+
+  stream->pos++;
+  skipWhitespace(stream);
+  if (stream->pos < stream->len && stream->text[stream->pos] == ']')
+  {
+    stream->pos++;
+    return true;
+  }
+
+  for (int index = 0;; index++)
+  {
+    if (!scanEntry(stream, depth + 1, index))
+    {
+      return false;
+    }
+
+    skipWhitespace(stream);
+    if (stream->pos < stream->len && stream->text[stream->pos] == ',')
+    {
+      stream->pos++;
+    }
+    else if (stream->pos < stream->len && stream->text[stream->pos] == ']')
+    {
+      stream->pos++;
+      return true;
+    }
+    else
+    {
+      return scanFailed(stream, "',' or ']' expected");
+    }
+  }
+}
+
+/*
+ * Method: skipMember
+ *
+ * A member that is not wanted.
+ */
+static bool skipMember(STREAM_EXTRACT_TYPE *stream, int depth,
+                       const char *, int)
+{
+  return scanValue(stream, depth, NULL);
+}
+
+/*
+ * Method: skipEntry
+ *
+ * An array entry that is not wanted.
+ */
+static bool skipEntry(STREAM_EXTRACT_TYPE *stream, int depth, int)
+{
+  return scanValue(stream, depth, NULL);
+}
+
+/*
+ * Method: scanValue
+ *
+ * Scan any value, and describe it when value is not NULL.
+ */
+static bool scanValue(STREAM_EXTRACT_TYPE *stream, int depth,
+                      STREAM_VALUE_TYPE *value)
+{
+  STREAM_VALUE_TYPE scanned;
+  bool escaped;
+
+  skipWhitespace(stream);
+  if (stream->pos >= stream->len)
+  {
+    return scanFailed(stream, "unexpected end of text");
+  }
+
+  int start = stream->pos;
+
+  switch (stream->text[start])
+  {
+  case '{':
+    scanned.type = HWTJ_OBJECT_TYPE;
+    if (!scanObject(stream, depth, skipMember))
+    {
+      return false;
+    }
+    break;
+  case '[':
+    scanned.type = HWTJ_ARRAY_TYPE;
+    if (!scanArray(stream, depth, skipEntry))
+    {
+      return false;
+    }
+    break;
+  case '"':
+    scanned.type = HWTJ_STRING_TYPE;
+    if (!scanString(stream, &scanned.text, &scanned.len, &escaped))
+    {
+      return false;
+    }
+    break;
+  default:
+    if (!scanScalar(stream, &scanned.type))
+    {
+      return false;
+    }
+    break;
+  }
+
+  if (value != NULL)
+  {
+    if (scanned.type != HWTJ_STRING_TYPE)
+    {
+      scanned.text = stream->text + start;
+      scanned.len = stream->pos - start;
+    }
+    scanned.found = true;
+    *value = scanned;
+  }
+
+  return true;
+}
+
+/*
+ * Method: scanField
+ *
+ * A member of an array entry, kept when it is a registered field.
+ */
+static bool scanField(STREAM_EXTRACT_TYPE *stream, int depth,
+                      const char *key, int keyLen)
+{
+  for (int i = 0; i < stream->fieldCount; i++)
+  {
+    if ((int)strlen(stream->fields[i]) != keyLen ||
+        memcmp(stream->fields[i], key, keyLen) != 0)
+    {
+      continue;
+    }
+
+    STREAM_VALUE_TYPE *value = &stream->values[i];
+    if (!scanValue(stream, depth, value))
+    {
+      return false;
+    }
+
+    if (value->type == HWTJ_STRING_TYPE &&
+        memchr(value->text, '\\', value->len) != NULL &&
+        !decode(value->text, value->len, &stream->decoded[i],
+                &stream->decodedCapacity[i], &value->text, &value->len))
+    {
+      return scanFailed(stream, "out of storage");
+    }
+    return true;
+  }
+
+  return scanValue(stream, depth, NULL);
+}
+
+/*
+ * Method: scanWantedEntry
+ *
+ * An entry of the wanted array: collect its fields and hand them
+ * to the callback.
+ */
+static bool scanWantedEntry(STREAM_EXTRACT_TYPE *stream, int depth,
+                            int index)
+{
+  memset(stream->values, 0, sizeof(stream->values));
+
+  skipWhitespace(stream);
+  if (stream->pos < stream->len && stream->text[stream->pos] == '{')
+  {
+    if (!scanObject(stream, depth, scanField))
+    {
+      return false;
+    }
+  }
+  else if (!scanValue(stream, depth, NULL))
+  {
+    return false;
+  }
+
+  stream->entries++;
+  if (!stream->onEntry(index, stream->values, stream->userData))
+  {
+    stream->stopped = true;
+    return false;
+  }
+
+  return true;
+}
+
+/*
+ * Method: scanRootMember
+ *
+ * A member of the outermost object, the wanted array is scanned
+ * entry by entry.
+ */
+static bool scanRootMember(STREAM_EXTRACT_TYPE *stream, int depth,
+                           const char *key, int keyLen)
+{
+  skipWhitespace(stream);
+
+  if (!stream->arrayFound &&
+      (int)strlen(stream->arrayName) == keyLen &&
+      memcmp(stream->arrayName, key, keyLen) == 0 &&
+      stream->pos < stream->len && stream->text[stream->pos] == '[')
+  {
+    stream->arrayFound = true;
+    return scanArray(stream, depth, scanWantedEntry);
+  }
+
+  return scanValue(stream, depth, NULL);
+}
+
+/*
+ * Method: streamArrayEntries
+ *
+ * Scan the text once, calling back for each entry of the array.
+ * The scan ends at the end of the text or when the callback returns
+ * false. arrayFound tells whether the array was there.
+ *
+ * returns: false if the text is not well formed JSON
+ */
+bool streamArrayEntries(STREAM_EXTRACT_TYPE *stream, const char *text,
+                        int textLen)
+{
+  stream->text = text;
+  stream->len = textLen;
+  stream->pos = 0;
+  stream->arrayFound = false;
+  stream->stopped = false;
+  stream->entries = 0;
+  stream->error = NULL;
+
+  skipWhitespace(stream);
+  if (stream->pos >= stream->len || text[stream->pos] != '{')
+  {
+    return scanFailed(stream, "object expected");
+  }
+
+  if (!scanObject(stream, 0, scanRootMember))
+  {
+    return stream->stopped;
+  }
+
+  skipWhitespace(stream);
+  if (stream->pos < stream->len)
+  {
+    return scanFailed(stream, "text follows the JSON value");
+  }
+
+  return true;
+}
+
+/*
+ * Method: streamValueString
+ *
+ * returns: a copy of a string or number field the caller frees,
+ *          NULL when the field was missing or of another type
+ */
+char *streamValueString(STREAM_VALUE_TYPE *value)
+{
+  if (!value->found || (value->type != HWTJ_STRING_TYPE &&
+                        value->type != HWTJ_NUMBER_TYPE))
+  {
+    return NULL;
+  }
+
+  char *copy = (char *)malloc(value->len + 1);
+  if (copy != NULL)
+  {
+    memcpy(copy, value->text, value->len);
+    copy[value->len] = '\0';
+  }
+
+  return copy;
+}
+
+/*
+ * Method: displayStreamError
+ *
+ * A helper method for displaying why a scan failed.
+ */
+void displayStreamError(STREAM_EXTRACT_TYPE *stream, const char *msg)
+{
+  printf("ERROR: %s\n", msg);
+  if (stream->error != NULL)
+  {
+    printf("Reason Text: %s at offset %d\n", stream->error,
+           stream->errorPos);
+  }
+}
+
+/*
+ * Method: freeStreamExtract
+ *
+ * Free the buffers of an extraction.
+ */
+void freeStreamExtract(STREAM_EXTRACT_TYPE *stream)
+{
+  for (int i = 0; i < STREAM_MAX_FIELDS; i++)
+  {
+    free(stream->decoded[i]);
+    stream->decoded[i] = NULL;
+    stream->decodedCapacity[i] = 0;
+  }
+  free(stream->key);
+  stream->key = NULL;
+  stream->keyCapacity = 0;
+}
@@ -0,0 +1,140 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    MODULE NAME= HWIRARNA                                            *
+ *                                                                     *
+ *  Sample C code for a storage arena. Strings and work areas needed   *
+ *  while a request is built and its response is handled are carved    *
+ *  out of chunks and given back in one step when the response is      *
+ *  done. The first chunk is kept, so an arena reused from one         *
+ *  response to the next does not allocate once it is warm.            *
+ *                                                                     *
+ *************************END OF SPECIFICATIONS************************/
+#pragma filetag("IBM-1047")     /* compile in EBCDIC */
+#pragma csect(code, "HWIRARNA") /* name of csect */
+#pragma longName
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "hwirarna.h"
+
+/* allocations are rounded up to keep them aligned for any type */
+#define ARENA_ALIGN 8
+
+/*
+ * Method: arenaAlloc
+ *
+ * returns: len bytes of uninitialized storage that stay valid until
+ *          the arena is reset, NULL if storage could not be obtained
+ */
+void *arenaAlloc(ARENA_TYPE *arena, int len)
+{
+  int alignedLen = (len + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+
+  if (alignedLen > arena->left)
+  {
+    int capacity = alignedLen > ARENA_CHUNK_LEN ? alignedLen
+                                                : ARENA_CHUNK_LEN;
+    ARENA_CHUNK_TYPE *chunk = (ARENA_CHUNK_TYPE *)malloc(
+        sizeof(ARENA_CHUNK_TYPE) + capacity);
+    if (chunk == NULL)
+    {
+      printf("arenaAlloc ERROR: out of storage\n");
+      return NULL;
+    }
+
+    chunk->capacity = capacity;
+    chunk->next = arena->chunks;
+    arena->chunks = chunk;
+    arena->next = (char *)(chunk + 1);
+    arena->left = capacity;
+    arena->chunkAllocs++;
+  }
+
+  void *storage = arena->next;
+  arena->next += alignedLen;
+  arena->left -= alignedLen;
+
+  return storage;
+}
+
+/*
+ * Method: arenaString
+ *
+ * returns: a NUL terminated copy of len characters of text that stays
+ *          valid until the arena is reset
+ */
+char *arenaString(ARENA_TYPE *arena, const char *text, int len)
+{
+  char *copy = (char *)arenaAlloc(arena, len + 1);
+  if (copy != NULL)
+  {
+    memcpy(copy, text, len);
+    copy[len] = '\0';
+  }
+
+  return copy;
+}
+
+/*
+ * Method: resetArena
+ *
+ * Give back everything allocated from the arena at once. The oldest
+ * chunk is kept for the next use when it has the standard size.
+ */
+void resetArena(ARENA_TYPE *arena)
+{
+  ARENA_CHUNK_TYPE *chunk = arena->chunks;
+
+  while (chunk != NULL && chunk->next != NULL)
+  {
+    ARENA_CHUNK_TYPE *older = chunk->next;
+    free(chunk);
+    chunk = older;
+  }
+
+  if (chunk != NULL && chunk->capacity != ARENA_CHUNK_LEN)
+  {
+    free(chunk);
+    chunk = NULL;
+  }
+
+  arena->chunks = chunk;
+  arena->next = chunk != NULL ? (char *)(chunk + 1) : NULL;
+  arena->left = chunk != NULL ? chunk->capacity : 0;
+}
+
+/*
+ * Method: freeArena
+ *
+ * Free all chunks of the arena and leave it empty.
+ */
+void freeArena(ARENA_TYPE *arena)
+{
+  while (arena->chunks != NULL)
+  {
+    ARENA_CHUNK_TYPE *older = arena->chunks->next;
+    free(arena->chunks);
+    arena->chunks = older;
+  }
+
+  arena->next = NULL;
+  arena->left = 0;
+}
@@ -0,0 +1,597 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    MODULE NAME= HWIRAUDT                                            *
+ *                                                                     *
+ *  Sample C code that uses HWIREST API to audit the properties of     *
+ *  many LPARs, as RXAUDIT1 does. The LPARs of each CPC are listed     *
+ *  once, their property queries are spread over a bounded number of   *
+ *  worker threads and a row is written as soon as each LPAR has been  *
+ *  queried.                                                           *
+ *                                                                     *
+ *************************END OF SPECIFICATIONS************************/
+#pragma filetag("IBM-1047")     /* compile in EBCDIC */
+#pragma csect(code, "HWIRAUDT") /* name of csect */
+#pragma longName
+#if defined(__MVS__) && !defined(_OPEN_THREADS) && !defined(_UNIX03_THREADS)
+#define _OPEN_THREADS /* pthread_create of the audit workers */
+#endif
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <fnmatch.h>
+#include <pthread.h>
+#include "hwijprs.h"
+#include "hwijbind.h"
+#include "hwirstc1.h"
+#include "hwiraudt.h"
+#include "hwirlidx.h"
+#include "hwirpoll.h"
+#include "hwirproj.h"
+
+/* RXAUDIT1 PrepLPARAttributes, binding them gives the properties=
+   projection of the query
+*/
+static const JSON_BINDING_TYPE auditBindings[] = {
+    BIND_FIELD(AUDIT_LPAR_TYPE, processorUsage, "processor-usage",
+               BIND_CHARS),
+    BIND_FIELD(AUDIT_LPAR_TYPE, generalPurposeProcessors,
+               "number-general-purpose-processors", BIND_INT),
+    BIND_FIELD(AUDIT_LPAR_TYPE, reservedGeneralPurposeProcessors,
+               "number-reserved-general-purpose-processors", BIND_INT),
+    BIND_FIELD(AUDIT_LPAR_TYPE, generalPurposeCores,
+               "number-general-purpose-cores", BIND_INT),
+    BIND_FIELD(AUDIT_LPAR_TYPE, reservedGeneralPurposeCores,
+               "number-reserved-general-purpose-cores", BIND_INT),
+    BIND_FIELD(AUDIT_LPAR_TYPE, ziipProcessors, "number-ziip-processors",
+               BIND_INT),
+    BIND_FIELD(AUDIT_LPAR_TYPE, reservedZiipProcessors,
+               "number-reserved-ziip-processors", BIND_INT),
+    BIND_FIELD(AUDIT_LPAR_TYPE, ziipCores, "number-ziip-cores", BIND_INT),
+    BIND_FIELD(AUDIT_LPAR_TYPE, reservedZiipCores,
+               "number-reserved-ziip-cores", BIND_INT),
+    BIND_FIELD(AUDIT_LPAR_TYPE, icfProcessors, "number-icf-processors",
+               BIND_INT),
+    BIND_FIELD(AUDIT_LPAR_TYPE, reservedIcfProcessors,
+               "number-reserved-icf-processors", BIND_INT),
+    BIND_FIELD(AUDIT_LPAR_TYPE, icfCores, "number-icf-cores", BIND_INT),
+    BIND_FIELD(AUDIT_LPAR_TYPE, reservedIcfCores,
+               "number-reserved-icf-cores", BIND_INT),
+    BIND_FIELD(AUDIT_LPAR_TYPE, iflProcessors, "number-ifl-processors",
+               BIND_INT),
+    BIND_FIELD(AUDIT_LPAR_TYPE, reservedIflProcessors,
+               "number-reserved-ifl-processors", BIND_INT),
+    BIND_FIELD(AUDIT_LPAR_TYPE, iflCores, "number-ifl-cores", BIND_INT),
+    BIND_FIELD(AUDIT_LPAR_TYPE, reservedIflCores,
+               "number-reserved-ifl-cores", BIND_INT),
+    BIND_FIELD(AUDIT_LPAR_TYPE, initialProcessingWeight,
+               "initial-processing-weight", BIND_INT),
+    BIND_FIELD(AUDIT_LPAR_TYPE, initialProcessingWeightCapped,
+               "initial-processing-weight-capped", BIND_BOOL),
+    BIND_FIELD(AUDIT_LPAR_TYPE, initialVfmStorage, "initial-vfm-storage",
+               BIND_INT64),
+    BIND_FIELD(AUDIT_LPAR_TYPE, maximumVfmStorage, "maximum-vfm-storage",
+               BIND_INT64),
+    BIND_FIELD(AUDIT_LPAR_TYPE, centralAllocation,
+               "storage-central-allocation", BIND_PRESENT),
+    BIND_FIELD(AUDIT_LPAR_TYPE, expandedAllocation,
+               "storage-expanded-allocation", BIND_PRESENT)};
+
+static const int auditBindingCount =
+    sizeof(auditBindings) / sizeof(auditBindings[0]);
+
+static const JSON_BINDING_TYPE storageBindings[] = {
+    BIND_FIELD(AUDIT_STORAGE_TYPE, elementType, "storage-element-type",
+               BIND_CHARS),
+    BIND_FIELD(AUDIT_STORAGE_TYPE, initial, "initial", BIND_INT64),
+    BIND_FIELD(AUDIT_STORAGE_TYPE, current, "current", BIND_INT64)};
+
+/* schemas compiled once */
+static JSON_SCHEMA_TYPE *auditSchema =
+    compileSchema(auditBindings, auditBindingCount);
+static JSON_SCHEMA_TYPE *storageSchema = compileSchema(storageBindings, 3);
+
+/* guards the shared fields of the audit and the rows written */
+static pthread_mutex_t auditLock = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+ * Method: addAuditItem
+ *
+ * Add an LPAR to the audit, an LPAR matched by more than one
+ * entry is not added again.
+ */
+static bool addAuditItem(AUDIT_TYPE *audit, int cpcIndex,
+                         LPAR_INFO_TYPE *lpar)
+{
+  for (int i = 0; i < audit->itemCount; i++)
+  {
+    if (audit->items[i].lpar == lpar)
+    {
+      return true;
+    }
+  }
+
+  if (audit->itemCount == audit->itemCapacity)
+  {
+    int newCapacity = audit->itemCapacity > 0 ? audit->itemCapacity * 2 : 16;
+    AUDIT_ITEM_TYPE *items = (AUDIT_ITEM_TYPE *)realloc(
+        audit->items, newCapacity * sizeof(AUDIT_ITEM_TYPE));
+    if (items == NULL)
+    {
+      printf("audit ERROR: out of storage\n");
+      return false;
+    }
+    audit->items = items;
+    audit->itemCapacity = newCapacity;
+  }
+
+  AUDIT_ITEM_TYPE *item = &audit->items[audit->itemCount++];
+  item->cpcIndex = cpcIndex;
+  item->lpar = lpar;
+
+  return true;
+}
+
+/*
+ * Method: addAuditSpec
+ *
+ * Record one <CPCname>[.<LPARname>] argument. The CPC is resolved and
+ * its LPARs listed once, the LPAR name may be a pattern using * and ?
+ * and all LPARs of the CPC are audited without one.
+ */
+static bool addAuditSpec(AUDIT_TYPE *audit, char *spec)
+{
+  char *separator = strchr(spec, '.');
+  const char *pattern = "*";
+  char *cpcUri = NULL;
+  char *cpcTargetName = NULL;
+  int matches = 0;
+
+  if (separator == spec || (separator != NULL && separator[1] == '\0'))
+  {
+    printf("audit ERROR: %s is not in <CPCname>[.<LPARname>] form\n", spec);
+    return false;
+  }
+
+  char **cpcNames = (char **)realloc(audit->cpcNames,
+                                     (audit->cpcCount + 1) * sizeof(char *));
+  if (cpcNames == NULL)
+  {
+    printf("audit ERROR: out of storage\n");
+    return false;
+  }
+  audit->cpcNames = cpcNames;
+
+  if (separator != NULL)
+  {
+    *separator = '\0';
+    pattern = separator + 1;
+  }
+  int cpcIndex = audit->cpcCount++;
+  audit->cpcNames[cpcIndex] = strdup(spec);
+  if (separator != NULL)
+  {
+    *separator = '.';
+  }
+
+  if (!resolveCPC(audit->cpcNames[cpcIndex], &cpcUri, &cpcTargetName))
+  {
+    printf("audit: CPC %s not found\n", audit->cpcNames[cpcIndex]);
+    return true;
+  }
+
+  LPAR_INDEX_TYPE *index = findLPARIndex(cpcTargetName);
+  if (index == NULL)
+  {
+    index = indexLPARs(cpcUri, cpcTargetName);
+  }
+
+  for (int i = 0; index != NULL && i < index->lparCount; i++)
+  {
+    LPAR_INFO_TYPE *lpar = &index->lpars[i];
+    if (fnmatch(pattern, lpar->name, 0) == 0)
+    {
+      if (!addAuditItem(audit, cpcIndex, lpar))
+      {
+        break;
+      }
+      matches++;
+    }
+  }
+
+  if (matches == 0)
+  {
+    printf("audit: no LPAR on CPC %s matches %s\n",
+           audit->cpcNames[cpcIndex], pattern);
+  }
+
+  free(cpcUri);
+  free(cpcTargetName);
+
+  return true;
+}
+
+/*
+ * Method: readStorageEntries
+ *
+ * Read the sizes of an LPAR from its storage allocation arrays in the
+ * parsed response, as RXAUDIT1 getStorageCentralAllocationEntries and
+ * getStorageExpandedAllocationEntries do.
+ */
+static void readStorageEntries(AUDIT_LPAR_TYPE *lpar)
+{
+  AUDIT_STORAGE_TYPE storage;
+
+  lpar->centralInitial = AUDIT_STORAGE_NONE;
+  lpar->centralCurrent = AUDIT_STORAGE_NONE;
+  lpar->reservedInitial = AUDIT_STORAGE_NONE;
+  lpar->reservedCurrent = AUDIT_STORAGE_NONE;
+  lpar->expandedCurrent = AUDIT_STORAGE_NONE;
+
+  HWTJ_HANDLE_TYPE central =
+      lpar->centralAllocation
+          ? find_array(0, (char *)"storage-central-allocation")
+          : 0;
+  int count = central != 0 ? getnumberOfEntries(central) : 0;
+
+  for (int i = 0; i < count; i++)
+  {
+    memset(&storage, 0, sizeof(AUDIT_STORAGE_TYPE));
+    int bound = bindObject(storageSchema, getArrayEntry(central, i), NULL,
+                           &storage);
+    if (!(bound & 0x01))
+    {
+      continue;
+    }
+
+    if (strcmp(storage.elementType, AUDIT_STORAGE_CENTRAL) == 0)
+    {
+      lpar->centralInitial = (bound & 0x02) ? storage.initial
+                                            : AUDIT_STORAGE_NONE;
+      lpar->centralCurrent = (bound & 0x04) ? storage.current
+                                            : AUDIT_STORAGE_NONE;
+    }
+    else if (strcmp(storage.elementType, AUDIT_STORAGE_RESERVED) == 0)
+    {
+      lpar->reservedInitial = (bound & 0x02) ? storage.initial
+                                             : AUDIT_STORAGE_NONE;
+      lpar->reservedCurrent = (bound & 0x04) ? storage.current
+                                             : AUDIT_STORAGE_NONE;
+    }
+  }
+
+  /* expanded storage has at most one entry */
+  HWTJ_HANDLE_TYPE expanded =
+      lpar->expandedAllocation
+          ? find_array(0, (char *)"storage-expanded-allocation")
+          : 0;
+  if (expanded != 0 && getnumberOfEntries(expanded) > 0)
+  {
+    memset(&storage, 0, sizeof(AUDIT_STORAGE_TYPE));
+    if (bindObject(storageSchema, getArrayEntry(expanded, 0), NULL,
+                   &storage) &
+        0x04)
+    {
+      lpar->expandedCurrent = storage.current;
+    }
+  }
+}
+
+/*
+ * Method: queryAuditLPAR
+ *
+ * GET <lpar-uri>?properties=<PrepLPARAttributes>&cached-acceptable=true
+ * and bind the reply, as RXAUDIT1 QueryLPAR does.
+ *
+ * returns: mask of the auditBindings returned, -1 when the query failed
+ */
+static int queryAuditLPAR(LPAR_INFO_TYPE *lpar, RESPBUF_TYPE *respBuf,
+                          AUDIT_LPAR_TYPE *record)
+{
+  memset(record, 0, sizeof(AUDIT_LPAR_TYPE));
+
+  int bound = queryBoundObject(lpar->uri, lpar->targetName, "LPAR",
+                               auditSchema, 0, cachedAcceptable, respBuf,
+                               record);
+  if (bound >= 0)
+  {
+    readStorageEntries(record);
+  }
+
+  return bound;
+}
+
+/*
+ * Method: printStorage
+ *
+ * A storage size column: N/A when the LPAR has no such storage, ERR
+ * when its allocation array was not returned.
+ */
+static void printStorage(bool returned, long long size)
+{
+  if (!returned)
+  {
+    printf(",ERR");
+  }
+  else if (size == AUDIT_STORAGE_NONE)
+  {
+    printf(",N/A");
+  }
+  else
+  {
+    printf(",%lld", size);
+  }
+}
+
+/*
+ * Method: printAuditHeader
+ *
+ * The comma separated header row of RXAUDIT1 PrepHdrRow, after the
+ * CPC name.
+ */
+static void printAuditHeader()
+{
+  printf("CPC,LPAR Name,status");
+  for (int i = 0; i < auditBindingCount; i++)
+  {
+    const JSON_BINDING_TYPE *field = &auditBindings[i];
+
+    if (field->type != BIND_PRESENT)
+    {
+      printf(",%s", field->name);
+    }
+    else if (field->offset == offsetof(AUDIT_LPAR_TYPE, centralAllocation))
+    {
+      printf(",Storage(CENTRAL)-Initial,Storage(CENTRAL)-Current"
+             ",Storage(RESERVED)-Initial,Storage(RESERVED)-Current");
+    }
+    else
+    {
+      printf(",Storage(EXPANDED)-Current");
+    }
+  }
+  printf("\n");
+}
+
+/*
+ * Method: printAuditRow
+ *
+ * Write the row of an audited LPAR, called with the audit lock held
+ * so that rows of different workers are not mixed. An LPAR that is
+ * not operating is not queried, its row ends after the status.
+ */
+static void printAuditRow(AUDIT_TYPE *audit, AUDIT_ITEM_TYPE *item,
+                          bool queried, RESPBUF_TYPE *respBuf,
+                          AUDIT_LPAR_TYPE *record, int bound)
+{
+  printf("%s,%s,%s", audit->cpcNames[item->cpcIndex], item->lpar->name,
+         item->lpar->status != NULL ? item->lpar->status : "");
+
+  if (!queried)
+  {
+    printf("\n");
+  }
+  else if (respBuf == NULL)
+  {
+    printf(",failed no response buffer\n");
+  }
+  else if (bound < 0)
+  {
+    RESPONSE_ERROR_TYPE *error = &respBuf->error;
+
+    printf(",failed http-status %d reason %d %.*s\n", error->httpStatus,
+           (error->found & ERROR_FOUND_REASON) ? error->reason : -1,
+           (error->found & ERROR_FOUND_MESSAGE) ? error->messageLen : 0,
+           (error->found & ERROR_FOUND_MESSAGE) ? error->message : "");
+  }
+  else
+  {
+    for (int i = 0; i < auditBindingCount; i++)
+    {
+      const JSON_BINDING_TYPE *field = &auditBindings[i];
+      const char *value = (const char *)record + field->offset;
+      bool returned = (bound >> i) & 0x01;
+
+      if (field->type == BIND_PRESENT)
+      {
+        if (field->offset == offsetof(AUDIT_LPAR_TYPE, centralAllocation))
+        {
+          printStorage(returned, record->centralInitial);
+          printStorage(returned, record->centralCurrent);
+          printStorage(returned, record->reservedInitial);
+          printStorage(returned, record->reservedCurrent);
+        }
+        else
+        {
+          printStorage(returned, record->expandedCurrent);
+        }
+      }
+      else if (!returned)
+      {
+        printf(",");
+      }
+      else if (field->type == BIND_CHARS)
+      {
+        printf(",%s", value);
+      }
+      else if (field->type == BIND_INT)
+      {
+        printf(",%d", *(const int *)value);
+      }
+      else if (field->type == BIND_BOOL)
+      {
+        printf(",%s", *(const bool *)value ? "true" : "false");
+      }
+      else
+      {
+        printf(",%lld", *(const long long *)value);
+      }
+    }
+    printf("\n");
+  }
+
+  fflush(stdout);
+}
+
+/*
+ * Method: auditWorker
+ *
+ * Query the next LPAR of the audit until all have been taken. Each
+ * worker thread uses its own parser context and response buffers.
+ */
+static void *auditWorker(void *data)
+{
+  AUDIT_TYPE *audit = (AUDIT_TYPE *)data;
+  AUDIT_LPAR_TYPE record;
+
+  while (true)
+  {
+    pthread_mutex_lock(&auditLock);
+    if (audit->next >= audit->itemCount)
+    {
+      pthread_mutex_unlock(&auditLock);
+      break;
+    }
+    AUDIT_ITEM_TYPE *item = &audit->items[audit->next++];
+    pthread_mutex_unlock(&auditLock);
+
+    /* the properties of an LPAR that is not operating may not be
+       available, RXAUDIT1 does not query them
+    */
+    RESPBUF_TYPE *respBuf = NULL;
+    bool operating = item->lpar->status != NULL &&
+                     strcmp(item->lpar->status, "operating") == 0;
+    bool failed = false;
+    int bound = -1;
+    double seconds = 0;
+
+    if (operating)
+    {
+      long long startMs = currentTimeMs();
+
+      respBuf = acquireResponseBuffer(RESPBUF_SMALL);
+      if (respBuf != NULL)
+      {
+        bound = queryAuditLPAR(item->lpar, respBuf, &record);
+      }
+
+      seconds = (currentTimeMs() - startMs) / 1000.0;
+      failed = respBuf == NULL || bound < 0;
+    }
+
+    pthread_mutex_lock(&auditLock);
+    printAuditRow(audit, item, operating, respBuf, &record, bound);
+    audit->sumSeconds += seconds;
+    audit->failed += failed ? 1 : 0;
+    audit->queried += operating ? 1 : 0;
+    pthread_mutex_unlock(&auditLock);
+
+    if (respBuf != NULL)
+    {
+      releaseResponseBuffer(respBuf);
+    }
+  }
+
+  return NULL;
+}
+
+/*
+ * Method: runAudit
+ *
+ * Report the RXAUDIT1 properties of every LPAR named on the command
+ * line, as comma separated rows:
+ *   -AUDIT [-MAX n] entry ...
+ * where each entry is <CPCname> for all of its LPARs or
+ * <CPCname>.<LPARname>, the LPAR name may use the * and ? wildcards.
+ * At most -MAX LPARs are queried at a time.
+ *
+ * returns: true if every LPAR was audited
+ */
+bool runAudit(int argc, char **argv)
+{
+  AUDIT_TYPE audit;
+  bool argsOk = true;
+  bool auditSuccess = false;
+
+  memset(&audit, 0, sizeof(AUDIT_TYPE));
+  audit.maxWorkers = AUDIT_MAX_WORKERS;
+
+  /* argv[1] is -AUDIT, the options come first */
+  int first = 2;
+  while (first + 1 < argc && strcasecmp(argv[first], "-MAX") == 0)
+  {
+    audit.maxWorkers = atoi(argv[first + 1]);
+    first += 2;
+  }
+
+  if (audit.maxWorkers < 1)
+  {
+    printf("audit ERROR: -MAX must be at least 1\n");
+    argsOk = false;
+  }
+  else if (first >= argc)
+  {
+    printf("audit ERROR: no <CPCname>[.<LPARname>] entries provided\n");
+    argsOk = false;
+  }
+
+  for (int i = first; i < argc && argsOk; i++)
+  {
+    argsOk = addAuditSpec(&audit, argv[i]);
+  }
+
+  if (argsOk && audit.itemCount > 0)
+  {
+    int workers = audit.maxWorkers < audit.itemCount ? audit.maxWorkers
+                                                     : audit.itemCount;
+
+    printf("*>>");
+    printf("auditing %d LPARs with %d workers at %s\n", audit.itemCount,
+           workers, printTime());
+    printAuditHeader();
+    fflush(stdout);
+
+    long long auditStartMs = currentTimeMs();
+    runRequestWorkers("audit", workers, auditWorker, &audit);
+    double auditSeconds = (currentTimeMs() - auditStartMs) / 1000.0;
+
+    printf("*>>");
+    printf("audited %d LPARs, %d operating queried (%d failed), with %d "
+           "workers in %.3f seconds (%.3f if run one at a time)\n",
+           audit.itemCount, audit.queried, audit.failed, workers,
+           auditSeconds, audit.sumSeconds);
+
+    auditSuccess = audit.failed == 0;
+  }
+  else if (argsOk)
+  {
+    printf("audit: no LPARs to audit\n");
+  }
+
+  for (int i = 0; i < audit.cpcCount; i++)
+  {
+    free(audit.cpcNames[i]);
+  }
+  free(audit.cpcNames);
+  free(audit.items);
+
+  return auditSuccess;
+}
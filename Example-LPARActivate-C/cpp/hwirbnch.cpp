@@ -0,0 +1,1171 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ ***********************************************************************
+ *                                                                     *
+ *    MODULE NAME= HWIRBNCH                                            *
+ *                                                                     *
+ *  Sample C code that benchmarks the request and parse hot path of    *
+ *  HWIRSTC1: parsing and extracting canned response bodies from a     *
+ *  200 byte job status up to a 15MB logical-partitions list, the      *
+ *  same bodies through precompiled selectors and record bindings,     *
+ *  members of a 160 member LPAR properties body read by name with     *
+ *  and without the key index, a 1MB array of energy samples           *
+ *  converted to doubles, a failure body parsed and scanned, the same  *
+ *  lists extracted by the streaming scanner, and full requests        *
+ *  carried by the SE simulator transport. Reports ns/op, bytes        *
+ *  allocated per op, parse throughput and peak RSS.                   *
+ *  With -JSON the cases are repeated for each JSON backend named.     *
+ *                                                                     *
+ *  USAGE: HWIRBNCH [-TIME seconds] [-JSON name,...] [case-prefix ...] *
+ *                                                                     *
+ *************************END OF SPECIFICATIONS************************/
+#pragma filetag("IBM-1047")     /* compile in EBCDIC */
+#pragma csect(code, "HWIRBNCH") /* name of csect */
+#pragma longName
+#include <stdlib.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <fcntl.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include <hwicic.h> /* BCPii interface declaration file */
+#include <hwtjic.h> /* JSON interface declaration file  */
+#include "hwijbknd.h"
+#include "hwijprs.h"
+#include "hwijsidx.h"
+#include "hwijstrm.h"
+#include "hwijpath.h"
+#include "hwijbind.h"
+#include "hwirerrb.h"
+#include "hwirstc1.h"
+#include "hwirtran.h"
+#include "hwirsim.h"
+#include "hwirbnch.h"
+
+#if defined(__GLIBC__)
+/* Count heap allocations by wrapping the glibc allocator. Elsewhere
+   allocations are not counted, on z/OS run with the RPTSTG(ON)
+   runtime option for heap statistics instead.
+*/
+extern "C" void *__libc_malloc(size_t size);
+extern "C" void *__libc_calloc(size_t count, size_t size);
+extern "C" void *__libc_realloc(void *ptr, size_t size);
+extern "C" void __libc_free(void *ptr);
+
+static bool allocCounted = true;
+static bool allocCounting = false;
+static long long allocBytes = 0;
+static long long allocCalls = 0;
+
+extern "C" void *malloc(size_t size) __THROW
+{
+  if (allocCounting)
+  {
+    allocBytes += size;
+    allocCalls++;
+  }
+  return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t count, size_t size) __THROW
+{
+  if (allocCounting)
+  {
+    allocBytes += count * size;
+    allocCalls++;
+  }
+  return __libc_calloc(count, size);
+}
+
+extern "C" void *realloc(void *ptr, size_t size) __THROW
+{
+  if (allocCounting)
+  {
+    allocBytes += size;
+    allocCalls++;
+  }
+  return __libc_realloc(ptr, size);
+}
+
+extern "C" void free(void *ptr) __THROW
+{
+  __libc_free(ptr);
+}
+#else
+static bool allocCounted = false;
+static bool allocCounting = false;
+static long long allocBytes = 0;
+static long long allocCalls = 0;
+#endif
+
+/* canned response bodies */
+static BENCH_BODY_TYPE jobBody = {"job200", 200, NULL, 0, 0};
+static BENCH_BODY_TYPE list1MB = {"1MB", 1048576, NULL, 0, 0};
+static BENCH_BODY_TYPE list5MB = {"5MB", 5242880, NULL, 0, 0};
+static BENCH_BODY_TYPE list15MB = {"15MB", 15728640 - 1, NULL, 0, 0};
+static BENCH_BODY_TYPE propsBody = {"props160", 16384, NULL, 0, 0};
+static BENCH_BODY_TYPE samples1MB = {"samples1MB", 1048576, NULL, 0, 0};
+static BENCH_BODY_TYPE errorBody = {"error", 0, NULL, 0, 0};
+
+/* the LPAR properties RXAUDIT1 PrepLPARAttributes audits, with the
+   values of the canned LPAR properties body
+*/
+static BENCH_PROP_TYPE auditedProps[] = {
+    {"processor-usage", "\"shared\""},
+    {"number-general-purpose-processors", "4"},
+    {"number-reserved-general-purpose-processors", "2"},
+    {"number-general-purpose-cores", "4"},
+    {"number-reserved-general-purpose-cores", "2"},
+    {"number-ziip-processors", "2"},
+    {"number-reserved-ziip-processors", "0"},
+    {"number-ziip-cores", "2"},
+    {"number-reserved-ziip-cores", "0"},
+    {"number-icf-processors", "0"},
+    {"number-reserved-icf-processors", "0"},
+    {"number-icf-cores", "0"},
+    {"number-reserved-icf-cores", "0"},
+    {"number-ifl-processors", "0"},
+    {"number-reserved-ifl-processors", "0"},
+    {"number-ifl-cores", "0"},
+    {"number-reserved-ifl-cores", "0"},
+    {"initial-processing-weight", "10"},
+    {"initial-processing-weight-capped", "false"},
+    {"initial-vfm-storage", "0"},
+    {"maximum-vfm-storage", "0"},
+    {"storage-central-allocation",
+     "[{\"storage-element-type\":\"central\",\"origin\":0,"
+     "\"initial\":16384,\"current\":16384,\"maximum\":32768,\"gap\":0},"
+     "{\"storage-element-type\":\"reserved\",\"origin\":32768,"
+     "\"initial\":8192,\"current\":8192,\"maximum\":8192,\"gap\":0}]"},
+    {"storage-expanded-allocation", "[]"}};
+
+static const int auditedPropCount =
+    sizeof(auditedProps) / sizeof(auditedProps[0]);
+
+/* objects resolved through the simulator for the request cases */
+static char *benchCpcUri = NULL;
+static char *benchCpcTarget = NULL;
+static char *benchLparUri = NULL;
+static char *benchLparTarget = NULL;
+
+/*
+ * Method: buildJobBody
+ *
+ * Canned job status reply padded to the target length.
+ */
+static bool buildJobBody(BENCH_BODY_TYPE *body)
+{
+  const char *prefix = "{\"status\":\"complete\",\"job-status-code\":200,"
+                       "\"job-reason-code\":0,\"job-results\":"
+                       "{\"message\":\"";
+  int prefixLen = strlen(prefix);
+  int padLen = body->targetLen - prefixLen - 3;
+
+  body->text = (char *)malloc(body->targetLen + 1);
+  if (body->text == NULL || padLen < 0)
+  {
+    return false;
+  }
+
+  strcpy(body->text, prefix);
+  memset(body->text + prefixLen, 'x', padLen);
+  strcpy(body->text + prefixLen + padLen, "\"}}");
+  body->len = strlen(body->text);
+  body->entries = 0;
+
+  return true;
+}
+
+/*
+ * Method: buildListBody
+ *
+ * Canned List Logical Partitions of CPC reply of about the target
+ * length, made of BENCH_ENTRY_LEN byte entries.
+ */
+static bool buildListBody(BENCH_BODY_TYPE *body)
+{
+  char entry[BENCH_ENTRY_LEN + 1];
+
+  body->text = (char *)malloc(body->targetLen + 1);
+  if (body->text == NULL)
+  {
+    return false;
+  }
+
+  strcpy(body->text, "{\"logical-partitions\":[");
+  body->len = strlen(body->text);
+  body->entries = 0;
+
+  while (body->len + BENCH_ENTRY_LEN + 3 <= body->targetLen)
+  {
+    int entryLen = sprintf(entry,
+                           "%s{\"name\":\"LP%05d\",\"request-origin\":false,"
+                           "\"object-uri\":\"/api/logical-partitions/"
+                           "51300000-0001-%05d\",\"target-name\":"
+                           "\"IBM390PS.CPC1.LP%05d\",\"status\":"
+                           "\"not-activated\",\"description\":\"",
+                           body->entries > 0 ? "," : "", body->entries,
+                           body->entries, body->entries);
+    int padLen = BENCH_ENTRY_LEN - entryLen - 2;
+
+    memcpy(body->text + body->len, entry, entryLen);
+    memset(body->text + body->len + entryLen, 'x', padLen);
+    memcpy(body->text + body->len + entryLen + padLen, "\"}", 2);
+    body->len += BENCH_ENTRY_LEN;
+    body->entries++;
+  }
+
+  strcpy(body->text + body->len, "]}");
+  body->len += 2;
+
+  return true;
+}
+
+/*
+ * Method: buildPropsBody
+ *
+ * Canned Get Logical Partition Properties reply with
+ * BENCH_PROPS_MEMBERS members: the properties RXAUDIT1 audits
+ * spread among others, alternately strings and numbers.
+ */
+static bool buildPropsBody(BENCH_BODY_TYPE *body)
+{
+  body->text = (char *)malloc(body->targetLen + 1);
+  if (body->text == NULL)
+  {
+    return false;
+  }
+
+  body->len = sprintf(body->text, "{");
+  for (int i = 0; i < BENCH_PROPS_MEMBERS; i++)
+  {
+    const char *separator = i > 0 ? "," : "";
+
+    if (i % BENCH_PROPS_SPREAD == BENCH_PROPS_SPREAD / 2 &&
+        i / BENCH_PROPS_SPREAD < auditedPropCount)
+    {
+      /* not in the order they are read, 10 and 23 share no factor */
+      BENCH_PROP_TYPE *prop =
+          &auditedProps[i / BENCH_PROPS_SPREAD * 10 % auditedPropCount];
+      if (body->len + strlen(prop->name) + strlen(prop->value) + 8 >
+          (size_t)body->targetLen)
+      {
+        return false;
+      }
+      body->len += sprintf(body->text + body->len, "%s\"%s\":%s",
+                           separator, prop->name, prop->value);
+      continue;
+    }
+
+    const char *format = i % 2 == 0 ? "%s\"lpar-property-%03d\":\"v%d\""
+                                    : "%s\"lpar-property-%03d\":%d";
+    if (body->len + 64 > body->targetLen)
+    {
+      return false;
+    }
+    body->len += sprintf(body->text + body->len, format, separator, i,
+                         i * 1000);
+  }
+  body->len += sprintf(body->text + body->len, "}");
+  body->entries = BENCH_PROPS_MEMBERS;
+
+  return true;
+}
+
+/*
+ * Method: buildSamplesBody
+ *
+ * Canned reply with an array of energy samples, numbers with three
+ * decimals, of about the target length.
+ */
+static bool buildSamplesBody(BENCH_BODY_TYPE *body)
+{
+  body->text = (char *)malloc(body->targetLen + 1);
+  if (body->text == NULL)
+  {
+    return false;
+  }
+
+  body->len = sprintf(body->text, "{\"energy-samples\":[");
+  body->entries = 0;
+
+  while (body->len + 32 <= body->targetLen)
+  {
+    body->len += sprintf(body->text + body->len, "%s%d.%03d",
+                         body->entries > 0 ? "," : "",
+                         100000 + body->entries * 7 % 90000,
+                         body->entries % 1000);
+    body->entries++;
+  }
+
+  body->len += sprintf(body->text + body->len, "]}");
+
+  return true;
+}
+
+/*
+ * Method: buildErrorBody
+ *
+ * Canned failure reply of a request for an unknown LPAR.
+ */
+static bool buildErrorBody(BENCH_BODY_TYPE *body)
+{
+  const char *text = "{\"http-status\":404,\"reason\":1,\"message\":"
+                     "\"logical partition not found\",\"request-uri\":"
+                     "\"/api/logical-partitions/51300000-0001-00099\","
+                     "\"request-method\":\"GET\",\"bcpii-error\":false}";
+
+  body->text = strdup(text);
+  body->len = strlen(text);
+  body->entries = 0;
+
+  return body->text != NULL;
+}
+
+/*
+ * Method: parseBody
+ *
+ * Parse only.
+ */
+static bool parseBody(BENCH_BODY_TYPE *body)
+{
+  return parse_json_text(body->text);
+}
+
+/*
+ * Method: extractJob
+ *
+ * Parse a job status reply and extract what getJobStatus does.
+ */
+static bool extractJob(BENCH_BODY_TYPE *body)
+{
+  if (!parse_json_text(body->text))
+  {
+    return false;
+  }
+
+  char *status = find_string(0, (char *)"status");
+  char *statusCode = find_optional_number(0, (char *)"job-status-code");
+  char *reasonCode = find_optional_number(0, (char *)"job-reason-code");
+  bool extracted = status != NULL && statusCode != NULL && reasonCode != NULL;
+
+  free(status);
+  free(statusCode);
+  free(reasonCode);
+
+  return extracted;
+}
+
+/*
+ * Method: extractList
+ *
+ * Parse a logical-partitions list and extract every entry the way
+ * listLPARs does.
+ */
+static bool extractList(BENCH_BODY_TYPE *body)
+{
+  if (!parse_json_text(body->text))
+  {
+    return false;
+  }
+
+  HWTJ_HANDLE_TYPE arrayhandle = find_array(0, (char *)"logical-partitions");
+  int entryNum = getnumberOfEntries(arrayhandle);
+  int extracted = 0;
+
+  for (int i = 0; i < entryNum; i++)
+  {
+    HWTJ_HANDLE_TYPE arrayentry = getArrayEntry(arrayhandle, i);
+    char *name = find_string(arrayentry, (char *)"name");
+    char *uri = find_string(arrayentry, (char *)"object-uri");
+    char *targetName = find_string(arrayentry, (char *)"target-name");
+    char *status = find_optional_string(arrayentry, (char *)statusProp);
+
+    if (name != NULL && uri != NULL && targetName != NULL)
+    {
+      extracted++;
+    }
+
+    free(name);
+    free(uri);
+    free(targetName);
+    free(status);
+  }
+
+  return extracted == body->entries;
+}
+
+/*
+ * Method: lookupProps
+ *
+ * Parse an LPAR properties reply and read the properties RXAUDIT1
+ * audits by name, one search each as its QueryLPAR does. The entries
+ * of the storage arrays are read in between, as its
+ * getStorageCentralAllocationEntries does.
+ */
+static bool lookupProps(BENCH_BODY_TYPE *body)
+{
+  if (!parse_json_text(body->text))
+  {
+    return false;
+  }
+
+  int found = 0;
+  for (int k = 0; k < auditedPropCount; k++)
+  {
+    char *name = (char *)auditedProps[k].name;
+    JSON_VIEW_TYPE view;
+
+    switch (auditedProps[k].value[0])
+    {
+    case '[':
+    {
+      HWTJ_HANDLE_TYPE array = find_array(0, name);
+      int count = array != 0 ? getnumberOfEntries(array) : 0;
+
+      for (int i = 0; i < count; i++)
+      {
+        find_view(getArrayEntry(array, i), (char *)"storage-element-type",
+                  HWTJ_STRING_TYPE, NULL, &view);
+      }
+      found += array != 0 ? 1 : 0;
+      break;
+    }
+    case 't':
+    case 'f':
+      found += find_boolvalue(0, name) >= 0 ? 1 : 0;
+      break;
+    case '"':
+      found += find_view(0, name, HWTJ_STRING_TYPE, NULL, &view) ? 1 : 0;
+      break;
+    default:
+      found += find_view(0, name, HWTJ_NUMBER_TYPE, NULL, &view) ? 1 : 0;
+      break;
+    }
+  }
+
+  return found == auditedPropCount;
+}
+
+/*
+ * Method: lookupPropsLinear
+ *
+ * lookupProps with every name found by a linear search.
+ */
+static bool lookupPropsLinear(BENCH_BODY_TYPE *body)
+{
+  JSON_PARSER_TYPE *parser = current_parser();
+  if (parser == NULL)
+  {
+    return false;
+  }
+
+  parser->keyIndex.disabled = true;
+  bool found = lookupProps(body);
+  parser->keyIndex.disabled = false;
+
+  return found;
+}
+
+/*
+ * Method: sumSamples
+ *
+ * Parse an energy samples reply and convert all samples to doubles
+ * in one call, as an aggregation of telemetry would.
+ */
+static bool sumSamples(BENCH_BODY_TYPE *body)
+{
+  double *samples = NULL;
+  double sum = 0;
+
+  if (!parse_json_text(body->text))
+  {
+    return false;
+  }
+
+  int count = get_double_array(find_array(0, (char *)"energy-samples"),
+                               &samples);
+  for (int i = 0; i < count; i++)
+  {
+    sum += samples[i];
+  }
+  free(samples);
+
+  return count == body->entries && sum > 0;
+}
+
+/*
+ * Method: parseError
+ *
+ * Decode a failure reply with a parser context of its own, the way
+ * traceFailureResponse did before the error scanner.
+ */
+static bool parseError(BENCH_BODY_TYPE *body)
+{
+  JSON_PARSER_TYPE *errorParser = acquire_parser();
+  JSON_PARSER_TYPE *callerParser = use_parser(errorParser);
+  JSON_VIEW_TYPE message;
+  bool decoded = false;
+
+  if (errorParser != NULL && parse_json_text(body->text))
+  {
+    decoded = find_boolvalue(0, (char *)"bcpii-error") == 0 &&
+              find_view(0, (char *)"message", HWTJ_STRING_TYPE, NULL, &message);
+  }
+
+  use_parser(callerParser);
+  release_parser(errorParser);
+
+  return decoded;
+}
+
+/*
+ * Method: scanError
+ *
+ * Decode a failure reply into an error record, as
+ * completeResponseBuffer does.
+ */
+static bool scanError(BENCH_BODY_TYPE *body)
+{
+  RESPONSE_ERROR_TYPE error;
+
+  return scanErrorBody(body->text, body->len, &error) &&
+         (error.found & ERROR_FOUND_MESSAGE) && error.reason == 1;
+}
+
+/* the fields extractJob and extractList search for */
+static JSON_PATH_TYPE *jobPath =
+    compilePath("{status,job-status-code,job-reason-code}");
+static JSON_PATH_TYPE *listPath = compilePath(
+    "logical-partitions[*].{name,object-uri,target-name,status}");
+
+/* what RXAUDIT1 QueryLPAR reads of an LPAR, and of each of its
+   central storage allocations
+*/
+static JSON_PATH_TYPE *auditPath = compilePath(
+    "{processor-usage,number-general-purpose-processors,"
+    "number-reserved-general-purpose-processors,number-general-purpose-cores,"
+    "number-reserved-general-purpose-cores,number-ziip-processors,"
+    "number-reserved-ziip-processors,number-ziip-cores,"
+    "number-reserved-ziip-cores,number-icf-processors,"
+    "number-reserved-icf-processors,number-icf-cores,"
+    "number-reserved-icf-cores,number-ifl-processors,"
+    "number-reserved-ifl-processors,number-ifl-cores,"
+    "number-reserved-ifl-cores,initial-processing-weight,"
+    "initial-processing-weight-capped,initial-vfm-storage,"
+    "maximum-vfm-storage,storage-central-allocation,"
+    "storage-expanded-allocation}");
+static JSON_PATH_TYPE *storagePath = compilePath(
+    "storage-central-allocation[*].{storage-element-type,initial,current}");
+
+/*
+ * Method: selectJob
+ *
+ * Parse a job status reply and select what extractJob extracts.
+ */
+static bool selectJob(BENCH_BODY_TYPE *body)
+{
+  PATH_RESULT_TYPE selected;
+  memset(&selected, 0, sizeof(PATH_RESULT_TYPE));
+
+  if (!parse_json_text(body->text) || !selectPath(jobPath, 0, &selected) ||
+      selected.rowCount != 1)
+  {
+    freePathResult(&selected);
+    return false;
+  }
+
+  char *status = selectedString(&selected, 0, 0);
+  char *statusCode = selectedString(&selected, 0, 1);
+  char *reasonCode = selectedString(&selected, 0, 2);
+  bool extracted = status != NULL && statusCode != NULL && reasonCode != NULL;
+
+  free(status);
+  free(statusCode);
+  free(reasonCode);
+  freePathResult(&selected);
+
+  return extracted;
+}
+
+/*
+ * Method: selectList
+ *
+ * Parse a logical-partitions list and select what extractList
+ * extracts from every entry.
+ */
+static bool selectList(BENCH_BODY_TYPE *body)
+{
+  PATH_RESULT_TYPE selected;
+  memset(&selected, 0, sizeof(PATH_RESULT_TYPE));
+
+  if (!parse_json_text(body->text) || !selectPath(listPath, 0, &selected))
+  {
+    freePathResult(&selected);
+    return false;
+  }
+
+  int extracted = 0;
+
+  for (int i = 0; i < selected.rowCount; i++)
+  {
+    char *name = selectedString(&selected, i, 0);
+    char *uri = selectedString(&selected, i, 1);
+    char *targetName = selectedString(&selected, i, 2);
+    char *status = selectedString(&selected, i, 3);
+
+    if (name != NULL && uri != NULL && targetName != NULL)
+    {
+      extracted++;
+    }
+
+    free(name);
+    free(uri);
+    free(targetName);
+    free(status);
+  }
+  freePathResult(&selected);
+
+  return extracted == body->entries;
+}
+
+/* the job status and list entry records the bind cases fill */
+static const JSON_BINDING_TYPE jobBindings[] = {
+    BIND_FIELD(JOB_STATUS_TYPE, status, "status", BIND_CHARS),
+    BIND_FIELD(JOB_STATUS_TYPE, jobStatusCode, "job-status-code", BIND_INT),
+    BIND_FIELD(JOB_STATUS_TYPE, jobReasonCode, "job-reason-code", BIND_INT)};
+static const JSON_BINDING_TYPE entryBindings[] = {
+    BIND_FIELD(LPAR_INFO_TYPE, name, "name", BIND_STRING),
+    BIND_FIELD(LPAR_INFO_TYPE, uri, "object-uri", BIND_STRING),
+    BIND_FIELD(LPAR_INFO_TYPE, targetName, "target-name", BIND_STRING),
+    BIND_FIELD(LPAR_INFO_TYPE, status, "status", BIND_STRING)};
+
+static JSON_SCHEMA_TYPE *jobSchema = compileSchema(jobBindings, 3);
+static JSON_SCHEMA_TYPE *entrySchema = compileSchema(entryBindings, 4);
+
+/* strings of the bound records, reset after each op */
+static ARENA_TYPE bindArena;
+
+/*
+ * Method: bindJob
+ *
+ * Parse a job status reply and bind it to a JOB_STATUS_TYPE.
+ */
+static bool bindJob(BENCH_BODY_TYPE *body)
+{
+  JOB_STATUS_TYPE jobStatus;
+
+  if (!parse_json_text(body->text))
+  {
+    return false;
+  }
+
+  return bindObject(jobSchema, 0, NULL, &jobStatus) == 0x07;
+}
+
+/*
+ * Method: bindList
+ *
+ * Parse a logical-partitions list and bind every entry to an
+ * LPAR_INFO_TYPE, the strings going to an arena.
+ */
+static bool bindList(BENCH_BODY_TYPE *body)
+{
+  if (!parse_json_text(body->text))
+  {
+    return false;
+  }
+
+  HWTJ_HANDLE_TYPE arrayhandle = find_array(0, (char *)"logical-partitions");
+  int entryNum = getnumberOfEntries(arrayhandle);
+  int extracted = 0;
+
+  for (int i = 0; i < entryNum; i++)
+  {
+    LPAR_INFO_TYPE lpar;
+
+    if ((bindObject(entrySchema, getArrayEntry(arrayhandle, i), &bindArena,
+                    &lpar) & 0x07) == 0x07)
+    {
+      extracted++;
+    }
+  }
+  resetArena(&bindArena);
+
+  return extracted == body->entries;
+}
+
+/*
+ * Method: selectProps
+ *
+ * Parse an LPAR properties reply and select what RXAUDIT1 reads of
+ * it, the audited properties in one pass over the members and then
+ * the initial and current size of each central storage allocation.
+ */
+static bool selectProps(BENCH_BODY_TYPE *body)
+{
+  PATH_RESULT_TYPE selected;
+  PATH_RESULT_TYPE storage;
+  memset(&selected, 0, sizeof(PATH_RESULT_TYPE));
+  memset(&storage, 0, sizeof(PATH_RESULT_TYPE));
+
+  if (!parse_json_text(body->text) || !selectPath(auditPath, 0, &selected) ||
+      selected.rowCount != 1 || !selectPath(storagePath, 0, &storage))
+  {
+    freePathResult(&selected);
+    freePathResult(&storage);
+    return false;
+  }
+
+  int found = 0;
+  for (int f = 0; f < auditedPropCount; f++)
+  {
+    if (selectedValue(&selected, 0, f)->found)
+    {
+      found++;
+    }
+  }
+
+  for (int i = 0; i < storage.rowCount; i++)
+  {
+    JSON_VIEW_TYPE view;
+    if (selectedView(&storage, i, 1, HWTJ_NUMBER_TYPE, &view) &&
+        selectedView(&storage, i, 2, HWTJ_NUMBER_TYPE, &view))
+    {
+      found++;
+    }
+  }
+
+  freePathResult(&selected);
+  freePathResult(&storage);
+
+  return found == auditedPropCount + 2;
+}
+
+/*
+ * Method: countStreamedLPAR
+ *
+ * Stream callback that copies the fields of an entry the way
+ * listLPARs does and counts the complete entries.
+ */
+static bool countStreamedLPAR(int, STREAM_VALUE_TYPE *values,
+                              void *userData)
+{
+  char *name = streamValueString(&values[0]);
+  char *uri = streamValueString(&values[1]);
+  char *targetName = streamValueString(&values[2]);
+  char *status = streamValueString(&values[3]);
+
+  if (name != NULL && uri != NULL && targetName != NULL)
+  {
+    (*(int *)userData)++;
+  }
+
+  free(name);
+  free(uri);
+  free(targetName);
+  free(status);
+
+  return true;
+}
+
+/*
+ * Method: streamList
+ *
+ * Extract every entry of a logical-partitions list in one pass
+ * over the text, without parsing it first.
+ */
+static bool streamList(BENCH_BODY_TYPE *body)
+{
+  STREAM_EXTRACT_TYPE stream;
+  int extracted = 0;
+
+  initStreamExtract(&stream, "logical-partitions", countStreamedLPAR,
+                    &extracted);
+  streamField(&stream, "name");
+  streamField(&stream, "object-uri");
+  streamField(&stream, "target-name");
+  streamField(&stream, statusProp);
+
+  bool streamed = streamArrayEntries(&stream, body->text, body->len);
+  freeStreamExtract(&stream);
+
+  return streamed && extracted == body->entries;
+}
+
+/*
+ * Method: requestProperties
+ *
+ * Activation pre-check request: build, carry, handle and parse.
+ */
+static bool requestProperties(BENCH_BODY_TYPE *)
+{
+  LPAR_PROPS_TYPE props;
+
+  bool fetched = getLPARProperties(benchLparUri, benchLparTarget,
+                                   LPAR_PROP_STATUS |
+                                       LPAR_PROP_NEXT_ACT_PROFILE,
+                                   &props);
+  freeLPARProperties(&props);
+
+  return fetched;
+}
+
+/*
+ * Method: requestList
+ *
+ * List Logical Partitions of CPC request: build, carry, handle,
+ * parse and extract every entry.
+ */
+static bool requestList(BENCH_BODY_TYPE *)
+{
+  LPAR_INFO_TYPE *lparList = NULL;
+
+  int lparCount = listLPARs(benchCpcUri, benchCpcTarget, &lparList);
+  freeLPARList(lparList, lparCount);
+
+  return lparCount > 0;
+}
+
+static BENCH_CASE_TYPE benchCases[] = {
+    {"parse-job200", parseBody, &jobBody, true},
+    {"parse-1MB", parseBody, &list1MB, true},
+    {"parse-5MB", parseBody, &list5MB, true},
+    {"parse-15MB", parseBody, &list15MB, true},
+    {"extract-job200", extractJob, &jobBody, true},
+    {"extract-1MB", extractList, &list1MB, true},
+    {"extract-5MB", extractList, &list5MB, true},
+    {"extract-15MB", extractList, &list15MB, true},
+    {"select-job200", selectJob, &jobBody, true},
+    {"select-1MB", selectList, &list1MB, true},
+    {"select-5MB", selectList, &list5MB, true},
+    {"select-15MB", selectList, &list15MB, true},
+    {"bind-job200", bindJob, &jobBody, true},
+    {"bind-1MB", bindList, &list1MB, true},
+    {"bind-5MB", bindList, &list5MB, true},
+    {"bind-15MB", bindList, &list15MB, true},
+    {"select-160", selectProps, &propsBody, true},
+    {"lookup-160", lookupProps, &propsBody, true},
+    {"lookup-160-lin", lookupPropsLinear, &propsBody, true},
+    {"numbers-1MB", sumSamples, &samples1MB, true},
+    {"error-parse", parseError, &errorBody, true},
+    {"error-scan", scanError, &errorBody, true},
+    {"stream-1MB", streamList, &list1MB, true},
+    {"stream-5MB", streamList, &list5MB, true},
+    {"stream-15MB", streamList, &list15MB, true},
+    {"request-props", requestProperties, NULL, false},
+    {"request-list", requestList, NULL, false}};
+
+static const int benchCaseCount = sizeof(benchCases) / sizeof(benchCases[0]);
+
+/*
+ * Method: benchSeconds
+ *
+ * Current time of day in seconds.
+ */
+static double benchSeconds()
+{
+  struct timeval now;
+  gettimeofday(&now, NULL);
+  return now.tv_sec + now.tv_usec / 1000000.0;
+}
+
+/*
+ * Method: peakRSSKB
+ *
+ * returns: peak resident set size of the process in KB
+ */
+static long peakRSSKB()
+{
+  struct rusage usage;
+
+  memset(&usage, 0, sizeof(usage));
+  getrusage(RUSAGE_SELF, &usage);
+
+  return usage.ru_maxrss;
+}
+
+/*
+ * Method: runCase
+ *
+ * Run one case until it has run for minSeconds. Request tracing
+ * is off for the warm-up run and the timed loop, so the request
+ * cases do not time the formatting of the trace; a failed warm-up
+ * is run once more with tracing on to show why.
+ */
+static bool runCase(BENCH_CASE_TYPE *benchCase, double minSeconds,
+                    BENCH_RESULT_TYPE *result)
+{
+  memset(result, 0, sizeof(BENCH_RESULT_TYPE));
+
+  bool savedTraceRequests = traceRequests;
+  traceRequests = false;
+
+  if (!benchCase->run(benchCase->body))
+  {
+    traceRequests = savedTraceRequests;
+    benchCase->run(benchCase->body);
+    printf("%s FAILED\n", benchCase->name);
+    return false;
+  }
+
+  fflush(stdout);
+  int savedStdout = dup(STDOUT_FILENO);
+  int nullFd = open("/dev/null", O_WRONLY);
+  if (nullFd >= 0)
+  {
+    dup2(nullFd, STDOUT_FILENO);
+    close(nullFd);
+  }
+
+  allocBytes = 0;
+  allocCalls = 0;
+  allocCounting = true;
+
+  double start = benchSeconds();
+  do
+  {
+    benchCase->run(benchCase->body);
+    result->iterations++;
+    result->elapsedSeconds = benchSeconds() - start;
+  } while (result->elapsedSeconds < minSeconds ||
+           result->iterations < BENCH_MIN_ITERATIONS);
+
+  allocCounting = false;
+  traceRequests = savedTraceRequests;
+  result->allocBytes = allocBytes;
+  result->allocCalls = allocCalls;
+
+  fflush(stdout);
+  if (savedStdout >= 0)
+  {
+    dup2(savedStdout, STDOUT_FILENO);
+    close(savedStdout);
+  }
+
+  result->peakRSSKB = peakRSSKB();
+
+  return true;
+}
+
+/*
+ * Method: printResult
+ *
+ * One line of the result table.
+ */
+static void printResult(BENCH_CASE_TYPE *benchCase,
+                        BENCH_RESULT_TYPE *result)
+{
+  double nsPerOp = result->elapsedSeconds * 1e9 / result->iterations;
+
+  printf("%-16s %9d %8lld %14.0f", benchCase->name,
+         benchCase->body != NULL ? benchCase->body->len : 0,
+         result->iterations, nsPerOp);
+
+  if (allocCounted)
+  {
+    printf(" %12lld %9lld",
+           result->allocBytes / result->iterations,
+           result->allocCalls / result->iterations);
+  }
+  else
+  {
+    printf(" %12s %9s", "-", "-");
+  }
+
+  if (benchCase->parses && benchCase->body != NULL)
+  {
+    printf(" %9.3f", (double)benchCase->body->len * result->iterations /
+                         result->elapsedSeconds / 1e9);
+  }
+  else
+  {
+    printf(" %9s", "-");
+  }
+
+  printf(" %11ld\n", result->peakRSSKB);
+}
+
+/*
+ * Method: selected
+ *
+ * returns: true if the case name starts with one of the prefixes,
+ *          or no prefix was given
+ */
+static bool selected(const char *name, char **prefixes, int prefixCount)
+{
+  if (prefixCount == 0)
+  {
+    return true;
+  }
+
+  for (int i = 0; i < prefixCount; i++)
+  {
+    if (strncasecmp(name, prefixes[i], strlen(prefixes[i])) == 0)
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/*
+ * Method: openBenchSimulator
+ *
+ * Carry the request cases with the SE simulator, without latency
+ * unless HWIRSTC1_SIM asks for it, and resolve the objects used.
+ */
+static bool openBenchSimulator()
+{
+  setenv(TRANSPORT_ENV, "SIM", 1);
+  setenv(SIM_CONFIG_ENV, "cpcs=1,lpars=60", 0);
+
+  return openTransport() &&
+         resolveCPC((char *)"CPC1", &benchCpcUri, &benchCpcTarget) &&
+         resolveLPAR(benchCpcUri, benchCpcTarget, (char *)"LP01",
+                     &benchLparUri, &benchLparTarget);
+}
+
+int main(int argc, char **argv)
+{
+  double minSeconds = BENCH_MIN_SECONDS;
+  char **prefixes = argv + 1;
+  int prefixCount = argc - 1;
+  bool benchOk = true;
+  bool simulating = false;
+  BENCH_RESULT_TYPE result;
+
+  char *backendList = NULL;
+
+  while (prefixCount >= 2)
+  {
+    if (strcasecmp(prefixes[0], "-TIME") == 0)
+    {
+      minSeconds = atof(prefixes[1]);
+    }
+    else if (strcasecmp(prefixes[0], "-JSON") == 0)
+    {
+      backendList = prefixes[1];
+    }
+    else
+    {
+      break;
+    }
+    prefixes += 2;
+    prefixCount -= 2;
+  }
+
+  /* the first backend named is the one initialized up front */
+  char *backendName = backendList != NULL ? strtok(backendList, ",") : NULL;
+  if (backendName != NULL)
+  {
+    setenv(JSON_BACKEND_ENV, backendName, 1);
+  }
+
+  if (!init_parser())
+  {
+    printf("Failed to initialize parser\n");
+    return -1;
+  }
+
+  if (!buildJobBody(&jobBody) || !buildListBody(&list1MB) ||
+      !buildListBody(&list5MB) || !buildListBody(&list15MB) ||
+      !buildPropsBody(&propsBody) || !buildSamplesBody(&samples1MB) ||
+      !buildErrorBody(&errorBody))
+  {
+    printf("ERROR: unable to build the canned response bodies\n");
+    do_cleanup();
+    return -1;
+  }
+
+  for (int i = 0; i < benchCaseCount && benchOk; i++)
+  {
+    if (benchCases[i].body == NULL &&
+        selected(benchCases[i].name, prefixes, prefixCount))
+    {
+      simulating = true;
+      benchOk = openBenchSimulator();
+      break;
+    }
+  }
+
+  while (benchOk)
+  {
+    printf("\n*>>BENCHMARK (at least %.1f seconds per case), "
+           "JSON backend %s",
+           minSeconds, json_backend_name());
+    if (strcmp(json_backend_name(), indexBackend.name) == 0)
+    {
+      printf(" (%s)", structuralClassifier());
+    }
+    printf(":\n");
+    printf("%-16s %9s %8s %14s %12s %9s %9s %11s\n", "CASE", "BYTES",
+           "ITER", "NS/OP", "ALLOC B/OP", "ALLOCS/OP", "GB/S",
+           "PEAK RSS KB");
+
+    for (int i = 0; i < benchCaseCount && benchOk; i++)
+    {
+      if (!selected(benchCases[i].name, prefixes, prefixCount))
+      {
+        continue;
+      }
+
+      if (runCase(&benchCases[i], minSeconds, &result))
+      {
+        printResult(&benchCases[i], &result);
+      }
+      else
+      {
+        benchOk = false;
+      }
+    }
+
+    /* switch to the next backend named */
+    backendName = backendName != NULL ? strtok(NULL, ",") : NULL;
+    if (backendName == NULL)
+    {
+      break;
+    }
+
+    setenv(JSON_BACKEND_ENV, backendName, 1);
+    do_cleanup();
+    benchOk = benchOk && init_parser();
+  }
+
+  if (simulating)
+  {
+    closeTransport();
+  }
+
+  free(jobBody.text);
+  free(list1MB.text);
+  free(list5MB.text);
+  free(list15MB.text);
+  free(propsBody.text);
+  free(samples1MB.text);
+  free(errorBody.text);
+  freeResponseBuffers();
+  do_cleanup();
+
+  return benchOk ? 0 : -1;
+}
@@ -0,0 +1,292 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    MODULE NAME= HWIRBUFP                                            *
+ *                                                                     *
+ *  Sample C code that manages a pool of HWIREST response buffers so   *
+ *  the response body, response date and request id data areas can     *
+ *  be re-used across requests instead of being allocated and          *
+ *  cleared for every call.                                            *
+ *                                                                     *
+ *************************END OF SPECIFICATIONS************************/
+#pragma filetag("IBM-1047")     /* compile in EBCDIC */
+#pragma csect(code, "HWIRBUFP") /* name of csect */
+#pragma longName
+#if defined(__MVS__) && !defined(_OPEN_THREADS) && !defined(_UNIX03_THREADS)
+#define _OPEN_THREADS /* the pool is shared by threads */
+#endif
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <hwicic.h> /* BCPii interface declaration file */
+#include "hwirbufp.h"
+
+/* body capacity for each size class */
+static const int sizeClassLen[RESPBUF_CLASSES] = {
+    RESPBUF_SMALL_LEN,
+    RESPBUF_LARGE_LEN};
+
+/* idle buffers, one list per size class */
+static RESPBUF_TYPE *idleList[RESPBUF_CLASSES];
+static int idleCount[RESPBUF_CLASSES];
+
+static RESPBUF_STATS_TYPE poolStats;
+
+/* guards the idle lists and the counters */
+static pthread_mutex_t poolLock = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+ * Method: clearUsed
+ *
+ * Clear only the bytes that the previous response wrote into the
+ * data areas of the buffer. Everything past those lengths is still
+ * zero from the initial allocation.
+ */
+static void clearUsed(RESPBUF_TYPE *buf)
+{
+  memset(buf->responseBody, 0, buf->bodyUsed);
+  memset(buf->responseDate, 0, buf->dateUsed);
+  memset(buf->requestId, 0, buf->requestIdUsed);
+
+  buf->bodyUsed = 0;
+  buf->dateUsed = 0;
+  buf->requestIdUsed = 0;
+}
+
+/*
+ * Method: acquireResponseBuffer
+ *
+ * Hand out a cleared buffer of the requested size class. An idle
+ * buffer is re-used when one is available (pool hit), otherwise a new
+ * one is allocated (pool miss).
+ *
+ * input arguments: RESPBUF_SMALL or RESPBUF_LARGE
+ * output: buffer, or NULL if storage could not be obtained
+ */
+RESPBUF_TYPE *acquireResponseBuffer(int sizeClass)
+{
+  RESPBUF_TYPE *buf = NULL;
+
+  if (sizeClass < 0 || sizeClass >= RESPBUF_CLASSES)
+  {
+    printf("acquireResponseBuffer ERROR: unknown size class %d\n",
+           sizeClass);
+    return NULL;
+  }
+
+  pthread_mutex_lock(&poolLock);
+  if (idleList[sizeClass] != NULL)
+  {
+    buf = idleList[sizeClass];
+    idleList[sizeClass] = buf->next;
+    idleCount[sizeClass]--;
+    poolStats.hits[sizeClass]++;
+    poolStats.bytesZeroed += buf->bodyUsed + buf->dateUsed +
+                             buf->requestIdUsed;
+  }
+  else
+  {
+    poolStats.misses[sizeClass]++;
+  }
+  pthread_mutex_unlock(&poolLock);
+
+  if (buf != NULL)
+  {
+    clearUsed(buf);
+  }
+  else
+  {
+    buf = (RESPBUF_TYPE *)calloc(1, sizeof(RESPBUF_TYPE));
+    if (buf == NULL)
+    {
+      printf("acquireResponseBuffer ERROR: out of storage\n");
+      return NULL;
+    }
+
+    /* calloc hands back zeroed storage, the extra byte
+       guarantees a NUL terminator for a full body
+    */
+    buf->responseBody = (char *)calloc(1, sizeClassLen[sizeClass] + 1);
+    if (buf->responseBody == NULL)
+    {
+      printf("acquireResponseBuffer ERROR: out of storage\n");
+      free(buf);
+      return NULL;
+    }
+
+    buf->sizeClass = sizeClass;
+    buf->capacity = sizeClassLen[sizeClass];
+  }
+
+  buf->next = NULL;
+  return buf;
+}
+
+/*
+ * Method: attachResponseBuffer
+ *
+ * Initialize the response structure with the address and
+ * length of the data areas owned by the buffer.
+ */
+void attachResponseBuffer(RESPBUF_TYPE *buf, RESPONSE_PARM_TYPE *response)
+{
+  response->responseBody = buf->responseBody;
+  response->responseBodyLen = buf->capacity;
+  response->responseDate = buf->responseDate;
+  response->responseDateLen = RESPBUF_SIDELEN;
+  response->requestId = buf->requestId;
+  response->requestIdLen = RESPBUF_SIDELEN;
+}
+
+/*
+ * Method: completeResponseBuffer
+ *
+ * Record how much of each data area the service wrote so that the
+ * next user of the buffer only clears those bytes, and NUL terminate
+ * the body for the parser. The body of a failed request is decoded
+ * into the error record of the buffer.
+ */
+void completeResponseBuffer(RESPBUF_TYPE *buf, RESPONSE_PARM_TYPE *response)
+{
+  int bodyLen = response->responseBodyLen;
+
+  /* a length outside the data area means we can't trust
+     it, so assume the whole area was touched
+  */
+  if (bodyLen < 0 || bodyLen > buf->capacity)
+  {
+    bodyLen = buf->capacity;
+  }
+
+  buf->bodyUsed = bodyLen;
+  buf->responseBody[bodyLen] = '\0';
+
+  buf->dateUsed = (response->responseDateLen >= 0 &&
+                   response->responseDateLen <= RESPBUF_SIDELEN)
+                      ? response->responseDateLen
+                      : RESPBUF_SIDELEN;
+  buf->requestIdUsed = (response->requestIdLen >= 0 &&
+                        response->requestIdLen <= RESPBUF_SIDELEN)
+                           ? response->requestIdLen
+                           : RESPBUF_SIDELEN;
+
+  if (response->httpStatus > 199 && response->httpStatus < 300)
+  {
+    memset(&buf->error, 0, sizeof(RESPONSE_ERROR_TYPE));
+  }
+  else
+  {
+    scanErrorBody(buf->responseBody, bodyLen, &buf->error);
+
+    /* a record is there for every failure, even without a body */
+    if (!(buf->error.found & ERROR_FOUND_HTTP_STATUS))
+    {
+      buf->error.httpStatus = response->httpStatus;
+      buf->error.found |= ERROR_FOUND_HTTP_STATUS;
+    }
+  }
+}
+
+/*
+ * Method: releaseResponseBuffer
+ *
+ * Return a buffer to the pool. Everything allocated from its arena
+ * is given back at once. Buffers beyond RESPBUF_MAX_IDLE for the
+ * size class are freed instead of being kept.
+ */
+void releaseResponseBuffer(RESPBUF_TYPE *buf)
+{
+  if (buf == NULL)
+  {
+    return;
+  }
+
+  resetArena(&buf->arena);
+
+  pthread_mutex_lock(&poolLock);
+  if (idleCount[buf->sizeClass] < RESPBUF_MAX_IDLE)
+  {
+    buf->next = idleList[buf->sizeClass];
+    idleList[buf->sizeClass] = buf;
+    idleCount[buf->sizeClass]++;
+    buf = NULL;
+  }
+  pthread_mutex_unlock(&poolLock);
+
+  if (buf != NULL)
+  {
+    freeArena(&buf->arena);
+    free(buf->responseBody);
+    free(buf);
+  }
+}
+
+/*
+ * Method: getResponseBufferStats
+ *
+ * Copy out the pool hit, miss and bytes zeroed counters.
+ */
+void getResponseBufferStats(RESPBUF_STATS_TYPE *stats)
+{
+  pthread_mutex_lock(&poolLock);
+  memcpy(stats, &poolStats, sizeof(RESPBUF_STATS_TYPE));
+  pthread_mutex_unlock(&poolLock);
+}
+
+/*
+ * Method: printResponseBufferStats
+ *
+ * Print the pool counters.
+ */
+void printResponseBufferStats()
+{
+  RESPBUF_STATS_TYPE stats;
+
+  getResponseBufferStats(&stats);
+  printf("*>>response buffer pool: small hits %lu misses %lu, "
+         "large hits %lu misses %lu, bytes zeroed %llu\n",
+         stats.hits[RESPBUF_SMALL], stats.misses[RESPBUF_SMALL],
+         stats.hits[RESPBUF_LARGE], stats.misses[RESPBUF_LARGE],
+         stats.bytesZeroed);
+}
+
+/*
+ * Method: freeResponseBuffers
+ *
+ * Free every idle buffer held by the pool.
+ */
+void freeResponseBuffers()
+{
+  pthread_mutex_lock(&poolLock);
+  for (int i = 0; i < RESPBUF_CLASSES; i++)
+  {
+    while (idleList[i] != NULL)
+    {
+      RESPBUF_TYPE *buf = idleList[i];
+      idleList[i] = buf->next;
+      freeArena(&buf->arena);
+      free(buf->responseBody);
+      free(buf);
+    }
+    idleCount[i] = 0;
+  }
+  pthread_mutex_unlock(&poolLock);
+}
@@ -0,0 +1,581 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    MODULE NAME= HWIRCACH                                            *
+ *                                                                     *
+ *  Sample C code that keeps the object-uri and target-name of CPCs    *
+ *  and LPARs in a memory mapped file, so later runs can skip the      *
+ *  List CPC Objects and List Logical Partitions of CPC requests.      *
+ *  Entries expire after a time to live and are invalidated when a     *
+ *  request using them fails with HTTP status 404 or a BCPii error.    *
+ *                                                                     *
+ *************************END OF SPECIFICATIONS************************/
+#pragma filetag("IBM-1047")     /* compile in EBCDIC */
+#pragma csect(code, "HWIRCACH") /* name of csect */
+#pragma longName
+#if defined(__MVS__) && !defined(_OPEN_THREADS) && !defined(_UNIX03_THREADS)
+#define _OPEN_THREADS /* the cache is shared by threads */
+#endif
+#include <stdlib.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <hwicic.h> /* BCPii interface declaration file */
+#include "hwircach.h"
+
+static const size_t cacheFileLen = sizeof(CACHE_HEADER_TYPE) +
+                                   CACHE_SLOTS * sizeof(CACHE_SLOT_TYPE);
+
+/* deleted and expired slots are compacted away once a store would
+   leave fewer empty slots than this, and no new entry takes an empty
+   slot past it, so that every probe ends at an empty slot early
+*/
+static const int minEmptySlots = CACHE_SLOTS / 8;
+
+static CACHE_HEADER_TYPE *cacheHeader = NULL;
+static CACHE_SLOT_TYPE *cacheSlots = NULL;
+static long long cacheTtl = CACHE_DEFAULT_TTL;
+
+/* kept open for the record lock that serializes the jobs sharing the
+   file, closing any descriptor of the file would release it
+*/
+static int cacheFd = -1;
+
+/* guards the slots, requests of concurrent threads may invalidate
+   entries while others are looked up
+*/
+static pthread_mutex_t cacheLock = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+ * Method: lockCacheFile
+ *
+ * Lock the whole cache file against the other jobs mapping it,
+ * F_RDLCK to read the slots or F_WRLCK to change them, F_UNLCK to
+ * release it. The record lock is per process, the threads of this
+ * one are serialized by cacheLock.
+ */
+static void lockCacheFile(short lockType)
+{
+  struct flock lock;
+
+  memset(&lock, 0, sizeof(lock));
+  lock.l_type = lockType;
+  lock.l_whence = SEEK_SET;
+  lock.l_start = 0;
+  lock.l_len = 0; /* to the end of the file */
+
+  while (fcntl(cacheFd, F_SETLKW, &lock) != 0 && errno == EINTR)
+  {
+  }
+}
+
+/*
+ * Method: cacheHash
+ *
+ * FNV-1a hash of the scope and name, never zero.
+ */
+static unsigned int cacheHash(const char *scope, const char *name)
+{
+  unsigned int hash = 2166136261u;
+
+  for (const char *c = scope; *c != '\0'; c++)
+  {
+    hash = (hash ^ (unsigned char)*c) * 16777619u;
+  }
+  hash = (hash ^ '.') * 16777619u;
+  for (const char *c = name; *c != '\0'; c++)
+  {
+    hash = (hash ^ (unsigned char)*c) * 16777619u;
+  }
+
+  return hash != 0 ? hash : 1;
+}
+
+/*
+ * Method: openResolutionCache
+ *
+ * Map the cache file named by HWIRSTC1_CACHE into storage, creating
+ * it when it does not exist yet. Nothing is read up front, lookups
+ * go straight to the mapped hash table. Without the environment
+ * variable the cache is disabled.
+ */
+bool openResolutionCache()
+{
+  struct stat fileInfo;
+
+  char *path = getenv(CACHE_PATH_ENV);
+  if (path == NULL || path[0] == '\0')
+  {
+    return false;
+  }
+
+  char *ttl = getenv(CACHE_TTL_ENV);
+  if (ttl != NULL && atoll(ttl) > 0)
+  {
+    cacheTtl = atoll(ttl);
+  }
+
+  int fd = open(path, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+  if (fd < 0)
+  {
+    printf("openResolutionCache ERROR: unable to open %s\n", path);
+    return false;
+  }
+
+  if (fstat(fd, &fileInfo) != 0 ||
+      ((size_t)fileInfo.st_size < cacheFileLen &&
+       ftruncate(fd, cacheFileLen) != 0))
+  {
+    printf("openResolutionCache ERROR: unable to size %s\n", path);
+    close(fd);
+    return false;
+  }
+
+  void *mapping = mmap(NULL, cacheFileLen, PROT_READ | PROT_WRITE,
+                       MAP_SHARED, fd, 0);
+
+  if (mapping == MAP_FAILED)
+  {
+    printf("openResolutionCache ERROR: unable to map %s\n", path);
+    close(fd);
+    return false;
+  }
+  cacheFd = fd;
+
+  cacheHeader = (CACHE_HEADER_TYPE *)mapping;
+  cacheSlots = (CACHE_SLOT_TYPE *)((char *)mapping +
+                                   sizeof(CACHE_HEADER_TYPE));
+
+  /* new file, or one written by a different layout, the other jobs
+     wait for the reset before they read the header or any slot
+  */
+  lockCacheFile(F_WRLCK);
+  if (memcmp(cacheHeader->eyecatcher, CACHE_EYECATCHER, 8) != 0 ||
+      cacheHeader->version != CACHE_VERSION ||
+      cacheHeader->slotCount != CACHE_SLOTS)
+  {
+    memset(mapping, 0, cacheFileLen);
+    memcpy(cacheHeader->eyecatcher, CACHE_EYECATCHER, 8);
+    cacheHeader->version = CACHE_VERSION;
+    cacheHeader->slotCount = CACHE_SLOTS;
+  }
+  lockCacheFile(F_UNLCK);
+
+  return true;
+}
+
+/*
+ * Method: closeResolutionCache
+ *
+ * Write the cache back to its file and unmap it.
+ */
+void closeResolutionCache()
+{
+  if (cacheHeader == NULL)
+  {
+    return;
+  }
+
+  msync(cacheHeader, cacheFileLen, MS_SYNC);
+  munmap(cacheHeader, cacheFileLen);
+  close(cacheFd);
+  cacheHeader = NULL;
+  cacheSlots = NULL;
+  cacheFd = -1;
+}
+
+/*
+ * Method: findSlot
+ *
+ * Linear probe for the slot holding scope and name. Compaction keeps
+ * empty slots in the table, so a miss ends at the first one.
+ *
+ * returns: the slot, or NULL if the entry is not cached
+ */
+static CACHE_SLOT_TYPE *findSlot(const char *scope, const char *name,
+                                 unsigned int hash)
+{
+  for (int probe = 0; probe < CACHE_SLOTS; probe++)
+  {
+    CACHE_SLOT_TYPE *slot = &cacheSlots[(hash + probe) & (CACHE_SLOTS - 1)];
+
+    if (slot->state == CACHE_SLOT_EMPTY)
+    {
+      return NULL;
+    }
+    if (slot->state == CACHE_SLOT_USED && slot->hash == hash &&
+        strcmp(slot->scope, scope) == 0 && strcmp(slot->name, name) == 0)
+    {
+      return slot;
+    }
+  }
+
+  return NULL;
+}
+
+/*
+ * Method: slotExpired
+ *
+ * True when a used slot is older than the time to live.
+ */
+static bool slotExpired(CACHE_SLOT_TYPE *slot, long long now)
+{
+  return now - slot->storedAt > cacheTtl;
+}
+
+/*
+ * Method: compactSlots
+ *
+ * Rebuild the table from its valid entries. Deleted and expired
+ * slots become empty again and every entry moves back as close to
+ * its home slot as it can. Called with the file write locked.
+ */
+static void compactSlots(long long now)
+{
+  CACHE_SLOT_TYPE *valid =
+      (CACHE_SLOT_TYPE *)malloc(CACHE_SLOTS * sizeof(CACHE_SLOT_TYPE));
+  int validCount = 0;
+
+  if (valid == NULL)
+  {
+    return;
+  }
+
+  for (int i = 0; i < CACHE_SLOTS; i++)
+  {
+    if (cacheSlots[i].state == CACHE_SLOT_USED &&
+        !slotExpired(&cacheSlots[i], now))
+    {
+      valid[validCount++] = cacheSlots[i];
+    }
+  }
+
+  memset(cacheSlots, 0, CACHE_SLOTS * sizeof(CACHE_SLOT_TYPE));
+  for (int i = 0; i < validCount; i++)
+  {
+    int probe = valid[i].hash & (CACHE_SLOTS - 1);
+    while (cacheSlots[probe].state != CACHE_SLOT_EMPTY)
+    {
+      probe = (probe + 1) & (CACHE_SLOTS - 1);
+    }
+    cacheSlots[probe] = valid[i];
+  }
+  cacheHeader->usedCount = validCount;
+  cacheHeader->deletedCount = 0;
+
+  free(valid);
+}
+
+/*
+ * Method: cacheLookup
+ *
+ * Return copies of the cached uri and target name of a CPC (empty
+ * scope) or of an LPAR (scope is the CPC target name). Expired
+ * entries are not returned, stores reuse their slots.
+ *
+ * returns: true if a valid entry was found
+ */
+bool cacheLookup(const char *scope, const char *name,
+                 char **uri, char **targetName)
+{
+  if (cacheSlots == NULL || scope == NULL || name == NULL)
+  {
+    return false;
+  }
+
+  bool found = false;
+
+  pthread_mutex_lock(&cacheLock);
+  lockCacheFile(F_RDLCK);
+  CACHE_SLOT_TYPE *slot = findSlot(scope, name, cacheHash(scope, name));
+  if (slot != NULL && !slotExpired(slot, (long long)time(NULL)))
+  {
+    *uri = strdup(slot->uri);
+    *targetName = strdup(slot->targetName);
+    found = *uri != NULL && *targetName != NULL;
+  }
+  lockCacheFile(F_UNLCK);
+  pthread_mutex_unlock(&cacheLock);
+
+  return found;
+}
+
+/*
+ * Method: cacheStore
+ *
+ * Add or refresh the entry for a CPC or an LPAR. A new entry takes the
+ * first empty, deleted or expired slot of its probe sequence. Values
+ * that do not fit a slot are not cached.
+ */
+void cacheStore(const char *scope, const char *name,
+                const char *uri, const char *targetName)
+{
+  if (cacheSlots == NULL || scope == NULL || name == NULL ||
+      uri == NULL || targetName == NULL ||
+      strlen(scope) >= CACHE_SCOPELEN || strlen(name) >= CACHE_NAMELEN ||
+      strlen(uri) >= CACHE_URILEN || strlen(targetName) >= CACHE_TARGETLEN)
+  {
+    return;
+  }
+
+  unsigned int hash = cacheHash(scope, name);
+  long long now = (long long)time(NULL);
+
+  pthread_mutex_lock(&cacheLock);
+  lockCacheFile(F_WRLCK);
+  int emptyCount =
+      CACHE_SLOTS - cacheHeader->usedCount - cacheHeader->deletedCount;
+  if (emptyCount <= minEmptySlots)
+  {
+    compactSlots(now);
+    emptyCount = CACHE_SLOTS - cacheHeader->usedCount;
+  }
+
+  CACHE_SLOT_TYPE *slot = findSlot(scope, name, hash);
+
+  for (int probe = 0; slot == NULL && probe < CACHE_SLOTS; probe++)
+  {
+    CACHE_SLOT_TYPE *candidate =
+        &cacheSlots[(hash + probe) & (CACHE_SLOTS - 1)];
+    if (candidate->state == CACHE_SLOT_EMPTY && emptyCount <= minEmptySlots)
+    {
+      break;
+    }
+    else if (candidate->state != CACHE_SLOT_USED)
+    {
+      slot = candidate;
+      cacheHeader->usedCount++;
+      if (candidate->state == CACHE_SLOT_DELETED)
+      {
+        cacheHeader->deletedCount--;
+      }
+    }
+    else if (slotExpired(candidate, now))
+    {
+      slot = candidate;
+    }
+  }
+
+  /* when the table is full of valid entries nothing is stored, a
+     stale table is no worse than no table
+  */
+  if (slot != NULL)
+  {
+    memset(slot, 0, sizeof(CACHE_SLOT_TYPE));
+    slot->hash = hash;
+    slot->storedAt = now;
+    strcpy(slot->scope, scope);
+    strcpy(slot->name, name);
+    strcpy(slot->uri, uri);
+    strcpy(slot->targetName, targetName);
+    slot->state = CACHE_SLOT_USED;
+  }
+  lockCacheFile(F_UNLCK);
+  pthread_mutex_unlock(&cacheLock);
+}
+
+/*
+ * Method: cacheInvalidate
+ *
+ * Drop every entry whose uri is the request uri or a prefix of it,
+ * or whose target name (or scope) is the request target name.
+ *
+ * returns: number of entries dropped
+ */
+int cacheInvalidate(const char *uri, int uriLen,
+                    const char *targetName, int targetNameLen)
+{
+  int dropped = 0;
+
+  if (cacheSlots == NULL)
+  {
+    return 0;
+  }
+
+  pthread_mutex_lock(&cacheLock);
+  lockCacheFile(F_WRLCK);
+  for (int i = 0; i < CACHE_SLOTS; i++)
+  {
+    CACHE_SLOT_TYPE *slot = &cacheSlots[i];
+    if (slot->state != CACHE_SLOT_USED)
+    {
+      continue;
+    }
+
+    bool match = false;
+    int slotUriLen = strlen(slot->uri);
+
+    if (uri != NULL && slotUriLen <= uriLen &&
+        memcmp(slot->uri, uri, slotUriLen) == 0 &&
+        (slotUriLen == uriLen || uri[slotUriLen] == '/' ||
+         uri[slotUriLen] == '?'))
+    {
+      match = true;
+    }
+    else if (targetName != NULL && targetNameLen > 0 &&
+             ((strlen(slot->targetName) == (size_t)targetNameLen &&
+               memcmp(slot->targetName, targetName, targetNameLen) == 0) ||
+              (strlen(slot->scope) == (size_t)targetNameLen &&
+               memcmp(slot->scope, targetName, targetNameLen) == 0)))
+    {
+      match = true;
+    }
+
+    if (match)
+    {
+      slot->state = CACHE_SLOT_DELETED;
+      cacheHeader->usedCount--;
+      cacheHeader->deletedCount++;
+      dropped++;
+    }
+  }
+  lockCacheFile(F_UNLCK);
+  pthread_mutex_unlock(&cacheLock);
+
+  return dropped;
+}
+
+/*
+ * Method: isBCPiiError
+ *
+ * Look for "bcpii-error":true in a failure response body without
+ * using the parser, so the caller's parsed document is left alone.
+ */
+static bool isBCPiiError(const char *body, int bodyLen)
+{
+  static const char key[] = "\"bcpii-error\"";
+  int keyLen = sizeof(key) - 1;
+
+  /* error bodies are small, don't scan a large unrelated body */
+  if (bodyLen > 65536)
+  {
+    bodyLen = 65536;
+  }
+
+  for (int i = 0; i + keyLen <= bodyLen; i++)
+  {
+    if (memcmp(body + i, key, keyLen) != 0)
+    {
+      continue;
+    }
+
+    int pos = i + keyLen;
+    while (pos < bodyLen && (body[pos] == ' ' || body[pos] == ':' ||
+                             body[pos] == '\t'))
+    {
+      pos++;
+    }
+    return pos + 4 <= bodyLen && memcmp(body + pos, "true", 4) == 0;
+  }
+
+  return false;
+}
+
+/*
+ * Method: isResolutionUri
+ *
+ * True for the uris a 404 of which means a cached CPC or LPAR is
+ * gone: the CPC list, a CPC, its LPAR list or its operations, and an
+ * LPAR or anything below it. A 404 of another resource of a CPC,
+ * e.g. a group or a profile that does not exist, says nothing about
+ * the CPC or its LPARs.
+ */
+static bool isResolutionUri(const char *uri, int uriLen)
+{
+  static const char cpcs[] = "/api/cpcs";
+  static const char lpars[] = "/api/logical-partitions/";
+  int pathLen = 0;
+
+  while (pathLen < uriLen && uri[pathLen] != '?')
+  {
+    pathLen++;
+  }
+
+  if (pathLen >= (int)sizeof(lpars) - 1 &&
+      memcmp(uri, lpars, sizeof(lpars) - 1) == 0)
+  {
+    return true;
+  }
+  if (pathLen < (int)sizeof(cpcs) - 1 ||
+      memcmp(uri, cpcs, sizeof(cpcs) - 1) != 0)
+  {
+    return false;
+  }
+  if (pathLen == (int)sizeof(cpcs) - 1)
+  {
+    return true;
+  }
+
+  if (uri[sizeof(cpcs) - 1] != '/')
+  {
+    return false;
+  }
+
+  /* past /api/cpcs/{cpc-id} */
+  const char *rest = (const char *)memchr(uri + sizeof(cpcs), '/',
+                                          pathLen - sizeof(cpcs));
+  if (rest == NULL)
+  {
+    return true;
+  }
+
+  int restLen = pathLen - (rest - uri);
+  return (restLen == 19 && memcmp(rest, "/logical-partitions", 19) == 0) ||
+         (restLen > 12 && memcmp(rest, "/operations/", 12) == 0);
+}
+
+/*
+ * Method: cacheCheckResponse
+ *
+ * Called after every request. A 404 of a CPC or LPAR resolution uri,
+ * or a failure flagged by BCPii (e.g. the target name is no longer
+ * known), means cached values for the request uri or target name may
+ * be stale, so they are dropped.
+ */
+void cacheCheckResponse(REQUEST_PARM_TYPE *request,
+                        RESPONSE_PARM_TYPE *response)
+{
+  if (cacheSlots == NULL ||
+      (response->httpStatus > 199 && response->httpStatus < 300))
+  {
+    return;
+  }
+
+  if ((response->httpStatus == 404 &&
+       isResolutionUri(request->uri, request->uriLen)) ||
+      (response->responseBody != NULL && response->responseBodyLen > 0 &&
+       isBCPiiError((char *)response->responseBody,
+                    response->responseBodyLen)))
+  {
+    int dropped = cacheInvalidate(request->uri, request->uriLen,
+                                  request->targetName,
+                                  request->targetNameLen);
+    if (dropped > 0)
+    {
+      printf("*>>%d resolution cache entries invalidated\n", dropped);
+    }
+  }
+}
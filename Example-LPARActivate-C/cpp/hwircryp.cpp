@@ -0,0 +1,607 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    MODULE NAME= HWIRCRYP                                            *
+ *                                                                     *
+ *  Sample C code that uses HWIREST API to take the crypto inventory   *
+ *  of a CPC, as RXCRYPT1 does. The image activation profiles of its   *
+ *  LPARs are read by a bounded number of worker threads, their crypto *
+ *  assignments decoded into sets of adapters and domains, and the     *
+ *  LPARs sharing a domain on an adapter are then found from those     *
+ *  sets without further requests.                                     *
+ *                                                                     *
+ *************************END OF SPECIFICATIONS************************/
+#pragma filetag("IBM-1047")     /* compile in EBCDIC */
+#pragma csect(code, "HWIRCRYP") /* name of csect */
+#pragma longName
+#if defined(__MVS__) && !defined(_OPEN_THREADS) && !defined(_UNIX03_THREADS)
+#define _OPEN_THREADS /* pthread_create of the profile workers */
+#endif
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include "hwijprs.h"
+#include "hwijbind.h"
+#include "hwirstc1.h"
+#include "hwircryp.h"
+#include "hwirlidx.h"
+#include "hwirproj.h"
+
+/* the properties of RXCRYPT1 PrepCryptoAttrs, binding them gives the
+   properties= projection of the query
+*/
+static const JSON_BINDING_TYPE queryBindings[] = {
+    BIND_FIELD(CRYPTO_QUERY_TYPE, counterAuthorization,
+               "crypto-activity-cpu-counter-authorization-control",
+               BIND_BOOL),
+    BIND_FIELD(CRYPTO_QUERY_TYPE, domains, "assigned-crypto-domains",
+               BIND_PRESENT),
+    BIND_FIELD(CRYPTO_QUERY_TYPE, cryptos, "assigned-cryptos",
+               BIND_PRESENT)};
+
+/* the entries read by RXCRYPT1 getAssignedCryptos */
+static const JSON_BINDING_TYPE cryptoBindings[] = {
+    BIND_FIELD(CRYPTO_ASSIGNMENT_TYPE, number, "number", BIND_INT),
+    BIND_FIELD(CRYPTO_ASSIGNMENT_TYPE, mode, "activation-type", BIND_CHARS)};
+
+/* the entries read by RXCRYPT1 getAssignedDomains */
+static const JSON_BINDING_TYPE domainBindings[] = {
+    BIND_FIELD(CRYPTO_ASSIGNMENT_TYPE, number, "domain-index", BIND_INT),
+    BIND_FIELD(CRYPTO_ASSIGNMENT_TYPE, mode, "access-mode", BIND_CHARS)};
+
+/* schemas compiled once */
+static JSON_SCHEMA_TYPE *querySchema = compileSchema(queryBindings, 3);
+static JSON_SCHEMA_TYPE *cryptoSchema = compileSchema(cryptoBindings, 2);
+static JSON_SCHEMA_TYPE *domainSchema = compileSchema(domainBindings, 2);
+
+/* guards the handing out of profiles and the failure count */
+static pthread_mutex_t cryptoLock = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+ * Method: addToSet
+ */
+static void addToSet(CRYPTO_SET_TYPE *set, int number)
+{
+  set->bits[number / 64] |= 1ULL << (number % 64);
+}
+
+/*
+ * Method: inSet
+ */
+static bool inSet(const CRYPTO_SET_TYPE *set, int number)
+{
+  return (set->bits[number / 64] >> (number % 64)) & 1;
+}
+
+/*
+ * Method: nowMicros
+ */
+static long long nowMicros()
+{
+  struct timeval now;
+  gettimeofday(&now, NULL);
+  return (long long)now.tv_sec * 1000000 + now.tv_usec;
+}
+
+/*
+ * Method: addProfile
+ *
+ * Add the image activation profile of an LPAR to the inventory, the
+ * profile of the same name as the LPAR as RXCRYPT1 assumes.
+ */
+static bool addProfile(CRYPTO_INVENTORY_TYPE *inventory,
+                       LPAR_INFO_TYPE *lpar)
+{
+  if (inventory->profileCount == inventory->profileCapacity)
+  {
+    int newCapacity = inventory->profileCapacity > 0
+                          ? inventory->profileCapacity * 2
+                          : 64;
+    CRYPTO_PROFILE_TYPE *profiles = (CRYPTO_PROFILE_TYPE *)realloc(
+        inventory->profiles, newCapacity * sizeof(CRYPTO_PROFILE_TYPE));
+    if (profiles == NULL)
+    {
+      printf("crypto ERROR: out of storage\n");
+      return false;
+    }
+    inventory->profiles = profiles;
+    inventory->profileCapacity = newCapacity;
+  }
+
+  CRYPTO_PROFILE_TYPE *profile =
+      &inventory->profiles[inventory->profileCount];
+  memset(profile, 0, sizeof(CRYPTO_PROFILE_TYPE));
+
+  /* <cpc-uri>/image-activation-profiles/<LPAR name> */
+  int uriLen = strlen(inventory->cpcUri) + strlen(lpar->name) + 32;
+  profile->name = strdup(lpar->name);
+  profile->uri = (char *)malloc(uriLen);
+  if (profile->name == NULL || profile->uri == NULL)
+  {
+    printf("crypto ERROR: out of storage\n");
+    free(profile->name);
+    free(profile->uri);
+    return false;
+  }
+  snprintf(profile->uri, uriLen, "%s/image-activation-profiles/%s",
+           inventory->cpcUri, lpar->name);
+  inventory->profileCount++;
+
+  return true;
+}
+
+/*
+ * Method: listProfiles
+ *
+ * Take the profiles of the LPARs of the CPC in lparStatus, from the
+ * LPAR index of the CPC, as RXCRYPT1 does from getLPARList.
+ */
+static bool listProfiles(CRYPTO_INVENTORY_TYPE *inventory,
+                         const char *lparStatus)
+{
+  LPAR_INDEX_TYPE *index = findLPARIndex(inventory->cpcTargetName);
+  if (index == NULL)
+  {
+    index = indexLPARs(inventory->cpcUri, inventory->cpcTargetName);
+  }
+  if (index == NULL)
+  {
+    printf("crypto ERROR: unable to list the LPARs of CPC %s\n",
+           inventory->cpcName);
+    return false;
+  }
+
+  for (int i = 0; i < index->lparCount; i++)
+  {
+    LPAR_INFO_TYPE *lpar = &index->lpars[i];
+
+    if (lpar->status != NULL && strcasecmp(lpar->status, lparStatus) == 0 &&
+        !addProfile(inventory, lpar))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/*
+ * Method: readProfile
+ *
+ * GET the crypto assignment of a profile, as RXCRYPT1 QueryCrypto
+ * does, and decode it into its sets. Domains without an access mode
+ * are taken as usage domains.
+ */
+static bool readProfile(CRYPTO_INVENTORY_TYPE *inventory,
+                        CRYPTO_PROFILE_TYPE *profile)
+{
+  CRYPTO_ASSIGNMENT_TYPE assignment;
+  CRYPTO_QUERY_TYPE query;
+
+  RESPBUF_TYPE *respBuf = acquireResponseBuffer(RESPBUF_SMALL);
+  if (respBuf == NULL)
+  {
+    return false;
+  }
+
+  /* GET <profile-uri>?properties=...&cached-acceptable=true */
+  memset(&query, 0, sizeof(CRYPTO_QUERY_TYPE));
+  if (queryBoundObject(profile->uri, inventory->cpcTargetName,
+                       "image activation profile", querySchema, 0,
+                       cachedAcceptable, respBuf, &query) >= 0)
+  {
+    profile->counterAuthorization = query.counterAuthorization;
+
+    HWTJ_HANDLE_TYPE cryptos =
+        query.cryptos ? find_array(0, (char *)"assigned-cryptos") : 0;
+    int count = cryptos != 0 ? getnumberOfEntries(cryptos) : 0;
+
+    for (int i = 0; i < count; i++)
+    {
+      memset(&assignment, 0, sizeof(CRYPTO_ASSIGNMENT_TYPE));
+      if ((bindObject(cryptoSchema, getArrayEntry(cryptos, i), NULL,
+                      &assignment) & 0x01) &&
+          assignment.number >= 0 && assignment.number < CRYPTO_MAX_ADAPTERS)
+      {
+        addToSet(&profile->adapters, assignment.number);
+        if (strcmp(assignment.mode, "candidate") == 0)
+        {
+          addToSet(&profile->candidateAdapters, assignment.number);
+        }
+      }
+    }
+
+    HWTJ_HANDLE_TYPE domains =
+        query.domains ? find_array(0, (char *)"assigned-crypto-domains")
+                      : 0;
+    count = domains != 0 ? getnumberOfEntries(domains) : 0;
+
+    for (int i = 0; i < count; i++)
+    {
+      memset(&assignment, 0, sizeof(CRYPTO_ASSIGNMENT_TYPE));
+      if ((bindObject(domainSchema, getArrayEntry(domains, i), NULL,
+                      &assignment) & 0x01) &&
+          assignment.number >= 0 && assignment.number < CRYPTO_MAX_DOMAINS)
+      {
+        addToSet(strcmp(assignment.mode, "control") == 0
+                     ? &profile->controlDomains
+                     : &profile->usageDomains,
+                 assignment.number);
+      }
+    }
+
+    profile->fetched = true;
+  }
+
+  releaseResponseBuffer(respBuf);
+
+  return profile->fetched;
+}
+
+/*
+ * Method: profileWorker
+ *
+ * Read the next profile of the inventory until all have been taken.
+ */
+static void *profileWorker(void *data)
+{
+  CRYPTO_INVENTORY_TYPE *inventory = (CRYPTO_INVENTORY_TYPE *)data;
+
+  while (true)
+  {
+    pthread_mutex_lock(&cryptoLock);
+    if (inventory->next >= inventory->profileCount)
+    {
+      pthread_mutex_unlock(&cryptoLock);
+      break;
+    }
+    CRYPTO_PROFILE_TYPE *profile = &inventory->profiles[inventory->next++];
+    pthread_mutex_unlock(&cryptoLock);
+
+    if (!readProfile(inventory, profile))
+    {
+      pthread_mutex_lock(&cryptoLock);
+      inventory->failed++;
+      pthread_mutex_unlock(&cryptoLock);
+    }
+  }
+
+  return NULL;
+}
+
+/*
+ * Method: indexProfiles
+ *
+ * Build the set of profiles of each adapter and usage domain.
+ */
+static bool indexProfiles(CRYPTO_INVENTORY_TYPE *inventory)
+{
+  int words = (inventory->profileCount + 63) / 64;
+
+  inventory->lparWords = words;
+  inventory->adapterLpars = (unsigned long long *)calloc(
+      CRYPTO_MAX_ADAPTERS * words, sizeof(unsigned long long));
+  inventory->domainLpars = (unsigned long long *)calloc(
+      CRYPTO_MAX_DOMAINS * words, sizeof(unsigned long long));
+  if (inventory->adapterLpars == NULL || inventory->domainLpars == NULL)
+  {
+    return false;
+  }
+
+  for (int p = 0; p < inventory->profileCount; p++)
+  {
+    CRYPTO_PROFILE_TYPE *profile = &inventory->profiles[p];
+    unsigned long long bit = 1ULL << (p % 64);
+
+    for (int a = 0; a < CRYPTO_MAX_ADAPTERS; a++)
+    {
+      if (inSet(&profile->adapters, a))
+      {
+        inventory->adapterLpars[a * words + p / 64] |= bit;
+      }
+    }
+    for (int d = 0; d < CRYPTO_MAX_DOMAINS; d++)
+    {
+      if (inSet(&profile->usageDomains, d))
+      {
+        inventory->domainLpars[d * words + p / 64] |= bit;
+      }
+    }
+  }
+
+  return true;
+}
+
+/*
+ * Method: buildCryptoInventory
+ *
+ * Resolve the CPC, list its LPARs and read the image activation
+ * profiles of those in lparStatus with up to maxWorkers threads.
+ *
+ * returns: true if every profile was read
+ */
+bool buildCryptoInventory(CRYPTO_INVENTORY_TYPE *inventory, char *cpcName,
+                          const char *lparStatus, int maxWorkers)
+{
+  memset(inventory, 0, sizeof(CRYPTO_INVENTORY_TYPE));
+  inventory->cpcName = cpcName;
+
+  if (!resolveCPC(cpcName, &inventory->cpcUri, &inventory->cpcTargetName) ||
+      !listProfiles(inventory, lparStatus))
+  {
+    return false;
+  }
+
+  int workers = maxWorkers < inventory->profileCount
+                    ? maxWorkers
+                    : inventory->profileCount;
+  runRequestWorkers("crypto", workers, profileWorker, inventory);
+
+  return indexProfiles(inventory) && inventory->failed == 0;
+}
+
+/*
+ * Method: findSharingLPARs
+ *
+ * Find the profiles that use domain on adapter, from the sets built
+ * by buildCryptoInventory.
+ *
+ * returns: number of profiles, the first maxProfiles of their indexes
+ *          are stored in profiles
+ */
+int findSharingLPARs(CRYPTO_INVENTORY_TYPE *inventory, int adapter,
+                     int domain, int *profiles, int maxProfiles)
+{
+  int found = 0;
+
+  if (adapter < 0 || adapter >= CRYPTO_MAX_ADAPTERS || domain < 0 ||
+      domain >= CRYPTO_MAX_DOMAINS || inventory->adapterLpars == NULL)
+  {
+    return 0;
+  }
+
+  unsigned long long *adapterSet =
+      &inventory->adapterLpars[adapter * inventory->lparWords];
+  unsigned long long *domainSet =
+      &inventory->domainLpars[domain * inventory->lparWords];
+
+  for (int w = 0; w < inventory->lparWords; w++)
+  {
+    unsigned long long both = adapterSet[w] & domainSet[w];
+
+    for (int b = 0; both != 0; b++, both >>= 1)
+    {
+      if (both & 1)
+      {
+        if (found < maxProfiles)
+        {
+          profiles[found] = w * 64 + b;
+        }
+        found++;
+      }
+    }
+  }
+
+  return found;
+}
+
+/*
+ * Method: freeCryptoInventory
+ */
+void freeCryptoInventory(CRYPTO_INVENTORY_TYPE *inventory)
+{
+  for (int i = 0; i < inventory->profileCount; i++)
+  {
+    free(inventory->profiles[i].name);
+    free(inventory->profiles[i].uri);
+  }
+  free(inventory->profiles);
+  free(inventory->adapterLpars);
+  free(inventory->domainLpars);
+  free(inventory->cpcUri);
+  free(inventory->cpcTargetName);
+  memset(inventory, 0, sizeof(CRYPTO_INVENTORY_TYPE));
+}
+
+/*
+ * Method: formatSet
+ *
+ * Format a set as ranges, e.g. 0-3,7,84, or - when empty.
+ */
+static char *formatSet(const CRYPTO_SET_TYPE *set, int limit, char *out,
+                       int outLen)
+{
+  int len = 0;
+
+  out[0] = '\0';
+  for (int i = 0; i < limit && len < outLen - 16; i++)
+  {
+    if (!inSet(set, i))
+    {
+      continue;
+    }
+
+    int last = i;
+    while (last + 1 < limit && inSet(set, last + 1))
+    {
+      last++;
+    }
+
+    len += sprintf(out + len, len > 0 ? ",%d" : "%d", i);
+    if (last > i)
+    {
+      len += sprintf(out + len, "-%d", last);
+    }
+    i = last;
+  }
+
+  return len > 0 ? out : strcpy(out, "-");
+}
+
+/*
+ * Method: printSharing
+ *
+ * Print the profiles that use domain on adapter.
+ */
+static void printSharing(CRYPTO_INVENTORY_TYPE *inventory, int adapter,
+                         int domain, int *found, int count)
+{
+  printf("adapter %d domain %d:", adapter, domain);
+  for (int i = 0; i < count && i < inventory->profileCount; i++)
+  {
+    printf(" %s", inventory->profiles[found[i]].name);
+  }
+  printf(" (%d LPARs)\n", count);
+}
+
+/*
+ * Method: runCryptoInventory
+ *
+ * Take the crypto inventory of the LPARs of a CPC in a status:
+ *   -CRYPTO [-MAX n] [-STATUS status] CPCname [adapter.domain ...]
+ * and print the LPARs that use each adapter.domain given, or every
+ * domain on an adapter used by more than one LPAR when none is.
+ *
+ * returns: true if every profile was read
+ */
+bool runCryptoInventory(int argc, char **argv)
+{
+  CRYPTO_INVENTORY_TYPE inventory;
+  int maxWorkers = CRYPTO_MAX_WORKERS;
+  const char *lparStatus = CRYPTO_LPAR_STATUS;
+  int first = 2;
+
+  /* argv[1] is -CRYPTO, the options come first */
+  while (first + 1 < argc)
+  {
+    if (strcasecmp(argv[first], "-MAX") == 0)
+    {
+      maxWorkers = atoi(argv[first + 1]);
+    }
+    else if (strcasecmp(argv[first], "-STATUS") == 0)
+    {
+      lparStatus = argv[first + 1];
+    }
+    else
+    {
+      break;
+    }
+    first += 2;
+  }
+
+  if (maxWorkers < 1 || first >= argc)
+  {
+    printf("crypto ERROR: a CPC name and -MAX of at least 1 are needed\n");
+    return false;
+  }
+
+  long long startMs = currentTimeMs();
+  bool inventoryOk = buildCryptoInventory(&inventory, argv[first],
+                                          lparStatus, maxWorkers);
+  double seconds = (currentTimeMs() - startMs) / 1000.0;
+
+  if (inventory.profileCount > 0)
+  {
+    char adapters[256];
+    char candidates[256];
+    char usage[256];
+    char control[256];
+
+    printf("*>>");
+    printf("crypto inventory of CPC %s: %d profiles (%d failed) read by "
+           "up to %d workers in %.3f seconds\n",
+           inventory.cpcName, inventory.profileCount, inventory.failed,
+           maxWorkers, seconds);
+    printf("%-8s %-16s %-16s %-16s %-16s %s\n", "LPAR", "ADAPTERS",
+           "CANDIDATES", "USAGE DOMAINS", "CONTROL DOMAINS", "COUNTERS");
+
+    for (int i = 0; i < inventory.profileCount; i++)
+    {
+      CRYPTO_PROFILE_TYPE *profile = &inventory.profiles[i];
+      if (!profile->fetched)
+      {
+        printf("%-8s failed\n", profile->name);
+        continue;
+      }
+      printf("%-8s %-16s %-16s %-16s %-16s %s\n", profile->name,
+             formatSet(&profile->adapters, CRYPTO_MAX_ADAPTERS, adapters,
+                       sizeof(adapters)),
+             formatSet(&profile->candidateAdapters, CRYPTO_MAX_ADAPTERS,
+                       candidates, sizeof(candidates)),
+             formatSet(&profile->usageDomains, CRYPTO_MAX_DOMAINS, usage,
+                       sizeof(usage)),
+             formatSet(&profile->controlDomains, CRYPTO_MAX_DOMAINS,
+                       control, sizeof(control)),
+             profile->counterAuthorization ? "authorized" : "-");
+    }
+  }
+
+  if (inventory.adapterLpars != NULL)
+  {
+    int *found = (int *)malloc(inventory.profileCount * sizeof(int));
+    int queries = 0;
+    long long queryStart = nowMicros();
+
+    for (int i = first + 1; found != NULL && i < argc; i++)
+    {
+      int adapter;
+      int domain;
+
+      if (sscanf(argv[i], "%d.%d", &adapter, &domain) != 2)
+      {
+        printf("crypto: %s is not in adapter.domain form\n", argv[i]);
+        continue;
+      }
+      int count = findSharingLPARs(&inventory, adapter, domain, found,
+                                   inventory.profileCount);
+      printSharing(&inventory, adapter, domain, found, count);
+      queries++;
+    }
+
+    /* without queries every adapter and domain pair is checked */
+    for (int a = 0; found != NULL && first + 1 == argc &&
+                    a < CRYPTO_MAX_ADAPTERS;
+         a++)
+    {
+      for (int d = 0; d < CRYPTO_MAX_DOMAINS; d++)
+      {
+        int count = findSharingLPARs(&inventory, a, d, found,
+                                     inventory.profileCount);
+        if (count > 1)
+        {
+          printSharing(&inventory, a, d, found, count);
+        }
+        queries++;
+      }
+    }
+
+    printf("*>>");
+    printf("%d adapter and domain pairs looked up in %lld microseconds\n",
+           queries, nowMicros() - queryStart);
+    free(found);
+  }
+
+  freeCryptoInventory(&inventory);
+
+  return inventoryOk;
+}
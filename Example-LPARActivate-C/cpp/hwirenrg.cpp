@@ -0,0 +1,593 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    MODULE NAME= HWIRENRG                                            *
+ *                                                                     *
+ *  Sample C code that uses HWIREST API to sample the energy           *
+ *  management data of CPCs on a fixed cadence. Complex properties     *
+ *  are flattened and the samples are appended to a time-series file   *
+ *  (hwirtser.cpp), which can then be reported by time range and       *
+ *  aggregated per window.                                             *
+ *                                                                     *
+ *************************END OF SPECIFICATIONS************************/
+#pragma filetag("IBM-1047")     /* compile in EBCDIC */
+#pragma csect(code, "HWIRENRG") /* name of csect */
+#pragma longName
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+#include <hwtjic.h> /* JSON interface declaration file  */
+#include "hwijbknd.h"
+#include "hwijprs.h"
+#include "hwijnum.h"
+#include "hwirstc1.h"
+#include "hwirenrg.h"
+#include "hwirtser.h"
+
+/*
+ * Method: addEnergySample
+ */
+static bool addEnergySample(ENERGY_ROUND_TYPE *round, ARENA_TYPE *arena,
+                            const char *name, int nameLen, double value)
+{
+  if (round->count == round->capacity)
+  {
+    int newCapacity = round->capacity > 0 ? round->capacity * 2 : 32;
+    SERIES_SAMPLE_TYPE *samples = (SERIES_SAMPLE_TYPE *)realloc(
+        round->samples, newCapacity * sizeof(SERIES_SAMPLE_TYPE));
+    if (samples == NULL)
+    {
+      return false;
+    }
+    round->samples = samples;
+    round->capacity = newCapacity;
+  }
+
+  SERIES_SAMPLE_TYPE *sample = &round->samples[round->count];
+  sample->name = arenaString(arena, name, nameLen);
+  sample->value = value;
+  if (sample->name == NULL)
+  {
+    return false;
+  }
+  round->count++;
+
+  return true;
+}
+
+/*
+ * Method: flattenValue
+ *
+ * Add the numbers and booleans of a value to the round. Members of
+ * an object are named <name>.<member>, entries of an array
+ * <name>.<index>. Strings and nulls are not sampled, nor are names
+ * longer than SERIES_MAX_NAME.
+ */
+static bool flattenValue(JSON_PARSER_TYPE *parser, HWTJ_HANDLE_TYPE value,
+                         char *name, int nameLen, int depth,
+                         ENERGY_ROUND_TYPE *round, ARENA_TYPE *arena)
+{
+  JSON_BACKEND_TYPE *backend = parser->backend;
+  HWTJ_JTYPE_TYPE type;
+
+  if (!backend->getType(parser->state, value, &type))
+  {
+    backend->displayError(parser->state, "Unable to retrieve type.");
+    return false;
+  }
+
+  if (type == HWTJ_NUMBER_TYPE)
+  {
+    const char *text;
+    int textLen;
+    double number;
+
+    if (backend->getValue(parser->state, value, &text, &textLen) &&
+        parseDouble(text, textLen, &number))
+    {
+      return addEnergySample(round, arena, name, nameLen, number);
+    }
+  }
+  else if (type == HWTJ_BOOLEAN_TYPE)
+  {
+    int boolean = backend->getBoolean(parser->state, value);
+    if (boolean >= 0)
+    {
+      return addEnergySample(round, arena, name, nameLen, boolean);
+    }
+  }
+  else if ((type == HWTJ_OBJECT_TYPE || type == HWTJ_ARRAY_TYPE) &&
+           depth < ENERGY_MAX_DEPTH)
+  {
+    int count = backend->getEntryCount(parser->state, value);
+
+    for (int i = 0; i < count; i++)
+    {
+      HWTJ_HANDLE_TYPE entry;
+      int entryLen;
+
+      if (type == HWTJ_OBJECT_TYPE)
+      {
+        const char *member;
+        int memberLen;
+
+        if (!backend->getObjectEntry(parser->state, value, i, &member,
+                                     &memberLen, &entry))
+        {
+          backend->displayError(parser->state,
+                                "Unable to retrieve object entry.");
+          return false;
+        }
+        entryLen = nameLen + 1 + memberLen;
+        if (entryLen < SERIES_MAX_NAME)
+        {
+          memcpy(name + nameLen + 1, member, memberLen);
+        }
+      }
+      else
+      {
+        if (!backend->getArrayEntry(parser->state, value, i, &entry))
+        {
+          backend->displayError(parser->state,
+                                "Unable to retrieve array entry.");
+          return false;
+        }
+        char index[16];
+        int indexLen = sprintf(index, "%d", i);
+        entryLen = nameLen + 1 + indexLen;
+        if (entryLen < SERIES_MAX_NAME)
+        {
+          memcpy(name + nameLen + 1, index, indexLen);
+        }
+      }
+
+      if (entryLen < SERIES_MAX_NAME)
+      {
+        name[nameLen] = '.';
+        if (!flattenValue(parser, entry, name, entryLen, depth + 1, round,
+                          arena))
+        {
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+/*
+ * Method: requestEnergyData
+ *
+ * GET <cpc-uri>/energy-management-data into respBuf.
+ *
+ * returns: true when the data was returned
+ */
+static bool requestEnergyData(ENERGY_CPC_TYPE *cpc, RESPBUF_TYPE *respBuf)
+{
+  REQUEST_PARM_TYPE request;
+  RESPONSE_PARM_TYPE response;
+
+  char *uri = (char *)arenaAlloc(&respBuf->arena, defaultLen2K);
+  if (uri == NULL ||
+      strlen(cpc->uri) + strlen("/energy-management-data") >= defaultLen2K)
+  {
+    return false;
+  }
+
+  memset(&request, 0, sizeof(REQUEST_PARM_TYPE));
+  memset(&response, 0, sizeof(RESPONSE_PARM_TYPE));
+
+  strcpy(uri, cpc->uri);
+  strcat(uri, "/energy-management-data");
+
+  request.httpMethod = HWI_REST_GET;
+  request.uri = uri;
+  request.uriLen = strlen(uri);
+  request.targetName = cpc->targetName;
+  request.targetNameLen = strlen(cpc->targetName);
+  request.requestTimeout = 0x00002688;
+
+  attachResponseBuffer(respBuf, &response);
+
+  traceRequest(&request, &response);
+
+  issueRequest(&request, &response);
+
+  completeResponseBuffer(respBuf, &response);
+
+  return isSuccessful(&response, &respBuf->error) &&
+         response.httpStatus == 200 && response.responseBodyLen > 0;
+}
+
+/*
+ * Method: sampleCPC
+ *
+ * Read the energy management data of a CPC and append its numeric
+ * properties to the time-series file as one round, taken at the time
+ * the request was issued.
+ *
+ * returns: number of values sampled, -1 when the CPC failed
+ */
+static int sampleCPC(ENERGY_CPC_TYPE *cpc, ENERGY_ROUND_TYPE *round,
+                     SERIES_WRITER_TYPE *writer)
+{
+  char name[SERIES_MAX_NAME];
+  int sampled = -1;
+
+  RESPBUF_TYPE *respBuf = acquireResponseBuffer(RESPBUF_SMALL);
+  if (respBuf == NULL)
+  {
+    return -1;
+  }
+
+  long long timeMs = currentTimeMs();
+  round->count = 0;
+
+  if (requestEnergyData(cpc, respBuf) &&
+      parse_json_text(respBuf->responseBody))
+  {
+    JSON_PARSER_TYPE *parser = current_parser();
+    HWTJ_HANDLE_TYPE objects = find_array(0, (char *)"objects");
+    int entries = objects != 0 ? getnumberOfEntries(objects) : 0;
+    int nameLen = strlen(cpc->name);
+    bool flattened = entries > 0 && nameLen < SERIES_MAX_NAME;
+
+    memcpy(name, cpc->name, nameLen);
+    for (int i = 0; i < entries && flattened; i++)
+    {
+      HWTJ_HANDLE_TYPE entry = getArrayEntry(objects, i);
+
+      /* the data of an object that failed is not sampled */
+      if (find_boolvalue(entry, (char *)"error-occurred") == 1)
+      {
+        flattened = false;
+        break;
+      }
+
+      HWTJ_HANDLE_TYPE *properties = (HWTJ_HANDLE_TYPE *)find_optional_value(
+          entry, (char *)"properties", HWTJ_OBJECT_TYPE);
+      if (properties != NULL)
+      {
+        flattened = flattenValue(parser, *properties, name, nameLen, 0,
+                                 round, &respBuf->arena);
+        free(properties);
+      }
+    }
+
+    if (flattened &&
+        appendSeriesRound(writer, timeMs, round->samples, round->count))
+    {
+      sampled = round->count;
+    }
+  }
+
+  releaseResponseBuffer(respBuf);
+
+  return sampled;
+}
+
+/*
+ * Method: resolveEnergyCPCs
+ *
+ * Resolve each CPC named on the command line, those not found are
+ * dropped.
+ *
+ * returns: number of CPCs resolved
+ */
+static int resolveEnergyCPCs(ENERGY_CPC_TYPE *cpcs, char **names,
+                             int nameCount)
+{
+  int resolved = 0;
+
+  for (int i = 0; i < nameCount; i++)
+  {
+    ENERGY_CPC_TYPE *cpc = &cpcs[resolved];
+    memset(cpc, 0, sizeof(ENERGY_CPC_TYPE));
+    cpc->name = names[i];
+
+    if (resolveCPC(cpc->name, &cpc->uri, &cpc->targetName))
+    {
+      resolved++;
+    }
+    else
+    {
+      printf("energy: CPC %s not found, not sampled\n", names[i]);
+    }
+  }
+
+  return resolved;
+}
+
+/*
+ * Method: runEnergySampler
+ *
+ * Sample the energy management data of every CPC named on the
+ * command line:
+ *   -ENERGY -FILE path [-EVERY s] [-COUNT n] CPCname ...
+ * every -EVERY seconds, -COUNT times or until the job is cancelled.
+ * Each round is written through before the next sample is taken.
+ *
+ * returns: true if every sample was taken
+ */
+bool runEnergySampler(int argc, char **argv)
+{
+  char *path = NULL;
+  int everySec = ENERGY_EVERY_SEC;
+  int count = 0;
+  int first = 2;
+
+  /* argv[1] is -ENERGY, the options come first */
+  while (first + 1 < argc && argv[first][0] == '-')
+  {
+    if (strcasecmp(argv[first], "-FILE") == 0)
+    {
+      path = argv[first + 1];
+    }
+    else if (strcasecmp(argv[first], "-EVERY") == 0)
+    {
+      everySec = atoi(argv[first + 1]);
+    }
+    else if (strcasecmp(argv[first], "-COUNT") == 0)
+    {
+      count = atoi(argv[first + 1]);
+    }
+    else
+    {
+      break;
+    }
+    first += 2;
+  }
+
+  if (path == NULL || everySec < 1 || count < 0 || first >= argc)
+  {
+    printf("energy ERROR: -FILE path, -EVERY of at least 1 second and "
+           "CPC names are needed\n");
+    return false;
+  }
+
+  ENERGY_CPC_TYPE *cpcs = (ENERGY_CPC_TYPE *)calloc(argc - first,
+                                                    sizeof(ENERGY_CPC_TYPE));
+  ENERGY_ROUND_TYPE round;
+  SERIES_WRITER_TYPE writer;
+  int failures = 0;
+
+  memset(&round, 0, sizeof(ENERGY_ROUND_TYPE));
+
+  int cpcCount = cpcs != NULL
+                     ? resolveEnergyCPCs(cpcs, argv + first, argc - first)
+                     : 0;
+
+  if (cpcCount > 0 && openSeriesWriter(&writer, path))
+  {
+    printf("*>>");
+    printf("sampling %d CPCs every %d seconds into %s at %s\n", cpcCount,
+           everySec, path, printTime());
+    fflush(stdout);
+
+    /* a trace of every sample would soon fill the output */
+    bool savedTraceRequests = traceRequests;
+    traceRequests = false;
+
+    long long startMs = currentTimeMs();
+    for (int tick = 0; count == 0 || tick < count; tick++)
+    {
+      long long tickMs = startMs + (long long)tick * everySec * 1000;
+      sleepMs((int)(tickMs - currentTimeMs()));
+
+      int values = 0;
+      int sampledCPCs = 0;
+      for (int i = 0; i < cpcCount; i++)
+      {
+        int sampled = sampleCPC(&cpcs[i], &round, &writer);
+        if (sampled < 0)
+        {
+          cpcs[i].failures++;
+          failures++;
+        }
+        else
+        {
+          values += sampled;
+          sampledCPCs++;
+        }
+      }
+
+      printf("*>>round %d: %d values of %d of %d CPCs, %lld bytes for "
+             "%lld values so far\n",
+             tick + 1, values, sampledCPCs, cpcCount, writer.bytes,
+             writer.values);
+      fflush(stdout);
+    }
+
+    traceRequests = savedTraceRequests;
+
+    printf("*>>");
+    printf("sampled %lld values in %lld bytes, %.2f bytes a value, "
+           "%d samples failed\n",
+           writer.values, writer.bytes,
+           writer.values > 0 ? (double)writer.bytes / writer.values : 0.0,
+           failures);
+    closeSeriesWriter(&writer);
+  }
+  else
+  {
+    failures++;
+  }
+
+  for (int i = 0; i < cpcCount; i++)
+  {
+    free(cpcs[i].uri);
+    free(cpcs[i].targetName);
+  }
+  free(cpcs);
+  free(round.samples);
+
+  return failures == 0;
+}
+
+/*
+ * Method: formatTime
+ *
+ * Format a time in ms since the epoch as UTC.
+ */
+static char *formatTime(long long timeMs, char *out, int outLen)
+{
+  time_t seconds = (time_t)(timeMs / 1000);
+  struct tm *utc = gmtime(&seconds);
+
+  if (utc == NULL || strftime(out, outLen, "%Y-%m-%d %H:%M:%S", utc) == 0)
+  {
+    snprintf(out, outLen, "%lld", timeMs);
+  }
+
+  return out;
+}
+
+/*
+ * Method: printPoint
+ */
+static bool printPoint(const SERIES_POINT_TYPE *point, void *)
+{
+  char time[32];
+
+  printf("%-48s %s %14.3f\n", point->name,
+         formatTime(point->timeMs, time, sizeof(time)), point->value);
+
+  return true;
+}
+
+/*
+ * Method: printWindow
+ */
+static bool printWindow(const SERIES_WINDOW_TYPE *window, void *)
+{
+  char time[32];
+
+  printf("%-48s %s %6d %12.3f %12.3f %12.3f\n", window->name,
+         formatTime(window->windowMs, time, sizeof(time)), window->count,
+         window->min, window->max, window->sum / window->count);
+
+  return true;
+}
+
+/*
+ * Method: reportTime
+ *
+ * returns: ms since the epoch of a -FROM or -TO value, seconds since
+ *          the epoch or, when negative, seconds before now
+ */
+static long long reportTime(const char *text)
+{
+  long long seconds = atoll(text);
+
+  if (seconds < 0)
+  {
+    return currentTimeMs() + seconds * 1000;
+  }
+
+  return seconds * 1000;
+}
+
+/*
+ * Method: runSeriesReport
+ *
+ * Report a time-series file:
+ *   -SERIES -FILE path [-FROM s] [-TO s] [-WINDOW s] [pattern]
+ * Every value of the series matching pattern (* and ? wildcards,
+ * all by default) from -FROM to -TO is printed, or with -WINDOW the
+ * count, minimum, maximum and average of each window of that many
+ * seconds.
+ *
+ * returns: true if the file could be read
+ */
+bool runSeriesReport(int argc, char **argv)
+{
+  char *path = NULL;
+  const char *pattern = NULL;
+  long long fromMs = 0;
+  long long toMs = 0x7FFFFFFFFFFFFFFFLL;
+  long long windowMs = 0;
+  SERIES_SCAN_STATS_TYPE stats;
+  bool reportOk;
+
+  /* argv[1] is -SERIES */
+  for (int i = 2; i < argc; i++)
+  {
+    if (strcasecmp(argv[i], "-FILE") == 0 && i + 1 < argc)
+    {
+      path = argv[++i];
+    }
+    else if (strcasecmp(argv[i], "-FROM") == 0 && i + 1 < argc)
+    {
+      fromMs = reportTime(argv[++i]);
+    }
+    else if (strcasecmp(argv[i], "-TO") == 0 && i + 1 < argc)
+    {
+      toMs = reportTime(argv[++i]);
+    }
+    else if (strcasecmp(argv[i], "-WINDOW") == 0 && i + 1 < argc)
+    {
+      windowMs = atoll(argv[++i]) * 1000;
+    }
+    else
+    {
+      pattern = argv[i];
+    }
+  }
+
+  if (path == NULL || windowMs < 0)
+  {
+    printf("series ERROR: -FILE path is needed\n");
+    return false;
+  }
+
+  long long startMs = currentTimeMs();
+
+  if (windowMs > 0)
+  {
+    printf("%-48s %-19s %6s %12s %12s %12s\n", "SERIES", "WINDOW (UTC)",
+           "COUNT", "MIN", "MAX", "AVG");
+    reportOk = aggregateSeries(path, pattern, fromMs, toMs, windowMs,
+                               printWindow, NULL, &stats);
+  }
+  else
+  {
+    printf("%-48s %-19s %14s\n", "SERIES", "TIME (UTC)", "VALUE");
+    reportOk = scanSeries(path, pattern, fromMs, toMs, printPoint, NULL,
+                          &stats);
+  }
+
+  if (reportOk)
+  {
+    printf("*>>");
+    printf("%lld of %lld values decoded matched, %d of %d blocks skipped "
+           "by time, in %.3f seconds\n",
+           stats.valuesMatched, stats.valuesDecoded, stats.blocksSkipped,
+           stats.blocks, (currentTimeMs() - startMs) / 1000.0);
+    if (stats.damaged)
+    {
+      printf("series: %s ends in a partial block\n", path);
+    }
+  }
+
+  return reportOk;
+}
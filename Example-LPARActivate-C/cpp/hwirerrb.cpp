@@ -0,0 +1,269 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    MODULE NAME= HWIRERRB                                            *
+ *                                                                     *
+ *  Sample C code that decodes the body of a failed HWIREST request    *
+ *  into an error record. The members of the outermost object are      *
+ *  scanned once and http-status, reason, message and bcpii-error      *
+ *  are picked out, nested values are skipped unread. Nothing is       *
+ *  allocated and no JSON parser is involved, so a document the        *
+ *  caller has parsed stays intact.                                    *
+ *                                                                     *
+ *************************END OF SPECIFICATIONS************************/
+#pragma filetag("IBM-1047")     /* compile in EBCDIC */
+#pragma csect(code, "HWIRERRB") /* name of csect */
+#pragma longName
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "hwijnum.h"
+#include "hwirerrb.h"
+
+/*
+ * Method: skipSpace
+ *
+ * returns: the position of the first character at or after pos that
+ *          is not JSON white space
+ */
+static int skipSpace(const char *text, int len, int pos)
+{
+  while (pos < len && (text[pos] == ' ' || text[pos] == '\t' ||
+                       text[pos] == '\n' || text[pos] == '\r'))
+  {
+    pos++;
+  }
+
+  return pos;
+}
+
+/*
+ * Method: skipString
+ *
+ * pos is at the opening quote.
+ *
+ * returns: the position after the closing quote, -1 when the string
+ *          is not terminated
+ */
+static int skipString(const char *text, int len, int pos, bool *escaped)
+{
+  *escaped = false;
+
+  for (pos++; pos < len; pos++)
+  {
+    if (text[pos] == '\\')
+    {
+      *escaped = true;
+      pos++;
+    }
+    else if (text[pos] == '"')
+    {
+      return pos + 1;
+    }
+  }
+
+  return -1;
+}
+
+/*
+ * Method: skipValue
+ *
+ * Skip a value, objects and arrays with everything nested in them.
+ *
+ * returns: the position after the value, -1 when it is not terminated
+ */
+static int skipValue(const char *text, int len, int pos)
+{
+  bool escaped;
+  int depth = 0;
+
+  while (pos < len)
+  {
+    char c = text[pos];
+
+    if (c == '"')
+    {
+      pos = skipString(text, len, pos, &escaped);
+      if (pos < 0 || depth == 0)
+      {
+        return pos;
+      }
+      continue;
+    }
+
+    if (c == '{' || c == '[')
+    {
+      depth++;
+    }
+    else if (c == '}' || c == ']')
+    {
+      if (depth == 0)
+      {
+        return pos;
+      }
+      if (--depth == 0)
+      {
+        return pos + 1;
+      }
+    }
+    else if (depth == 0 && (c == ',' || c == ' ' || c == '\t' ||
+                            c == '\n' || c == '\r'))
+    {
+      return pos;
+    }
+    pos++;
+  }
+
+  return depth == 0 ? pos : -1;
+}
+
+/*
+ * Method: keyIs
+ *
+ * returns: true when the key of keyLen characters is name
+ */
+static bool keyIs(const char *key, int keyLen, const char *name)
+{
+  return (int)strlen(name) == keyLen && memcmp(key, name, keyLen) == 0;
+}
+
+/*
+ * Method: scanInt
+ *
+ * returns: true when the value is an integer in the range of an int
+ */
+static bool scanInt(const char *value, int valueLen, int *number)
+{
+  long long wide;
+
+  if (!parseInt64(value, valueLen, &wide) || wide < -2147483647 - 1 ||
+      wide > 2147483647)
+  {
+    return false;
+  }
+
+  *number = (int)wide;
+
+  return true;
+}
+
+/*
+ * Method: scanErrorBody
+ *
+ * Decode the failure body of len characters of text into error. A
+ * member of another type than expected is treated as missing.
+ *
+ * returns: true when text is an object, found tells which members it
+ *          had. On false the members before the malformed text are
+ *          still recorded.
+ */
+bool scanErrorBody(const char *text, int len, RESPONSE_ERROR_TYPE *error)
+{
+  memset(error, 0, sizeof(RESPONSE_ERROR_TYPE));
+
+  int pos = skipSpace(text, len, 0);
+  if (pos >= len || text[pos] != '{')
+  {
+    return false;
+  }
+
+  pos = skipSpace(text, len, pos + 1);
+  if (pos < len && text[pos] == '}')
+  {
+    return true;
+  }
+
+  while (pos < len && text[pos] == '"')
+  {
+    bool escaped;
+    const char *key = text + pos + 1;
+    int keyEnd = skipString(text, len, pos, &escaped);
+    if (keyEnd < 0)
+    {
+      return false;
+    }
+    int keyLen = keyEnd - 1 - (pos + 1);
+
+    pos = skipSpace(text, len, keyEnd);
+    if (pos >= len || text[pos] != ':')
+    {
+      return false;
+    }
+
+    int valueStart = skipSpace(text, len, pos + 1);
+    int valueEnd = skipValue(text, len, valueStart);
+    if (valueEnd < 0 || valueEnd == valueStart)
+    {
+      return false;
+    }
+
+    const char *value = text + valueStart;
+    int valueLen = valueEnd - valueStart;
+
+    if (keyIs(key, keyLen, "http-status"))
+    {
+      if (scanInt(value, valueLen, &error->httpStatus))
+      {
+        error->found |= ERROR_FOUND_HTTP_STATUS;
+      }
+    }
+    else if (keyIs(key, keyLen, "reason"))
+    {
+      if (scanInt(value, valueLen, &error->reason))
+      {
+        error->found |= ERROR_FOUND_REASON;
+      }
+    }
+    else if (keyIs(key, keyLen, "message"))
+    {
+      if (value[0] == '"')
+      {
+        skipString(text, len, valueStart, &error->messageEscaped);
+        error->message = value + 1;
+        error->messageLen = valueLen - 2;
+        error->found |= ERROR_FOUND_MESSAGE;
+      }
+    }
+    else if (keyIs(key, keyLen, "bcpii-error"))
+    {
+      if (keyIs(value, valueLen, "true") || keyIs(value, valueLen, "false"))
+      {
+        error->bcpiiError = value[0] == 't';
+        error->found |= ERROR_FOUND_BCPII;
+      }
+    }
+
+    pos = skipSpace(text, len, valueEnd);
+    if (pos < len && text[pos] == ',')
+    {
+      pos = skipSpace(text, len, pos + 1);
+    }
+    else if (pos < len && text[pos] == '}')
+    {
+      return true;
+    }
+    else
+    {
+      return false;
+    }
+  }
+
+  return false;
+}
@@ -0,0 +1,618 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    MODULE NAME= HWIRFLET                                            *
+ *                                                                     *
+ *  Sample C code that uses HWIREST API to activate many LPARs in one  *
+ *  run. Each CPC is resolved once, activations are started up to a    *
+ *  global and a per-CPC concurrency limit and all of the resulting    *
+ *  job URIs are POLLed together by a job tracker (hwirjobs.cpp).      *
+ *                                                                     *
+ *************************END OF SPECIFICATIONS************************/
+#pragma filetag("IBM-1047")     /* compile in EBCDIC */
+#pragma csect(code, "HWIRFLET") /* name of csect */
+#pragma longName
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <fnmatch.h>
+#include "hwirstc1.h"
+#include "hwirflet.h"
+#include "hwirlidx.h"
+
+/*
+ * Method: addFleetCPC
+ *
+ * Return the index of the named CPC, adding it when it is new.
+ */
+static int addFleetCPC(FLEET_TYPE *fleet, char *cpcName)
+{
+  for (int i = 0; i < fleet->cpcCount; i++)
+  {
+    if (strcmp(fleet->cpcs[i].name, cpcName) == 0)
+    {
+      return i;
+    }
+  }
+
+  if (fleet->cpcCount == fleet->cpcCapacity)
+  {
+    int newCapacity = fleet->cpcCapacity > 0 ? fleet->cpcCapacity * 2 : 8;
+    FLEET_CPC_TYPE *cpcs = (FLEET_CPC_TYPE *)realloc(
+        fleet->cpcs, newCapacity * sizeof(FLEET_CPC_TYPE));
+    if (cpcs == NULL)
+    {
+      return -1;
+    }
+    fleet->cpcs = cpcs;
+    fleet->cpcCapacity = newCapacity;
+  }
+
+  FLEET_CPC_TYPE *cpc = &fleet->cpcs[fleet->cpcCount];
+  memset(cpc, 0, sizeof(FLEET_CPC_TYPE));
+  cpc->name = strdup(cpcName);
+
+  return fleet->cpcCount++;
+}
+
+/*
+ * Method: addFleetItem
+ *
+ * Add an LPAR to the fleet, an LPAR that is already present
+ * is not added again.
+ */
+static FLEET_ITEM_TYPE *addFleetItem(FLEET_TYPE *fleet, int cpcIndex,
+                                     char *lparName)
+{
+  for (int i = 0; i < fleet->itemCount; i++)
+  {
+    if (fleet->items[i].cpcIndex == cpcIndex &&
+        strcmp(fleet->items[i].lparName, lparName) == 0)
+    {
+      return NULL;
+    }
+  }
+
+  if (fleet->itemCount == fleet->itemCapacity)
+  {
+    int newCapacity = fleet->itemCapacity > 0 ? fleet->itemCapacity * 2 : 16;
+    FLEET_ITEM_TYPE *items = (FLEET_ITEM_TYPE *)realloc(
+        fleet->items, newCapacity * sizeof(FLEET_ITEM_TYPE));
+    if (items == NULL)
+    {
+      printf("fleet ERROR: out of storage\n");
+      return NULL;
+    }
+    fleet->items = items;
+    fleet->itemCapacity = newCapacity;
+  }
+
+  FLEET_ITEM_TYPE *item = &fleet->items[fleet->itemCount++];
+  memset(item, 0, sizeof(FLEET_ITEM_TYPE));
+  item->cpcIndex = cpcIndex;
+  item->lparName = strdup(lparName);
+  item->state = FLEET_WAITING;
+  item->jobStatusCode = -1;
+  item->jobReasonCode = -1;
+
+  return item;
+}
+
+/*
+ * Method: finishFleetItem
+ *
+ * Mark an item as done without an activation job.
+ */
+static void finishFleetItem(FLEET_ITEM_TYPE *item, const char *outcome)
+{
+  item->state = FLEET_DONE;
+  item->outcome = outcome;
+}
+
+/*
+ * Method: addFleetSpec
+ *
+ * Record one <CPCname>.<LPARname> argument. The LPAR name may be a
+ * pattern using * and ? which is matched against every LPAR of the
+ * CPC once the CPC has been resolved.
+ */
+static bool addFleetSpec(FLEET_TYPE *fleet, char *spec,
+                         char ***patterns, int **patternCpcs,
+                         int *patternCount)
+{
+  char *separator = strchr(spec, '.');
+
+  if (separator == NULL || separator == spec || separator[1] == '\0')
+  {
+    printf("fleet ERROR: %s is not in <CPCname>.<LPARname> form\n", spec);
+    return false;
+  }
+
+  *separator = '\0';
+  int cpcIndex = addFleetCPC(fleet, spec);
+  char *lparName = separator + 1;
+  *separator = '.';
+
+  if (cpcIndex < 0)
+  {
+    printf("fleet ERROR: out of storage\n");
+    return false;
+  }
+
+  if (strpbrk(lparName, "*?") == NULL)
+  {
+    addFleetItem(fleet, cpcIndex, lparName);
+    return true;
+  }
+
+  char **newPatterns = (char **)realloc(*patterns,
+                                        (*patternCount + 1) * sizeof(char *));
+  int *newPatternCpcs = (int *)realloc(*patternCpcs,
+                                       (*patternCount + 1) * sizeof(int));
+  if (newPatterns == NULL || newPatternCpcs == NULL)
+  {
+    printf("fleet ERROR: out of storage\n");
+    return false;
+  }
+  *patterns = newPatterns;
+  *patternCpcs = newPatternCpcs;
+  (*patterns)[*patternCount] = strdup(lparName);
+  (*patternCpcs)[*patternCount] = cpcIndex;
+  (*patternCount)++;
+
+  return true;
+}
+
+/*
+ * Method: readFleetList
+ *
+ * Read <CPCname>.<LPARname> entries, one per line, from a data set
+ * (DD:ddname) or a file. Blank lines and lines starting with * or #
+ * are ignored.
+ */
+static bool readFleetList(FLEET_TYPE *fleet, char *listName,
+                          char ***patterns, int **patternCpcs,
+                          int *patternCount)
+{
+  char line[defaultLen];
+  bool listOk = true;
+
+  FILE *listFile = fopen(listName, "r");
+  if (listFile == NULL)
+  {
+    printf("fleet ERROR: unable to open %s\n", listName);
+    return false;
+  }
+
+  while (fgets(line, sizeof(line), listFile) != NULL)
+  {
+    /* strip trailing blanks and sequence numbers of fixed records */
+    char *spec = strtok(line, " \t\r\n");
+    if (spec == NULL || spec[0] == '*' || spec[0] == '#')
+    {
+      continue;
+    }
+    if (!addFleetSpec(fleet, spec, patterns, patternCpcs, patternCount))
+    {
+      listOk = false;
+    }
+  }
+
+  fclose(listFile);
+  return listOk;
+}
+
+/*
+ * Method: resolveFleet
+ *
+ * Resolve each CPC once, expand the LPAR name patterns against the
+ * LPARs of their CPC and resolve the URI and target name of every
+ * LPAR in the fleet. A CPC with a pattern or more than one LPAR in
+ * the fleet is indexed with a single list request, its LPARs are
+ * then resolved from the index.
+ */
+static void resolveFleet(FLEET_TYPE *fleet, char **patterns,
+                         int *patternCpcs, int patternCount)
+{
+  for (int i = 0; i < fleet->cpcCount; i++)
+  {
+    FLEET_CPC_TYPE *cpc = &fleet->cpcs[i];
+    int lparRefs = 0;
+
+    cpc->resolved = resolveCPC(cpc->name, &cpc->uri, &cpc->targetName);
+
+    for (int j = 0; j < fleet->itemCount; j++)
+    {
+      lparRefs += fleet->items[j].cpcIndex == i ? 1 : 0;
+    }
+    for (int j = 0; j < patternCount; j++)
+    {
+      /* a pattern needs the full list anyway */
+      lparRefs += patternCpcs[j] == i ? 2 : 0;
+    }
+
+    if (cpc->resolved && lparRefs > 1)
+    {
+      indexLPARs(cpc->uri, cpc->targetName);
+    }
+  }
+
+  for (int i = 0; i < patternCount; i++)
+  {
+    FLEET_CPC_TYPE *cpc = &fleet->cpcs[patternCpcs[i]];
+    LPAR_INDEX_TYPE *index = NULL;
+    int matches = 0;
+
+    if (cpc->resolved)
+    {
+      index = findLPARIndex(cpc->targetName);
+    }
+
+    for (int j = 0; index != NULL && j < index->lparCount; j++)
+    {
+      LPAR_INFO_TYPE *lpar = &index->lpars[j];
+      if (fnmatch(patterns[i], lpar->name, 0) == 0)
+      {
+        FLEET_ITEM_TYPE *item = addFleetItem(fleet, patternCpcs[i],
+                                             lpar->name);
+        if (item != NULL)
+        {
+          item->lparUri = strdup(lpar->uri);
+          item->lparTargetName = strdup(lpar->targetName);
+        }
+        matches++;
+      }
+    }
+
+    if (matches == 0)
+    {
+      printf("fleet: no LPAR on CPC %s matches %s\n", cpc->name,
+             patterns[i]);
+    }
+  }
+
+  for (int i = 0; i < fleet->itemCount; i++)
+  {
+    FLEET_ITEM_TYPE *item = &fleet->items[i];
+    FLEET_CPC_TYPE *cpc = &fleet->cpcs[item->cpcIndex];
+
+    if (!cpc->resolved)
+    {
+      finishFleetItem(item, "no CPC");
+    }
+    else if (item->lparUri == NULL &&
+             !resolveLPAR(cpc->uri, cpc->targetName, item->lparName,
+                          &item->lparUri, &item->lparTargetName))
+    {
+      finishFleetItem(item, "no LPAR");
+    }
+  }
+}
+
+/*
+ * Method: startFleetActivation
+ *
+ * Check that the LPAR is not activated, read its next activation
+ * profile and POST the activate operation. The resulting job is
+ * added to the tracker.
+ */
+static void startFleetActivation(FLEET_TYPE *fleet, FLEET_ITEM_TYPE *item,
+                                 JOB_TRACKER_TYPE *tracker)
+{
+  LPAR_PROPS_TYPE props;
+
+  item->startMs = currentTimeMs();
+
+  /* status and next activation profile in a single request */
+  if (!getLPARProperties(item->lparUri, item->lparTargetName,
+                         LPAR_PROP_STATUS | LPAR_PROP_NEXT_ACT_PROFILE,
+                         &props))
+  {
+    freeLPARProperties(&props);
+    finishFleetItem(item, "failed");
+    return;
+  }
+
+  if (0 != strcmp(statusLparNotActive, props.status))
+  {
+    printf("fleet: LPAR %s is in %s status, not activated\n",
+           item->lparName, props.status);
+    freeLPARProperties(&props);
+    finishFleetItem(item, "skipped");
+    return;
+  }
+
+  char *activateUri = (char *)malloc(defaultLen2K);
+  char *requestBody = (char *)malloc(defaultLen64K);
+
+  memset(activateUri, 0, defaultLen2K);
+  memset(requestBody, 0, defaultLen64K);
+
+  strcpy(activateUri, item->lparUri);
+  strcat(activateUri, "/operations/activate");
+
+  strcpy(requestBody, "{");
+  strcat(requestBody, "\"activation-profile-name\":\"");
+  strcat(requestBody, props.nextActivationProfile);
+  strcat(requestBody, "\",\"force\":true");
+  strcat(requestBody, "}");
+
+  if (asyncPostTracked(tracker, activateUri, item->lparTargetName,
+                       requestBody, (char *)"activate LPAR", POLL_OP_ACTIVATE,
+                       NULL, item) != NULL)
+  {
+    item->state = FLEET_ACTIVE;
+    fleet->active++;
+    fleet->cpcs[item->cpcIndex].active++;
+  }
+  else
+  {
+    finishFleetItem(item, "failed");
+  }
+
+  freeLPARProperties(&props);
+  free(activateUri);
+  free(requestBody);
+}
+
+/*
+ * Method: admitFleetActivations
+ *
+ * Start waiting activations while the global and per-CPC limits
+ * allow it.
+ *
+ * returns: number of items still waiting
+ */
+static int admitFleetActivations(FLEET_TYPE *fleet,
+                                 JOB_TRACKER_TYPE *tracker)
+{
+  int waiting = 0;
+
+  for (int i = 0; i < fleet->itemCount; i++)
+  {
+    FLEET_ITEM_TYPE *item = &fleet->items[i];
+
+    if (item->state != FLEET_WAITING)
+    {
+      continue;
+    }
+
+    if (fleet->active < fleet->maxActive &&
+        fleet->cpcs[item->cpcIndex].active < fleet->maxActivePerCPC)
+    {
+      startFleetActivation(fleet, item, tracker);
+    }
+
+    if (item->state == FLEET_WAITING)
+    {
+      waiting++;
+    }
+  }
+
+  return waiting;
+}
+
+/*
+ * Method: collectFleetCompletions
+ *
+ * Record the result of every job that completed since the last call
+ * and free up its concurrency slots.
+ */
+static void collectFleetCompletions(FLEET_TYPE *fleet,
+                                    JOB_TRACKER_TYPE *tracker)
+{
+  JOB_ENTRY_TYPE *job;
+
+  while ((job = nextCompletedJob(tracker)) != NULL)
+  {
+    FLEET_ITEM_TYPE *item = (FLEET_ITEM_TYPE *)job->userData;
+
+    item->state = FLEET_DONE;
+    item->elapsedSeconds = (currentTimeMs() - item->startMs) / 1000.0;
+    item->jobStatus = job->status != NULL ? strdup(job->status) : NULL;
+    item->jobStatusCode = job->jobStatusCode;
+    item->jobReasonCode = job->jobReasonCode;
+
+    if (job->pollResult.timedOut)
+    {
+      item->outcome = "timed out";
+    }
+    else if (job->status != NULL &&
+             strcmp(statusJobComplete, job->status) == 0 &&
+             (job->jobStatusCode < 0 ||
+              (job->jobStatusCode > 199 && job->jobStatusCode < 300)))
+    {
+      item->outcome = "activated";
+    }
+    else
+    {
+      item->outcome = "failed";
+    }
+
+    printf("fleet: LPAR %s %s after %.2f seconds\n", item->lparName,
+           item->outcome, item->elapsedSeconds);
+
+    fleet->active--;
+    fleet->cpcs[item->cpcIndex].active--;
+  }
+}
+
+/*
+ * Method: printFleetSummary
+ *
+ * Print one row per LPAR with its outcome and elapsed time.
+ */
+static bool printFleetSummary(FLEET_TYPE *fleet, double wallSeconds)
+{
+  int activated = 0;
+  double sumSeconds = 0;
+
+  printf("*>>\n");
+  printf("*>>FLEET SUMMARY:\n");
+  printf("%-8s %-8s %-10s %-14s %5s %6s %9s\n",
+         "CPC", "LPAR", "OUTCOME", "JOB STATUS", "CODE", "REASON",
+         "ELAPSED");
+
+  for (int i = 0; i < fleet->itemCount; i++)
+  {
+    FLEET_ITEM_TYPE *item = &fleet->items[i];
+
+    printf("%-8s %-8s %-10s %-14s %5d %6d %9.2f\n",
+           fleet->cpcs[item->cpcIndex].name, item->lparName,
+           item->outcome != NULL ? item->outcome : "not run",
+           item->jobStatus != NULL ? item->jobStatus : "-",
+           item->jobStatusCode, item->jobReasonCode,
+           item->elapsedSeconds);
+
+    if (item->outcome != NULL && strcmp(item->outcome, "activated") == 0)
+    {
+      activated++;
+    }
+    sumSeconds += item->elapsedSeconds;
+  }
+
+  printf("*>>%d of %d LPARs activated in %.2f seconds "
+         "(%.2f seconds if run one at a time)\n",
+         activated, fleet->itemCount, wallSeconds, sumSeconds);
+
+  return fleet->itemCount > 0 && activated == fleet->itemCount;
+}
+
+/*
+ * Method: freeFleet
+ *
+ * Free all storage held by the fleet.
+ */
+static void freeFleet(FLEET_TYPE *fleet)
+{
+  for (int i = 0; i < fleet->cpcCount; i++)
+  {
+    free(fleet->cpcs[i].name);
+    free(fleet->cpcs[i].uri);
+    free(fleet->cpcs[i].targetName);
+  }
+  for (int i = 0; i < fleet->itemCount; i++)
+  {
+    free(fleet->items[i].lparName);
+    free(fleet->items[i].lparUri);
+    free(fleet->items[i].lparTargetName);
+    free(fleet->items[i].jobStatus);
+  }
+  free(fleet->cpcs);
+  free(fleet->items);
+}
+
+/*
+ * Method: runFleet
+ *
+ * Activate every LPAR named on the command line:
+ *   -FLEET [-MAX n] [-MAXCPC n] entry ...
+ * where each entry is <CPCname>.<LPARname>, the LPAR name may use
+ * the * and ? wildcards, or the name of a data set (DD:ddname) or
+ * file (/path) holding one such entry per line.
+ *
+ * returns: true if every LPAR was activated
+ */
+bool runFleet(int argc, char **argv)
+{
+  FLEET_TYPE fleet;
+  char **patterns = NULL;
+  int *patternCpcs = NULL;
+  int patternCount = 0;
+  bool argsOk = true;
+  bool fleetSuccess = false;
+
+  memset(&fleet, 0, sizeof(FLEET_TYPE));
+  fleet.maxActive = FLEET_MAX_ACTIVE;
+  fleet.maxActivePerCPC = FLEET_MAX_ACTIVE_CPC;
+
+  /* argv[1] is -FLEET */
+  for (int i = 2; i < argc && argsOk; i++)
+  {
+    if (strcasecmp(argv[i], "-MAX") == 0 && i + 1 < argc)
+    {
+      fleet.maxActive = atoi(argv[++i]);
+    }
+    else if (strcasecmp(argv[i], "-MAXCPC") == 0 && i + 1 < argc)
+    {
+      fleet.maxActivePerCPC = atoi(argv[++i]);
+    }
+    else if (strncasecmp(argv[i], "DD:", 3) == 0 || argv[i][0] == '/')
+    {
+      argsOk = readFleetList(&fleet, argv[i], &patterns, &patternCpcs,
+                             &patternCount);
+    }
+    else
+    {
+      argsOk = addFleetSpec(&fleet, argv[i], &patterns, &patternCpcs,
+                            &patternCount);
+    }
+  }
+
+  if (fleet.maxActive < 1 || fleet.maxActivePerCPC < 1)
+  {
+    printf("fleet ERROR: concurrency limits must be at least 1\n");
+    argsOk = false;
+  }
+  else if (fleet.cpcCount == 0)
+  {
+    printf("fleet ERROR: no <CPCname>.<LPARname> entries provided\n");
+    argsOk = false;
+  }
+
+  if (argsOk)
+  {
+    long long fleetStartMs = currentTimeMs();
+
+    resolveFleet(&fleet, patterns, patternCpcs, patternCount);
+
+    JOB_TRACKER_TYPE *tracker = createJobTracker(&pollPolicy);
+    if (tracker != NULL)
+    {
+      printf("*>>");
+      printf("starting fleet activation of %d LPARs at %s\n",
+             fleet.itemCount, printTime());
+
+      /* with nothing in flight admission always starts an item
+         or finishes it, so the loop ends once nothing is waiting */
+      while (admitFleetActivations(&fleet, tracker) > 0 ||
+             pendingJobCount(tracker) > 0)
+      {
+        runJobTrackerOnce(tracker);
+        collectFleetCompletions(&fleet, tracker);
+      }
+
+      fleetSuccess = printFleetSummary(
+          &fleet, (currentTimeMs() - fleetStartMs) / 1000.0);
+      freeJobTracker(tracker);
+    }
+  }
+
+  for (int i = 0; i < patternCount; i++)
+  {
+    free(patterns[i]);
+  }
+  free(patterns);
+  free(patternCpcs);
+  freeFleet(&fleet);
+
+  return fleetSuccess;
+}
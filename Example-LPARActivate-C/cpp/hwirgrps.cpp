@@ -0,0 +1,990 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    MODULE NAME= HWIRGRPS                                            *
+ *                                                                     *
+ *  Sample C code that uses HWIREST API to reconcile the members of    *
+ *  custom groups with a desired membership. The groups of each CPC    *
+ *  are listed once and their members read once, then only the adds   *
+ *  and removes that differ are issued, spread over worker threads     *
+ *  with a limit on the requests in flight to each SE.                 *
+ *                                                                     *
+ *************************END OF SPECIFICATIONS************************/
+#pragma filetag("IBM-1047")     /* compile in EBCDIC */
+#pragma csect(code, "HWIRGRPS") /* name of csect */
+#pragma longName
+#if defined(__MVS__) && !defined(_OPEN_THREADS) && !defined(_UNIX03_THREADS)
+#define _OPEN_THREADS /* pthread_create of the reconcile workers */
+#endif
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <pthread.h>
+#include "hwijbind.h"
+#include "hwirstc1.h"
+#include "hwirgrps.h"
+#include "hwirlidx.h"
+
+static const JSON_BINDING_TYPE memberBindings[] = {
+    BIND_FIELD(GROUPS_MEMBER_TYPE, name, GROUP_NAME_KEY, BIND_STRING),
+    BIND_FIELD(GROUPS_MEMBER_TYPE, uri, GROUP_URI_KEY, BIND_STRING)};
+
+static JSON_SCHEMA_TYPE *memberSchema = compileSchema(memberBindings, 2);
+
+/* guards the task states, the active counts and the failure count */
+static pthread_mutex_t groupsLock = PTHREAD_MUTEX_INITIALIZER;
+
+/* signalled when a task is done and its CPC has room again */
+static pthread_cond_t groupsTaskDone = PTHREAD_COND_INITIALIZER;
+
+/*
+ * Method: addGroupsCPC
+ *
+ * Return the index of the named CPC, adding it when it is new.
+ */
+static int addGroupsCPC(GROUPS_TYPE *recon, char *cpcName)
+{
+  for (int i = 0; i < recon->cpcCount; i++)
+  {
+    if (strcmp(recon->cpcs[i].name, cpcName) == 0)
+    {
+      return i;
+    }
+  }
+
+  if (recon->cpcCount == recon->cpcCapacity)
+  {
+    int newCapacity = recon->cpcCapacity > 0 ? recon->cpcCapacity * 2 : 8;
+    GROUPS_CPC_TYPE *cpcs = (GROUPS_CPC_TYPE *)realloc(
+        recon->cpcs, newCapacity * sizeof(GROUPS_CPC_TYPE));
+    if (cpcs == NULL)
+    {
+      return -1;
+    }
+    recon->cpcs = cpcs;
+    recon->cpcCapacity = newCapacity;
+  }
+
+  GROUPS_CPC_TYPE *cpc = &recon->cpcs[recon->cpcCount];
+  memset(cpc, 0, sizeof(GROUPS_CPC_TYPE));
+  cpc->name = strdup(cpcName);
+
+  return recon->cpcCount++;
+}
+
+/*
+ * Method: addGroupsGroup
+ *
+ * Return the named group of a CPC, adding it when it is new.
+ */
+static GROUPS_GROUP_TYPE *addGroupsGroup(GROUPS_TYPE *recon, int cpcIndex,
+                                         char *groupName)
+{
+  for (int i = 0; i < recon->groupCount; i++)
+  {
+    if (recon->groups[i].cpcIndex == cpcIndex &&
+        strcmp(recon->groups[i].name, groupName) == 0)
+    {
+      return &recon->groups[i];
+    }
+  }
+
+  if (recon->groupCount == recon->groupCapacity)
+  {
+    int newCapacity = recon->groupCapacity > 0 ? recon->groupCapacity * 2
+                                               : 16;
+    GROUPS_GROUP_TYPE *groups = (GROUPS_GROUP_TYPE *)realloc(
+        recon->groups, newCapacity * sizeof(GROUPS_GROUP_TYPE));
+    if (groups == NULL)
+    {
+      return NULL;
+    }
+    recon->groups = groups;
+    recon->groupCapacity = newCapacity;
+  }
+
+  GROUPS_GROUP_TYPE *group = &recon->groups[recon->groupCount++];
+  memset(group, 0, sizeof(GROUPS_GROUP_TYPE));
+  group->cpcIndex = cpcIndex;
+  group->name = strdup(groupName);
+  group->state = GROUPS_WAITING;
+
+  return group;
+}
+
+/*
+ * Method: addGroupsMember
+ *
+ * Append an LPAR to a member array, growing it as needed.
+ */
+static GROUPS_MEMBER_TYPE *addGroupsMember(GROUPS_MEMBER_TYPE **members,
+                                           int *count, int *capacity)
+{
+  if (*count == *capacity)
+  {
+    int newCapacity = *capacity > 0 ? *capacity * 2 : 16;
+    GROUPS_MEMBER_TYPE *grown = (GROUPS_MEMBER_TYPE *)realloc(
+        *members, newCapacity * sizeof(GROUPS_MEMBER_TYPE));
+    if (grown == NULL)
+    {
+      return NULL;
+    }
+    *members = grown;
+    *capacity = newCapacity;
+  }
+
+  GROUPS_MEMBER_TYPE *member = &(*members)[(*count)++];
+  memset(member, 0, sizeof(GROUPS_MEMBER_TYPE));
+
+  return member;
+}
+
+/*
+ * Method: addGroupsSpec
+ *
+ * Record one <CPCname>.<groupname>=<LPARname>,... argument, the
+ * desired members of the group. A group named more than once gets
+ * all of the LPARs named, an empty list removes every LPAR.
+ */
+static bool addGroupsSpec(GROUPS_TYPE *recon, char *spec)
+{
+  char *equals = strchr(spec, '=');
+  char *separator = strchr(spec, '.');
+
+  if (equals == NULL || separator == NULL || separator == spec ||
+      separator + 1 >= equals)
+  {
+    printf("groups ERROR: %s is not in "
+           "<CPCname>.<groupname>=<LPARname>,... form\n",
+           spec);
+    return false;
+  }
+
+  *separator = '\0';
+  *equals = '\0';
+  int cpcIndex = addGroupsCPC(recon, spec);
+  GROUPS_GROUP_TYPE *group =
+      cpcIndex >= 0 ? addGroupsGroup(recon, cpcIndex, separator + 1) : NULL;
+  *separator = '.';
+  *equals = '=';
+
+  if (group == NULL)
+  {
+    printf("groups ERROR: out of storage\n");
+    return false;
+  }
+
+  char *list = strdup(equals + 1);
+  char *save = NULL;
+
+  for (char *name = strtok_r(list, ",", &save); name != NULL;
+       name = strtok_r(NULL, ",", &save))
+  {
+    bool known = false;
+    for (int i = 0; i < group->desiredCount && !known; i++)
+    {
+      known = strcmp(group->desired[i].name, name) == 0;
+    }
+    if (known)
+    {
+      continue;
+    }
+
+    GROUPS_MEMBER_TYPE *member = addGroupsMember(
+        &group->desired, &group->desiredCount, &group->desiredCapacity);
+    if (member == NULL)
+    {
+      printf("groups ERROR: out of storage\n");
+      free(list);
+      return false;
+    }
+    member->name = strdup(name);
+  }
+
+  free(list);
+  return true;
+}
+
+/*
+ * Method: readGroupsList
+ *
+ * Read <CPCname>.<groupname>=<LPARname>,... entries, one per line,
+ * from a data set (DD:ddname) or a file. Blank lines and lines
+ * starting with * or # are ignored.
+ */
+static bool readGroupsList(GROUPS_TYPE *recon, char *listName)
+{
+  char line[defaultLen64K];
+  bool listOk = true;
+
+  FILE *listFile = fopen(listName, "r");
+  if (listFile == NULL)
+  {
+    printf("groups ERROR: unable to open %s\n", listName);
+    return false;
+  }
+
+  while (fgets(line, sizeof(line), listFile) != NULL)
+  {
+    /* strip trailing blanks and sequence numbers of fixed records */
+    char *spec = strtok(line, " \t\r\n");
+    if (spec == NULL || spec[0] == '*' || spec[0] == '#')
+    {
+      continue;
+    }
+    if (!addGroupsSpec(recon, spec))
+    {
+      listOk = false;
+    }
+  }
+
+  fclose(listFile);
+  return listOk;
+}
+
+/* the CPC whose groups are being matched by keepListedGroup */
+typedef struct
+{
+  GROUPS_TYPE *recon;
+  int cpcIndex;
+} GROUPS_LISTING_TYPE;
+
+/*
+ * Method: keepListedGroup
+ *
+ * Stream callback that keeps the object-uri of each group listed
+ * that is to be reconciled.
+ */
+static bool keepListedGroup(int, STREAM_VALUE_TYPE *values,
+                            void *userData)
+{
+  GROUPS_LISTING_TYPE *listing = (GROUPS_LISTING_TYPE *)userData;
+  GROUPS_TYPE *recon = listing->recon;
+  GROUPS_MEMBER_TYPE listed;
+
+  memset(&listed, 0, sizeof(GROUPS_MEMBER_TYPE));
+  bindStreamedEntry(memberSchema, values, NULL, &listed);
+
+  for (int i = 0; listed.name != NULL && i < recon->groupCount; i++)
+  {
+    GROUPS_GROUP_TYPE *group = &recon->groups[i];
+    if (group->cpcIndex == listing->cpcIndex && group->uri == NULL &&
+        strcmp(group->name, listed.name) == 0)
+    {
+      group->uri = listed.uri;
+      listed.uri = NULL;
+      break;
+    }
+  }
+
+  free(listed.name);
+  free(listed.uri);
+
+  return true;
+}
+
+/*
+ * Method: listCPCGroups
+ *
+ * GET /api/groups from the SE of a CPC, one request for all of the
+ * groups of the CPC that are reconciled, as GetCustomUserGroups of
+ * RXUSRGP1. A CPC with a single group reconciled asks for that group
+ * only with ?name=, as GetUserGroupURI does.
+ */
+static bool listCPCGroups(GROUPS_TYPE *recon, int cpcIndex)
+{
+  STREAM_EXTRACT_TYPE stream;
+  GROUPS_LISTING_TYPE listing;
+  char nameParm[defaultLen2K];
+  const char *onlyGroup = NULL;
+  int groupCount = 0;
+  bool listed = false;
+
+  listing.recon = recon;
+  listing.cpcIndex = cpcIndex;
+
+  for (int i = 0; i < recon->groupCount; i++)
+  {
+    if (recon->groups[i].cpcIndex == cpcIndex)
+    {
+      onlyGroup = recon->groups[i].name;
+      groupCount++;
+    }
+  }
+
+  bool filtered =
+      groupCount == 1 && strlen(onlyGroup) + 7 <= sizeof(nameParm);
+  if (filtered)
+  {
+    sprintf(nameParm, "?name=%s", onlyGroup);
+  }
+
+  RESPBUF_TYPE *respBuf = acquireResponseBuffer(RESPBUF_LARGE);
+  if (respBuf == NULL)
+  {
+    return false;
+  }
+
+  if (queryLPARObject((char *)CUSTOM_USR_GRPS_URI,
+                      recon->cpcs[cpcIndex].targetName,
+                      filtered ? nameParm : NULL, respBuf))
+  {
+    initStreamExtract(&stream, GROUPS_LIST_KEY, keepListedGroup,
+                      &listing);
+    streamSchema(&stream, memberSchema);
+
+    if (!streamArrayEntries(&stream, respBuf->responseBody,
+                            respBuf->bodyUsed))
+    {
+      displayStreamError(&stream, "Unable to parse JSON data.");
+    }
+    else
+    {
+      listed = stream.arrayFound;
+    }
+    freeStreamExtract(&stream);
+  }
+
+  releaseResponseBuffer(respBuf);
+
+  return listed;
+}
+
+/*
+ * Method: discoverGroups
+ *
+ * Resolve each CPC, list its groups and index its LPARs once, then
+ * resolve the desired members of every group from that index. An
+ * LPAR that is not on the CPC is left out of the desired members.
+ */
+static void discoverGroups(GROUPS_TYPE *recon)
+{
+  for (int i = 0; i < recon->cpcCount; i++)
+  {
+    GROUPS_CPC_TYPE *cpc = &recon->cpcs[i];
+
+    cpc->resolved = resolveCPC(cpc->name, &cpc->uri, &cpc->targetName) &&
+                    listCPCGroups(recon, i);
+
+    if (cpc->resolved && findLPARIndex(cpc->targetName) == NULL)
+    {
+      indexLPARs(cpc->uri, cpc->targetName);
+    }
+  }
+
+  for (int i = 0; i < recon->groupCount; i++)
+  {
+    GROUPS_GROUP_TYPE *group = &recon->groups[i];
+    GROUPS_CPC_TYPE *cpc = &recon->cpcs[group->cpcIndex];
+    LPAR_INDEX_TYPE *index =
+        cpc->resolved ? findLPARIndex(cpc->targetName) : NULL;
+
+    if (!cpc->resolved)
+    {
+      group->outcome = "no CPC";
+    }
+    else if (group->uri == NULL)
+    {
+      group->outcome = "no group";
+    }
+    else if (index == NULL)
+    {
+      group->outcome = "no LPARs";
+    }
+
+    if (group->outcome != NULL)
+    {
+      group->state = GROUPS_DONE;
+      continue;
+    }
+
+    int kept = 0;
+    for (int j = 0; j < group->desiredCount; j++)
+    {
+      GROUPS_MEMBER_TYPE *member = &group->desired[j];
+      LPAR_INFO_TYPE *lpar = lookupIndexedLPAR(index, member->name);
+
+      if (lpar == NULL)
+      {
+        printf("groups: no LPAR %s on CPC %s, not added to %s\n",
+               member->name, cpc->name, group->name);
+        free(member->name);
+        continue;
+      }
+      member->uri = strdup(lpar->uri);
+      group->desired[kept++] = *member;
+    }
+    group->desiredCount = kept;
+  }
+}
+
+/*
+ * Method: keepGroupMember
+ *
+ * Stream callback that adds an entry of the members array to the
+ * current members of the group.
+ */
+static bool keepGroupMember(int, STREAM_VALUE_TYPE *values,
+                            void *userData)
+{
+  GROUPS_GROUP_TYPE *group = (GROUPS_GROUP_TYPE *)userData;
+
+  GROUPS_MEMBER_TYPE *member = addGroupsMember(
+      &group->members, &group->memberCount, &group->memberCapacity);
+  if (member == NULL)
+  {
+    return false;
+  }
+
+  bindStreamedEntry(memberSchema, values, NULL, member);
+  if (member->uri == NULL)
+  {
+    free(member->name);
+    group->memberCount--;
+  }
+
+  return true;
+}
+
+/*
+ * Method: readGroupMembers
+ *
+ * GET /api/groups/{group-id}/members, the name and object-uri of each
+ * member as GetCustomGroupMems of RXUSRGP1 reads them.
+ */
+static bool readGroupMembers(GROUPS_TYPE *recon, GROUPS_GROUP_TYPE *group)
+{
+  STREAM_EXTRACT_TYPE stream;
+  bool listed = false;
+
+  RESPBUF_TYPE *respBuf = acquireResponseBuffer(RESPBUF_LARGE);
+  if (respBuf == NULL)
+  {
+    return false;
+  }
+
+  if (queryLPARObject(group->uri, recon->cpcs[group->cpcIndex].targetName,
+                      (char *)GROUP_MEMBERS_URI, respBuf))
+  {
+    initStreamExtract(&stream, GROUP_MEMBERS_KEY, keepGroupMember,
+                      group);
+    streamSchema(&stream, memberSchema);
+
+    listed = streamArrayEntries(&stream, respBuf->responseBody,
+                                respBuf->bodyUsed) &&
+             stream.arrayFound && !stream.stopped;
+    freeStreamExtract(&stream);
+  }
+
+  releaseResponseBuffer(respBuf);
+
+  if (!listed)
+  {
+    group->outcome = "failed";
+  }
+
+  return listed;
+}
+
+/*
+ * Method: applyGroupOp
+ *
+ * POST add-member or remove-member for one LPAR of a group, with the
+ * request body of AddGroupMember and RemoveGroupMember of RXUSRGP1.
+ */
+static bool applyGroupOp(GROUPS_TYPE *recon, GROUPS_OP_TYPE *op)
+{
+  GROUPS_GROUP_TYPE *group = &recon->groups[op->groupIndex];
+  char uri[defaultLen2K];
+  char requestBody[defaultLen2K];
+
+  if (strlen(group->uri) + 32 > sizeof(uri) ||
+      strlen(op->lpar->uri) + 32 > sizeof(requestBody))
+  {
+    printf("groups ERROR: uri of %s too long\n", op->lpar->name);
+    return false;
+  }
+
+  sprintf(uri, "%s/operations/%s", group->uri,
+          op->opType == GROUPS_OP_ADD ? ADD_GROUP_MEMBER_OP
+                                      : RMV_GROUP_MEMBER_OP);
+  sprintf(requestBody, "{\"" GROUP_URI_KEY "\":\"%s\"}", op->lpar->uri);
+
+  RESPBUF_TYPE *respBuf = acquireResponseBuffer(RESPBUF_SMALL);
+  if (respBuf == NULL)
+  {
+    return false;
+  }
+
+  op->applied = syncPost(uri, recon->cpcs[group->cpcIndex].targetName,
+                         requestBody, respBuf);
+  if (!op->applied)
+  {
+    op->httpStatus = respBuf->error.httpStatus;
+    op->reason = (respBuf->error.found & ERROR_FOUND_REASON)
+                     ? respBuf->error.reason
+                     : -1;
+  }
+
+  releaseResponseBuffer(respBuf);
+
+  return op->applied;
+}
+
+/*
+ * Method: taskState
+ *
+ * returns: state of a task of the current list, a group or an op
+ */
+static int *taskState(GROUPS_TYPE *recon, int task)
+{
+  return recon->applying ? &recon->ops[task].state
+                         : &recon->groups[task].state;
+}
+
+/*
+ * Method: taskCPC
+ */
+static GROUPS_CPC_TYPE *taskCPC(GROUPS_TYPE *recon, int task)
+{
+  int groupIndex = recon->applying ? recon->ops[task].groupIndex : task;
+
+  return &recon->cpcs[recon->groups[groupIndex].cpcIndex];
+}
+
+/*
+ * Method: groupsWorker
+ *
+ * Take the first waiting task whose CPC is below the per CPC limit
+ * until all have been taken, waiting for a task to finish when every
+ * waiting task is on a CPC at its limit.
+ */
+static void *groupsWorker(void *data)
+{
+  GROUPS_TYPE *recon = (GROUPS_TYPE *)data;
+
+  pthread_mutex_lock(&groupsLock);
+  while (true)
+  {
+    int task = -1;
+    bool waiting = false;
+
+    while (recon->firstWaiting < recon->taskCount &&
+           *taskState(recon, recon->firstWaiting) != GROUPS_WAITING)
+    {
+      recon->firstWaiting++;
+    }
+
+    for (int i = recon->firstWaiting; i < recon->taskCount; i++)
+    {
+      if (*taskState(recon, i) == GROUPS_WAITING)
+      {
+        waiting = true;
+        if (taskCPC(recon, i)->active < recon->maxActivePerCPC)
+        {
+          task = i;
+          break;
+        }
+      }
+    }
+
+    if (task < 0)
+    {
+      if (!waiting)
+      {
+        break;
+      }
+      pthread_cond_wait(&groupsTaskDone, &groupsLock);
+      continue;
+    }
+
+    GROUPS_CPC_TYPE *cpc = taskCPC(recon, task);
+    *taskState(recon, task) = GROUPS_ACTIVE;
+    if (++cpc->active > cpc->peak)
+    {
+      cpc->peak = cpc->active;
+    }
+    pthread_mutex_unlock(&groupsLock);
+
+    bool taskOk = recon->applying
+                      ? applyGroupOp(recon, &recon->ops[task])
+                      : readGroupMembers(recon, &recon->groups[task]);
+
+    pthread_mutex_lock(&groupsLock);
+    cpc->active--;
+    *taskState(recon, task) = GROUPS_DONE;
+    recon->failed += taskOk ? 0 : 1;
+    pthread_cond_broadcast(&groupsTaskDone);
+  }
+  pthread_mutex_unlock(&groupsLock);
+
+  return NULL;
+}
+
+/*
+ * Method: runGroupsWorkers
+ *
+ * Start up to -MAX threads over the groups, or over the ops when
+ * applying, and wait for them. The calling thread works too when
+ * threads cannot be created.
+ *
+ * returns: number of workers started
+ */
+static int runGroupsWorkers(GROUPS_TYPE *recon, bool applying)
+{
+  recon->applying = applying;
+  recon->taskCount = applying ? recon->opCount : recon->groupCount;
+  recon->firstWaiting = 0;
+
+  int workers = recon->maxActive < recon->taskCount ? recon->maxActive
+                                                    : recon->taskCount;
+
+  return runRequestWorkers("groups", workers, groupsWorker, recon);
+}
+
+/*
+ * Method: compareMemberUris
+ */
+static int compareMemberUris(const void *left, const void *right)
+{
+  return strcmp(((const GROUPS_MEMBER_TYPE *)left)->uri,
+                ((const GROUPS_MEMBER_TYPE *)right)->uri);
+}
+
+/*
+ * Method: addGroupsOp
+ */
+static bool addGroupsOp(GROUPS_TYPE *recon, int groupIndex, int opType,
+                        GROUPS_MEMBER_TYPE *lpar)
+{
+  if (recon->opCount == recon->opCapacity)
+  {
+    int newCapacity = recon->opCapacity > 0 ? recon->opCapacity * 2 : 64;
+    GROUPS_OP_TYPE *ops = (GROUPS_OP_TYPE *)realloc(
+        recon->ops, newCapacity * sizeof(GROUPS_OP_TYPE));
+    if (ops == NULL)
+    {
+      printf("groups ERROR: out of storage\n");
+      return false;
+    }
+    recon->ops = ops;
+    recon->opCapacity = newCapacity;
+  }
+
+  GROUPS_OP_TYPE *op = &recon->ops[recon->opCount++];
+  memset(op, 0, sizeof(GROUPS_OP_TYPE));
+  op->groupIndex = groupIndex;
+  op->opType = opType;
+  op->lpar = lpar;
+  op->state = GROUPS_WAITING;
+
+  return true;
+}
+
+/*
+ * Method: planGroups
+ *
+ * Compare the desired and the current members of each group that
+ * was read, both sorted by uri, and add an op for each LPAR that is
+ * only in one of them. Members in both are left alone, and so are
+ * members that are not LPARs, e.g. a CPC, as only LPARs are named.
+ */
+static bool planGroups(GROUPS_TYPE *recon)
+{
+  for (int g = 0; g < recon->groupCount; g++)
+  {
+    GROUPS_GROUP_TYPE *group = &recon->groups[g];
+    if (group->outcome != NULL)
+    {
+      continue;
+    }
+
+    qsort(group->desired, group->desiredCount, sizeof(GROUPS_MEMBER_TYPE),
+          compareMemberUris);
+    qsort(group->members, group->memberCount, sizeof(GROUPS_MEMBER_TYPE),
+          compareMemberUris);
+
+    int d = 0;
+    int m = 0;
+    while (d < group->desiredCount || m < group->memberCount)
+    {
+      int order = d == group->desiredCount ? 1
+                  : m == group->memberCount
+                      ? -1
+                      : strcmp(group->desired[d].uri,
+                               group->members[m].uri);
+      bool opOk = true;
+
+      if (order < 0)
+      {
+        opOk = addGroupsOp(recon, g, GROUPS_OP_ADD, &group->desired[d++]);
+      }
+      else if (order > 0 &&
+               strncmp(group->members[m].uri, LPAR_MEMBER_URI,
+                       sizeof(LPAR_MEMBER_URI) - 1) != 0)
+      {
+        group->unchanged++;
+        m++;
+      }
+      else if (order > 0)
+      {
+        opOk = addGroupsOp(recon, g, GROUPS_OP_REMOVE,
+                           &group->members[m++]);
+      }
+      else
+      {
+        group->unchanged++;
+        d++;
+        m++;
+      }
+
+      if (!opOk)
+      {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+/*
+ * Method: printGroupsOps
+ *
+ * Print one row per op with its outcome, or the plan with -PLAN.
+ */
+static void printGroupsOps(GROUPS_TYPE *recon)
+{
+  printf("%-8s %-16s %-6s %-8s %s\n", "CPC", "GROUP", "CHANGE", "LPAR",
+         "OUTCOME");
+
+  for (int i = 0; i < recon->groupCount; i++)
+  {
+    GROUPS_GROUP_TYPE *group = &recon->groups[i];
+    if (group->outcome != NULL)
+    {
+      printf("%-8s %-16s %-6s %-8s %s\n", recon->cpcs[group->cpcIndex].name,
+             group->name, "-", "-", group->outcome);
+    }
+  }
+
+  for (int i = 0; i < recon->opCount; i++)
+  {
+    GROUPS_OP_TYPE *op = &recon->ops[i];
+    GROUPS_GROUP_TYPE *group = &recon->groups[op->groupIndex];
+
+    printf("%-8s %-16s %-6s %-8s ", recon->cpcs[group->cpcIndex].name,
+           group->name, op->opType == GROUPS_OP_ADD ? "add" : "remove",
+           op->lpar->name != NULL ? op->lpar->name : op->lpar->uri);
+    if (recon->planOnly)
+    {
+      printf("planned\n");
+    }
+    else if (op->applied)
+    {
+      printf("done\n");
+    }
+    else
+    {
+      printf("failed, http-status %d reason %d\n", op->httpStatus,
+             op->reason);
+    }
+  }
+}
+
+/*
+ * Method: freeGroupsMembers
+ */
+static void freeGroupsMembers(GROUPS_MEMBER_TYPE *members, int count)
+{
+  for (int i = 0; i < count; i++)
+  {
+    free(members[i].name);
+    free(members[i].uri);
+  }
+  free(members);
+}
+
+/*
+ * Method: freeGroups
+ *
+ * Free all storage held by the reconciliation.
+ */
+static void freeGroups(GROUPS_TYPE *recon)
+{
+  for (int i = 0; i < recon->cpcCount; i++)
+  {
+    free(recon->cpcs[i].name);
+    free(recon->cpcs[i].uri);
+    free(recon->cpcs[i].targetName);
+  }
+  for (int i = 0; i < recon->groupCount; i++)
+  {
+    free(recon->groups[i].name);
+    free(recon->groups[i].uri);
+    freeGroupsMembers(recon->groups[i].desired,
+                      recon->groups[i].desiredCount);
+    freeGroupsMembers(recon->groups[i].members,
+                      recon->groups[i].memberCount);
+  }
+  free(recon->cpcs);
+  free(recon->groups);
+  free(recon->ops);
+}
+
+/*
+ * Method: runGroupReconcile
+ *
+ * Make the members of custom groups the LPARs named:
+ *   -GROUPS [-MAX n] [-MAXCPC n] [-PLAN] entry ...
+ * where each entry is <CPCname>.<groupname>=<LPARname>,... or the
+ * name of a data set (DD:ddname) or file (/path) holding one such
+ * entry per line. The groups of each CPC are listed and their members
+ * read once, then only the differences are added or removed, at most
+ * -MAX requests at a time and -MAXCPC at a time on one SE. -PLAN
+ * prints the differences without changing the groups.
+ *
+ * returns: true if every group was reconciled
+ */
+bool runGroupReconcile(int argc, char **argv)
+{
+  GROUPS_TYPE recon;
+  bool argsOk = true;
+  bool reconcileSuccess = false;
+
+  memset(&recon, 0, sizeof(GROUPS_TYPE));
+  recon.maxActive = GROUPS_MAX_ACTIVE;
+  recon.maxActivePerCPC = GROUPS_MAX_ACTIVE_CPC;
+
+  /* argv[1] is -GROUPS */
+  for (int i = 2; i < argc && argsOk; i++)
+  {
+    if (strcasecmp(argv[i], "-MAX") == 0 && i + 1 < argc)
+    {
+      recon.maxActive = atoi(argv[++i]);
+    }
+    else if (strcasecmp(argv[i], "-MAXCPC") == 0 && i + 1 < argc)
+    {
+      recon.maxActivePerCPC = atoi(argv[++i]);
+    }
+    else if (strcasecmp(argv[i], "-PLAN") == 0)
+    {
+      recon.planOnly = true;
+    }
+    else if (strncasecmp(argv[i], "DD:", 3) == 0 || argv[i][0] == '/')
+    {
+      argsOk = readGroupsList(&recon, argv[i]);
+    }
+    else
+    {
+      argsOk = addGroupsSpec(&recon, argv[i]);
+    }
+  }
+
+  if (recon.maxActive < 1 || recon.maxActivePerCPC < 1)
+  {
+    printf("groups ERROR: concurrency limits must be at least 1\n");
+    argsOk = false;
+  }
+  else if (argsOk && recon.groupCount == 0)
+  {
+    printf("groups ERROR: no <CPCname>.<groupname>=<LPARname>,... "
+           "entries provided\n");
+    argsOk = false;
+  }
+
+  if (argsOk)
+  {
+    long long startMs = currentTimeMs();
+
+    printf("*>>");
+    printf("reconciling %d groups on %d CPCs at %s\n", recon.groupCount,
+           recon.cpcCount, printTime());
+
+    discoverGroups(&recon);
+    runGroupsWorkers(&recon, false);
+    int unreadGroups = recon.failed;
+    double discoverSeconds = (currentTimeMs() - startMs) / 1000.0;
+
+    int current = 0;
+    int unchanged = 0;
+    int adds = 0;
+    bool planOk = planGroups(&recon);
+
+    for (int i = 0; i < recon.groupCount; i++)
+    {
+      current += recon.groups[i].memberCount;
+      unchanged += recon.groups[i].unchanged;
+    }
+    for (int i = 0; i < recon.opCount; i++)
+    {
+      adds += recon.ops[i].opType == GROUPS_OP_ADD ? 1 : 0;
+    }
+
+    printf("*>>");
+    printf("read %d groups with %d members in %.3f seconds: %d unchanged, "
+           "%d to add, %d to remove\n",
+           recon.groupCount, current, discoverSeconds, unchanged, adds,
+           recon.opCount - adds);
+
+    if (planOk && !recon.planOnly && recon.opCount > 0)
+    {
+      long long applyStartMs = currentTimeMs();
+
+      recon.failed = 0;
+      for (int i = 0; i < recon.cpcCount; i++)
+      {
+        recon.cpcs[i].peak = 0;
+      }
+      int workers = runGroupsWorkers(&recon, true);
+      int peak = 0;
+
+      for (int i = 0; i < recon.cpcCount; i++)
+      {
+        peak = recon.cpcs[i].peak > peak ? recon.cpcs[i].peak : peak;
+      }
+
+      printGroupsOps(&recon);
+      printf("*>>");
+      printf("applied %d of %d changes with %d workers, at most %d at a "
+             "time on one CPC, in %.3f seconds\n",
+             recon.opCount - recon.failed, recon.opCount, workers, peak,
+             (currentTimeMs() - applyStartMs) / 1000.0);
+    }
+    else if (planOk)
+    {
+      printGroupsOps(&recon);
+    }
+
+    bool groupsOk = true;
+    for (int i = 0; i < recon.groupCount; i++)
+    {
+      groupsOk = groupsOk && recon.groups[i].outcome == NULL;
+    }
+
+    reconcileSuccess = planOk && groupsOk && unreadGroups == 0 &&
+                       recon.failed == 0;
+  }
+
+  freeGroups(&recon);
+
+  return reconcileSuccess;
+}
@@ -0,0 +1,487 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    MODULE NAME= HWIRJOBS                                            *
+ *                                                                     *
+ *  Sample C code that tracks any number of outstanding job URIs       *
+ *  returned by asynchronous POST operations and POLLs all of them     *
+ *  from a single scheduler loop, earliest next poll first.            *
+ *  Completed jobs are delivered through a callback and a completion   *
+ *  queue as soon as they finish.                                      *
+ *                                                                     *
+ *************************END OF SPECIFICATIONS************************/
+#pragma filetag("IBM-1047")     /* compile in EBCDIC */
+#pragma csect(code, "HWIRJOBS") /* name of csect */
+#pragma longName
+#include <stdlib.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <string.h>
+#include "hwirjobs.h"
+#include "hwirstc1.h"
+
+/* initial number of job slots, doubled as needed */
+static const int initialJobCapacity = 16;
+
+/*
+ * Method: heapLess
+ *
+ * Ordering of the pending heap, earliest next poll first and
+ * the oldest job first for equal times.
+ */
+static bool heapLess(JOB_ENTRY_TYPE *a, JOB_ENTRY_TYPE *b)
+{
+  if (a->nextPollMs != b->nextPollMs)
+  {
+    return a->nextPollMs < b->nextPollMs;
+  }
+  return a->jobId < b->jobId;
+}
+
+/*
+ * Method: heapPush
+ *
+ * Add a job to the pending heap.
+ */
+static void heapPush(JOB_TRACKER_TYPE *tracker, JOB_ENTRY_TYPE *job)
+{
+  int child = tracker->pendingCount++;
+
+  while (child > 0)
+  {
+    int parent = (child - 1) / 2;
+    if (!heapLess(job, tracker->pending[parent]))
+    {
+      break;
+    }
+    tracker->pending[child] = tracker->pending[parent];
+    child = parent;
+  }
+  tracker->pending[child] = job;
+}
+
+/*
+ * Method: heapPop
+ *
+ * Remove and return the job with the earliest next poll.
+ */
+static JOB_ENTRY_TYPE *heapPop(JOB_TRACKER_TYPE *tracker)
+{
+  JOB_ENTRY_TYPE *top = tracker->pending[0];
+  JOB_ENTRY_TYPE *last = tracker->pending[--tracker->pendingCount];
+  int parent = 0;
+
+  while (true)
+  {
+    int child = 2 * parent + 1;
+    if (child >= tracker->pendingCount)
+    {
+      break;
+    }
+    if (child + 1 < tracker->pendingCount &&
+        heapLess(tracker->pending[child + 1], tracker->pending[child]))
+    {
+      child++;
+    }
+    if (!heapLess(tracker->pending[child], last))
+    {
+      break;
+    }
+    tracker->pending[parent] = tracker->pending[child];
+    parent = child;
+  }
+  if (tracker->pendingCount > 0)
+  {
+    tracker->pending[parent] = last;
+  }
+
+  return top;
+}
+
+/*
+ * Method: growTracker
+ *
+ * Make room for one more job in the job, pending
+ * and completion arrays.
+ */
+static bool growTracker(JOB_TRACKER_TYPE *tracker)
+{
+  if (tracker->jobCount < tracker->jobCapacity)
+  {
+    return true;
+  }
+
+  int newCapacity = tracker->jobCapacity * 2;
+  JOB_ENTRY_TYPE **jobs = (JOB_ENTRY_TYPE **)realloc(
+      tracker->jobs, newCapacity * sizeof(JOB_ENTRY_TYPE *));
+  if (jobs == NULL)
+  {
+    return false;
+  }
+  tracker->jobs = jobs;
+
+  JOB_ENTRY_TYPE **pending = (JOB_ENTRY_TYPE **)realloc(
+      tracker->pending, newCapacity * sizeof(JOB_ENTRY_TYPE *));
+  if (pending == NULL)
+  {
+    return false;
+  }
+  tracker->pending = pending;
+
+  JOB_ENTRY_TYPE **completed = (JOB_ENTRY_TYPE **)realloc(
+      tracker->completed, newCapacity * sizeof(JOB_ENTRY_TYPE *));
+  if (completed == NULL)
+  {
+    return false;
+  }
+  tracker->completed = completed;
+
+  tracker->jobCapacity = newCapacity;
+  return true;
+}
+
+/*
+ * Method: createJobTracker
+ *
+ * Create an empty tracker that polls with the given policy.
+ */
+JOB_TRACKER_TYPE *createJobTracker(POLL_POLICY_TYPE *policy)
+{
+  JOB_TRACKER_TYPE *tracker =
+      (JOB_TRACKER_TYPE *)calloc(1, sizeof(JOB_TRACKER_TYPE));
+  if (tracker == NULL)
+  {
+    printf("createJobTracker ERROR: out of storage\n");
+    return NULL;
+  }
+
+  tracker->policy = policy;
+  tracker->jitterSeed = (unsigned int)(currentTimeMs() ^ getpid()) ^
+                        (unsigned int)(size_t)tracker;
+  tracker->jobCapacity = initialJobCapacity;
+  tracker->jobs = (JOB_ENTRY_TYPE **)malloc(
+      initialJobCapacity * sizeof(JOB_ENTRY_TYPE *));
+  tracker->pending = (JOB_ENTRY_TYPE **)malloc(
+      initialJobCapacity * sizeof(JOB_ENTRY_TYPE *));
+  tracker->completed = (JOB_ENTRY_TYPE **)malloc(
+      initialJobCapacity * sizeof(JOB_ENTRY_TYPE *));
+
+  if (tracker->jobs == NULL || tracker->pending == NULL ||
+      tracker->completed == NULL)
+  {
+    printf("createJobTracker ERROR: out of storage\n");
+    freeJobTracker(tracker);
+    return NULL;
+  }
+
+  return tracker;
+}
+
+/*
+ * Method: trackJob
+ *
+ * Start tracking a job uri. The first poll is scheduled near the
+ * completion time learned for the operation type.
+ *
+ * input arguments: tracker, job uri, target name, description,
+ *                  operation type, optional completion callback
+ *                  and the data passed to it
+ * output: the job entry, owned by the tracker
+ */
+JOB_ENTRY_TYPE *trackJob(JOB_TRACKER_TYPE *tracker,
+                         char *jobUri,
+                         char *targetName,
+                         char *description,
+                         int opType,
+                         JOB_CALLBACK_TYPE callback,
+                         void *userData)
+{
+  if (jobUri == NULL || targetName == NULL)
+  {
+    printf("trackJob ERROR: missing job uri or target name\n");
+    return NULL;
+  }
+
+  if (!growTracker(tracker))
+  {
+    printf("trackJob ERROR: out of storage\n");
+    return NULL;
+  }
+
+  JOB_ENTRY_TYPE *job = (JOB_ENTRY_TYPE *)calloc(1, sizeof(JOB_ENTRY_TYPE));
+  if (job == NULL)
+  {
+    printf("trackJob ERROR: out of storage\n");
+    return NULL;
+  }
+
+  job->jobId = tracker->jobCount;
+  job->jobUri = strdup(jobUri);
+  job->targetName = strdup(targetName);
+  job->description = description != NULL ? strdup(description) : NULL;
+  job->opType = opType;
+  job->jobStatusCode = -1;
+  job->jobReasonCode = -1;
+  job->callback = callback;
+  job->userData = userData;
+
+  job->startMs = currentTimeMs();
+  job->intervalMs = tracker->policy->initialIntervalMs;
+  job->nextPollMs = job->startMs +
+                    applyJitterMs(firstPollDelayMs(opType, tracker->policy),
+                                  tracker->policy, &tracker->jitterSeed);
+  if (tracker->policy->deadlineSec > 0)
+  {
+    job->deadlineMs = job->startMs +
+                      (long long)tracker->policy->deadlineSec * 1000;
+    if (job->nextPollMs > job->deadlineMs)
+    {
+      job->nextPollMs = job->deadlineMs;
+    }
+  }
+
+  tracker->jobs[tracker->jobCount++] = job;
+  heapPush(tracker, job);
+
+  return job;
+}
+
+/*
+ * Method: asyncPostTracked
+ *
+ * Issue an asynchronous POST operation and track the resulting
+ * job uri instead of waiting for it.
+ *
+ * input arguments: tracker, uri, target name, request body,
+ *                  description, operation type, optional completion
+ *                  callback and the data passed to it
+ * output: the job entry, or NULL if the POST failed
+ */
+JOB_ENTRY_TYPE *asyncPostTracked(JOB_TRACKER_TYPE *tracker,
+                                 char *uriArg,
+                                 char *targetNameArg,
+                                 char *requestBodyArg,
+                                 char *description,
+                                 int opType,
+                                 JOB_CALLBACK_TYPE callback,
+                                 void *userData)
+{
+  char *jobUri = (char *)malloc(defaultLen2K);
+  JOB_ENTRY_TYPE *job = NULL;
+
+  if (jobUri != NULL &&
+      asyncPost(uriArg, targetNameArg, requestBodyArg, jobUri))
+  {
+    job = trackJob(tracker, jobUri, targetNameArg, description, opType,
+                   callback, userData);
+  }
+
+  free(jobUri);
+  return job;
+}
+
+/*
+ * Method: completeJob
+ *
+ * Move a finished job to the completion queue, learn its completion
+ * time and run its callback.
+ */
+static void completeJob(JOB_TRACKER_TYPE *tracker, JOB_ENTRY_TYPE *job)
+{
+  job->done = true;
+
+  /* the job finished somewhere between the last two polls or, when it
+     was never seen running, before the first poll, whose time is then
+     taken as an upper bound
+  */
+  if (!job->pollResult.timedOut && job->status != NULL &&
+      strcmp(statusJobComplete, job->status) == 0)
+  {
+    recordPollCompletion(job->opType,
+                         job->pollResult.lastRunningSeconds > 0
+                             ? (job->pollResult.lastRunningSeconds +
+                                job->pollResult.detectSeconds) /
+                                   2
+                             : job->pollResult.detectSeconds);
+  }
+
+  tracker->completed[tracker->completedHead + tracker->completedCount] = job;
+  tracker->completedCount++;
+
+  if (job->callback != NULL)
+  {
+    job->callback(job, job->userData);
+  }
+}
+
+/*
+ * Method: pollTrackedJob
+ *
+ * GET the job uri once and update the job entry. A job that is still
+ * running is rescheduled with the next backoff interval, unless its
+ * deadline has been reached.
+ */
+static void pollTrackedJob(JOB_TRACKER_TYPE *tracker, JOB_ENTRY_TYPE *job)
+{
+  JOB_STATUS_TYPE jobStatus;
+  bool polled = getJobStatus(job->jobUri, job->targetName, &jobStatus);
+  long long nowMs = currentTimeMs();
+
+  job->pollResult.polls++;
+  job->pollResult.detectSeconds = (nowMs - job->startMs) / 1000.0;
+
+  if (!polled)
+  {
+    /* as with pollJobUri, a failed status request ends the polling */
+    completeJob(tracker, job);
+    return;
+  }
+
+  /* the status is only copied when it changed */
+  if (job->status == NULL || strcmp(job->status, jobStatus.status) != 0)
+  {
+    free(job->status);
+    job->status = strdup(jobStatus.status);
+  }
+  job->jobStatusCode = jobStatus.jobStatusCode;
+  job->jobReasonCode = jobStatus.jobReasonCode;
+
+  if (!jobStatus.running)
+  {
+    completeJob(tracker, job);
+    return;
+  }
+
+  job->pollResult.lastRunningSeconds = job->pollResult.detectSeconds;
+
+  if (job->deadlineMs > 0 && nowMs >= job->deadlineMs)
+  {
+    job->pollResult.timedOut = true;
+    completeJob(tracker, job);
+    return;
+  }
+
+  job->nextPollMs = nowMs + applyJitterMs(job->intervalMs, tracker->policy,
+                                          &tracker->jitterSeed);
+  if (job->deadlineMs > 0 && job->nextPollMs > job->deadlineMs)
+  {
+    job->nextPollMs = job->deadlineMs;
+  }
+  job->intervalMs = nextPollDelayMs(job->intervalMs, tracker->policy);
+
+  heapPush(tracker, job);
+}
+
+/*
+ * Method: runJobTrackerOnce
+ *
+ * Wait until the earliest scheduled poll is due and issue it.
+ * Callers that need to do other work between polls (e.g. start
+ * more operations) call this in their own loop.
+ *
+ * output: false if there was no pending job to poll
+ */
+bool runJobTrackerOnce(JOB_TRACKER_TYPE *tracker)
+{
+  if (tracker->pendingCount == 0)
+  {
+    return false;
+  }
+
+  long long waitMs = tracker->pending[0]->nextPollMs - currentTimeMs();
+  if (waitMs > 0)
+  {
+    sleepMs((int)waitMs);
+  }
+
+  pollTrackedJob(tracker, heapPop(tracker));
+  return true;
+}
+
+/*
+ * Method: runJobTracker
+ *
+ * POLL until every tracked job has finished or timed out.
+ */
+void runJobTracker(JOB_TRACKER_TYPE *tracker)
+{
+  while (runJobTrackerOnce(tracker))
+  {
+  }
+}
+
+/*
+ * Method: nextCompletedJob
+ *
+ * Remove the oldest entry from the completion queue.
+ *
+ * output: the job, or NULL if no job has completed since the last call
+ */
+JOB_ENTRY_TYPE *nextCompletedJob(JOB_TRACKER_TYPE *tracker)
+{
+  if (tracker->completedCount == 0)
+  {
+    return NULL;
+  }
+
+  tracker->completedCount--;
+  return tracker->completed[tracker->completedHead++];
+}
+
+/*
+ * Method: pendingJobCount
+ *
+ * Number of jobs still being polled.
+ */
+int pendingJobCount(JOB_TRACKER_TYPE *tracker)
+{
+  return tracker->pendingCount;
+}
+
+/*
+ * Method: freeJobTracker
+ *
+ * Free the tracker and every job entry it owns, and save the
+ * completion times learned from its jobs.
+ */
+void freeJobTracker(JOB_TRACKER_TYPE *tracker)
+{
+  if (tracker == NULL)
+  {
+    return;
+  }
+
+  savePollHistory();
+
+  for (int i = 0; i < tracker->jobCount; i++)
+  {
+    JOB_ENTRY_TYPE *job = tracker->jobs[i];
+    free(job->jobUri);
+    free(job->targetName);
+    free(job->description);
+    free(job->status);
+    free(job);
+  }
+
+  free(tracker->jobs);
+  free(tracker->pending);
+  free(tracker->completed);
+  free(tracker);
+}
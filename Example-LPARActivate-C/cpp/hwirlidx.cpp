@@ -0,0 +1,231 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ ***********************************************************************
+ *                                                                     *
+ *    MODULE NAME= HWIRLIDX                                            *
+ *                                                                     *
+ *  Sample C code that indexes all LPARs of a CPC by name from one     *
+ *  List Logical Partitions of CPC request, so resolving any number    *
+ *  of LPARs on that CPC costs a single round trip.                    *
+ *                                                                     *
+ *************************END OF SPECIFICATIONS************************/
+#pragma filetag("IBM-1047")     /* compile in EBCDIC */
+#pragma csect(code, "HWIRLIDX") /* name of csect */
+#pragma longName
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "hwircach.h"
+#include "hwirlidx.h"
+
+/* indexes built during this run, one per CPC */
+static LPAR_INDEX_TYPE *lparIndexes = NULL;
+
+/*
+ * Method: nameHash
+ *
+ * FNV-1a hash of an LPAR name.
+ */
+static unsigned int nameHash(const char *name)
+{
+  unsigned int hash = 2166136261u;
+
+  for (const char *c = name; *c != '\0'; c++)
+  {
+    hash = (hash ^ (unsigned char)*c) * 16777619u;
+  }
+
+  return hash;
+}
+
+/*
+ * Method: freeLPARIndex
+ *
+ * Free one index together with the LPAR list it owns.
+ */
+static void freeLPARIndex(LPAR_INDEX_TYPE *index)
+{
+  freeLPARList(index->lpars, index->lparCount);
+  free(index->slots);
+  free(index->cpcTargetName);
+  free(index);
+}
+
+/*
+ * Method: indexLPARs
+ *
+ * Issue List Logical Partitions of CPC operation for all LPARs and
+ * index the response by LPAR name. The index replaces any earlier
+ * one for the same CPC, and every LPAR is also written to the
+ * resolution cache.
+ *
+ * input arguments: CPC uri and target name
+ * returns: the index, NULL if the request failed
+ */
+LPAR_INDEX_TYPE *indexLPARs(char *cpcUri, char *cpcTargetName)
+{
+  LPAR_INFO_TYPE *lparList = NULL;
+
+  int lparCount = listLPARs(cpcUri, cpcTargetName, &lparList);
+  if (lparCount < 0)
+  {
+    return NULL;
+  }
+
+  LPAR_INDEX_TYPE *index =
+      (LPAR_INDEX_TYPE *)calloc(1, sizeof(LPAR_INDEX_TYPE));
+  if (index == NULL)
+  {
+    freeLPARList(lparList, lparCount);
+    return NULL;
+  }
+
+  index->lpars = lparList;
+  index->lparCount = lparCount;
+
+  /* keep the table at most half full */
+  index->slotCount = 16;
+  while (index->slotCount < lparCount * 2)
+  {
+    index->slotCount *= 2;
+  }
+
+  index->slots = (int *)calloc(index->slotCount, sizeof(int));
+  index->cpcTargetName = strdup(cpcTargetName);
+  if (index->slots == NULL || index->cpcTargetName == NULL)
+  {
+    printf("indexLPARs ERROR: unable to allocate the LPAR index\n");
+    freeLPARIndex(index);
+    return NULL;
+  }
+
+  for (int i = 0; i < lparCount; i++)
+  {
+    unsigned int slot = nameHash(lparList[i].name);
+    while (index->slots[slot & (index->slotCount - 1)] != 0)
+    {
+      slot++;
+    }
+    index->slots[slot & (index->slotCount - 1)] = i + 1;
+
+    cacheStore(cpcTargetName, lparList[i].name,
+               lparList[i].uri, lparList[i].targetName);
+  }
+
+  /* replace the index of this CPC built earlier in the run */
+  LPAR_INDEX_TYPE **link = &lparIndexes;
+  while (*link != NULL)
+  {
+    if (strcmp((*link)->cpcTargetName, cpcTargetName) == 0)
+    {
+      LPAR_INDEX_TYPE *stale = *link;
+      *link = stale->next;
+      freeLPARIndex(stale);
+    }
+    else
+    {
+      link = &(*link)->next;
+    }
+  }
+
+  index->next = lparIndexes;
+  lparIndexes = index;
+
+  printf("indexed %d LPARs of CPC %s\n", lparCount, cpcTargetName);
+
+  return index;
+}
+
+/*
+ * Method: findLPARIndex
+ *
+ * returns: the index built for the CPC, NULL if there is none
+ */
+LPAR_INDEX_TYPE *findLPARIndex(const char *cpcTargetName)
+{
+  if (cpcTargetName == NULL)
+  {
+    return NULL;
+  }
+
+  for (LPAR_INDEX_TYPE *index = lparIndexes; index != NULL;
+       index = index->next)
+  {
+    if (strcmp(index->cpcTargetName, cpcTargetName) == 0)
+    {
+      return index;
+    }
+  }
+
+  return NULL;
+}
+
+/*
+ * Method: lookupIndexedLPAR
+ *
+ * returns: the indexed LPAR with the given name, NULL if the CPC
+ *          has no such LPAR
+ */
+LPAR_INFO_TYPE *lookupIndexedLPAR(LPAR_INDEX_TYPE *index,
+                                  const char *LPARname)
+{
+  if (index == NULL || LPARname == NULL)
+  {
+    return NULL;
+  }
+
+  unsigned int slot = nameHash(LPARname);
+  for (int probe = 0; probe < index->slotCount; probe++, slot++)
+  {
+    int entry = index->slots[slot & (index->slotCount - 1)];
+    if (entry == 0)
+    {
+      break;
+    }
+    if (strcmp(index->lpars[entry - 1].name, LPARname) == 0)
+    {
+      index->hits++;
+      return &index->lpars[entry - 1];
+    }
+  }
+
+  return NULL;
+}
+
+/*
+ * Method: freeLPARIndexes
+ *
+ * Free every index built during this run.
+ */
+void freeLPARIndexes()
+{
+  while (lparIndexes != NULL)
+  {
+    LPAR_INDEX_TYPE *index = lparIndexes;
+    lparIndexes = index->next;
+
+    if (index->hits > 0)
+    {
+      printf("*>>LPAR index for CPC %s served %d lookups\n",
+             index->cpcTargetName, index->hits);
+    }
+    freeLPARIndex(index);
+  }
+}
@@ -0,0 +1,322 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    MODULE NAME= HWIRPOLL                                            *
+ *                                                                     *
+ *  Sample C code that decides when to POLL a job URI: exponential     *
+ *  backoff with jitter and a ceiling, a hard deadline, and a first    *
+ *  poll scheduled near the completion time learned for the type of    *
+ *  operation (activate, load, deactivate).                            *
+ *                                                                     *
+ *************************END OF SPECIFICATIONS************************/
+#pragma filetag("IBM-1047")     /* compile in EBCDIC */
+#pragma csect(code, "HWIRPOLL") /* name of csect */
+#pragma longName
+#include <stdlib.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sys/time.h>
+#include "hwirpoll.h"
+
+/* initial 2 second interval, growing by 50% per poll up to
+   30 seconds, +/- 20% jitter, abandon after 10 minutes
+*/
+POLL_POLICY_TYPE pollPolicy = {2000, 30000, 150, 20, 10 * 60};
+
+/* weight given to the newest sample in the learned average */
+static const double historyWeight = 0.3;
+
+/* first poll is scheduled at this percentage of the learned time */
+static const int firstPollPct = 90;
+
+static const char *opNames[POLL_OP_TYPES] = {
+    "activate",
+    "load",
+    "deactivate",
+    "other"};
+
+static POLL_HISTORY_TYPE pollHistory[POLL_OP_TYPES];
+static bool historyLoaded = false;
+static bool historyChanged = false;
+
+/*
+ * Method: pollOpName
+ *
+ * Return the printable name of an operation type.
+ */
+const char *pollOpName(int opType)
+{
+  if (opType < 0 || opType >= POLL_OP_TYPES)
+  {
+    opType = POLL_OP_OTHER;
+  }
+  return opNames[opType];
+}
+
+/*
+ * Method: firstPollDelayMs
+ *
+ * Delay before the first poll of a new job. When a completion time
+ * has been learned for the operation type the first poll is scheduled
+ * just before that time, otherwise the initial interval is used.
+ */
+int firstPollDelayMs(int opType, POLL_POLICY_TYPE *policy)
+{
+  int delayMs = policy->initialIntervalMs;
+
+  if (!historyLoaded)
+  {
+    loadPollHistory();
+  }
+
+  if (opType >= 0 && opType < POLL_OP_TYPES &&
+      pollHistory[opType].samples > 0)
+  {
+    delayMs = (int)(pollHistory[opType].avgSeconds * 10.0 * firstPollPct);
+    if (delayMs < policy->initialIntervalMs)
+    {
+      delayMs = policy->initialIntervalMs;
+    }
+  }
+
+  return delayMs;
+}
+
+/*
+ * Method: nextPollDelayMs
+ *
+ * Grow the interval by backoffPct, capped at maxIntervalMs.
+ */
+int nextPollDelayMs(int previousMs, POLL_POLICY_TYPE *policy)
+{
+  long long delayMs = (long long)previousMs * policy->backoffPct / 100;
+
+  if (delayMs < policy->initialIntervalMs)
+  {
+    delayMs = policy->initialIntervalMs;
+  }
+  if (delayMs > policy->maxIntervalMs)
+  {
+    delayMs = policy->maxIntervalMs;
+  }
+
+  return (int)delayMs;
+}
+
+/*
+ * Method: applyJitterMs
+ *
+ * Spread a delay by +/- jitterPct so that many pollers started at the
+ * same time do not hit the SE in lock step. The random state is the
+ * caller's, so pollers on different threads do not share one.
+ */
+int applyJitterMs(int delayMs, POLL_POLICY_TYPE *policy,
+                  unsigned int *seed)
+{
+  int spreadMs = (int)((long long)delayMs * policy->jitterPct / 100);
+
+  if (spreadMs <= 0)
+  {
+    return delayMs;
+  }
+
+  delayMs += (rand_r(seed) % (2 * spreadMs + 1)) - spreadMs;
+  return delayMs > 0 ? delayMs : 0;
+}
+
+/*
+ * Method: recordPollCompletion
+ *
+ * Fold the measured completion time of a job into the learned
+ * average for its operation type. The history is saved by
+ * savePollHistory once the jobs have been polled.
+ */
+void recordPollCompletion(int opType, double seconds)
+{
+  if (opType < 0 || opType >= POLL_OP_TYPES || seconds < 0)
+  {
+    return;
+  }
+
+  if (!historyLoaded)
+  {
+    loadPollHistory();
+  }
+
+  POLL_HISTORY_TYPE *entry = &pollHistory[opType];
+  if (entry->samples == 0)
+  {
+    entry->avgSeconds = seconds;
+  }
+  else
+  {
+    entry->avgSeconds = historyWeight * seconds +
+                        (1.0 - historyWeight) * entry->avgSeconds;
+  }
+  entry->samples++;
+  historyChanged = true;
+}
+
+/*
+ * Method: loadPollHistory
+ *
+ * Read learned completion times from the file named by the
+ * HWIRSTC1_POLLHIST environment variable. Each line holds:
+ *   <operation> <average seconds> <samples>
+ * Without the variable, times are only learned for this run.
+ */
+bool loadPollHistory()
+{
+  char opName[32];
+  double avgSeconds;
+  int samples;
+
+  historyLoaded = true;
+
+  char *path = getenv(POLL_HISTORY_ENV);
+  if (path == NULL || path[0] == '\0')
+  {
+    return false;
+  }
+
+  FILE *historyFile = fopen(path, "r");
+  if (historyFile == NULL)
+  {
+    return false;
+  }
+
+  while (fscanf(historyFile, "%31s %lf %d", opName, &avgSeconds,
+                &samples) == 3)
+  {
+    for (int i = 0; i < POLL_OP_TYPES; i++)
+    {
+      if (strcmp(opName, opNames[i]) == 0 && samples > 0)
+      {
+        pollHistory[i].avgSeconds = avgSeconds;
+        pollHistory[i].samples = samples;
+      }
+    }
+  }
+
+  fclose(historyFile);
+  return true;
+}
+
+/*
+ * Method: savePollHistory
+ *
+ * Write the learned completion times back to the history file, when
+ * a completion was recorded since they were loaded or last saved.
+ */
+bool savePollHistory()
+{
+  if (!historyChanged)
+  {
+    return false;
+  }
+
+  char *path = getenv(POLL_HISTORY_ENV);
+  if (path == NULL || path[0] == '\0')
+  {
+    return false;
+  }
+
+  FILE *historyFile = fopen(path, "w");
+  if (historyFile == NULL)
+  {
+    printf("savePollHistory ERROR: unable to open %s\n", path);
+    return false;
+  }
+
+  for (int i = 0; i < POLL_OP_TYPES; i++)
+  {
+    if (pollHistory[i].samples > 0)
+    {
+      fprintf(historyFile, "%s %.2f %d\n", opNames[i],
+              pollHistory[i].avgSeconds, pollHistory[i].samples);
+    }
+  }
+
+  fclose(historyFile);
+  historyChanged = false;
+  return true;
+}
+
+/*
+ * Method: printPollResult
+ *
+ * Report the final job status together with how long it took to
+ * detect the completion and how many polls were needed.
+ */
+void printPollResult(const char *jobStatus, POLL_RESULT_TYPE *result)
+{
+  if (result->timedOut)
+  {
+    printf("job still %s after %.2f seconds, polling abandoned "
+           "after %d polls\n",
+           jobStatus != NULL ? jobStatus : "unknown",
+           result->detectSeconds, result->polls);
+  }
+  else
+  {
+    printf("job %s detected after %.2f seconds, %d polls, "
+           "last seen running at %.2f seconds\n",
+           jobStatus != NULL ? jobStatus : "status unknown",
+           result->detectSeconds, result->polls,
+           result->lastRunningSeconds);
+  }
+}
+
+/*
+ * Method: currentTimeMs
+ *
+ * Current time of day in milliseconds.
+ */
+long long currentTimeMs()
+{
+  struct timeval now;
+  gettimeofday(&now, NULL);
+  return (long long)now.tv_sec * 1000 + now.tv_usec / 1000;
+}
+
+/*
+ * Method: sleepMs
+ *
+ * Sleep for the number of milliseconds, usleep is only
+ * used for the sub-second remainder.
+ */
+void sleepMs(int delayMs)
+{
+  if (delayMs <= 0)
+  {
+    return;
+  }
+
+  if (delayMs >= 1000)
+  {
+    sleep(delayMs / 1000);
+  }
+  if (delayMs % 1000 > 0)
+  {
+    usleep((delayMs % 1000) * 1000);
+  }
+}
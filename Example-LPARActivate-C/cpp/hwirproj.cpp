@@ -0,0 +1,336 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    MODULE NAME= HWIRPROJ                                            *
+ *                                                                     *
+ *  Sample C code that derives the properties= query parameter of an   *
+ *  object query from the fields a schema binds, so that a GET never   *
+ *  returns properties the caller does not read, and counts the        *
+ *  requests and bytes received of each schema. On request one object  *
+ *  of each schema is also received whole, to estimate the savings.    *
+ *                                                                     *
+ *************************END OF SPECIFICATIONS************************/
+#pragma filetag("IBM-1047")     /* compile in EBCDIC */
+#pragma csect(code, "HWIRPROJ") /* name of csect */
+#pragma longName
+#if defined(__MVS__) && !defined(_OPEN_THREADS) && !defined(_UNIX03_THREADS)
+#define _OPEN_THREADS /* the counters are shared by threads */
+#endif
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include "hwijprs.h"
+#include "hwirstc1.h"
+#include "hwirproj.h"
+
+static PROJECTION_STATS_TYPE projectionStats[PROJECTION_MAX_STATS];
+static int projectionStatsCount = 0;
+
+/* -1 until PROJECTION_SAMPLE_ENV is read */
+static int projectionSample = -1;
+
+/* guards the counters */
+static pthread_mutex_t projectionLock = PTHREAD_MUTEX_INITIALIZER;
+
+/*
+ * Method: buildProjection
+ *
+ * Build ?properties=a,b,c from the member names of the schema fields
+ * set in fieldMask, all of them when it is 0, followed by &extraParms
+ * when given, e.g. cached-acceptable=true.
+ *
+ * returns: length of the query, -1 when it does not fit in queryLen
+ */
+int buildProjection(JSON_SCHEMA_TYPE *schema, int fieldMask,
+                    const char *extraParms, char *query, int queryLen)
+{
+  int len = sprintf(query, "?properties=");
+  int names = 0;
+
+  for (int i = 0; i < schema->fieldCount; i++)
+  {
+    const char *name = schema->fields[i].name;
+    int nameLen = strlen(name);
+
+    if (fieldMask != 0 && !(fieldMask & (1 << i)))
+    {
+      continue;
+    }
+
+    /* a member bound by more than one field is asked for once */
+    bool listed = false;
+    for (int j = 0; j < i && !listed; j++)
+    {
+      listed = (fieldMask == 0 || (fieldMask & (1 << j))) &&
+               strcmp(schema->fields[j].name, name) == 0;
+    }
+    if (listed)
+    {
+      continue;
+    }
+
+    if (len + nameLen + 2 > queryLen)
+    {
+      return -1;
+    }
+    len += sprintf(query + len, names > 0 ? ",%s" : "%s", name);
+    names++;
+  }
+
+  if (extraParms != NULL)
+  {
+    if (len + (int)strlen(extraParms) + 2 > queryLen)
+    {
+      return -1;
+    }
+    len += sprintf(query + len, "&%s", extraParms);
+  }
+
+  return len;
+}
+
+/*
+ * Method: findProjectionStats
+ *
+ * returns: the counters of a schema and object class, added when
+ *          new, NULL when the table is full. Called with the lock held.
+ */
+static PROJECTION_STATS_TYPE *findProjectionStats(
+    JSON_SCHEMA_TYPE *schema, const char *objectClass)
+{
+  for (int i = 0; i < projectionStatsCount; i++)
+  {
+    if (projectionStats[i].schema == schema &&
+        strcmp(projectionStats[i].objectClass, objectClass) == 0)
+    {
+      return &projectionStats[i];
+    }
+  }
+
+  if (projectionStatsCount == PROJECTION_MAX_STATS)
+  {
+    return NULL;
+  }
+
+  PROJECTION_STATS_TYPE *stats = &projectionStats[projectionStatsCount++];
+  memset(stats, 0, sizeof(PROJECTION_STATS_TYPE));
+  stats->schema = schema;
+  stats->objectClass = objectClass;
+  stats->properties = -1;
+
+  return stats;
+}
+
+/*
+ * Method: countProjected
+ *
+ * returns: number of properties buildProjection asks for
+ */
+static int countProjected(JSON_SCHEMA_TYPE *schema, int fieldMask)
+{
+  int names = 0;
+
+  for (int i = 0; i < schema->fieldCount; i++)
+  {
+    if (fieldMask != 0 && !(fieldMask & (1 << i)))
+    {
+      continue;
+    }
+
+    bool listed = false;
+    for (int j = 0; j < i && !listed; j++)
+    {
+      listed = (fieldMask == 0 || (fieldMask & (1 << j))) &&
+               strcmp(schema->fields[j].name, schema->fields[i].name) == 0;
+    }
+    if (!listed)
+    {
+      names++;
+    }
+  }
+
+  return names;
+}
+
+/*
+ * Method: sampleWholeObject
+ *
+ * GET the object without the projection, with extraParms only, and
+ * keep the bytes received against those of the projected response.
+ * Called once per schema, without the lock held.
+ */
+static void sampleWholeObject(char *uri, char *targetName,
+                              const char *extraParms,
+                              PROJECTION_STATS_TYPE *stats,
+                              unsigned long projectedBytes)
+{
+  char query[defaultLen];
+  char *queryParms = NULL;
+
+  if (extraParms != NULL && strlen(extraParms) + 2 <= sizeof(query))
+  {
+    sprintf(query, "?%s", extraParms);
+    queryParms = query;
+  }
+
+  RESPBUF_TYPE *respBuf = acquireResponseBuffer(RESPBUF_LARGE);
+  if (respBuf == NULL)
+  {
+    return;
+  }
+
+  if (queryLPARObject(uri, targetName, queryParms, respBuf))
+  {
+    pthread_mutex_lock(&projectionLock);
+    stats->sampleProjected = projectedBytes;
+    stats->sampleWhole = respBuf->bodyUsed;
+    pthread_mutex_unlock(&projectionLock);
+  }
+
+  releaseResponseBuffer(respBuf);
+}
+
+/*
+ * Method: queryProjected
+ *
+ * GET the object with the properties= projection of the schema, see
+ * buildProjection, and count the request and the bytes received.
+ * With PROJECTION_SAMPLE_ENV set, the first object of the schema is
+ * sampled whole as well.
+ *
+ * returns: true on HTTP status 200 with a response body
+ */
+bool queryProjected(char *uri, char *targetName, const char *objectClass,
+                    JSON_SCHEMA_TYPE *schema, int fieldMask,
+                    const char *extraParms, RESPBUF_TYPE *respBuf)
+{
+  char *query = (char *)arenaAlloc(&respBuf->arena, defaultLen2K);
+
+  if (query == NULL ||
+      buildProjection(schema, fieldMask, extraParms, query, defaultLen2K) < 0)
+  {
+    printf("queryProjected ERROR: projection of %s too long\n",
+           objectClass);
+    return false;
+  }
+
+  bool querySuccess = queryLPARObject(uri, targetName, query, respBuf);
+
+  bool sample = false;
+
+  pthread_mutex_lock(&projectionLock);
+  if (projectionSample < 0)
+  {
+    char *setting = getenv(PROJECTION_SAMPLE_ENV);
+    projectionSample = setting != NULL && setting[0] != '\0' &&
+                       strcmp(setting, "0") != 0;
+  }
+  PROJECTION_STATS_TYPE *stats = findProjectionStats(schema, objectClass);
+  if (stats != NULL && querySuccess)
+  {
+    stats->requests++;
+    stats->bytesReceived += respBuf->bodyUsed;
+    stats->properties = countProjected(schema, fieldMask);
+
+    /* the first thread to get here samples, the others go on */
+    sample = projectionSample && !stats->sampleTaken;
+    stats->sampleTaken = true;
+  }
+  pthread_mutex_unlock(&projectionLock);
+
+  if (sample)
+  {
+    sampleWholeObject(uri, targetName, extraParms, stats,
+                      respBuf->bodyUsed);
+  }
+
+  return querySuccess;
+}
+
+/*
+ * Method: queryBoundObject
+ *
+ * queryProjected, then parse the response and bind it to record in a
+ * single pass. String values are copied to the arena of respBuf. The
+ * parse is left in place for the caller to read nested values.
+ *
+ * returns: mask of the fields bound, -1 when the query failed
+ */
+int queryBoundObject(char *uri, char *targetName, const char *objectClass,
+                     JSON_SCHEMA_TYPE *schema, int fieldMask,
+                     const char *extraParms, RESPBUF_TYPE *respBuf,
+                     void *record)
+{
+  if (!queryProjected(uri, targetName, objectClass, schema, fieldMask,
+                      extraParms, respBuf))
+  {
+    return -1;
+  }
+
+  if (!parse_json_text(respBuf->responseBody))
+  {
+    printf("ERROR: malformed %s response body\n", objectClass);
+    return -1;
+  }
+
+  int bound = bindObject(schema, 0, &respBuf->arena, record);
+
+  return fieldMask != 0 ? bound & fieldMask : bound;
+}
+
+/*
+ * Method: printProjectionStats
+ *
+ * Print the requests, bytes received and properties asked for of each
+ * schema, and, when an object was sampled whole, the bytes the
+ * requests would have received without the projection estimated from
+ * it.
+ */
+void printProjectionStats()
+{
+  pthread_mutex_lock(&projectionLock);
+  for (int i = 0; i < projectionStatsCount; i++)
+  {
+    PROJECTION_STATS_TYPE *stats = &projectionStats[i];
+
+    printf("*>>projection of %s: %lu requests, %llu bytes received "
+           "(%llu a request), %d of %d properties asked for\n",
+           stats->objectClass, stats->requests, stats->bytesReceived,
+           stats->requests > 0 ? stats->bytesReceived / stats->requests
+                               : 0ULL,
+           stats->properties, stats->schema->fieldCount);
+
+    if (stats->sampleWhole > 0 && stats->sampleProjected > 0)
+    {
+      unsigned long long wholeBytes = (unsigned long long)stats->sampleWhole *
+                                      stats->bytesReceived /
+                                      stats->sampleProjected;
+      printf("*>>projection of %s: sampled object %lu bytes whole, %lu "
+             "projected, about %llu bytes saved\n",
+             stats->objectClass, stats->sampleWhole,
+             stats->sampleProjected,
+             wholeBytes > stats->bytesReceived
+                 ? wholeBytes - stats->bytesReceived
+                 : 0ULL);
+    }
+  }
+  pthread_mutex_unlock(&projectionLock);
+}
@@ -0,0 +1,1342 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ ***********************************************************************
+ *                                                                     *
+ *    MODULE NAME= HWIRSIM                                             *
+ *                                                                     *
+ *  Sample C code that simulates the Support Element side of the       *
+ *  HWIREST requests issued by the sample: List CPC Objects, List      *
+ *  Logical Partitions of CPC, Get Logical Partition Properties,       *
+ *  the activate, load and deactivate operations and their jobs.       *
+ *  Latency, list body sizes and job durations are configurable, so    *
+ *  polling, fleet runs and buffer handling can be exercised without   *
+ *  an SE.                                                             *
+ *                                                                     *
+ *************************END OF SPECIFICATIONS************************/
+#pragma filetag("IBM-1047")    /* compile in EBCDIC */
+#pragma csect(code, "HWIRSIM") /* name of csect */
+#pragma longName
+#if defined(__MVS__) && !defined(_OPEN_THREADS) && !defined(_UNIX03_THREADS)
+#define _OPEN_THREADS /* the simulator state is shared by threads */
+#endif
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <strings.h>
+#include <math.h>
+#include <time.h>
+#include <pthread.h>
+#include <hwicic.h> /* BCPii interface declaration file */
+#include "hwirpoll.h"
+#include "hwirsim.h"
+
+SIM_CONFIG_TYPE simConfig = {1, 8, 0, SIM_LATENCY_FIXED, 0, 0, 5, 20, 0, 4,
+                             1};
+
+static SIM_LPAR_TYPE *simLpars = NULL;
+static int simLparCount = 0;
+
+static SIM_JOB_TYPE *simJobs = NULL;
+static int simJobCount = 0;
+static int simJobCapacity = 0;
+
+/* custom group membership, one flag per group and LPAR of a CPC */
+static unsigned char *simMembers = NULL;
+
+static unsigned int simRandom = 1;
+static int simRequests = 0;
+
+/* serializes requests of concurrent threads, except for the latency
+   they wait out side by side
+*/
+static pthread_mutex_t simLock = PTHREAD_MUTEX_INITIALIZER;
+
+static const char *simNotActivated = "not-activated";
+static const char *simOperating = "operating";
+
+/*
+ * Method: nextRandom
+ *
+ * xorshift generator, a given seed always gives the same run.
+ */
+static unsigned int nextRandom()
+{
+  simRandom ^= simRandom << 13;
+  simRandom ^= simRandom >> 17;
+  simRandom ^= simRandom << 5;
+  return simRandom;
+}
+
+/*
+ * Method: randomBetween
+ *
+ * returns: a random value from low to high inclusive
+ */
+static int randomBetween(int low, int high)
+{
+  if (high <= low)
+  {
+    return low;
+  }
+  return low + (int)(nextRandom() % (unsigned int)(high - low + 1));
+}
+
+/*
+ * Method: parseRange
+ *
+ * Parse "a" or "a:b" into two integers, b defaults to a.
+ */
+static void parseRange(char *value, int *low, int *high)
+{
+  char *colon = strchr(value, ':');
+
+  *low = atoi(value);
+  *high = colon != NULL ? atoi(colon + 1) : *low;
+}
+
+/*
+ * Method: parseSimConfig
+ *
+ * Apply the keyword=value pairs of HWIRSTC1_SIM to simConfig.
+ */
+static bool parseSimConfig(char *settings)
+{
+  bool configOk = true;
+  char *copy = strdup(settings);
+  char *save = NULL;
+
+  for (char *pair = strtok_r(copy, ", ", &save); pair != NULL;
+       pair = strtok_r(NULL, ", ", &save))
+  {
+    char *value = strchr(pair, '=');
+    if (value == NULL)
+    {
+      printf("simulator ERROR: %s is not keyword=value\n", pair);
+      configOk = false;
+      continue;
+    }
+    *value++ = '\0';
+
+    if (strcasecmp(pair, "cpcs") == 0)
+    {
+      simConfig.cpcCount = atoi(value);
+    }
+    else if (strcasecmp(pair, "lpars") == 0)
+    {
+      simConfig.lparsPerCPC = atoi(value);
+    }
+    else if (strcasecmp(pair, "active") == 0)
+    {
+      simConfig.activePct = atoi(value);
+    }
+    else if (strcasecmp(pair, "job") == 0)
+    {
+      parseRange(value, &simConfig.jobMinSec, &simConfig.jobMaxSec);
+    }
+    else if (strcasecmp(pair, "listbytes") == 0)
+    {
+      simConfig.listBytes = atoi(value);
+    }
+    else if (strcasecmp(pair, "groups") == 0)
+    {
+      simConfig.groupsPerCPC = atoi(value);
+    }
+    else if (strcasecmp(pair, "seed") == 0)
+    {
+      simConfig.seed = (unsigned int)strtoul(value, NULL, 10);
+    }
+    else if (strcasecmp(pair, "latency") == 0)
+    {
+      char *params = strchr(value, ':');
+      if (params == NULL)
+      {
+        simConfig.latencyDist = SIM_LATENCY_FIXED;
+        params = value;
+      }
+      else
+      {
+        *params++ = '\0';
+        if (strcasecmp(value, "fixed") == 0)
+        {
+          simConfig.latencyDist = SIM_LATENCY_FIXED;
+        }
+        else if (strcasecmp(value, "uniform") == 0)
+        {
+          simConfig.latencyDist = SIM_LATENCY_UNIFORM;
+        }
+        else if (strcasecmp(value, "exp") == 0)
+        {
+          simConfig.latencyDist = SIM_LATENCY_EXP;
+        }
+        else
+        {
+          printf("simulator ERROR: unknown latency distribution %s\n",
+                 value);
+          configOk = false;
+        }
+      }
+      parseRange(params, &simConfig.latencyMs, &simConfig.latencyMaxMs);
+    }
+    else
+    {
+      printf("simulator ERROR: unknown setting %s\n", pair);
+      configOk = false;
+    }
+  }
+
+  free(copy);
+
+  if (simConfig.cpcCount < 1 || simConfig.cpcCount > 99 ||
+      simConfig.lparsPerCPC < 1 || simConfig.lparsPerCPC > 999 ||
+      simConfig.groupsPerCPC < 0 || simConfig.groupsPerCPC > 999)
+  {
+    printf("simulator ERROR: cpcs must be 1-99, lpars 1-999 and "
+           "groups 0-999\n");
+    configOk = false;
+  }
+
+  return configOk;
+}
+
+/*
+ * Method: openSimulator
+ *
+ * Read the simulator settings and create the simulated CPCs and
+ * their LPARs.
+ */
+bool openSimulator()
+{
+  char *settings = getenv(SIM_CONFIG_ENV);
+  if (settings != NULL && !parseSimConfig(settings))
+  {
+    return false;
+  }
+
+  simRandom = simConfig.seed != 0 ? simConfig.seed : 1;
+
+  simLparCount = simConfig.cpcCount * simConfig.lparsPerCPC;
+  simLpars = (SIM_LPAR_TYPE *)calloc(simLparCount, sizeof(SIM_LPAR_TYPE));
+  simMembers = (unsigned char *)calloc(
+      simLparCount * simConfig.groupsPerCPC + 1, 1);
+  if (simLpars == NULL || simMembers == NULL)
+  {
+    free(simLpars);
+    free(simMembers);
+    simLpars = NULL;
+    simMembers = NULL;
+    return false;
+  }
+
+  for (int i = 0; i < simLparCount; i++)
+  {
+    SIM_LPAR_TYPE *lpar = &simLpars[i];
+    int cpc = i / simConfig.lparsPerCPC + 1;
+    int number = i % simConfig.lparsPerCPC + 1;
+
+    lpar->cpcIndex = cpc - 1;
+    sprintf(lpar->name, simConfig.lparsPerCPC < 100 ? "LP%02d" : "LP%03d",
+            number);
+    sprintf(lpar->uri, "/api/logical-partitions/51300000-%04d-%04d",
+            cpc, number);
+    sprintf(lpar->targetName, "IBM390PS.CPC%d.%s", cpc, lpar->name);
+    strcpy(lpar->nextProfile, lpar->name);
+    strcpy(lpar->loadAddress, "0A100");
+    strcpy(lpar->loadParm, "0A1000M1");
+    lpar->status = randomBetween(1, 100) <= simConfig.activePct
+                       ? simOperating
+                       : simNotActivated;
+
+    /* the n-th LPAR starts out in group n modulo the group count */
+    if (simConfig.groupsPerCPC > 0)
+    {
+      simMembers[(lpar->cpcIndex * simConfig.groupsPerCPC +
+                  (number - 1) % simConfig.groupsPerCPC) *
+                     simConfig.lparsPerCPC +
+                 number - 1] = 1;
+    }
+  }
+
+  printf("*>>simulating %d CPCs with %d LPARs each\n",
+         simConfig.cpcCount, simConfig.lparsPerCPC);
+
+  return true;
+}
+
+/*
+ * Method: closeSimulator
+ *
+ * Free the simulated objects and jobs.
+ */
+void closeSimulator()
+{
+  printf("*>>simulator served %d requests\n", simRequests);
+
+  free(simLpars);
+  free(simJobs);
+  free(simMembers);
+  simLpars = NULL;
+  simMembers = NULL;
+  simJobs = NULL;
+  simLparCount = 0;
+  simJobCount = 0;
+  simJobCapacity = 0;
+}
+
+/*
+ * Method: bodyAppend
+ *
+ * printf style append to a response body.
+ */
+static void bodyAppend(SIM_BODY_TYPE *body, const char *format, ...)
+{
+  va_list args;
+
+  va_start(args, format);
+  int needed = vsnprintf(NULL, 0, format, args);
+  va_end(args);
+
+  if (body->len + needed + 1 > body->capacity)
+  {
+    int newCapacity = body->capacity > 0 ? body->capacity : 1024;
+    while (body->len + needed + 1 > newCapacity)
+    {
+      newCapacity *= 2;
+    }
+
+    char *data = (char *)realloc(body->data, newCapacity);
+    if (data == NULL)
+    {
+      return;
+    }
+    body->data = data;
+    body->capacity = newCapacity;
+  }
+
+  va_start(args, format);
+  vsnprintf(body->data + body->len, body->capacity - body->len, format, args);
+  va_end(args);
+  body->len += needed;
+}
+
+/*
+ * Method: bodyPad
+ *
+ * Append count filler characters to a response body.
+ */
+static void bodyPad(SIM_BODY_TYPE *body, int count)
+{
+  if (count <= 0)
+  {
+    return;
+  }
+
+  bodyAppend(body, "%*s", count, "");
+  memset(body->data + body->len - count, 'x', count);
+}
+
+/*
+ * Method: queryParm
+ *
+ * Copy the value of a query parameter of the uri into value.
+ *
+ * returns: true if the parameter is present
+ */
+static bool queryParm(const char *query, const char *name,
+                      char *value, int valueLen)
+{
+  int nameLen = strlen(name);
+
+  for (const char *parm = query; parm != NULL && *parm != '\0';)
+  {
+    parm++; /* skip ? or & */
+    if (strncmp(parm, name, nameLen) == 0 && parm[nameLen] == '=')
+    {
+      const char *start = parm + nameLen + 1;
+      int len = strcspn(start, "&");
+      if (len >= valueLen)
+      {
+        len = valueLen - 1;
+      }
+      memcpy(value, start, len);
+      value[len] = '\0';
+      return true;
+    }
+    parm = strchr(parm, '&');
+  }
+
+  return false;
+}
+
+/*
+ * Method: advanceJobs
+ *
+ * Apply the result of every job that completed by now.
+ */
+static void advanceJobs(long long nowMs)
+{
+  for (int i = 0; i < simJobCount; i++)
+  {
+    SIM_JOB_TYPE *job = &simJobs[i];
+    if (job->lparIndex >= 0 && nowMs >= job->doneMs)
+    {
+      simLpars[job->lparIndex].status =
+          job->opType == POLL_OP_DEACTIVATE ? simNotActivated : simOperating;
+      job->lparIndex = -1; /* applied */
+    }
+  }
+}
+
+/*
+ * Method: errorBody
+ *
+ * Build an error response body like the one an SE returns.
+ */
+static int errorBody(SIM_BODY_TYPE *body, int httpStatus, int reason,
+                     const char *message, bool bcpiiError)
+{
+  bodyAppend(body,
+             "{\"http-status\":%d,\"reason\":%d,\"message\":\"%s\","
+             "\"bcpii-error\":%s}",
+             httpStatus, reason, message, bcpiiError ? "true" : "false");
+  return httpStatus;
+}
+
+/*
+ * Method: listCPCs
+ *
+ * GET /api/cpcs[?name=CPCname]
+ */
+static int listCPCs(const char *query, SIM_BODY_TYPE *body)
+{
+  char name[64];
+  bool filtered = queryParm(query, "name", name, sizeof(name));
+  bool first = true;
+
+  bodyAppend(body, "{\"cpcs\":[");
+  for (int cpc = 1; cpc <= simConfig.cpcCount; cpc++)
+  {
+    char cpcName[16];
+    sprintf(cpcName, "CPC%d", cpc);
+    if (filtered && strcmp(name, cpcName) != 0)
+    {
+      continue;
+    }
+
+    bodyAppend(body,
+               "%s{\"name\":\"%s\",\"object-uri\":\"/api/cpcs/"
+               "51300000-%04d\",\"target-name\":\"IBM390PS.%s\"}",
+               first ? "" : ",", cpcName, cpc, cpcName);
+    first = false;
+  }
+  bodyAppend(body, "]}");
+
+  return 200;
+}
+
+/*
+ * Method: appendLPARList
+ *
+ * Append the logical-partitions array entries of a CPC, each
+ * description holds padLen filler characters.
+ */
+static int appendLPARList(SIM_BODY_TYPE *body, int cpcIndex,
+                          const char *name, bool filtered, int padLen)
+{
+  int entries = 0;
+
+  bodyAppend(body, "{\"logical-partitions\":[");
+  for (int i = 0; i < simLparCount; i++)
+  {
+    SIM_LPAR_TYPE *lpar = &simLpars[i];
+    if (lpar->cpcIndex != cpcIndex ||
+        (filtered && strcmp(name, lpar->name) != 0))
+    {
+      continue;
+    }
+
+    bodyAppend(body,
+               "%s{\"name\":\"%s\",\"request-origin\":false,"
+               "\"object-uri\":\"%s\",\"target-name\":\"%s\","
+               "\"status\":\"%s\",\"description\":\"",
+               entries > 0 ? "," : "", lpar->name, lpar->uri,
+               lpar->targetName, lpar->status);
+    bodyPad(body, padLen);
+    bodyAppend(body, "\"}");
+    entries++;
+  }
+  bodyAppend(body, "]}");
+
+  return entries;
+}
+
+/*
+ * Method: listLPARsOfCPC
+ *
+ * GET /api/cpcs/{cpc-id}/logical-partitions[?name=LPARname]
+ * With listbytes set, the descriptions of an unfiltered list are
+ * padded so the response is about that size.
+ */
+static int listLPARsOfCPC(int cpcIndex, const char *query,
+                          SIM_BODY_TYPE *body)
+{
+  char name[64];
+  bool filtered = queryParm(query, "name", name, sizeof(name));
+
+  int entries = appendLPARList(body, cpcIndex, name, filtered, 0);
+
+  if (!filtered && simConfig.listBytes > body->len && entries > 0)
+  {
+    int padLen = (simConfig.listBytes - body->len) / entries;
+    body->len = 0;
+    appendLPARList(body, cpcIndex, name, filtered, padLen);
+  }
+
+  return 200;
+}
+
+/*
+ * Method: propertyWanted
+ *
+ * returns: true when name is in the comma separated properties list,
+ *          or there is no list
+ */
+static bool propertyWanted(const char *properties, const char *name)
+{
+  if (properties == NULL)
+  {
+    return true;
+  }
+
+  /* match whole names */
+  const char *match = strstr(properties, name);
+  int nameLen = strlen(name);
+  while (match != NULL &&
+         ((match != properties && match[-1] != ',') ||
+          (match[nameLen] != '\0' && match[nameLen] != ',')))
+  {
+    match = strstr(match + 1, name);
+  }
+
+  return match != NULL;
+}
+
+/*
+ * Method: energyData
+ *
+ * GET /api/cpcs/{cpc-id}/energy-management-data
+ * Power follows the number of operating LPARs of the CPC, the
+ * power supplies are a complex property.
+ */
+static int energyData(int cpcIndex, SIM_BODY_TYPE *body)
+{
+  int operating = 0;
+
+  for (int i = 0; i < simLparCount; i++)
+  {
+    if (simLpars[i].cpcIndex == cpcIndex &&
+        simLpars[i].status == simOperating)
+    {
+      operating++;
+    }
+  }
+
+  int watts = 4200 + operating * 150 + randomBetween(0, 120);
+  int ambient = 210 + randomBetween(0, 30);
+  int exhaust = ambient + 80 + operating * 2 + randomBetween(0, 20);
+  int supplyA = watts / 2 + randomBetween(-40, 40);
+
+  bodyAppend(body,
+             "{\"objects\":[{\"object-uri\":\"/api/cpcs/51300000-%04d\","
+             "\"object-id\":\"51300000-%04d\",\"class\":\"cpc\","
+             "\"error-occurred\":false,\"properties\":{"
+             "\"cpc-power-rating\":12000,\"cpc-power-consumption\":%d,"
+             "\"cpc-power-saving\":\"not-supported\","
+             "\"zcpc-ambient-temperature\":%d.%d,"
+             "\"zcpc-exhaust-temperature\":%d.%d,"
+             "\"zcpc-humidity\":%d,\"zcpc-heat-load\":%d,"
+             "\"zcpc-power-supplies\":[{\"id\":\"A\",\"input-power\":%d},"
+             "{\"id\":\"B\",\"input-power\":%d}]}}]}",
+             cpcIndex + 1, cpcIndex + 1, watts, ambient / 10, ambient % 10,
+             exhaust / 10, exhaust % 10, 40 + randomBetween(0, 10),
+             watts * 341 / 100, supplyA, watts - supplyA);
+
+  return 200;
+}
+
+/*
+ * Method: lparProperties
+ *
+ * GET /api/logical-partitions/{id}[?properties=a,b,c]
+ */
+static int lparProperties(SIM_LPAR_TYPE *lpar, const char *query,
+                          SIM_BODY_TYPE *body)
+{
+  char properties[2048];
+  bool filtered = queryParm(query, "properties", properties,
+                            sizeof(properties));
+
+  const char *names[] = {"name", "object-uri", "target-name", "status",
+                         "next-activation-profile-name", "activation-mode",
+                         "last-used-load-address",
+                         "last-used-load-parameter"};
+  const char *values[] = {lpar->name, lpar->uri, lpar->targetName,
+                          lpar->status, lpar->nextProfile, "ESA390",
+                          lpar->loadAddress, lpar->loadParm};
+  bool first = true;
+
+  bodyAppend(body, "{");
+  for (int i = 0; i < (int)(sizeof(names) / sizeof(names[0])); i++)
+  {
+    if (!propertyWanted(filtered ? properties : NULL, names[i]))
+    {
+      continue;
+    }
+
+    bodyAppend(body, "%s\"%s\":\"%s\"", first ? "" : ",",
+               names[i], values[i]);
+    first = false;
+  }
+
+  /* the processors, weight and storage RXAUDIT1 audits */
+  int n = (int)(lpar - simLpars);
+  if (propertyWanted(filtered ? properties : NULL, "processor-usage"))
+  {
+    bodyAppend(body, "%s\"processor-usage\":\"%s\"", first ? "" : ",",
+               n % 4 == 0 ? "dedicated" : "shared");
+    first = false;
+  }
+
+  int gp = 2 + n % 4;
+  int ziip = n % 3;
+  int ifl = n % 5 == 0 ? 2 : 0;
+  const char *numberNames[] = {
+      "number-general-purpose-processors",
+      "number-reserved-general-purpose-processors",
+      "number-general-purpose-cores", "number-reserved-general-purpose-cores",
+      "number-ziip-processors", "number-reserved-ziip-processors",
+      "number-ziip-cores", "number-reserved-ziip-cores",
+      "number-icf-processors", "number-reserved-icf-processors",
+      "number-icf-cores", "number-reserved-icf-cores",
+      "number-ifl-processors", "number-reserved-ifl-processors",
+      "number-ifl-cores", "number-reserved-ifl-cores",
+      "initial-processing-weight", "initial-vfm-storage",
+      "maximum-vfm-storage"};
+  int numberValues[] = {gp, 1, gp, 1, ziip, 0, ziip, 0, 0, 0, 0, 0,
+                        ifl, 0, ifl, 0, 10 * (1 + n % 5), 0, 0};
+
+  for (int i = 0; i < (int)(sizeof(numberNames) / sizeof(numberNames[0]));
+       i++)
+  {
+    if (propertyWanted(filtered ? properties : NULL, numberNames[i]))
+    {
+      bodyAppend(body, "%s\"%s\":%d", first ? "" : ",", numberNames[i],
+                 numberValues[i]);
+      first = false;
+    }
+  }
+
+  if (propertyWanted(filtered ? properties : NULL,
+                     "initial-processing-weight-capped"))
+  {
+    bodyAppend(body, "%s\"initial-processing-weight-capped\":%s",
+               first ? "" : ",", n % 6 == 0 ? "true" : "false");
+    first = false;
+  }
+
+  /* central storage in MB, every third LPAR with reserved storage */
+  int central = 8192 * (1 + n % 4);
+  if (propertyWanted(filtered ? properties : NULL,
+                     "storage-central-allocation"))
+  {
+    bodyAppend(body,
+               "%s\"storage-central-allocation\":[{\"storage-element-type\":"
+               "\"central\",\"origin\":0,\"initial\":%d,\"current\":%d,"
+               "\"maximum\":%d,\"gap\":0}",
+               first ? "" : ",", central, central, central * 2);
+    if (n % 3 == 0)
+    {
+      bodyAppend(body,
+                 ",{\"storage-element-type\":\"reserved\",\"origin\":%d,"
+                 "\"initial\":4096,\"current\":4096,\"maximum\":4096,"
+                 "\"gap\":0}",
+                 central * 2);
+    }
+    bodyAppend(body, "]");
+    first = false;
+  }
+
+  if (propertyWanted(filtered ? properties : NULL,
+                     "storage-expanded-allocation"))
+  {
+    bodyAppend(body, "%s\"storage-expanded-allocation\":[]",
+               first ? "" : ",");
+    first = false;
+  }
+  bodyAppend(body, "}");
+
+  return 200;
+}
+
+/*
+ * Method: listProfiles
+ *
+ * GET /api/cpcs/{cpc-id}/image-activation-profiles
+ * Each LPAR has an image profile of its name.
+ */
+static int listProfiles(int cpcIndex, SIM_BODY_TYPE *body)
+{
+  bool first = true;
+
+  bodyAppend(body, "{\"image-activation-profiles\":[");
+  for (int i = 0; i < simLparCount; i++)
+  {
+    if (simLpars[i].cpcIndex != cpcIndex)
+    {
+      continue;
+    }
+
+    bodyAppend(body,
+               "%s{\"name\":\"%s\",\"element-uri\":\"/api/cpcs/"
+               "51300000-%04d/image-activation-profiles/%s\"}",
+               first ? "" : ",", simLpars[i].name, cpcIndex + 1,
+               simLpars[i].name);
+    first = false;
+  }
+  bodyAppend(body, "]}");
+
+  return 200;
+}
+
+/*
+ * Method: profileProperties
+ *
+ * GET /api/cpcs/{cpc-id}/image-activation-profiles/{name}
+ *     [?properties=a,b,c]
+ * The n-th LPAR of a CPC is assigned crypto adapters 2n and 2n + 1
+ * modulo 16 and usage domain n modulo 12, every fifth one usage
+ * domain n + 3 too and every fourth one control of domain 84, so
+ * that LPARs 24 apart share a domain on an adapter.
+ */
+static int profileProperties(SIM_LPAR_TYPE *lpar, int lparNumber,
+                             const char *query, SIM_BODY_TYPE *body)
+{
+  char properties[512];
+  bool filtered = queryParm(query, "properties", properties,
+                            sizeof(properties));
+  const char *list = filtered ? properties : NULL;
+  int adapter = (lparNumber * 2) % 16;
+  int usage = lparNumber % 12;
+
+  bodyAppend(body, "{\"name\":\"%s\"", lpar->name);
+  if (propertyWanted(list, "description"))
+  {
+    bodyAppend(body, ",\"description\":\"image profile of %s\"",
+               lpar->name);
+  }
+  if (propertyWanted(list,
+                     "crypto-activity-cpu-counter-authorization-control"))
+  {
+    bodyAppend(body,
+               ",\"crypto-activity-cpu-counter-authorization-control\":%s",
+               lparNumber % 3 == 0 ? "true" : "false");
+  }
+  if (propertyWanted(list, "assigned-cryptos"))
+  {
+    bodyAppend(body,
+               ",\"assigned-cryptos\":[{\"number\":%d,"
+               "\"activation-type\":\"online\"},{\"number\":%d,"
+               "\"activation-type\":\"%s\"}]",
+               adapter, adapter + 1,
+               lparNumber % 7 == 0 ? "candidate" : "online");
+  }
+  if (propertyWanted(list, "assigned-crypto-domains"))
+  {
+    bodyAppend(body,
+               ",\"assigned-crypto-domains\":[{\"domain-index\":%d,"
+               "\"access-mode\":\"control-usage\"}",
+               usage);
+    if (lparNumber % 5 == 0)
+    {
+      bodyAppend(body,
+                 ",{\"domain-index\":%d,\"access-mode\":\"control-usage\"}",
+                 usage + 3);
+    }
+    if (lparNumber % 4 == 0)
+    {
+      bodyAppend(body,
+                 ",{\"domain-index\":84,\"access-mode\":\"control\"}");
+    }
+    bodyAppend(body, "]");
+  }
+  bodyAppend(body, "}");
+
+  return 200;
+}
+
+/*
+ * Method: findSimLPAR
+ *
+ * returns: index of the LPAR with the uri id, -1 if there is none
+ */
+static int findSimLPAR(const char *uri, int idLen)
+{
+  for (int i = 0; i < simLparCount; i++)
+  {
+    if ((int)strlen(simLpars[i].uri) == idLen &&
+        memcmp(simLpars[i].uri, uri, idLen) == 0)
+    {
+      return i;
+    }
+  }
+  return -1;
+}
+
+/*
+ * Method: groupMember
+ *
+ * returns: membership flag of the n-th LPAR of a CPC in a group
+ */
+static unsigned char *groupMember(int cpcIndex, int group, int lparNumber)
+{
+  return &simMembers[(cpcIndex * simConfig.groupsPerCPC + group) *
+                         simConfig.lparsPerCPC +
+                     lparNumber];
+}
+
+/*
+ * Method: listGroups
+ *
+ * GET /api/groups[?name=groupname]
+ * The custom groups of the SE of the target CPC.
+ */
+static int listGroups(int cpcIndex, const char *query, SIM_BODY_TYPE *body)
+{
+  char name[64];
+  bool filtered = queryParm(query, "name", name, sizeof(name));
+  bool first = true;
+
+  bodyAppend(body, "{\"groups\":[");
+  for (int group = 1; group <= simConfig.groupsPerCPC; group++)
+  {
+    char groupName[16];
+    sprintf(groupName, "GRP%d", group);
+    if (filtered && strcmp(name, groupName) != 0)
+    {
+      continue;
+    }
+
+    bodyAppend(body,
+               "%s{\"name\":\"%s\",\"object-uri\":\"/api/groups/"
+               "51300000-%04d-%04d\"}",
+               first ? "" : ",", groupName, cpcIndex + 1, group);
+    first = false;
+  }
+  bodyAppend(body, "]}");
+
+  return 200;
+}
+
+/*
+ * Method: groupMembers
+ *
+ * GET /api/groups/{group-id}/members
+ */
+static int groupMembers(int cpcIndex, int group, SIM_BODY_TYPE *body)
+{
+  bool first = true;
+
+  bodyAppend(body, "{\"members\":[");
+  for (int i = 0; i < simConfig.lparsPerCPC; i++)
+  {
+    if (*groupMember(cpcIndex, group, i))
+    {
+      SIM_LPAR_TYPE *lpar =
+          &simLpars[cpcIndex * simConfig.lparsPerCPC + i];
+      bodyAppend(body, "%s{\"object-uri\":\"%s\",\"name\":\"%s\"}",
+                 first ? "" : ",", lpar->uri, lpar->name);
+      first = false;
+    }
+  }
+  bodyAppend(body, "]}");
+
+  return 200;
+}
+
+/*
+ * Method: changeGroupMember
+ *
+ * POST /api/groups/{group-id}/operations/add-member
+ * POST /api/groups/{group-id}/operations/remove-member
+ * with a request body of {"object-uri":"/api/logical-partitions/..."}
+ */
+static int changeGroupMember(int cpcIndex, int group, bool add,
+                             REQUEST_PARM_TYPE *request,
+                             SIM_BODY_TYPE *body)
+{
+  char requestBody[512];
+  int len = request->requestBodyLen < (int)sizeof(requestBody) - 1
+                ? request->requestBodyLen
+                : (int)sizeof(requestBody) - 1;
+
+  memcpy(requestBody, request->requestBody != NULL ? request->requestBody
+                                                   : "",
+         request->requestBody != NULL ? len : 0);
+  requestBody[request->requestBody != NULL ? len : 0] = '\0';
+
+  char *uri = strstr(requestBody, "\"object-uri\"");
+  uri = uri != NULL ? strchr(uri + 12, '"') : NULL;
+  char *uriEnd = uri != NULL ? strchr(uri + 1, '"') : NULL;
+  if (uriEnd == NULL)
+  {
+    return errorBody(body, 400, 5, "object-uri missing", false);
+  }
+
+  int lparIndex = findSimLPAR(uri + 1, uriEnd - uri - 1);
+  if (lparIndex < 0 || simLpars[lparIndex].cpcIndex != cpcIndex)
+  {
+    return errorBody(body, 404, 2, "object not found", false);
+  }
+
+  unsigned char *member = groupMember(
+      cpcIndex, group, lparIndex - cpcIndex * simConfig.lparsPerCPC);
+  if (*member == (add ? 1 : 0))
+  {
+    return errorBody(body, 409, add ? 130 : 131,
+                     add ? "object is already a member"
+                         : "object is not a member",
+                     false);
+  }
+  *member = add ? 1 : 0;
+
+  return 204;
+}
+
+/*
+ * Method: startJob
+ *
+ * POST /api/logical-partitions/{id}/operations/{operation}
+ * Start a job that completes after a random time within the
+ * configured job duration.
+ */
+static int startJob(int lparIndex, int opType, SIM_BODY_TYPE *body)
+{
+  if (simJobCount == simJobCapacity)
+  {
+    int newCapacity = simJobCapacity > 0 ? simJobCapacity * 2 : 16;
+    SIM_JOB_TYPE *jobs = (SIM_JOB_TYPE *)realloc(
+        simJobs, newCapacity * sizeof(SIM_JOB_TYPE));
+    if (jobs == NULL)
+    {
+      return errorBody(body, 503, 1, "simulator out of storage", false);
+    }
+    simJobs = jobs;
+    simJobCapacity = newCapacity;
+  }
+
+  SIM_JOB_TYPE *job = &simJobs[simJobCount];
+  job->lparIndex = lparIndex;
+  job->opType = opType;
+  job->deleted = false;
+  job->doneMs = currentTimeMs() +
+                1000LL * randomBetween(simConfig.jobMinSec,
+                                       simConfig.jobMaxSec);
+
+  bodyAppend(body, "{\"job-uri\":\"/api/jobs/51300000-job-%d\"}",
+             simJobCount);
+  simJobCount++;
+
+  return 202;
+}
+
+/*
+ * Method: jobStatus
+ *
+ * GET and DELETE /api/jobs/{job-id}
+ */
+static int jobStatus(int jobIndex, int httpMethod, SIM_BODY_TYPE *body)
+{
+  if (jobIndex < 0 || jobIndex >= simJobCount || simJobs[jobIndex].deleted)
+  {
+    return errorBody(body, 404, 1, "job not found", false);
+  }
+
+  SIM_JOB_TYPE *job = &simJobs[jobIndex];
+
+  if (httpMethod == HWI_REST_DELETE)
+  {
+    job->deleted = true;
+    return 204;
+  }
+
+  if (job->lparIndex >= 0)
+  {
+    bodyAppend(body, "{\"status\":\"running\"}");
+  }
+  else
+  {
+    bodyAppend(body,
+               "{\"status\":\"complete\",\"job-status-code\":200,"
+               "\"job-reason-code\":0,\"job-results\":null}");
+  }
+
+  return 200;
+}
+
+/*
+ * Method: routeRequest
+ *
+ * Serve one request into body.
+ *
+ * returns: HTTP status
+ */
+static int routeRequest(REQUEST_PARM_TYPE *request, SIM_BODY_TYPE *body)
+{
+  char *uri = (char *)malloc(request->uriLen + 1);
+  int httpStatus;
+
+  memcpy(uri, request->uri, request->uriLen);
+  uri[request->uriLen] = '\0';
+
+  char *query = strchr(uri, '?');
+  int pathLen = query != NULL ? query - uri : request->uriLen;
+
+  char *targetName = (char *)malloc(request->targetNameLen + 1);
+  memcpy(targetName, request->targetName != NULL ? request->targetName : "",
+         request->targetNameLen);
+  targetName[request->targetNameLen] = '\0';
+
+  int cpc = 0;
+  int lparIndex = -1;
+  int jobIndex = -1;
+  int consumed = 0;
+  int profilesEnd = 0;
+  int group = 0;
+  int groupEnd = 0;
+
+  if (pathLen == 9 && strncmp(uri, "/api/cpcs", 9) == 0 &&
+      request->httpMethod == HWI_REST_GET)
+  {
+    httpStatus = listCPCs(query, body);
+  }
+  else if (sscanf(uri, "/api/cpcs/51300000-%4d/logical-partitions%n",
+                  &cpc, &consumed) == 1 &&
+           consumed == pathLen && request->httpMethod == HWI_REST_GET)
+  {
+    char cpcTarget[32];
+    sprintf(cpcTarget, "IBM390PS.CPC%d", cpc);
+
+    if (cpc < 1 || cpc > simConfig.cpcCount)
+    {
+      httpStatus = errorBody(body, 404, 1, "cpc not found", false);
+    }
+    else if (strcmp(targetName, cpcTarget) != 0)
+    {
+      httpStatus = errorBody(body, 404, 1, "unknown target name", true);
+    }
+    else
+    {
+      httpStatus = listLPARsOfCPC(cpc - 1, query, body);
+    }
+  }
+  else if (sscanf(uri, "/api/cpcs/51300000-%4d/energy-management-data%n",
+                  &cpc, &consumed) == 1 &&
+           consumed == pathLen && request->httpMethod == HWI_REST_GET)
+  {
+    char cpcTarget[32];
+    sprintf(cpcTarget, "IBM390PS.CPC%d", cpc);
+
+    if (cpc < 1 || cpc > simConfig.cpcCount)
+    {
+      httpStatus = errorBody(body, 404, 1, "cpc not found", false);
+    }
+    else if (strcmp(targetName, cpcTarget) != 0)
+    {
+      httpStatus = errorBody(body, 404, 1, "unknown target name", true);
+    }
+    else
+    {
+      httpStatus = energyData(cpc - 1, body);
+    }
+  }
+  else if (sscanf(uri, "/api/cpcs/51300000-%4d/image-activation-profiles%n",
+                  &cpc, &profilesEnd) == 1 &&
+           profilesEnd > 0 && request->httpMethod == HWI_REST_GET &&
+           (profilesEnd == pathLen ||
+            (profilesEnd < pathLen - 1 && uri[profilesEnd] == '/')))
+  {
+    char cpcTarget[32];
+    sprintf(cpcTarget, "IBM390PS.CPC%d", cpc);
+    const char *profile = profilesEnd < pathLen ? uri + profilesEnd + 1
+                                                : NULL;
+    int profileLen = pathLen - profilesEnd - 1;
+    int lparNumber = 0;
+
+    lparIndex = -1;
+    for (int i = 0; profile != NULL && i < simLparCount; i++)
+    {
+      if (simLpars[i].cpcIndex == cpc - 1)
+      {
+        if ((int)strlen(simLpars[i].name) == profileLen &&
+            strncmp(simLpars[i].name, profile, profileLen) == 0)
+        {
+          lparIndex = i;
+          break;
+        }
+        lparNumber++;
+      }
+    }
+
+    if (cpc < 1 || cpc > simConfig.cpcCount)
+    {
+      httpStatus = errorBody(body, 404, 1, "cpc not found", false);
+    }
+    else if (strcmp(targetName, cpcTarget) != 0)
+    {
+      httpStatus = errorBody(body, 404, 1, "unknown target name", true);
+    }
+    else if (profile == NULL)
+    {
+      httpStatus = listProfiles(cpc - 1, body);
+    }
+    else if (lparIndex < 0)
+    {
+      httpStatus = errorBody(body, 404, 1, "image profile not found",
+                             false);
+    }
+    else
+    {
+      httpStatus = profileProperties(&simLpars[lparIndex], lparNumber, query,
+                                     body);
+    }
+  }
+  else if (strncmp(uri, "/api/logical-partitions/", 24) == 0)
+  {
+    char *operation = strstr(uri, "/operations/");
+    int idLen = operation != NULL ? operation - uri : pathLen;
+
+    lparIndex = findSimLPAR(uri, idLen);
+    if (lparIndex < 0)
+    {
+      httpStatus = errorBody(body, 404, 1, "logical partition not found",
+                             false);
+    }
+    else if (strcmp(targetName, simLpars[lparIndex].targetName) != 0)
+    {
+      httpStatus = errorBody(body, 404, 1, "unknown target name", true);
+    }
+    else if (operation == NULL && request->httpMethod == HWI_REST_GET)
+    {
+      httpStatus = lparProperties(&simLpars[lparIndex], query, body);
+    }
+    else if (operation != NULL && request->httpMethod == HWI_REST_POST)
+    {
+      operation += 12;
+      if (strcmp(operation, "activate") == 0)
+      {
+        httpStatus = startJob(lparIndex, POLL_OP_ACTIVATE, body);
+      }
+      else if (strcmp(operation, "load") == 0)
+      {
+        httpStatus = startJob(lparIndex, POLL_OP_LOAD, body);
+      }
+      else if (strcmp(operation, "deactivate") == 0)
+      {
+        httpStatus = startJob(lparIndex, POLL_OP_DEACTIVATE, body);
+      }
+      else
+      {
+        httpStatus = errorBody(body, 404, 1, "operation not supported",
+                               false);
+      }
+    }
+    else
+    {
+      httpStatus = errorBody(body, 405, 0, "method not allowed", false);
+    }
+  }
+  else if (pathLen == 11 && strncmp(uri, "/api/groups", 11) == 0 &&
+           request->httpMethod == HWI_REST_GET)
+  {
+    if (sscanf(targetName, "IBM390PS.CPC%d%n", &cpc, &consumed) != 1 ||
+        consumed != (int)strlen(targetName) || cpc < 1 ||
+        cpc > simConfig.cpcCount)
+    {
+      httpStatus = errorBody(body, 404, 1, "unknown target name", true);
+    }
+    else
+    {
+      httpStatus = listGroups(cpc - 1, query, body);
+    }
+  }
+  else if (sscanf(uri, "/api/groups/51300000-%4d-%4d%n", &cpc, &group,
+                  &groupEnd) == 2 &&
+           groupEnd > 0)
+  {
+    char cpcTarget[32];
+    sprintf(cpcTarget, "IBM390PS.CPC%d", cpc);
+    const char *rest = uri + groupEnd;
+    int restLen = pathLen - groupEnd;
+
+    if (cpc < 1 || cpc > simConfig.cpcCount || group < 1 ||
+        group > simConfig.groupsPerCPC)
+    {
+      httpStatus = errorBody(body, 404, 1, "group not found", false);
+    }
+    else if (strcmp(targetName, cpcTarget) != 0)
+    {
+      httpStatus = errorBody(body, 404, 1, "unknown target name", true);
+    }
+    else if (restLen == 8 && strncmp(rest, "/members", 8) == 0 &&
+             request->httpMethod == HWI_REST_GET)
+    {
+      httpStatus = groupMembers(cpc - 1, group - 1, body);
+    }
+    else if (restLen == 22 &&
+             strncmp(rest, "/operations/add-member", 22) == 0 &&
+             request->httpMethod == HWI_REST_POST)
+    {
+      httpStatus = changeGroupMember(cpc - 1, group - 1, true, request,
+                                     body);
+    }
+    else if (restLen == 25 &&
+             strncmp(rest, "/operations/remove-member", 25) == 0 &&
+             request->httpMethod == HWI_REST_POST)
+    {
+      httpStatus = changeGroupMember(cpc - 1, group - 1, false, request,
+                                     body);
+    }
+    else
+    {
+      httpStatus = errorBody(body, 404, 1, "operation not supported",
+                             false);
+    }
+  }
+  else if (sscanf(uri, "/api/jobs/51300000-job-%d%n", &jobIndex,
+                  &consumed) == 1 &&
+           consumed == pathLen)
+  {
+    httpStatus = jobStatus(jobIndex, request->httpMethod, body);
+  }
+  else
+  {
+    httpStatus = errorBody(body, 404, 1, "uri not supported", false);
+  }
+
+  free(uri);
+  free(targetName);
+
+  return httpStatus;
+}
+
+/*
+ * Method: requestLatencyMs
+ *
+ * returns: latency of one request drawn from the configured
+ *          distribution
+ */
+static int requestLatencyMs()
+{
+  switch (simConfig.latencyDist)
+  {
+  case SIM_LATENCY_UNIFORM:
+    return randomBetween(simConfig.latencyMs, simConfig.latencyMaxMs);
+  case SIM_LATENCY_EXP:
+  {
+    double uniform = (nextRandom() % 1000000 + 1) / 1000001.0;
+    int latency = (int)(-log(uniform) * simConfig.latencyMs);
+    if (simConfig.latencyMaxMs > simConfig.latencyMs &&
+        latency > simConfig.latencyMaxMs)
+    {
+      latency = simConfig.latencyMaxMs;
+    }
+    return latency;
+  }
+  default:
+    return simConfig.latencyMs;
+  }
+}
+
+/*
+ * Method: simulateRequest
+ *
+ * Serve a request the way an SE would and fill in the response
+ * parameters the way HWIREST does. Response bodies larger than the
+ * caller's area are truncated.
+ */
+void simulateRequest(REQUEST_PARM_TYPE *request,
+                     RESPONSE_PARM_TYPE *response)
+{
+  SIM_BODY_TYPE body;
+  char date[64];
+
+  memset(&body, 0, sizeof(SIM_BODY_TYPE));
+
+  pthread_mutex_lock(&simLock);
+  int requestNumber = ++simRequests;
+  int latencyMs = requestLatencyMs();
+  pthread_mutex_unlock(&simLock);
+
+  sleepMs(latencyMs);
+
+  pthread_mutex_lock(&simLock);
+  advanceJobs(currentTimeMs());
+
+  response->httpStatus = routeRequest(request, &body);
+
+  if (response->responseBody != NULL)
+  {
+    if (body.len > response->responseBodyLen)
+    {
+      body.len = response->responseBodyLen;
+    }
+    memcpy(response->responseBody, body.data, body.len);
+    response->responseBodyLen = body.len;
+  }
+
+  time_t now = time(NULL);
+  strftime(date, sizeof(date), "%a, %d %b %Y %H:%M:%S GMT", gmtime(&now));
+
+  if (response->responseDate != NULL)
+  {
+    int dateLen = strlen(date);
+    if (dateLen > response->responseDateLen)
+    {
+      dateLen = response->responseDateLen;
+    }
+    memcpy(response->responseDate, date, dateLen);
+    response->responseDateLen = dateLen;
+  }
+
+  if (response->requestId != NULL)
+  {
+    char requestId[32];
+    int requestIdLen = sprintf(requestId, "sim-%d", requestNumber);
+    if (requestIdLen > response->requestIdLen)
+    {
+      requestIdLen = response->requestIdLen;
+    }
+    memcpy(response->requestId, requestId, requestIdLen);
+    response->requestIdLen = requestIdLen;
+  }
+  pthread_mutex_unlock(&simLock);
+
+  free(body.data);
+}
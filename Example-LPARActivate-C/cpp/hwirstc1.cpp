@@ -29,8 +29,12 @@
 #pragma filetag("IBM-1047")    /* compile in EBCDIC */
 #pragma csect(code, "HWIRSTC1") /* name of csect */
 #pragma longName
+#if defined(__MVS__) && !defined(_OPEN_THREADS) && !defined(_UNIX03_THREADS)
+#define _OPEN_THREADS /* pthread_create of the request workers */
+#endif
 
 #include <stdlib.h>
+#include <stddef.h>
 #include <unistd.h>
 #include <stdio.h>
 #include <string.h>
@@ -38,26 +42,194 @@
 #include <iconv.h>
 #include <time.h>
 #include <sys/time.h>
+#include <pthread.h>
 #include <hwtjic.h> /* JSON interface declaration file  */
 #include <hwicic.h> /* BCPii interface declaration file */
 #include "hwijprs.h"
+#include "hwijstrm.h"
+#include "hwijpath.h"
+#include "hwijbind.h"
+#include "hwirbufp.h"
+#include "hwirpoll.h"
+#include "hwirjobs.h"
 #include "hwirstc1.h"
+#include "hwirflet.h"
+#include "hwiraudt.h"
+#include "hwirenrg.h"
+#include "hwircryp.h"
+#include "hwirgrps.h"
+#include "hwircach.h"
+#include "hwirlidx.h"
+#include "hwirproj.h"
+#include "hwirtran.h"
 
 /* set to true for more detailed tracing */
 bool verbose2 = false;
 
+/* maximum number of bytes of a single text field (e.g. the response
+   body) written to the trace, 0 means no limit
+*/
+int traceTextLimit = defaultLen64K;
+
+/* set to false to trace nothing of requests and responses, e.g. while
+   energy samples are taken
+*/
+bool traceRequests = true;
+
+/* set in the threads of runRequestWorkers, which trace only the
+   requests that fail
+*/
+static pthread_key_t quietThreadKey;
+static pthread_once_t quietThreadOnce = PTHREAD_ONCE_INIT;
+
+/* a worker and its data, passed to each thread */
+typedef struct
+{
+  REQUEST_WORKER_TYPE worker;
+  void *data;
+} REQUEST_WORKERS_TYPE;
+
+/* text fields are written to the trace in slices of this size */
+static const int traceChunkLen = 4096;
+
+/* property name and record field of each LPAR_PROP_ flag, the
+   binding at index i is the property of flag 1 << i
+*/
+static const JSON_BINDING_TYPE lparPropBindings[] = {
+    BIND_FIELD(LPAR_PROPS_TYPE, status,
+               "status", BIND_STRING),
+    BIND_FIELD(LPAR_PROPS_TYPE, nextActivationProfile,
+               "next-activation-profile-name", BIND_STRING),
+    BIND_FIELD(LPAR_PROPS_TYPE, activationMode,
+               "activation-mode", BIND_STRING),
+    BIND_FIELD(LPAR_PROPS_TYPE, loadAddress,
+               "last-used-load-address", BIND_STRING),
+    BIND_FIELD(LPAR_PROPS_TYPE, loadParm,
+               "last-used-load-parameter", BIND_STRING)};
+
+static const int lparPropCount =
+    sizeof(lparPropBindings) / sizeof(lparPropBindings[0]);
+
+/* a job status response */
+static const JSON_BINDING_TYPE jobStatusBindings[] = {
+    BIND_FIELD(JOB_STATUS_TYPE, status, "status", BIND_CHARS),
+    BIND_FIELD(JOB_STATUS_TYPE, jobStatusCode, "job-status-code", BIND_INT),
+    BIND_FIELD(JOB_STATUS_TYPE, jobReasonCode, "job-reason-code", BIND_INT),
+    BIND_FIELD(JOB_STATUS_TYPE, jobResults, "job-results", BIND_PRESENT)};
+
+#define JOB_BOUND_STATUS 0x01
+
+/* an entry of a logical-partitions list */
+static const JSON_BINDING_TYPE lparInfoBindings[] = {
+    BIND_FIELD(LPAR_INFO_TYPE, name, "name", BIND_STRING),
+    BIND_FIELD(LPAR_INFO_TYPE, uri, "object-uri", BIND_STRING),
+    BIND_FIELD(LPAR_INFO_TYPE, targetName, "target-name", BIND_STRING),
+    BIND_FIELD(LPAR_INFO_TYPE, status, "status", BIND_STRING)};
+
+#define LPAR_BOUND_REQUIRED 0x07 /* name, object-uri and target-name */
+
+/* the entry of a cpcs or logical-partitions list filtered by name */
+static const JSON_BINDING_TYPE listedObjectBindings[] = {
+    BIND_FIELD(LISTED_OBJECT_TYPE, uri, "object-uri", BIND_STRING),
+    BIND_FIELD(LISTED_OBJECT_TYPE, targetName, "target-name", BIND_STRING)};
+
+#define BINDING_COUNT(bindings) (sizeof(bindings) / sizeof(bindings[0]))
+
+/* schemas compiled once */
+static JSON_SCHEMA_TYPE *lparPropSchema =
+    compileSchema(lparPropBindings, BINDING_COUNT(lparPropBindings));
+static JSON_SCHEMA_TYPE *jobStatusSchema =
+    compileSchema(jobStatusBindings, BINDING_COUNT(jobStatusBindings));
+static JSON_SCHEMA_TYPE *lparInfoSchema =
+    compileSchema(lparInfoBindings, BINDING_COUNT(lparInfoBindings));
+static JSON_SCHEMA_TYPE *listedObjectSchema =
+    compileSchema(listedObjectBindings, BINDING_COUNT(listedObjectBindings));
+
 /* globals */
 char *CPCuri;
 char *LPARuri;
 char *CPCtargetName;
 char *LPARtargetName;
 
+struct timeval timeDay;
+time_t tvSeconds;
+time_t startTimer;
+time_t endTimer;
+
+struct tm *localTimeREST;
+
+/* HWIRSTC1_NOMAIN leaves main out, so the functions below can be
+   bound into other programs such as the HWIRBNCH benchmark
+*/
+#ifndef HWIRSTC1_NOMAIN
 int main(int argc, char **argv)
 {
   bool response = false;
 
+  /* Fleet mode, activate many LPARs in one run, audit mode, report
+     the properties of many LPARs, energy mode, sample the energy
+     management data of CPCs into a time-series file, crypto mode,
+     take the crypto inventory of the profiles of a CPC, or groups
+     mode, reconcile the members of custom groups
+  */
+  if (argc >= 3 && (strcasecmp(argv[1], "-FLEET") == 0 ||
+                    strcasecmp(argv[1], "-AUDIT") == 0 ||
+                    strcasecmp(argv[1], "-ENERGY") == 0 ||
+                    strcasecmp(argv[1], "-CRYPTO") == 0 ||
+                    strcasecmp(argv[1], "-GROUPS") == 0))
+  {
+    /* Create a new parser instance. */
+    if (!init_parser())
+    {
+      printf("Failed to initialize parser\n");
+      return -1;
+    }
+
+    if (!openTransport())
+    {
+      do_cleanup();
+      return -1;
+    }
+    openResolutionCache();
+
+    if (strcasecmp(argv[1], "-FLEET") == 0)
+    {
+      response = runFleet(argc, argv);
+    }
+    else if (strcasecmp(argv[1], "-AUDIT") == 0)
+    {
+      response = runAudit(argc, argv);
+    }
+    else if (strcasecmp(argv[1], "-ENERGY") == 0)
+    {
+      response = runEnergySampler(argc, argv);
+    }
+    else if (strcasecmp(argv[1], "-CRYPTO") == 0)
+    {
+      response = runCryptoInventory(argc, argv);
+    }
+    else
+    {
+      response = runGroupReconcile(argc, argv);
+    }
+
+    freeLPARIndexes();
+    closeResolutionCache();
+    closeTransport();
+    printResponseBufferStats();
+    printProjectionStats();
+    freeResponseBuffers();
+
+    /* Terminate the parser instance before exiting */
+    do_cleanup();
+  }
+  /* Report a time-series file written in energy mode */
+  else if (argc >= 3 && strcasecmp(argv[1], "-SERIES") == 0)
+  {
+    response = runSeriesReport(argc, argv);
+  }
   /* The caller is expected to pass in CPC name and LPAR name */
-  if (argc == 3)
+  else if (argc == 3)
   {
     for (int i = 1; i < argc; i++)
     {
@@ -72,6 +244,13 @@ int main(int argc, char **argv)
       return -1;
     }
 
+    if (!openTransport())
+    {
+      do_cleanup();
+      return -1;
+    }
+    openResolutionCache();
+
     /* Sets CPCuri and CPCtargetName */
     response = getCPCInfo(argv[1]);
 
@@ -87,6 +266,13 @@ int main(int argc, char **argv)
       response = activateLPAR();
     }
 
+    freeLPARIndexes();
+    closeResolutionCache();
+    closeTransport();
+    printResponseBufferStats();
+    printProjectionStats();
+    freeResponseBuffers();
+
     /* Terminate the parser instance before exiting */
     do_cleanup();
   }
@@ -94,109 +280,104 @@ int main(int argc, char **argv)
   {
     printf("ERROR: Wrong number of arguments\n");
     printf("USAGE: HWIRSTC1 <CPCname> <LPARname>\n");
+    printf("       HWIRSTC1 -FLEET [-MAX n] [-MAXCPC n] "
+           "<CPCname>.<LPARname>|DD:ddname|/path ...\n");
+    printf("       HWIRSTC1 -AUDIT [-MAX n] "
+           "<CPCname>[.<LPARname>] ...\n");
+    printf("       HWIRSTC1 -ENERGY -FILE path [-EVERY s] [-COUNT n] "
+           "<CPCname> ...\n");
+    printf("       HWIRSTC1 -SERIES -FILE path [-FROM s] [-TO s] "
+           "[-WINDOW s] [pattern]\n");
+    printf("       HWIRSTC1 -CRYPTO [-MAX n] [-STATUS status] <CPCname> "
+           "[adapter.domain ...]\n");
+    printf("       HWIRSTC1 -GROUPS [-MAX n] [-MAXCPC n] [-PLAN] "
+           "<CPCname>.<group>=<LPARname>,...|DD:ddname|/path ...\n");
   }
 
   return response;
 }
+#endif
 
 /*
- * Method: getNextActivationProfile
+ * Method: getLPARProperties
+ *
+ * Retrieve a set of LPAR properties with a single
+ * GET <lpar-uri>?properties=a,b,c request and parse the response
+ * once. propertySet is the LPAR_PROP_ flags of the properties
+ * wanted, each one found is copied into its field of props.
  *
- * Retrieve the current next activation profile name for the LPAR
- * if the information was succesfully returned
- * point the LPARnextActProfile to it's value
+ * input arguments: uri, target name, LPAR_PROP_ flags
+ * output arguments: property record, free with freeLPARProperties
+ * returns: true if every requested property was returned
  */
-bool getNextActivationProfile(char **LPARnextActProfile)
+bool getLPARProperties(char *lparUri,
+                       char *lparTargetName,
+                       int propertySet,
+                       LPAR_PROPS_TYPE *props)
 {
-  char *responseBody = (char *)malloc(defaultLen15MB);
-  char *queryParm = (char *)malloc(defaultLen);
+  bool found = false;
 
-  memset(responseBody, 0, defaultLen15MB);
-  memset(queryParm, 0, defaultLen);
+  memset(props, 0, sizeof(LPAR_PROPS_TYPE));
 
-  strcpy(queryParm, "?properties=");
-  strcat(queryParm, nextActProfile);
-  strcat(queryParm, "&");
-  strcat(queryParm, cachedAcceptable);
+  /* the response buffer is kept with the properties, their values
+     are copied to its arena and given back by freeLPARProperties
+  */
+  props->respBuf = acquireResponseBuffer(RESPBUF_SMALL);
+  if (props->respBuf == NULL)
+  {
+    return false;
+  }
 
-  if (queryLPAR(queryParm, &responseBody, defaultLen15MB))
+  /* the properties= projection is derived from the LPAR_PROP_ flags
+     set, one pass over the members binds every property to props
+  */
+  int bound = queryBoundObject(lparUri, lparTargetName, "LPAR",
+                               lparPropSchema, propertySet,
+                               cachedAcceptable, props->respBuf, props);
+  if (bound >= 0)
   {
-    if (parse_json_text((char *)responseBody))
+    props->fetched = bound & propertySet;
+    for (int i = 0; i < lparPropCount; i++)
     {
-      *LPARnextActProfile = find_string(0, (char *)nextActProfile);
-      if (*LPARnextActProfile != NULL)
+      char **field = (char **)((char *)props + lparPropBindings[i].offset);
+
+      if (!(propertySet & (1 << i)) || !tracingRequests())
+      {
+        continue;
+      }
+      else if (props->fetched & (1 << i))
       {
-        printf("LPAR %s is %s\n", nextActProfile, *LPARnextActProfile);
-        free(responseBody);
-        free(queryParm);
-        return true;
+        printf("LPAR %s is %s\n", lparPropBindings[i].name, *field);
       }
       else
       {
-        printf("ERROR: null returned instead of LPAR activation profile\n");
+        printf("ERROR: null returned instead of LPAR %s\n",
+               lparPropBindings[i].name);
       }
     }
-    else
-    {
-      printf("ERROR: malformed LPAR activation profile response body\n");
-    }
+    found = props->fetched == propertySet;
   }
 
-  free(responseBody);
-  free(queryParm);
-
-  return false;
+  return found;
 }
 
 /*
- * Method: getLPARStatus
+ * Method: freeLPARProperties
  *
- * Retrieve the current status of the LPAR,
- * if the information was succesfully returned
- * point the LPARtatusValue to it's value
+ * Give back the property values set by getLPARProperties, together
+ * with the response buffer they were copied to.
  */
-bool getLPARStatus(char **LPARstatusValue)
+void freeLPARProperties(LPAR_PROPS_TYPE *props)
 {
-  char *responseBody = (char *)malloc(defaultLen15MB);
-  char *queryParm = (char *)malloc(defaultLen);
-
-  *LPARstatusValue = NULL;
-
-  memset(responseBody, 0, defaultLen15MB);
-  memset(queryParm, 0, defaultLen);
-
-  strcpy(queryParm, "?properties=");
-  strcat(queryParm, statusProp);
-  strcat(queryParm, "&");
-  strcat(queryParm, cachedAcceptable);
-
-  if (queryLPAR(queryParm, &responseBody, defaultLen15MB))
+  for (int i = 0; i < lparPropCount; i++)
   {
-    if (parse_json_text((char *)responseBody))
-    {
-      *LPARstatusValue = find_string(0, (char *)statusProp);
-      if (*LPARstatusValue != NULL)
-      {
-        printf("LPAR %s is %s\n", statusProp, *LPARstatusValue);
-        free(responseBody);
-        free(queryParm);
-        return true;
-      }
-      else
-      {
-        printf("ERROR: null returned instead of LPAR status\n");
-      }
-    }
-    else
-    {
-      printf("ERROR: malformed LPAR status response body\n");
-    }
+    char **field = (char **)((char *)props + lparPropBindings[i].offset);
+    *field = NULL;
   }
+  props->fetched = 0;
 
-  free(responseBody);
-  free(queryParm);
-
-  return false;
+  releaseResponseBuffer(props->respBuf);
+  props->respBuf = NULL;
 }
 
 /*
@@ -207,13 +388,13 @@ bool getLPARStatus(char **LPARstatusValue)
  * the result of the operation.
  *
  * input arguments: uri, target name, request body
- * output arguments: pre-allocated 2048 KB data area for
+ * output arguments: pre-allocated defaultLen2K byte data area for
  *                   the resulting job URI
  */
 bool asyncPost(char *uriArg,
                char *targetNameArg,
                char *requestBodyArg,
-               char **jobUri)
+               char *jobUri)
 {
   bool asyncSuccess = false;
 
@@ -267,33 +448,26 @@ bool asyncPost(char *uriArg,
   }
 
   /* now initialize the response parm that will
-     be populated with the resulting data
+     be populated with the resulting data, an async
+     post only returns a job-uri so a small buffer is enough
   */
-  char *responseBody = (char *)malloc(defaultLen15MB);
-  char *responseDate = (char *)malloc(defaultLen);
-  char *requestId = (char *)malloc(defaultLen);
-
-  memset(responseBody, 0, defaultLen15MB);
-  memset(responseDate, 0, defaultLen);
-  memset(requestId, 0, defaultLen);
-
-  response.responseBody = responseBody;
-  response.responseBodyLen = defaultLen15MB;
-  response.responseDate = responseDate;
-  response.responseDateLen = defaultLen;
-  response.requestId = requestId;
-  response.requestIdLen = defaultLen;
+  RESPBUF_TYPE *respBuf = acquireResponseBuffer(RESPBUF_SMALL);
+  if (respBuf == NULL)
+  {
+    return false;
+  }
+  attachResponseBuffer(respBuf, &response);
 
   traceRequest(&request, &response);
 
-  hwirest(
-      &request,
-      &response);
+  issueRequest(&request, &response);
+
+  completeResponseBuffer(respBuf, &response);
 
   /* On success, an async post request returns with
      HTTP Status 202 and a job URI
   */
-  if (isSuccessful(&response) &&
+  if (isSuccessful(&response, &respBuf->error) &&
       response.httpStatus == 202 &&
       response.responseBodyLen > 0)
   {
@@ -306,12 +480,21 @@ bool asyncPost(char *uriArg,
       entryNum = getnumberOfEntries(0);
       if (entryNum == 1)
       {
-        *jobUri = find_string(0, "job-uri");
-        if (*jobUri != NULL)
+        JSON_VIEW_TYPE view;
+
+        if (find_view(0, (char *)"job-uri", HWTJ_STRING_TYPE, &respBuf->arena,
+                      &view) &&
+            view.len < defaultLen2K)
         {
-          printf("jobUri:%s\n", *jobUri);
+          memcpy(jobUri, view.text, view.len);
+          jobUri[view.len] = '\0';
+          printf("jobUri:%s\n", jobUri);
           asyncSuccess = true;
         }
+        else
+        {
+          printf("asyncPost ERROR: job-uri not returned\n");
+        }
       }
       else
       {
@@ -320,13 +503,73 @@ bool asyncPost(char *uriArg,
     }
   }
 
-  free(responseBody);
-  free(responseDate);
-  free(requestId);
+  releaseResponseBuffer(respBuf);
 
   return asyncSuccess;
 }
 
+/*
+ * Method: syncPost
+ *
+ * Issue a POST operation that completes within the request, e.g.
+ * Add Member to Custom Group, and returns HTTP status 200 or 204
+ * rather than a job-uri. A failure is decoded into respBuf->error.
+ *
+ * input arguments: uri, target name, request body, response buffer
+ */
+bool syncPost(char *uriArg,
+              char *targetNameArg,
+              char *requestBodyArg,
+              RESPBUF_TYPE *respBuf)
+{
+  REQUEST_PARM_TYPE request;
+  RESPONSE_PARM_TYPE response;
+
+  memset(&request, 0, sizeof(REQUEST_PARM_TYPE));
+  memset(&response, 0, sizeof(RESPONSE_PARM_TYPE));
+
+  if (uriArg == NULL || targetNameArg == NULL)
+  {
+    printf("syncPost ERROR: missing required uriArg or targetNameArg\n");
+    return false;
+  }
+  else if (strlen(uriArg) > defaultLen2K ||
+           strlen(targetNameArg) > defaultLen)
+  {
+    printf("syncPost ERROR: uriArg or targetNameArg too long\n");
+    return false;
+  }
+  else if (requestBodyArg != NULL && strlen(requestBodyArg) > defaultLen64K)
+  {
+    printf("syncPost ERROR: requestBodyArg too long\n");
+    return false;
+  }
+
+  request.uri = uriArg;
+  request.uriLen = strlen(uriArg);
+  request.httpMethod = HWI_REST_POST;
+  request.requestTimeout = 0x00002688;
+  request.targetName = targetNameArg;
+  request.targetNameLen = strlen(targetNameArg);
+
+  if (requestBodyArg != NULL)
+  {
+    request.requestBody = requestBodyArg;
+    request.requestBodyLen = strlen(requestBodyArg);
+  }
+
+  attachResponseBuffer(respBuf, &response);
+
+  traceRequest(&request, &response);
+
+  issueRequest(&request, &response);
+
+  completeResponseBuffer(respBuf, &response);
+
+  return isSuccessful(&response, &respBuf->error) &&
+         (response.httpStatus == 200 || response.httpStatus == 204);
+}
+
 /*
  * Method: getCPCInfo
  *
@@ -335,6 +578,39 @@ bool asyncPost(char *uriArg,
  * request will build on this information.
  */
 bool getCPCInfo(char *CPCname)
+{
+  return resolveCPC(CPCname, &CPCuri, &CPCtargetName);
+}
+
+/*
+ * Method: keepListedObject
+ *
+ * Stream callback that counts the entries of a filtered list and
+ * keeps the object-uri and target-name of the first one.
+ */
+static bool keepListedObject(int, STREAM_VALUE_TYPE *values,
+                             void *userData)
+{
+  LISTED_OBJECT_TYPE *listed = (LISTED_OBJECT_TYPE *)userData;
+
+  if (listed->count++ == 0)
+  {
+    bindStreamedEntry(listedObjectSchema, values, NULL, listed);
+  }
+
+  return true;
+}
+
+/*
+ * Method: resolveCPC
+ *
+ * Issue List CPC Objects operation filtered by the CPC name and
+ * return the URI and target name associated with the CPC.
+ *
+ * input arguments: CPC name
+ * output arguments: pointers to the CPC uri and target name strings
+ */
+bool resolveCPC(char *CPCname, char **cpcUri, char **cpcTargetName)
 {
   bool listSuccess = false;
 
@@ -355,6 +631,13 @@ bool getCPCInfo(char *CPCname)
     return false;
   }
 
+  if (cacheLookup("", CPCname, cpcUri, cpcTargetName))
+  {
+    printf("CPCuri:%s (cached)\n", *cpcUri);
+    printf("CPCtargetName:%s (cached)\n", *cpcTargetName);
+    return true;
+  }
+
   /* Issue a CPC LIST request to obtain the uri
     and target name associated with CPC named T115:
     GET /api/cpcs?name=<CPCname>
@@ -363,10 +646,18 @@ bool getCPCInfo(char *CPCname)
   not require a target name value because it
   will automatically be sent to the local SE
   */
-  char *uri = (char *)malloc(defaultLen2K);
-  char *responseBody = (char *)malloc(defaultLen15MB);
-  char *responseDate = (char *)malloc(defaultLen);
-  char *requestId = (char *)malloc(defaultLen);
+  RESPBUF_TYPE *respBuf = acquireResponseBuffer(RESPBUF_LARGE);
+  if (respBuf == NULL)
+  {
+    return false;
+  }
+
+  char *uri = (char *)arenaAlloc(&respBuf->arena, defaultLen2K);
+  if (uri == NULL)
+  {
+    releaseResponseBuffer(respBuf);
+    return false;
+  }
 
   memset(uri, 0, defaultLen2K);
   strcpy(uri, "/api/cpcs?name=");
@@ -384,70 +675,64 @@ bool getCPCInfo(char *CPCname)
     the response value for that specific field and the data area
     length will be updated to reflect the length of that value.
   */
-  memset(responseBody, 0, defaultLen15MB);
-  memset(responseDate, 0, defaultLen);
-  memset(requestId, 0, defaultLen);
-  response.responseBody = responseBody;
-  response.responseBodyLen = defaultLen15MB;
-  response.responseDate = responseDate;
-  response.responseDateLen = defaultLen;
-  response.requestId = requestId;
-  response.requestIdLen = defaultLen;
+  attachResponseBuffer(respBuf, &response);
 
   traceRequest(&request, &response);
 
-  hwirest(
-      &request,
-      &response);
+  issueRequest(&request, &response);
+
+  completeResponseBuffer(respBuf, &response);
 
   /* An httpStatus in the 200 range indicates the request was successful
   NOTE: A success does not mean the cpc info was returned,
   the response body may contain an empty cpcs array because
   the SE was not able to match the CPC name or the user ID was
   */
-  if (isSuccessful(&response) &&
+  if (isSuccessful(&response, &respBuf->error) &&
       response.responseBodyLen > 0)
   {
-    /* Parse the response JSON text. */
-    if (parse_json_text((char *)response.responseBody))
-    {
-      HWTJ_HANDLE_TYPE arrayhandle;
-      HWTJ_HANDLE_TYPE arrayentry;
-      int entryNum = 0;
+    /* Extract the uri and target name of the cpcs entries as the
+       response text is scanned.
+    */
+    LISTED_OBJECT_TYPE listed;
+    STREAM_EXTRACT_TYPE stream;
 
-      arrayhandle = find_array(0, "cpcs");
-      if (arrayhandle != NULL)
-      {
-        entryNum = getnumberOfEntries(arrayhandle);
-        if (entryNum == 1)
-        {
-          arrayentry = getArrayEntry(arrayhandle, 0);
-          CPCuri = find_string(arrayentry, "object-uri");
-          CPCtargetName = find_string(arrayentry, "target-name");
-
-          if (CPCuri != NULL && CPCtargetName != NULL)
-          {
-            printf("CPCuri:%s\n", CPCuri);
-            printf("CPCtargetName:%s\n", CPCtargetName);
-            listSuccess = true;
-          }
-        }
-        else
-        {
-          printf("getCPCInfo ERROR: empty cpcs array returned, verify authorization\n");
-        }
-      }
-      else
-      {
-        printf("getCPCInfo ERROR: cpc array not found\n");
-      }
+    memset(&listed, 0, sizeof(LISTED_OBJECT_TYPE));
+    initStreamExtract(&stream, "cpcs", keepListedObject, &listed);
+    streamSchema(&stream, listedObjectSchema);
+
+    if (!streamArrayEntries(&stream, (char *)response.responseBody,
+                            response.responseBodyLen))
+    {
+      displayStreamError(&stream, "Unable to parse JSON data.");
+    }
+    else if (!stream.arrayFound)
+    {
+      printf("getCPCInfo ERROR: cpc array not found\n");
+    }
+    else if (listed.count == 1 &&
+             listed.uri != NULL && listed.targetName != NULL)
+    {
+      *cpcUri = listed.uri;
+      *cpcTargetName = listed.targetName;
+      listed.uri = listed.targetName = NULL;
+
+      printf("CPCuri:%s\n", *cpcUri);
+      printf("CPCtargetName:%s\n", *cpcTargetName);
+      cacheStore("", CPCname, *cpcUri, *cpcTargetName);
+      listSuccess = true;
     }
+    else
+    {
+      printf("getCPCInfo ERROR: empty cpcs array returned, verify authorization\n");
+    }
+
+    free(listed.uri);
+    free(listed.targetName);
+    freeStreamExtract(&stream);
   }
 
-  free(uri);
-  free(responseBody);
-  free(responseDate);
-  free(requestId);
+  releaseResponseBuffer(respBuf);
 
   return listSuccess;
 }
@@ -463,25 +748,42 @@ bool getCPCInfo(char *CPCname)
  * input arguments: query parameter, if passed in must include the
  *  "?", e.g: "?properties=name"
  *
- * output arguments: pre-allocated response body data area
- *                   and the size of the data area
+ * output arguments: response buffer from acquireResponseBuffer,
+ *                   holds the response body on return
  */
 bool queryLPAR(char *queryParms,
-               char **responseBody,
-               int responseBodyLen)
+               RESPBUF_TYPE *respBuf)
+{
+  return queryLPARObject(LPARuri, LPARtargetName, queryParms, respBuf);
+}
+
+/*
+ * Method: queryLPARObject
+ *
+ * Same as queryLPAR for the LPAR identified by the
+ * passed in uri and target name.
+ */
+bool queryLPARObject(char *lparUri,
+                     char *lparTargetName,
+                     char *queryParms,
+                     RESPBUF_TYPE *respBuf)
 {
   bool querySuccess = false;
 
   REQUEST_PARM_TYPE request;
   RESPONSE_PARM_TYPE response;
 
-  char *uri = (char *)malloc(defaultLen2K);
+  char *uri = (char *)arenaAlloc(&respBuf->arena, defaultLen2K);
+  if (uri == NULL)
+  {
+    return false;
+  }
 
   memset(&request, 0, sizeof(REQUEST_PARM_TYPE));
   memset(&response, 0, sizeof(RESPONSE_PARM_TYPE));
 
   memset(uri, 0, defaultLen2K);
-  strcpy(uri, LPARuri);
+  strcpy(uri, lparUri);
 
   if (queryParms != NULL)
   {
@@ -492,50 +794,29 @@ bool queryLPAR(char *queryParms,
     else
     {
       printf("queryLPAR ERROR: queryParms too long\n");
-      free(uri);
       return false;
     }
   }
 
-  char *targetName = (char *)malloc(defaultLen);
-  char *responseDate = (char *)malloc(defaultLen);
-  char *requestId = (char *)malloc(defaultLen);
-
-  memset(targetName, 0, defaultLen);
-  strcpy(targetName, LPARtargetName);
-
   request.httpMethod = HWI_REST_GET;
   request.uri = uri;
   request.uriLen = strlen(uri);
-  request.targetName = targetName;
-  request.targetNameLen = strlen(targetName);
+  request.targetName = lparTargetName;
+  request.targetNameLen = strlen(lparTargetName);
   request.requestTimeout = 0x00002688;
 
-  memset(responseDate, 0, defaultLen);
-  memset(requestId, 0, defaultLen);
-
-  response.responseBody = *responseBody;
-  response.responseBodyLen = responseBodyLen;
-  response.responseDate = responseDate;
-  response.responseDateLen = defaultLen;
-  response.requestId = requestId;
-  response.requestIdLen = defaultLen;
+  attachResponseBuffer(respBuf, &response);
 
   traceRequest(&request, &response);
 
-  hwirest(
-      &request,
-      &response);
+  issueRequest(&request, &response);
+
+  completeResponseBuffer(respBuf, &response);
 
-  querySuccess = isSuccessful(&response) &&
+  querySuccess = isSuccessful(&response, &respBuf->error) &&
                  response.httpStatus == 200 &&
                  (response.responseBodyLen > 0);
 
-  free(uri);
-  free(targetName);
-  free(responseDate);
-  free(requestId);
-
   return querySuccess;
 }
 
@@ -545,125 +826,306 @@ bool queryLPAR(char *queryParms,
  * Issue List Logical Partitions of CPC operation to retrieve the URI
  * and target name assocaited with the LPAR. All subsequent
  * request will build on this information.
+ *
+ * Without an LPAR name all LPARs of the CPC are listed and indexed
+ * by name, later lookups of any LPAR on the CPC are served from
+ * that index. LPARuri and LPARtargetName are left unset.
  */
 bool getLPARInfo(char *LPARname)
 {
-  bool listSuccess = false;
-  bool parseForUri = false;
+  if (LPARname == NULL)
+  {
+    printf("getLPARInfo: LPAR name not provided, asking for all\n");
+    return indexLPARs(CPCuri, CPCtargetName) != NULL;
+  }
+
+  return resolveLPAR(CPCuri, CPCtargetName, LPARname,
+                     &LPARuri, &LPARtargetName);
+}
 
+/*
+ * Method: requestLPARList
+ *
+ * Issue List Logical Partitions of CPC operation, filtered by the
+ * LPAR name when one is provided, and stream the entries of the
+ * logical-partitions array of the response to the stream callback.
+ *
+ * input arguments: CPC uri and target name, LPAR name or NULL for all,
+ *                  stream with its fields registered
+ * returns: true if the array was found and scanned
+ */
+bool requestLPARList(char *cpcUri,
+                     char *cpcTargetName,
+                     char *LPARname,
+                     STREAM_EXTRACT_TYPE *stream)
+{
   REQUEST_PARM_TYPE request;
   RESPONSE_PARM_TYPE response;
 
-  char *uri = (char *)malloc(defaultLen2K);
+  bool listSuccess = false;
+
+  if (cpcUri == NULL || cpcTargetName == NULL)
+  {
+    printf("requestLPARList ERROR: missing CPC uri or target name\n");
+    return false;
+  }
+  else if (LPARname != NULL &&
+           strlen(cpcUri) + strlen(LPARname) + 25 > defaultLen2K)
+  {
+    printf("getLPARInfo ERROR: LPARname too long\n");
+    return false;
+  }
 
   memset(&request, 0, sizeof(REQUEST_PARM_TYPE));
   memset(&response, 0, sizeof(RESPONSE_PARM_TYPE));
 
+  RESPBUF_TYPE *respBuf = acquireResponseBuffer(RESPBUF_LARGE);
+  if (respBuf == NULL)
+  {
+    return false;
+  }
+
   /* create /api/cpcs/{cpc-id}/logical-partitions?name=LPARname */
+  char *uri = (char *)arenaAlloc(&respBuf->arena, defaultLen2K);
+  if (uri == NULL)
+  {
+    releaseResponseBuffer(respBuf);
+    return false;
+  }
   memset(uri, 0, defaultLen2K);
-  strcpy(uri, CPCuri);
+  strcpy(uri, cpcUri);
 
   if (LPARname == NULL)
   {
-    printf("getLPARInfo: LPAR name not provided, asking for all\n");
     strcat(uri, "/logical-partitions");
   }
-  else if ((defaultLen2K - strlen(LPARname)) < 0)
-  {
-    printf("getLPARInfo ERROR: LPARname too long\n");
-    free(uri);
-    return false;
-  }
   else
   {
     strcat(uri, "/logical-partitions?name=");
     strncat(uri, LPARname, strlen(LPARname));
-    parseForUri = true;
   }
 
-  char *targetName = (char *)malloc(defaultLen);
-  char *responseBody = (char *)malloc(defaultLen15MB);
-  char *responseDate = (char *)malloc(defaultLen);
-  char *requestId = (char *)malloc(defaultLen);
-
-  memset(targetName, 0, defaultLen);
-  strcpy(targetName, CPCtargetName);
-
   request.httpMethod = HWI_REST_GET;
   request.uri = uri;
   request.uriLen = strlen(uri);
-  request.targetName = targetName;
-  request.targetNameLen = strlen(targetName);
+  request.targetName = cpcTargetName;
+  request.targetNameLen = strlen(cpcTargetName);
   request.requestTimeout = 0x00002688;
 
-  memset(responseBody, 0, defaultLen15MB);
-  memset(responseDate, 0, defaultLen);
-  memset(requestId, 0, defaultLen);
-  response.responseBody = responseBody;
-  response.responseBodyLen = defaultLen15MB;
-  response.responseDate = responseDate;
-  response.responseDateLen = defaultLen;
-  response.requestId = requestId;
-  response.requestIdLen = defaultLen;
+  attachResponseBuffer(respBuf, &response);
 
   traceRequest(&request, &response);
 
-  hwirest(
-      &request,
-      &response);
+  issueRequest(&request, &response);
 
-  if (isSuccessful(&response) && parseForUri &&
+  completeResponseBuffer(respBuf, &response);
+
+  if (isSuccessful(&response, &respBuf->error) &&
       response.responseBodyLen > 0)
   {
-    /* Parse the response JSON text. */
-    if (parse_json_text((char *)response.responseBody))
+    if (!streamArrayEntries(stream, (char *)response.responseBody,
+                            response.responseBodyLen))
     {
-      HWTJ_HANDLE_TYPE arrayhandle;
-      HWTJ_HANDLE_TYPE arrayentry;
-      int entryNum = 0;
+      displayStreamError(stream, "Unable to parse JSON data.");
+    }
+    else if (!stream->arrayFound)
+    {
+      printf("getLPARInfo ERROR: logical-partitions array not found\n");
+    }
+    else
+    {
+      listSuccess = true;
+    }
+  }
 
-      arrayhandle = find_array(0, "logical-partitions");
-      if (arrayhandle != NULL)
-      {
-        entryNum = getnumberOfEntries(arrayhandle);
-        if (entryNum == 1)
-        {
-          arrayentry = getArrayEntry(arrayhandle, 0);
-          LPARuri = find_string(arrayentry, "object-uri");
-          LPARtargetName = find_string(arrayentry, "target-name");
-
-          if (LPARuri != NULL && LPARtargetName != NULL)
-          {
-            printf("LPARuri:%s\n", LPARuri);
-            printf("LPARtargetName:%s\n", LPARtargetName);
-            listSuccess = true;
-          }
-          else
-          {
-            printf("getLPARInfo ERROR: failed to located uri and or target name\n");
-          }
-        }
-        else
-        {
-          printf("getLPARInfo ERROR: empty logical-partitions array returned, verify authorization\n");
-        }
-      }
-      else
-      {
-        printf("etLPARInfo ERROR: logical-partitions array not found\n");
-      }
+  releaseResponseBuffer(respBuf);
+  return listSuccess;
+}
+
+/*
+ * Method: resolveLPAR
+ *
+ * Issue List Logical Partitions of CPC operation filtered by the
+ * LPAR name and return the URI and target name associated with
+ * the LPAR. No request is issued when the LPAR is in the resolution
+ * cache, or when all LPARs of the CPC were indexed by indexLPARs.
+ *
+ * input arguments: CPC uri and target name, LPAR name
+ * output arguments: pointers to the LPAR uri and target name strings
+ */
+bool resolveLPAR(char *cpcUri,
+                 char *cpcTargetName,
+                 char *LPARname,
+                 char **lparUri,
+                 char **lparTargetName)
+{
+  bool listSuccess = false;
+  LISTED_OBJECT_TYPE listed;
+  STREAM_EXTRACT_TYPE stream;
+
+  if (LPARname == NULL)
+  {
+    printf("resolveLPAR ERROR: missing LPAR name\n");
+    return false;
+  }
+
+  /* LPAR entries are scoped by the target name of their CPC */
+  if (cacheLookup(cpcTargetName, LPARname, lparUri, lparTargetName))
+  {
+    printf("LPARuri:%s (cached)\n", *lparUri);
+    printf("LPARtargetName:%s (cached)\n", *lparTargetName);
+    return true;
+  }
+
+  LPAR_INDEX_TYPE *index = findLPARIndex(cpcTargetName);
+  if (index != NULL)
+  {
+    LPAR_INFO_TYPE *lpar = lookupIndexedLPAR(index, LPARname);
+    if (lpar == NULL)
+    {
+      printf("getLPARInfo ERROR: LPAR %s not found on CPC\n", LPARname);
+      return false;
     }
+
+    *lparUri = strdup(lpar->uri);
+    *lparTargetName = strdup(lpar->targetName);
+    printf("LPARuri:%s (indexed)\n", *lparUri);
+    printf("LPARtargetName:%s (indexed)\n", *lparTargetName);
+    return *lparUri != NULL && *lparTargetName != NULL;
   }
 
-  free(uri);
-  free(targetName);
-  free(responseBody);
-  free(responseDate);
-  free(requestId);
+  memset(&listed, 0, sizeof(LISTED_OBJECT_TYPE));
+  initStreamExtract(&stream, "logical-partitions", keepListedObject,
+                    &listed);
+  streamSchema(&stream, listedObjectSchema);
+
+  if (requestLPARList(cpcUri, cpcTargetName, LPARname, &stream))
+  {
+    if (listed.count != 1)
+    {
+      printf("getLPARInfo ERROR: empty logical-partitions array returned, verify authorization\n");
+    }
+    else if (listed.uri != NULL && listed.targetName != NULL)
+    {
+      *lparUri = listed.uri;
+      *lparTargetName = listed.targetName;
+      listed.uri = listed.targetName = NULL;
+
+      printf("LPARuri:%s\n", *lparUri);
+      printf("LPARtargetName:%s\n", *lparTargetName);
+      cacheStore(cpcTargetName, LPARname, *lparUri, *lparTargetName);
+      listSuccess = true;
+    }
+    else
+    {
+      printf("getLPARInfo ERROR: failed to located uri and or target name\n");
+    }
+  }
+
+  free(listed.uri);
+  free(listed.targetName);
+  freeStreamExtract(&stream);
 
   return listSuccess;
 }
 
+/*
+ * Method: addListedLPAR
+ *
+ * Stream callback that adds an entry of the logical-partitions
+ * array to the LPAR list being built. Entries without a name, uri
+ * or target name are skipped.
+ */
+static bool addListedLPAR(int, STREAM_VALUE_TYPE *values,
+                          void *userData)
+{
+  LPAR_LIST_TYPE *list = (LPAR_LIST_TYPE *)userData;
+
+  if (list->count == list->capacity)
+  {
+    int newCapacity = list->capacity > 0 ? list->capacity * 2 : 64;
+    LPAR_INFO_TYPE *newLpars = (LPAR_INFO_TYPE *)realloc(
+        list->lpars, newCapacity * sizeof(LPAR_INFO_TYPE));
+    if (newLpars == NULL)
+    {
+      list->failed = true;
+      return false;
+    }
+    list->lpars = newLpars;
+    list->capacity = newCapacity;
+  }
+
+  LPAR_INFO_TYPE *lpar = &list->lpars[list->count];
+
+  memset(lpar, 0, sizeof(LPAR_INFO_TYPE));
+  int bound = bindStreamedEntry(lparInfoSchema, values, NULL, lpar);
+
+  if ((bound & LPAR_BOUND_REQUIRED) == LPAR_BOUND_REQUIRED)
+  {
+    list->count++;
+  }
+  else
+  {
+    free(lpar->name);
+    free(lpar->uri);
+    free(lpar->targetName);
+    free(lpar->status);
+  }
+
+  return true;
+}
+
+/*
+ * Method: listLPARs
+ *
+ * Issue List Logical Partitions of CPC operation for all LPARs
+ * and return the name, URI, target name and status of each. The
+ * entries are added to the list as the response is scanned.
+ *
+ * input arguments: CPC uri and target name
+ * output arguments: pointer to the LPAR array, free with freeLPARList
+ * returns: number of LPARs, -1 if the request failed
+ */
+int listLPARs(char *cpcUri, char *cpcTargetName, LPAR_INFO_TYPE **lparList)
+{
+  LPAR_LIST_TYPE list;
+  STREAM_EXTRACT_TYPE stream;
+
+  memset(&list, 0, sizeof(LPAR_LIST_TYPE));
+  initStreamExtract(&stream, "logical-partitions", addListedLPAR, &list);
+  streamSchema(&stream, lparInfoSchema);
+
+  bool listed = requestLPARList(cpcUri, cpcTargetName, NULL, &stream);
+  freeStreamExtract(&stream);
+
+  if (!listed || list.failed)
+  {
+    freeLPARList(list.lpars, list.count);
+    *lparList = NULL;
+    return -1;
+  }
+
+  *lparList = list.lpars;
+  return list.count;
+}
+
+/*
+ * Method: freeLPARList
+ *
+ * Free an LPAR array returned by listLPARs.
+ */
+void freeLPARList(LPAR_INFO_TYPE *lparList, int lparCount)
+{
+  for (int i = 0; i < lparCount; i++)
+  {
+    free(lparList[i].name);
+    free(lparList[i].uri);
+    free(lparList[i].targetName);
+    free(lparList[i].status);
+  }
+  free(lparList);
+}
+
 /*
  * Method: activateLPAR
  *
@@ -679,20 +1141,27 @@ bool activateLPAR()
 {
   bool actionSuccess = false;
 
-  char *LPARstatusValue = NULL;
-  char *LPARnextActProfile = NULL;
+  LPAR_PROPS_TYPE props;
   char *description = "activate LPAR";
 
-  /* In this scenario, we only want to attempt an activate
+  /* Read the status and the next activation profile in one request.
+     In this scenario, we only want to attempt an activate
      if the current status is 'not-activated'
   */
-  if (getLPARStatus(&LPARstatusValue)) {
-    if (0 != strcmp(statusLparNotActive,LPARstatusValue)) {
-      printf("activateLPAR ERROR:\n");
-      printf("LPAR is expected to be in %s status\n", statusLparNotActive);
-      printf("LPAR is currently in %s status\n", LPARstatusValue);
-      return false;
-    }
+  if (!getLPARProperties(LPARuri, LPARtargetName,
+                         LPAR_PROP_STATUS | LPAR_PROP_NEXT_ACT_PROFILE,
+                         &props))
+  {
+    freeLPARProperties(&props);
+    return false;
+  }
+
+  if (0 != strcmp(statusLparNotActive, props.status)) {
+    printf("activateLPAR ERROR:\n");
+    printf("LPAR is expected to be in %s status\n", statusLparNotActive);
+    printf("LPAR is currently in %s status\n", props.status);
+    freeLPARProperties(&props);
+    return false;
   }
 
   char *activateUri = (char *)malloc(defaultLen2K);
@@ -702,24 +1171,23 @@ bool activateLPAR()
     To illustrate how a request body is used, re-use the current
      next activation profile for this LPAR as input
   */
-  if (getNextActivationProfile(&LPARnextActProfile))
-  {
-    memset(activateUri, 0, defaultLen2K);
-    memset(requestBody, 0, defaultLen64K);
+  memset(activateUri, 0, defaultLen2K);
+  memset(requestBody, 0, defaultLen64K);
 
-    strcpy(activateUri, LPARuri);
-    strcat(activateUri, "/operations/activate");
+  strcpy(activateUri, LPARuri);
+  strcat(activateUri, "/operations/activate");
 
-    strcpy(requestBody, "{");
-    strcat(requestBody, "\"activation-profile-name\":\"");
-    strcat(requestBody, LPARnextActProfile);
-    strcat(requestBody, "\",\"force\":true");
-    strcat(requestBody, "}");
+  strcpy(requestBody, "{");
+  strcat(requestBody, "\"activation-profile-name\":\"");
+  strcat(requestBody, props.nextActivationProfile);
+  strcat(requestBody, "\",\"force\":true");
+  strcat(requestBody, "}");
 
-    actionSuccess = asyncPostWorker(activateUri, LPARtargetName,
-                                    requestBody, description);
-  }
+  actionSuccess = asyncPostWorker(activateUri, LPARtargetName,
+                                  requestBody, description,
+                                  POLL_OP_ACTIVATE);
 
+  freeLPARProperties(&props);
   free(activateUri);
   free(requestBody);
 
@@ -734,59 +1202,95 @@ bool activateLPAR()
  * how long the actual operations takes.
  *
  * input arguments: uri, target name, request body,
- *                  description of operations
+ *                  description of operations, operation type
+ *                  (POLL_OP_ACTIVATE, POLL_OP_LOAD, ...)
  */
 bool asyncPostWorker(char *uriArg,
                      char *targetNameArg,
                      char *requestBodyArg,
-                     char *description)
+                     char *description,
+                     int opType)
 {
   bool actionSuccess = false;
 
-  char *jobStatus;
+  char *jobStatus = NULL;
   char *jobUri = (char *)malloc(defaultLen2K);
+  POLL_RESULT_TYPE pollResult;
 
+  if (jobUri == NULL)
+  {
+    return false;
+  }
   memset(jobUri, 0, defaultLen2K);
 
   startTimeRecorder();
-  if (asyncPost(uriArg, targetNameArg, requestBodyArg, &jobUri))
+  if (asyncPost(uriArg, targetNameArg, requestBodyArg, jobUri))
   {
-    pollJobUri(jobUri, targetNameArg, &jobStatus);
-    if (0 == strcmp(statusJobComplete, jobStatus))
+    pollJobUri(jobUri, targetNameArg, opType, &jobStatus, &pollResult);
+    if (jobStatus != NULL && 0 == strcmp(statusJobComplete, jobStatus))
     {
       actionSuccess = true;
     }
+    else if (pollResult.timedOut)
+    {
+      printf("job timed out after %d seconds\n", pollPolicy.deadlineSec);
+    }
     else
     {
-      printf("job failed with final job status of %s\n", jobStatus);
+      printf("job failed with final job status of %s\n",
+             jobStatus != NULL ? jobStatus : "unknown");
     }
   }
   endTimeRecorder(description);
 
+  free(jobStatus);
+  free(jobUri);
+
   return actionSuccess;
 }
 
 /*
  * Method: pollJobUri
  *
- * POLLs the job URI every 5 seconds until it's finished
+ * POLLs the job URI until it's finished or the pollPolicy deadline
+ * is reached. The first poll is scheduled near the completion time
+ * learned for the operation type, later polls back off from the
+ * initial interval up to the ceiling. This is a job tracker
+ * (hwirjobs.cpp) holding a single job.
  *
- * input arguments: job uri, target name
- * output arguments: pointer to jobStatus string
+ * input arguments: job uri, target name, operation type
+ * output arguments: pointer to jobStatus string, poll result
  */
-void pollJobUri(char *jobUri, char *jobTargetName, char **jobStatus)
+void pollJobUri(char *jobUri, char *jobTargetName, int opType,
+                char **jobStatus, POLL_RESULT_TYPE *pollResult)
 {
   *jobStatus = NULL;
+  memset(pollResult, 0, sizeof(POLL_RESULT_TYPE));
+
+  JOB_TRACKER_TYPE *tracker = createJobTracker(&pollPolicy);
+  if (tracker == NULL)
+  {
+    return;
+  }
+
   printf("*>>");
   printf("starting polling at %s\n", printTime());
-  while (isJobRunning(jobUri, jobTargetName, jobStatus))
+
+  JOB_ENTRY_TYPE *job = trackJob(tracker, jobUri, jobTargetName, NULL,
+                                 opType, NULL, NULL);
+  if (job != NULL)
   {
-    sleep(5); // sleep in seconds
-    if (verbose2)
-    {
-      printf("polling again at %s\n", printTime());
-    }
+    runJobTracker(tracker);
+
+    /* hand the status string over to the caller */
+    *jobStatus = job->status;
+    job->status = NULL;
+    memcpy(pollResult, &job->pollResult, sizeof(POLL_RESULT_TYPE));
+
+    printPollResult(*jobStatus, pollResult);
   }
+
+  freeJobTracker(tracker);
 }
 
 /*
@@ -843,16 +1347,48 @@ char *printTime()
  * output arguments: pointer to jobStatus string
  */
 bool isJobRunning(char *uriArg, char *targetNameArg, char **jobStatus)
+{
+  JOB_STATUS_TYPE jobStatusInfo;
+
+  getJobStatus(uriArg, targetNameArg, &jobStatusInfo);
+  *jobStatus = jobStatusInfo.status[0] != '\0'
+                   ? strdup(jobStatusInfo.status)
+                   : NULL;
+
+  return jobStatusInfo.running;
+}
+
+/*
+ * Method: getJobStatus
+ *
+ * Retrieve the status of the job associated with the passed in
+ * job uri. Once the job is no longer running the job-status-code
+ * and job-reason-code are returned as well.
+ *
+ * input arguments: uri, target name
+ * output arguments: job status, codes are -1 when not returned
+ * returns: true if the job status was retrieved
+ */
+bool getJobStatus(char *uriArg, char *targetNameArg,
+                  JOB_STATUS_TYPE *jobStatus)
 {
   REQUEST_PARM_TYPE request;
   RESPONSE_PARM_TYPE response;
 
-  int responseBodyLen = defaultLen15MB;
-  char *responseDate = (char *)malloc(defaultLen);
-  char *requestId = (char *)malloc(defaultLen);
-  char *responseBody = (char *)malloc(responseBodyLen);
+  bool statusFound = false;
 
-  bool jobRunning = false;
+  jobStatus->status[0] = '\0';
+  jobStatus->jobStatusCode = -1;
+  jobStatus->jobReasonCode = -1;
+  jobStatus->jobResults = false;
+  jobStatus->running = false;
+
+  /* job status replies are small, poll with the small size class */
+  RESPBUF_TYPE *respBuf = acquireResponseBuffer(RESPBUF_SMALL);
+  if (respBuf == NULL)
+  {
+    return false;
+  }
 
   memset(&request, 0, sizeof(REQUEST_PARM_TYPE));
   memset(&response, 0, sizeof(RESPONSE_PARM_TYPE));
@@ -864,100 +1400,125 @@ bool isJobRunning(char *uriArg, char *targetNameArg, char **jobStatus)
   request.targetNameLen = strlen(targetNameArg);
   request.requestTimeout = 0x00002688;
 
-  memset(responseBody, 0, responseBodyLen);
-  memset(responseDate, 0, defaultLen);
-  memset(requestId, 0, defaultLen);
-
-  response.responseBody = responseBody;
-  response.responseBodyLen = responseBodyLen;
-  response.responseDate = responseDate;
-  response.responseDateLen = defaultLen;
-  response.requestId = requestId;
-  response.requestIdLen = defaultLen;
+  attachResponseBuffer(respBuf, &response);
 
   if (verbose2)
   {
     traceRequest(&request, &response);
   }
 
-  hwirest(
-      &request,
-      &response);
+  issueRequest(&request, &response);
+
+  completeResponseBuffer(respBuf, &response);
 
   if (response.httpStatus == 200 &&
       response.responseBodyLen > 0)
   {
-    /* Parse the response JSON text. */
+    /* Parse the response JSON text and bind all fields at once,
+       the codes are only present once the job has ended.
+    */
     if (parse_json_text((char *)response.responseBody))
     {
-      *jobStatus = find_string(0, "status");
+      int bound = bindObject(jobStatusSchema, 0, &respBuf->arena, jobStatus);
 
-      if (*jobStatus == NULL)
+      if (bound < 0 || !(bound & JOB_BOUND_STATUS))
       {
         printf("Error encountered retrieving status property\n");
       }
       else
       {
+        statusFound = true;
+
         if (verbose2)
         {
-          printf("job status is %s\n", **jobStatus);
+          printf("job status is %s\n", jobStatus->status);
         }
 
-        if (strncmp(statusJobRunning, *jobStatus,
+        if (strncmp(statusJobRunning, jobStatus->status,
                     strlen(statusJobRunning)) == 0 ||
-            strncmp(statusJobCanPen, *jobStatus,
+            strncmp(statusJobCanPen, jobStatus->status,
                     strlen(statusJobCanPen)) == 0)
         {
-          jobRunning = true;
+          jobStatus->running = true;
         }
       }
     }
   }
 
-  free(responseBody);
-  free(responseDate);
-  free(requestId);
+  releaseResponseBuffer(respBuf);
 
-  return jobRunning;
+  return statusFound;
+}
+
+/*
+ * Method: printTextSlice
+ *
+ * Write a length-delimited text field to the trace straight from the
+ * request or response data area. Nothing is copied, the text is written
+ * in traceChunkLen slices and stops after traceTextLimit bytes, so the
+ * storage used does not depend on the length of the field.
+ */
+void printTextSlice(int len, const char *text, char *description)
+{
+  int traceLen = len;
+
+  if (len <= 0 || text == NULL || text[0] == '\0')
+  {
+    return;
+  }
+
+  if (traceTextLimit > 0 && traceLen > traceTextLimit)
+  {
+    traceLen = traceTextLimit;
+  }
+
+  printf("* >%s:'", description);
+  for (int offset = 0; offset < traceLen; offset += traceChunkLen)
+  {
+    int sliceLen = traceLen - offset;
+    if (sliceLen > traceChunkLen)
+    {
+      sliceLen = traceChunkLen;
+    }
+    printf("%.*s", sliceLen, text + offset);
+  }
+  printf("'\n");
+
+  if (traceLen < len)
+  {
+    printf("* >%s truncated, %d of %d bytes traced\n",
+           description, traceLen, len);
+  }
 }
 
 /*
  * Method: printConstTextStr
  *
- * Print out the contents of the constant string if the string is:
- * not null, not empty, and within the maximum allowable size of 15 Megabytes.
+ * Print out the contents of the constant string if the string is
+ * not null and not empty.
  */
 void printConstTextStr(int len, const char *text, char *description)
 {
-  char diagTextString[defaultLen15MB];
   if (verbose2)
   {
     printf("* >%sLen: %X (hex), %d (dec)\n",
            description, len, len);
   }
 
-  if (len > 0 && len < defaultLen15MB &&
-      text && text[0] != '\0')
-  {
-    memcpy(diagTextString, text, len);
-    diagTextString[len] = '\0';
-    printf("* >%s:'%s'\n",
-           description, diagTextString);
-  }
+  printTextSlice(len, text, description);
 }
 
 /*
  * Method: printTextStr
  *
- * Print out the contents of the string if the string is:
- * not null, not empty, and within the maximum allowable size of 15 Megabytes.
+ * Print out the contents of the string if the string is
+ * not null and not empty.
  */
 void printTextStr(int len,
                   char *text,
                   char *description,
                   char **ptrAddr)
 {
-  char diagTextString[defaultLen15MB];
   if (verbose2)
   {
     printf("* >%sLen: %X (hex), %d (dec)\n",
@@ -967,18 +1528,113 @@ void printTextStr(int len,
            description, ptrAddr);
   }
 
-  /************************************************
-	 * Clone the diag text area into a buffer which
-	 * allows C semantics (null-termination)
-	 ***********************************************/
-  if (len > 0 && len < defaultLen15MB &&
-      text && text[0] != '\0')
+  printTextSlice(len, text, description);
+}
+
+/*
+ * Method: createQuietThreadKey
+ */
+static void createQuietThreadKey()
+{
+  pthread_key_create(&quietThreadKey, NULL);
+}
+
+/*
+ * Method: setQuietThread
+ *
+ * Turn the traces of successful requests of the calling thread off
+ * or back on.
+ */
+static void setQuietThread(bool quiet)
+{
+  pthread_once(&quietThreadOnce, createQuietThreadKey);
+  pthread_setspecific(quietThreadKey, quiet ? &quietThreadKey : NULL);
+}
+
+/*
+ * Method: tracingRequests
+ *
+ * returns: true when the requests of the calling thread are traced,
+ *          traceRequests is set and the thread is not a request worker
+ */
+bool tracingRequests()
+{
+  void *quiet = NULL;
+
+  if (!traceRequests)
+  {
+    return false;
+  }
+
+  pthread_once(&quietThreadOnce, createQuietThreadKey);
+#if defined(__MVS__) && !defined(_UNIX03_THREADS)
+  pthread_getspecific(quietThreadKey, &quiet);
+#else
+  quiet = pthread_getspecific(quietThreadKey);
+#endif
+
+  return quiet == NULL;
+}
+
+/*
+ * Method: requestWorker
+ *
+ * Thread start routine of runRequestWorkers.
+ */
+static void *requestWorker(void *data)
+{
+  REQUEST_WORKERS_TYPE *workers = (REQUEST_WORKERS_TYPE *)data;
+
+  setQuietThread(true);
+  return workers->worker(workers->data);
+}
+
+/*
+ * Method: runRequestWorkers
+ *
+ * Start workerCount threads running worker over data and wait for
+ * them. The per request traces of the workers would bury the output
+ * of the caller, so they trace only the requests that fail. The
+ * calling thread works instead when no thread can be created.
+ *
+ * input arguments: name of the caller for messages, number of
+ *                  threads, the worker and its data
+ * returns: number of threads started
+ */
+int runRequestWorkers(const char *caller, int workerCount,
+                      REQUEST_WORKER_TYPE worker, void *data)
+{
+  REQUEST_WORKERS_TYPE workers = {worker, data};
+  pthread_t *threads = (pthread_t *)calloc(
+      workerCount > 0 ? workerCount : 1, sizeof(pthread_t));
+  int started = 0;
+
+  for (int i = 0; threads != NULL && i < workerCount; i++)
+  {
+    if (pthread_create(&threads[i], NULL, requestWorker, &workers) != 0)
+    {
+      printf("%s: started %d of %d workers\n", caller, started,
+             workerCount);
+      break;
+    }
+    started++;
+  }
+
+  if (started == 0)
+  {
+    setQuietThread(true);
+    worker(data);
+    setQuietThread(false);
+  }
+
+  for (int i = 0; i < started; i++)
   {
-    memcpy(diagTextString, text, len);
-    diagTextString[len] = '\0';
-    printf("* >%s:'%s'\n",
-           description, diagTextString);
+    void *status;
+    pthread_join(threads[i], &status);
   }
+  free(threads);
+
+  return started;
 }
 
 /*
@@ -988,6 +1644,11 @@ void printTextStr(int len,
  */
 void traceRequest(REQUEST_PARM_TYPE *pParm, RESPONSE_PARM_TYPE *pParm2)
 {
+  if (!tracingRequests())
+  {
+    return;
+  }
+
   if (verbose2)
   {
     printf("\n\n*>>REQUEST PARM:\n");
@@ -1015,27 +1676,26 @@ void traceRequest(REQUEST_PARM_TYPE *pParm, RESPONSE_PARM_TYPE *pParm2)
   }
   else
   {
-    char *httpMethodStr = (char *)malloc(defaultLen);
-    memset(httpMethodStr, 0, defaultLen);
+    const char *httpMethodStr;
     switch (pParm->httpMethod)
     {
     case HWI_REST_GET:
-      strcpy(httpMethodStr, "GET");
+      httpMethodStr = "GET";
       break;
     case HWI_REST_POST:
-      strcpy(httpMethodStr, "POST");
+      httpMethodStr = "POST";
       break;
     case HWI_REST_DELETE:
-      strcpy(httpMethodStr, "DELETE");
+      httpMethodStr = "DELETE";
       break;
     default:
-      strcpy(httpMethodStr, "Unrecognized");
+      httpMethodStr = "Unrecognized";
       break;
     }
 
     printf("*>>\n");
     printf("*>>REQUEST:\n");
-    printf("%s %s\n", httpMethodStr, pParm->uri);
+    printf("%s %.*s\n", httpMethodStr, pParm->uriLen, pParm->uri);
     printConstTextStr(pParm->targetNameLen, pParm->targetName, "targetName");
     printConstTextStr(pParm->clientCorrelatorLen, pParm->clientCorrelator,
                       "clientCorrelator");
@@ -1044,14 +1704,28 @@ void traceRequest(REQUEST_PARM_TYPE *pParm, RESPONSE_PARM_TYPE *pParm2)
   }
 }
 
+/*
+ * Method: issueRequest
+ *
+ * Issue the HWIREST request with the selected transport (hwirtran.cpp).
+ * Every request goes through here so that failures can invalidate
+ * cached uri and target name values.
+ */
+void issueRequest(REQUEST_PARM_TYPE *request, RESPONSE_PARM_TYPE *response)
+{
+  transportRequest(request, response);
+
+  cacheCheckResponse(request, response);
+}
+
 /*
  * Method: isSuccessful
  *
  * Return TRUE if the HTTP Status is in the 2xx range,
  * otherwise return FALSE. In addition, trace the corresonding
- * response parameters.
+ * response parameters, for a failure with its decoded error record.
  */
-bool isSuccessful(RESPONSE_PARM_TYPE *pParm)
+bool isSuccessful(RESPONSE_PARM_TYPE *pParm, RESPONSE_ERROR_TYPE *error)
 {
   if (pParm->httpStatus > 199 && pParm->httpStatus < 300)
   {
@@ -1060,7 +1734,7 @@ bool isSuccessful(RESPONSE_PARM_TYPE *pParm)
   }
   else
   {
-    traceFailureResponse(pParm);
+    traceFailureResponse(pParm, error);
     return false;
   }
 }
@@ -1073,6 +1747,11 @@ bool isSuccessful(RESPONSE_PARM_TYPE *pParm)
  */
 void traceSuccessResponse(RESPONSE_PARM_TYPE *pParm)
 {
+  if (!tracingRequests())
+  {
+    return;
+  }
+
   printf("*>>\n");
   printf("*>>REQUEST was successful: %d\n", pParm->httpStatus);
 
@@ -1096,10 +1775,16 @@ void traceSuccessResponse(RESPONSE_PARM_TYPE *pParm)
  * Method: traceFailureResponse
  *
  * Print out the various response parameters associated
- * with a failed operation
+ * with a failed operation and its error record
  */
-void traceFailureResponse(RESPONSE_PARM_TYPE *pParm)
+void traceFailureResponse(RESPONSE_PARM_TYPE *pParm,
+                          RESPONSE_ERROR_TYPE *error)
 {
+  if (!traceRequests)
+  {
+    return;
+  }
+
   if (pParm->httpStatus < 200 || pParm->httpStatus > 299)
   {
     printf("*>>\n");
@@ -1119,32 +1804,31 @@ void traceFailureResponse(RESPONSE_PARM_TYPE *pParm)
                      (char **)&pParm->responseBody);
       }
 
-      if (parse_json_text((char *)pParm->responseBody))
+      /* decoded by completeResponseBuffer, the document the caller
+         has parsed is left alone
+      */
+      if (!(error->found & ERROR_FOUND_BCPII))
       {
-        HWTJ_HANDLE_TYPE arrayentry;
-        char *errorMsg;
-        int isBCPiiError;
-
-        isBCPiiError = find_boolvalue(0, "bcpii-error");
+        printf("bcpii-error not found\n");
+      }
+      else if (error->bcpiiError)
+      {
+        printf("bcpii-error is true\n");
+      }
+      else
+      {
+        printf("bcpii-error is false\n");
+      }
 
-        if (isBCPiiError == 0)
-        {
-          printf("bcpii-error is false\n");
-        }
-        else if (isBCPiiError == 1)
-        {
-          printf("bcpii-error is true\n");
-        }
-        else
-        {
-          printf("bcpii-error not found\n");
-        }
+      if (error->found & ERROR_FOUND_REASON)
+      {
+        printf("reason: %d\n", error->reason);
+      }
 
-        errorMsg = find_string(0, "message");
-        if (errorMsg != NULL)
-        {
-          printf("error: %s\n", errorMsg);
-        }
+      /* printed straight from the failure body, nothing to free */
+      if (error->found & ERROR_FOUND_MESSAGE)
+      {
+        printf("error: %.*s\n", error->messageLen, error->message);
       }
     }
 
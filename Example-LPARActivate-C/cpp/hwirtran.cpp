@@ -0,0 +1,144 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ ***********************************************************************
+ *                                                                     *
+ *    MODULE NAME= HWIRTRAN                                            *
+ *                                                                     *
+ *  Sample C code that selects how HWIREST requests are carried:       *
+ *  by the HWIREST service itself, or by the in-process SE simulator   *
+ *  so the sample can run without an SE, and off z/OS.                 *
+ *                                                                     *
+ *************************END OF SPECIFICATIONS************************/
+#pragma filetag("IBM-1047")     /* compile in EBCDIC */
+#pragma csect(code, "HWIRTRAN") /* name of csect */
+#pragma longName
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <strings.h>
+#include <hwicic.h> /* BCPii interface declaration file */
+#include "hwirsim.h"
+#include "hwirtran.h"
+
+#ifdef __MVS__
+/*
+ * Method: hwirestIssue
+ *
+ * Carry the request with the HWIREST service.
+ */
+static void hwirestIssue(REQUEST_PARM_TYPE *request,
+                         RESPONSE_PARM_TYPE *response)
+{
+  hwirest(
+      request,
+      response);
+}
+#endif
+
+/* available transports, the first one is the default */
+static TRANSPORT_TYPE transports[] = {
+#ifdef __MVS__
+    {"HWIREST", NULL, hwirestIssue, NULL},
+#endif
+    {"SIM", openSimulator, simulateRequest, closeSimulator}};
+
+static const int transportCount = sizeof(transports) / sizeof(transports[0]);
+
+static TRANSPORT_TYPE *transport = &transports[0];
+
+/*
+ * Method: openTransport
+ *
+ * Select the transport named by HWIRSTC1_TRANSPORT, or the
+ * default one, and prepare it for use.
+ */
+bool openTransport()
+{
+  char *name = getenv(TRANSPORT_ENV);
+
+  transport = &transports[0];
+
+  if (name != NULL && name[0] != '\0')
+  {
+    transport = NULL;
+    for (int i = 0; i < transportCount; i++)
+    {
+      if (strcasecmp(transports[i].name, name) == 0)
+      {
+        transport = &transports[i];
+      }
+    }
+
+    if (transport == NULL)
+    {
+      printf("openTransport ERROR: unknown transport %s\n", name);
+      transport = &transports[0];
+      return false;
+    }
+  }
+
+  if (transport->open != NULL && !transport->open())
+  {
+    printf("openTransport ERROR: unable to open transport %s\n",
+           transport->name);
+    return false;
+  }
+
+  if (strcmp(transport->name, "HWIREST") != 0)
+  {
+    printf("*>>requests are carried by transport %s\n", transport->name);
+  }
+
+  return true;
+}
+
+/*
+ * Method: closeTransport
+ *
+ * Release what the selected transport holds.
+ */
+void closeTransport()
+{
+  if (transport->close != NULL)
+  {
+    transport->close();
+  }
+}
+
+/*
+ * Method: transportRequest
+ *
+ * Carry one request with the selected transport.
+ */
+void transportRequest(REQUEST_PARM_TYPE *request,
+                      RESPONSE_PARM_TYPE *response)
+{
+  transport->issue(request, response);
+}
+
+/*
+ * Method: transportName
+ *
+ * returns: name of the selected transport
+ */
+const char *transportName()
+{
+  return transport->name;
+}
@@ -0,0 +1,938 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    MODULE NAME= HWIRTSER                                            *
+ *                                                                     *
+ *  Sample C code that keeps samples in a compact time-series file.    *
+ *  Rounds of samples are appended to blocks, times and values are     *
+ *  stored as varint deltas, and range scans skip the blocks outside   *
+ *  of the time range by their header.                                 *
+ *                                                                     *
+ *************************END OF SPECIFICATIONS************************/
+#pragma filetag("IBM-1047")     /* compile in EBCDIC */
+#pragma csect(code, "HWIRTSER") /* name of csect */
+#pragma longName
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <fnmatch.h>
+#include "hwirtser.h"
+
+/* largest magnitude of a value, in thousandths, that is stored */
+static const double seriesLimit = 9.0e15;
+
+/*
+ * Method: putBigEndian
+ *
+ * Store the low bytes of value, most significant first.
+ */
+static void putBigEndian(unsigned char *out, unsigned long long value,
+                         int bytes)
+{
+  for (int i = bytes - 1; i >= 0; i--)
+  {
+    out[i] = (unsigned char)(value & 0xFF);
+    value >>= 8;
+  }
+}
+
+/*
+ * Method: getBigEndian
+ */
+static unsigned long long getBigEndian(const unsigned char *in, int bytes)
+{
+  unsigned long long value = 0;
+
+  for (int i = 0; i < bytes; i++)
+  {
+    value = (value << 8) | in[i];
+  }
+
+  return value;
+}
+
+/*
+ * Method: putVarint
+ *
+ * Store value 7 bits a byte, low bits first, the high bit of a byte
+ * is set when more bytes follow.
+ *
+ * returns: number of bytes stored, at most 10
+ */
+static int putVarint(unsigned char *out, unsigned long long value)
+{
+  int len = 0;
+
+  while (value >= 0x80)
+  {
+    out[len++] = (unsigned char)(value | 0x80);
+    value >>= 7;
+  }
+  out[len++] = (unsigned char)value;
+
+  return len;
+}
+
+/*
+ * Method: getVarint
+ *
+ * returns: false when the varint runs past len
+ */
+static bool getVarint(const unsigned char *in, int len, int *pos,
+                      unsigned long long *value)
+{
+  unsigned long long result = 0;
+
+  for (int shift = 0; *pos < len && shift < 64; shift += 7)
+  {
+    unsigned char byte = in[(*pos)++];
+    result |= (unsigned long long)(byte & 0x7F) << shift;
+    if (!(byte & 0x80))
+    {
+      *value = result;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/*
+ * Method: zigzag
+ *
+ * Map small negative and positive deltas to small unsigned values.
+ */
+static unsigned long long zigzag(long long value)
+{
+  return ((unsigned long long)value << 1) ^ (unsigned long long)(value >> 63);
+}
+
+/*
+ * Method: unzigzag
+ */
+static long long unzigzag(unsigned long long value)
+{
+  return (long long)(value >> 1) ^ -(long long)(value & 1);
+}
+
+/* divisors of a value delta, by the low 2 bits of its code */
+static const long long deltaDivisors[] = {1, 10, 100, 1000};
+
+/*
+ * Method: encodeDelta
+ *
+ * Code a delta of thousandths as zigzag(delta / divisor) shifted left
+ * by 2 bits, the low bits telling the largest divisor that divides
+ * it, so that whole numbers cost no more than their integer deltas.
+ */
+static unsigned long long encodeDelta(long long delta)
+{
+  int k = 3;
+
+  while (k > 0 && delta % deltaDivisors[k] != 0)
+  {
+    k--;
+  }
+
+  return (zigzag(delta / deltaDivisors[k]) << 2) | k;
+}
+
+/*
+ * Method: decodeDelta
+ */
+static long long decodeDelta(unsigned long long code)
+{
+  return unzigzag(code >> 2) * deltaDivisors[code & 3];
+}
+
+/*
+ * Method: readBlockHeader
+ *
+ * Read the header of the block at the current position of file.
+ *
+ * returns: false at the end of the file or when the header does not
+ *          describe a block that fits within fileSize
+ */
+static bool readBlockHeader(FILE *file, long offset, long fileSize,
+                            int *len, int *rounds, long long *firstMs,
+                            long long *lastMs)
+{
+  unsigned char header[SERIES_BLOCK_HEADER_LEN];
+
+  if (fread(header, 1, sizeof(header), file) != sizeof(header))
+  {
+    return false;
+  }
+
+  *len = (int)getBigEndian(header, 4);
+  *rounds = (int)getBigEndian(header + 4, 4);
+  *firstMs = (long long)getBigEndian(header + 8, 8);
+  *lastMs = (long long)getBigEndian(header + 16, 8);
+
+  return *len > 0 && *rounds > 0 && *firstMs <= *lastMs &&
+         offset + SERIES_BLOCK_HEADER_LEN + *len <= fileSize;
+}
+
+/*
+ * Method: writeBlockHeader
+ *
+ * Rewrite the header of the open block and go back to the end.
+ */
+static bool writeBlockHeader(SERIES_WRITER_TYPE *writer)
+{
+  unsigned char header[SERIES_BLOCK_HEADER_LEN];
+
+  putBigEndian(header, writer->blockLen, 4);
+  putBigEndian(header + 4, writer->blockRounds, 4);
+  putBigEndian(header + 8, writer->firstMs, 8);
+  putBigEndian(header + 16, writer->lastMs, 8);
+
+  return fseek(writer->file, writer->blockOffset, SEEK_SET) == 0 &&
+         fwrite(header, 1, sizeof(header), writer->file) == sizeof(header) &&
+         fseek(writer->file, 0, SEEK_END) == 0;
+}
+
+/*
+ * Method: clearBlockSeries
+ *
+ * Forget the series of the open block, the next block defines them
+ * again so that each block can be decoded on its own.
+ */
+static void clearBlockSeries(SERIES_WRITER_TYPE *writer)
+{
+  for (int i = 0; i < writer->seriesCount; i++)
+  {
+    free(writer->names[i]);
+  }
+  writer->seriesCount = 0;
+  writer->blockOffset = -1;
+}
+
+/*
+ * Method: openSeriesWriter
+ *
+ * Open a time-series file to append to, creating it when it does not
+ * exist. A partial block left by a writer that ended before updating
+ * its header is cut off.
+ */
+bool openSeriesWriter(SERIES_WRITER_TYPE *writer, const char *path)
+{
+  char magic[SERIES_MAGIC_LEN];
+
+  memset(writer, 0, sizeof(SERIES_WRITER_TYPE));
+  writer->blockOffset = -1;
+
+  writer->file = fopen(path, "r+b");
+  if (writer->file == NULL)
+  {
+    writer->file = fopen(path, "w+b");
+    if (writer->file == NULL ||
+        fwrite(SERIES_MAGIC, 1, SERIES_MAGIC_LEN, writer->file) !=
+            SERIES_MAGIC_LEN)
+    {
+      printf("series ERROR: unable to create %s\n", path);
+      closeSeriesWriter(writer);
+      return false;
+    }
+    return true;
+  }
+
+  if (fread(magic, 1, SERIES_MAGIC_LEN, writer->file) != SERIES_MAGIC_LEN ||
+      memcmp(magic, SERIES_MAGIC, SERIES_MAGIC_LEN) != 0)
+  {
+    printf("series ERROR: %s is not a time-series file\n", path);
+    closeSeriesWriter(writer);
+    return false;
+  }
+
+  fseek(writer->file, 0, SEEK_END);
+  long fileSize = ftell(writer->file);
+  long offset = SERIES_MAGIC_LEN;
+  int len;
+  int rounds;
+  long long firstMs;
+  long long lastMs;
+
+  fseek(writer->file, offset, SEEK_SET);
+  while (readBlockHeader(writer->file, offset, fileSize, &len, &rounds,
+                         &firstMs, &lastMs))
+  {
+    offset += SERIES_BLOCK_HEADER_LEN + len;
+    fseek(writer->file, offset, SEEK_SET);
+  }
+
+  if (offset < fileSize)
+  {
+    printf("series: %ld bytes of a partial block cut off %s\n",
+           fileSize - offset, path);
+    fflush(writer->file);
+    if (ftruncate(fileno(writer->file), offset) != 0)
+    {
+      printf("series ERROR: unable to cut off %s\n", path);
+      closeSeriesWriter(writer);
+      return false;
+    }
+  }
+  fseek(writer->file, offset, SEEK_SET);
+
+  return true;
+}
+
+/*
+ * Method: reserveRound
+ *
+ * Make room for extra more bytes in the round being encoded.
+ */
+static bool reserveRound(SERIES_WRITER_TYPE *writer, int used, int extra)
+{
+  if (used + extra <= writer->roundCapacity)
+  {
+    return true;
+  }
+
+  int newCapacity = writer->roundCapacity > 0 ? writer->roundCapacity : 1024;
+  while (newCapacity < used + extra)
+  {
+    newCapacity *= 2;
+  }
+
+  unsigned char *round = (unsigned char *)realloc(writer->round, newCapacity);
+  if (round == NULL)
+  {
+    return false;
+  }
+  writer->round = round;
+  writer->roundCapacity = newCapacity;
+
+  return true;
+}
+
+/*
+ * Method: addBlockSeries
+ *
+ * returns: the number of the new series of the open block, -1 when
+ *          out of storage
+ */
+static int addBlockSeries(SERIES_WRITER_TYPE *writer, const char *name)
+{
+  if (writer->seriesCount == writer->seriesCapacity)
+  {
+    int newCapacity = writer->seriesCapacity > 0 ? writer->seriesCapacity * 2
+                                                 : 32;
+    char **names = (char **)realloc(writer->names,
+                                    newCapacity * sizeof(char *));
+    if (names == NULL)
+    {
+      return -1;
+    }
+    writer->names = names;
+
+    long long *previous = (long long *)realloc(
+        writer->previous, newCapacity * sizeof(long long));
+    if (previous == NULL)
+    {
+      return -1;
+    }
+    writer->previous = previous;
+    writer->seriesCapacity = newCapacity;
+  }
+
+  writer->names[writer->seriesCount] = strdup(name);
+  writer->previous[writer->seriesCount] = 0;
+
+  return writer->seriesCount++;
+}
+
+/*
+ * Method: storable
+ *
+ * returns: true when the sample can be stored, its value in
+ *          thousandths in scaled
+ */
+static bool storable(SERIES_SAMPLE_TYPE *sample, long long *scaled)
+{
+  double value = sample->value * SERIES_SCALE;
+
+  if (!(value > -seriesLimit && value < seriesLimit) ||
+      strlen(sample->name) >= SERIES_MAX_NAME)
+  {
+    return false;
+  }
+
+  *scaled = llround(value);
+  return true;
+}
+
+/*
+ * Method: appendSeriesRound
+ *
+ * Append the samples taken at timeMs as one round. Samples of the
+ * same series should come in the same order from round to round, a
+ * series is then found without a search. Values that cannot be
+ * stored are counted in skipped.
+ *
+ * returns: false when the round could not be written
+ */
+bool appendSeriesRound(SERIES_WRITER_TYPE *writer, long long timeMs,
+                       SERIES_SAMPLE_TYPE *samples, int count)
+{
+  long long scaled;
+  int storableCount = 0;
+
+  for (int i = 0; i < count; i++)
+  {
+    storableCount += storable(&samples[i], &scaled) ? 1 : 0;
+  }
+  writer->skipped += count - storableCount;
+  if (storableCount == 0 || timeMs < 0)
+  {
+    return true;
+  }
+
+  /* deltas are not negative within a block */
+  if (writer->blockOffset >= 0 &&
+      (writer->blockRounds >= SERIES_BLOCK_ROUNDS ||
+       timeMs < writer->lastMs))
+  {
+    clearBlockSeries(writer);
+  }
+
+  if (writer->blockOffset < 0)
+  {
+    writer->blockOffset = ftell(writer->file);
+    writer->blockLen = 0;
+    writer->blockRounds = 0;
+    writer->firstMs = timeMs;
+    writer->lastMs = timeMs;
+
+    /* a block without rounds is cut off by the next open */
+    if (!writeBlockHeader(writer))
+    {
+      return false;
+    }
+  }
+
+  if (!reserveRound(writer, 0, 20))
+  {
+    return false;
+  }
+  int used = putVarint(writer->round, timeMs - writer->lastMs);
+  used += putVarint(writer->round + used, storableCount);
+
+  int hint = 0;
+  for (int i = 0; i < count; i++)
+  {
+    if (!storable(&samples[i], &scaled))
+    {
+      continue;
+    }
+
+    int series = -1;
+    if (hint < writer->seriesCount &&
+        strcmp(writer->names[hint], samples[i].name) == 0)
+    {
+      series = hint;
+    }
+    for (int j = 0; series < 0 && j < writer->seriesCount; j++)
+    {
+      if (strcmp(writer->names[j], samples[i].name) == 0)
+      {
+        series = j;
+      }
+    }
+
+    int nameLen = strlen(samples[i].name);
+    if (!reserveRound(writer, used, 30 + nameLen))
+    {
+      return false;
+    }
+
+    if (series < 0)
+    {
+      series = addBlockSeries(writer, samples[i].name);
+      if (series < 0)
+      {
+        return false;
+      }
+      used += putVarint(writer->round + used, series);
+      used += putVarint(writer->round + used, nameLen);
+      memcpy(writer->round + used, samples[i].name, nameLen);
+      used += nameLen;
+    }
+    else
+    {
+      used += putVarint(writer->round + used, series);
+    }
+
+    used += putVarint(writer->round + used,
+                      encodeDelta(scaled - writer->previous[series]));
+    writer->previous[series] = scaled;
+    hint = series + 1;
+  }
+
+  if (fwrite(writer->round, 1, used, writer->file) != (size_t)used)
+  {
+    return false;
+  }
+
+  writer->blockLen += used;
+  writer->blockRounds++;
+  writer->lastMs = timeMs;
+  writer->values += storableCount;
+  writer->bytes += used + (writer->blockRounds == 1
+                               ? SERIES_BLOCK_HEADER_LEN
+                               : 0);
+
+  /* the header is written last, a block it does not cover yet is
+     cut off by the next open
+  */
+  return writeBlockHeader(writer) && fflush(writer->file) == 0;
+}
+
+/*
+ * Method: closeSeriesWriter
+ */
+void closeSeriesWriter(SERIES_WRITER_TYPE *writer)
+{
+  clearBlockSeries(writer);
+
+  if (writer->file != NULL)
+  {
+    fclose(writer->file);
+    writer->file = NULL;
+  }
+
+  free(writer->names);
+  free(writer->previous);
+  free(writer->round);
+  writer->names = NULL;
+  writer->previous = NULL;
+  writer->round = NULL;
+  writer->seriesCapacity = 0;
+  writer->roundCapacity = 0;
+}
+
+/* state of a scan, the series tables are those of the current block */
+typedef struct
+{
+  unsigned char *payload;
+  int payloadCapacity;
+  char *names; /* NUL terminated names of the block */
+  const char **series;
+  bool *matches;
+  long long *previous;
+  int seriesCapacity;
+} SERIES_READER_TYPE;
+
+/*
+ * Method: reserveReader
+ *
+ * Make room for a block payload of len bytes and its series, a block
+ * has fewer series than payload bytes.
+ */
+static bool reserveReader(SERIES_READER_TYPE *reader, int len)
+{
+  if (len <= reader->payloadCapacity)
+  {
+    return true;
+  }
+
+  free(reader->payload);
+  free(reader->names);
+  free(reader->series);
+  free(reader->matches);
+  free(reader->previous);
+
+  reader->payload = (unsigned char *)malloc(len);
+  reader->names = (char *)malloc(len);
+  reader->series = (const char **)malloc(len * sizeof(char *));
+  reader->matches = (bool *)malloc(len * sizeof(bool));
+  reader->previous = (long long *)malloc(len * sizeof(long long));
+
+  if (reader->payload == NULL || reader->names == NULL ||
+      reader->series == NULL || reader->matches == NULL ||
+      reader->previous == NULL)
+  {
+    reader->payloadCapacity = 0;
+    return false;
+  }
+  reader->payloadCapacity = len;
+
+  return true;
+}
+
+/*
+ * Method: decodeBlock
+ *
+ * Decode the rounds of a block and pass the matching values within
+ * the time range to onPoint.
+ *
+ * returns: false when the callback stopped the scan or the block is
+ *          malformed, damaged is then set
+ */
+static bool decodeBlock(SERIES_READER_TYPE *reader, int block, int len,
+                        int rounds, long long firstMs, const char *pattern,
+                        long long fromMs, long long toMs,
+                        SERIES_POINT_CALLBACK onPoint, void *userData,
+                        SERIES_SCAN_STATS_TYPE *stats)
+{
+  const unsigned char *in = reader->payload;
+  int pos = 0;
+  int seriesCount = 0;
+  int namesUsed = 0;
+  long long timeMs = firstMs;
+  SERIES_POINT_TYPE point;
+
+  point.block = block;
+
+  for (int r = 0; r < rounds; r++)
+  {
+    unsigned long long delta;
+    unsigned long long count;
+
+    if (!getVarint(in, len, &pos, &delta) ||
+        !getVarint(in, len, &pos, &count))
+    {
+      stats->damaged = true;
+      return false;
+    }
+    timeMs += (long long)delta;
+
+    for (unsigned long long v = 0; v < count; v++)
+    {
+      unsigned long long series;
+      unsigned long long value;
+
+      if (!getVarint(in, len, &pos, &series) ||
+          series > (unsigned long long)seriesCount)
+      {
+        stats->damaged = true;
+        return false;
+      }
+
+      if (series == (unsigned long long)seriesCount)
+      {
+        unsigned long long nameLen;
+        if (!getVarint(in, len, &pos, &nameLen) ||
+            nameLen > (unsigned long long)(len - pos))
+        {
+          stats->damaged = true;
+          return false;
+        }
+
+        char *name = reader->names + namesUsed;
+        memcpy(name, in + pos, nameLen);
+        name[nameLen] = '\0';
+        pos += nameLen;
+        namesUsed += nameLen + 1;
+
+        reader->series[seriesCount] = name;
+        reader->matches[seriesCount] =
+            pattern == NULL || fnmatch(pattern, name, 0) == 0;
+        reader->previous[seriesCount] = 0;
+        seriesCount++;
+      }
+
+      if (!getVarint(in, len, &pos, &value))
+      {
+        stats->damaged = true;
+        return false;
+      }
+      reader->previous[series] += decodeDelta(value);
+      stats->valuesDecoded++;
+
+      if (reader->matches[series] && timeMs >= fromMs && timeMs <= toMs)
+      {
+        point.name = reader->series[series];
+        point.series = (int)series;
+        point.timeMs = timeMs;
+        point.value = reader->previous[series] / SERIES_SCALE;
+        stats->valuesMatched++;
+
+        if (!onPoint(&point, userData))
+        {
+          return false;
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+/*
+ * Method: scanSeries
+ *
+ * Pass every value of the series matching pattern (* and ?
+ * wildcards, NULL for all) taken from fromMs to toMs to onPoint, in
+ * the order they were appended. Blocks outside of the time range are
+ * skipped by their header.
+ *
+ * returns: false when the file could not be read
+ */
+bool scanSeries(const char *path, const char *pattern, long long fromMs,
+                long long toMs, SERIES_POINT_CALLBACK onPoint,
+                void *userData, SERIES_SCAN_STATS_TYPE *stats)
+{
+  SERIES_READER_TYPE reader;
+  char magic[SERIES_MAGIC_LEN];
+  bool scanOk = true;
+
+  memset(stats, 0, sizeof(SERIES_SCAN_STATS_TYPE));
+  memset(&reader, 0, sizeof(SERIES_READER_TYPE));
+
+  FILE *file = fopen(path, "rb");
+  if (file == NULL)
+  {
+    printf("series ERROR: unable to open %s\n", path);
+    return false;
+  }
+
+  if (fread(magic, 1, SERIES_MAGIC_LEN, file) != SERIES_MAGIC_LEN ||
+      memcmp(magic, SERIES_MAGIC, SERIES_MAGIC_LEN) != 0)
+  {
+    printf("series ERROR: %s is not a time-series file\n", path);
+    fclose(file);
+    return false;
+  }
+
+  fseek(file, 0, SEEK_END);
+  long fileSize = ftell(file);
+  long offset = SERIES_MAGIC_LEN;
+  int len;
+  int rounds;
+  long long firstMs;
+  long long lastMs;
+
+  bool more = true;
+
+  fseek(file, offset, SEEK_SET);
+  while (more && readBlockHeader(file, offset, fileSize, &len, &rounds,
+                                 &firstMs, &lastMs))
+  {
+    int block = stats->blocks++;
+    offset += SERIES_BLOCK_HEADER_LEN + len;
+
+    if (lastMs < fromMs || firstMs > toMs)
+    {
+      stats->blocksSkipped++;
+      fseek(file, offset, SEEK_SET);
+      continue;
+    }
+
+    if (!reserveReader(&reader, len))
+    {
+      printf("series ERROR: out of storage\n");
+      scanOk = false;
+      break;
+    }
+    more = fread(reader.payload, 1, len, file) == (size_t)len &&
+           decodeBlock(&reader, block, len, rounds, firstMs, pattern, fromMs,
+                       toMs, onPoint, userData, stats);
+  }
+
+  /* the blocks ended before the file did */
+  if (more && offset < fileSize)
+  {
+    stats->damaged = true;
+  }
+
+  free(reader.payload);
+  free(reader.names);
+  free(reader.series);
+  free(reader.matches);
+  free(reader.previous);
+  fclose(file);
+
+  return scanOk;
+}
+
+/* open windows of the series of an aggregation */
+typedef struct
+{
+  SERIES_WINDOW_TYPE *windows;
+  int windowCount;
+  int windowCapacity;
+  long long windowMs;
+
+  /* window of each series of the current block, -1 until looked up */
+  int block;
+  int *slots;
+  int slotCapacity;
+
+  SERIES_WINDOW_CALLBACK onWindow;
+  void *userData;
+  bool stopped;
+} SERIES_AGGREGATE_TYPE;
+
+/*
+ * Method: findWindow
+ *
+ * returns: the open window of the named series, added when new
+ */
+static int findWindow(SERIES_AGGREGATE_TYPE *aggregate, const char *name)
+{
+  for (int i = 0; i < aggregate->windowCount; i++)
+  {
+    if (strcmp(aggregate->windows[i].name, name) == 0)
+    {
+      return i;
+    }
+  }
+
+  if (aggregate->windowCount == aggregate->windowCapacity)
+  {
+    int newCapacity = aggregate->windowCapacity > 0
+                          ? aggregate->windowCapacity * 2
+                          : 32;
+    SERIES_WINDOW_TYPE *windows = (SERIES_WINDOW_TYPE *)realloc(
+        aggregate->windows, newCapacity * sizeof(SERIES_WINDOW_TYPE));
+    if (windows == NULL)
+    {
+      return -1;
+    }
+    aggregate->windows = windows;
+    aggregate->windowCapacity = newCapacity;
+  }
+
+  SERIES_WINDOW_TYPE *window = &aggregate->windows[aggregate->windowCount];
+  memset(window, 0, sizeof(SERIES_WINDOW_TYPE));
+  window->name = strdup(name);
+
+  return aggregate->windowCount++;
+}
+
+/*
+ * Method: aggregatePoint
+ *
+ * Add a value to the window of its series, the window is passed on
+ * once a value of a later window comes.
+ */
+static bool aggregatePoint(const SERIES_POINT_TYPE *point, void *userData)
+{
+  SERIES_AGGREGATE_TYPE *aggregate = (SERIES_AGGREGATE_TYPE *)userData;
+
+  if (point->block != aggregate->block)
+  {
+    aggregate->block = point->block;
+    if (aggregate->slots != NULL)
+    {
+      memset(aggregate->slots, 0xFF, aggregate->slotCapacity * sizeof(int));
+    }
+  }
+
+  if (point->series >= aggregate->slotCapacity)
+  {
+    int newCapacity = point->series * 2 + 32;
+    int *slots = (int *)realloc(aggregate->slots, newCapacity * sizeof(int));
+    if (slots == NULL)
+    {
+      return false;
+    }
+    memset(slots + aggregate->slotCapacity, 0xFF,
+           (newCapacity - aggregate->slotCapacity) * sizeof(int));
+    aggregate->slots = slots;
+    aggregate->slotCapacity = newCapacity;
+  }
+
+  int slot = aggregate->slots[point->series];
+  if (slot < 0)
+  {
+    slot = findWindow(aggregate, point->name);
+    if (slot < 0)
+    {
+      return false;
+    }
+    aggregate->slots[point->series] = slot;
+  }
+
+  SERIES_WINDOW_TYPE *window = &aggregate->windows[slot];
+  long long windowMs = point->timeMs - point->timeMs % aggregate->windowMs;
+
+  if (window->count > 0 && window->windowMs != windowMs)
+  {
+    if (!aggregate->onWindow(window, aggregate->userData))
+    {
+      aggregate->stopped = true;
+      return false;
+    }
+    window->count = 0;
+  }
+
+  if (window->count == 0)
+  {
+    window->windowMs = windowMs;
+    window->min = window->max = window->sum = point->value;
+    window->count = 1;
+  }
+  else
+  {
+    window->min = point->value < window->min ? point->value : window->min;
+    window->max = point->value > window->max ? point->value : window->max;
+    window->sum += point->value;
+    window->count++;
+  }
+
+  return true;
+}
+
+/*
+ * Method: aggregateSeries
+ *
+ * Pass the minimum, maximum and sum of the values of each series
+ * matching pattern in each window of windowMs from fromMs to toMs to
+ * onWindow. Windows start at multiples of windowMs since the epoch
+ * and are passed on as they end, the last window of each series when
+ * the scan is done.
+ *
+ * returns: false when the file could not be read
+ */
+bool aggregateSeries(const char *path, const char *pattern,
+                     long long fromMs, long long toMs, long long windowMs,
+                     SERIES_WINDOW_CALLBACK onWindow, void *userData,
+                     SERIES_SCAN_STATS_TYPE *stats)
+{
+  SERIES_AGGREGATE_TYPE aggregate;
+
+  memset(&aggregate, 0, sizeof(SERIES_AGGREGATE_TYPE));
+  aggregate.windowMs = windowMs > 0 ? windowMs : 1;
+  aggregate.block = -1;
+  aggregate.onWindow = onWindow;
+  aggregate.userData = userData;
+
+  bool scanOk = scanSeries(path, pattern, fromMs, toMs, aggregatePoint,
+                           &aggregate, stats);
+
+  for (int i = 0; i < aggregate.windowCount; i++)
+  {
+    if (scanOk && !aggregate.stopped && aggregate.windows[i].count > 0 &&
+        !onWindow(&aggregate.windows[i], userData))
+    {
+      aggregate.stopped = true;
+    }
+    free((char *)aggregate.windows[i].name);
+  }
+  free(aggregate.windows);
+  free(aggregate.slots);
+
+  return scanOk;
+}
@@ -0,0 +1,91 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    HEADER NAME= HWIJBIND                                            *
+ *                                                                     *
+ *  Header that contains the JSON to record binding declarations used  *
+ *  by hwijbind.cpp and its callers                                    *
+ *                                                                     *
+ **********************************************************************/
+#ifndef HWIJBIND_H
+#define HWIJBIND_H
+
+#include <stddef.h>
+#include <hwtjic.h> /* JSON interface declaration file  */
+#include "hwirarna.h"
+#include "hwijpath.h"
+#include "hwijstrm.h"
+
+/**********************************
+ * Constants
+ *********************************/
+
+/* how the value of a member is stored in its record field */
+#define BIND_STRING 1  /* char *, copied to the arena or malloc'd */
+#define BIND_CHARS 2   /* char[size], NUL terminated, cut to fit */
+#define BIND_INT 3     /* int from a number */
+#define BIND_BOOL 4    /* bool from true or false */
+#define BIND_PRESENT 5 /* bool, set when the member is there */
+#define BIND_INT64 6   /* long long from an integer */
+#define BIND_UINT64 7  /* unsigned long long from an integer */
+#define BIND_DOUBLE 8  /* double from a number */
+
+/* a binding of the record field member of type record to the JSON
+   member name, e.g. BIND_FIELD(JOB_STATUS_TYPE, jobStatusCode,
+   "job-status-code", BIND_INT)
+*/
+#define BIND_FIELD(record, member, name, type) \
+  {name, type, offsetof(record, member), sizeof(((record *)0)->member)}
+
+/**********************************
+ * Types
+ *********************************/
+typedef struct
+{
+  const char *name;
+  int type;
+  size_t offset;
+  int size;
+} JSON_BINDING_TYPE;
+
+/* Bindings of the fields of a record, compiled once into a path that
+   selects all of them in one pass over the members of an object.
+   Field i sets bit 1 << i of the mask the bind functions return.
+*/
+typedef struct
+{
+  const JSON_BINDING_TYPE *fields;
+  int fieldCount;
+  JSON_PATH_TYPE *path;
+} JSON_SCHEMA_TYPE;
+
+/**********************************
+ * Functions
+ *********************************/
+JSON_SCHEMA_TYPE *compileSchema(const JSON_BINDING_TYPE *fields,
+                                int fieldCount);
+void freeSchema(JSON_SCHEMA_TYPE *schema);
+int bindObject(JSON_SCHEMA_TYPE *schema, HWTJ_HANDLE_TYPE object,
+               ARENA_TYPE *arena, void *record);
+bool streamSchema(STREAM_EXTRACT_TYPE *stream, JSON_SCHEMA_TYPE *schema);
+int bindStreamedEntry(JSON_SCHEMA_TYPE *schema, STREAM_VALUE_TYPE *values,
+                      ARENA_TYPE *arena, void *record);
+
+#endif
@@ -0,0 +1,102 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ ***********************************************************************
+ *                                                                     *
+ *    HEADER NAME= HWIJBKND                                            *
+ *                                                                     *
+ *  Header that contains the JSON backend interface behind the         *
+ *  hwijprs.cpp helpers, implemented by hwijhwtj.cpp (z/OS JSON        *
+ *  parser), hwijnatv.cpp (native parser) and hwijsidx.cpp             *
+ *  (structural index)                                                 *
+ *                                                                     *
+ **********************************************************************/
+#ifndef HWIJBKND_H
+#define HWIJBKND_H
+
+#include <hwtjic.h> /* JSON interface declaration file  */
+
+/**********************************
+ * Constants
+ *********************************/
+
+/* environment variable selecting the JSON backend by name, e.g.
+   ENVAR("HWIRSTC1_JSON=NATIVE"). The default is HWTJ on z/OS and
+   NATIVE elsewhere.
+*/
+#define JSON_BACKEND_ENV "HWIRSTC1_JSON"
+
+/**********************************
+ * Types
+ *********************************/
+
+/* Operations a JSON backend provides. Each parser context has its
+   own backend state: init allocates it, even when it fails so that
+   displayError can tell why, and term frees it. Handles are backend
+   specific, handle 0 is the outermost value of the parsed text.
+   Values and entries are only valid until the next parse with the
+   same state.
+
+   search        - find name among the members of object
+   getType       - JSON type (HWTJ_..._TYPE) of a value
+   getValue      - text of a string (without quotes, unescaped) or
+                   number value, not NUL terminated
+   getBoolean    - 1 for true, 0 for false, -1 on error
+   getEntryCount - entries of an array or members of an object
+   getObjectEntry - name (unescaped, not NUL terminated, valid
+                    until the next call) and value of the member at
+                    index, members asked for in order are found in
+                    order
+*/
+typedef struct
+{
+  const char *name;
+  bool (*init)(void **state);
+  bool (*parse)(void *state, const char *text, int textLen);
+  bool (*search)(void *state, HWTJ_HANDLE_TYPE object, const char *name,
+                 HWTJ_HANDLE_TYPE *value);
+  bool (*getType)(void *state, HWTJ_HANDLE_TYPE value,
+                  HWTJ_JTYPE_TYPE *type);
+  bool (*getValue)(void *state, HWTJ_HANDLE_TYPE value, const char **text,
+                   int *textLen);
+  int (*getBoolean)(void *state, HWTJ_HANDLE_TYPE value);
+  bool (*getArrayEntry)(void *state, HWTJ_HANDLE_TYPE array, int index,
+                        HWTJ_HANDLE_TYPE *entry);
+  int (*getEntryCount)(void *state, HWTJ_HANDLE_TYPE handle);
+  bool (*getObjectEntry)(void *state, HWTJ_HANDLE_TYPE object, int index,
+                         const char **name, int *nameLen,
+                         HWTJ_HANDLE_TYPE *value);
+  void (*displayError)(void *state, const char *msg);
+  bool (*term)(void *state);
+} JSON_BACKEND_TYPE;
+
+#ifdef __MVS__
+extern JSON_BACKEND_TYPE hwtjBackend;
+#endif
+extern JSON_BACKEND_TYPE nativeBackend;
+extern JSON_BACKEND_TYPE indexBackend;
+
+/**********************************
+ * Functions
+ *********************************/
+
+/* shared by the backends that keep the text, see hwijnatv.cpp */
+int unescapeJSON(const char *in, int inLen, char *out);
+
+#endif
@@ -0,0 +1,108 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    HEADER NAME= HWIJKIDX                                            *
+ *                                                                     *
+ *  Header that contains the object key index declarations used by     *
+ *  hwijkidx.cpp and the parser contexts                               *
+ *                                                                     *
+ **********************************************************************/
+#ifndef HWIJKIDX_H
+#define HWIJKIDX_H
+
+#include <hwtjic.h> /* JSON interface declaration file  */
+#include "hwijbknd.h"
+
+/**********************************
+ * Constants
+ *********************************/
+
+/* objects with fewer members are searched linearly */
+#define KEY_INDEX_MIN_MEMBERS 16
+
+/* objects searched lately that are remembered, so that searches of
+   other objects in between, e.g. of the entries of an array member,
+   do not discard the index of the object
+*/
+#define KEY_INDEX_OBJECTS 4
+
+/* what is known about an object searched lately */
+#define KEY_INDEX_NONE 0   /* nothing searched since the parse */
+#define KEY_INDEX_SEEN 1   /* searched once, linearly */
+#define KEY_INDEX_LINEAR 2 /* too small or not an object */
+#define KEY_INDEX_BUILT 3  /* its members are in the slots */
+
+/**********************************
+ * Types
+ *********************************/
+
+/* A member of the indexed object, nameOffset is -1 in a free slot */
+typedef struct
+{
+  unsigned int hash;
+  int nameOffset; /* into names */
+  int nameLen;
+  HWTJ_HANDLE_TYPE value;
+} KEY_SLOT_TYPE;
+
+/* Hash index over the member names of one object. It is built from
+   one pass over the members the second time the object is searched,
+   so reading many names of one object no longer costs a linear search
+   each. The slots and names are kept from one object and parse to
+   the next.
+*/
+typedef struct
+{
+  int status;
+  HWTJ_HANDLE_TYPE object;
+  unsigned long lastUsed; /* searches counter when last searched */
+
+  KEY_SLOT_TYPE *slots;
+  int slotCount; /* a power of two */
+  int slotCapacity;
+
+  char *names; /* copies of the member names */
+  int namesLen;
+  int namesCapacity;
+} KEY_OBJECT_INDEX_TYPE;
+
+/* The objects a parser context searched lately, the least recently
+   searched one is given up for a new object. A zeroed index is
+   empty.
+*/
+typedef struct
+{
+  bool disabled; /* search linearly, for comparisons */
+  KEY_OBJECT_INDEX_TYPE objects[KEY_INDEX_OBJECTS];
+
+  unsigned long searches; /* searches over its lifetime */
+  unsigned long builds;   /* indexes built over its lifetime */
+} JSON_KEY_INDEX_TYPE;
+
+/**********************************
+ * Functions
+ *********************************/
+bool keyIndexSearch(JSON_KEY_INDEX_TYPE *index, JSON_BACKEND_TYPE *backend,
+                    void *state, HWTJ_HANDLE_TYPE object, const char *name,
+                    HWTJ_HANDLE_TYPE *value);
+void resetKeyIndex(JSON_KEY_INDEX_TYPE *index);
+void freeKeyIndex(JSON_KEY_INDEX_TYPE *index);
+
+#endif
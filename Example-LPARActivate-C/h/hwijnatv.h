@@ -0,0 +1,92 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ ***********************************************************************
+ *                                                                     *
+ *    HEADER NAME= HWIJNATV                                            *
+ *                                                                     *
+ *  Header that contains the native JSON backend declarations used     *
+ *  by hwijnatv.cpp                                                    *
+ *                                                                     *
+ **********************************************************************/
+#ifndef HWIJNATV_H
+#define HWIJNATV_H
+
+#include <hwtjic.h> /* JSON interface declaration file  */
+
+/**********************************
+ * Constants
+ *********************************/
+
+/* deepest nesting of objects and arrays accepted */
+#define NATIVE_MAX_DEPTH 256
+
+/* node flags */
+#define NATIVE_ESCAPED 0x01 /* string holds backslash escapes */
+
+/**********************************
+ * Types
+ *********************************/
+
+/* The parsed text is a flat array of nodes in document order, a
+   handle is a node index and node 0 is the outermost value. An
+   object is followed by its members, each a key node followed by
+   the value, an array by its entries. next skips a value together
+   with everything nested in it.
+*/
+typedef struct
+{
+  HWTJ_JTYPE_TYPE type;
+  int start; /* offset of the text, strings without the quotes */
+  int len;
+  int next;  /* node following the value and its content */
+  int count; /* members of an object, entries of an array */
+  int flags;
+} NATIVE_NODE_TYPE;
+
+/* State of one parser, the backend state of a parser context */
+typedef struct
+{
+  /* text of the last parse, HWTJPARS alike it is not copied */
+  const char *text;
+  int len;
+
+  NATIVE_NODE_TYPE *nodes;
+  int nodeCount;
+  int nodeCapacity;
+
+  /* entry nodes of the array last passed to nativeGetArrayEntry */
+  int entryArray;
+  int *entryNodes;
+  int entryCapacity;
+
+  /* member last returned by nativeGetObjectEntry, its key node */
+  int memberObject;
+  int memberIndex;
+  int memberKey;
+
+  /* unescaped copy of the string last returned by nativeGetValue */
+  char *scratch;
+  int scratchCapacity;
+
+  const char *error;
+  int errorPos;
+} NATIVE_PARSER_TYPE;
+
+#endif
@@ -0,0 +1,49 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    HEADER NAME= HWIJNUM                                             *
+ *                                                                     *
+ *  Header that contains the JSON number conversion declarations       *
+ *  used by hwijnum.cpp and its callers                                *
+ *                                                                     *
+ **********************************************************************/
+#ifndef HWIJNUM_H
+#define HWIJNUM_H
+
+/**********************************
+ * Constants
+ *********************************/
+
+/* significant digits kept in the 64 bit mantissa of a number */
+#define NUM_MAX_DIGITS 19
+
+/* largest power of ten that is exact in a double. A mantissa of at
+   most 2 ** 53 scaled by such a power is converted without strtod.
+*/
+#define NUM_FAST_EXPONENT 22
+
+/**********************************
+ * Functions
+ *********************************/
+bool parseInt64(const char *text, int len, long long *value);
+bool parseUint64(const char *text, int len, unsigned long long *value);
+bool parseDouble(const char *text, int len, double *value);
+
+#endif
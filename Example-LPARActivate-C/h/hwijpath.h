@@ -0,0 +1,106 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    HEADER NAME= HWIJPATH                                            *
+ *                                                                     *
+ *  Header that contains the JSON path selector declarations used      *
+ *  by hwijpath.cpp and its callers                                    *
+ *                                                                     *
+ **********************************************************************/
+#ifndef HWIJPATH_H
+#define HWIJPATH_H
+
+#include <hwtjic.h> /* JSON interface declaration file  */
+#include "hwijprs.h"
+
+/**********************************
+ * Constants
+ *********************************/
+
+/* most members a path enters before its fields */
+#define PATH_MAX_SEGMENTS 8
+
+/* most fields a path selects from each object, enough for the 23
+   LPAR properties RXAUDIT1 PrepLPARAttributes audits
+*/
+#define PATH_MAX_FIELDS 30
+
+/**********************************
+ * Types
+ *********************************/
+
+/* A member a path enters. When eachEntry is set the member is an
+   array and the rest of the path is applied to each of its entries.
+*/
+typedef struct
+{
+  char *name;
+  bool eachEntry;
+} PATH_SEGMENT_TYPE;
+
+/* A compiled path, e.g. logical-partitions[*].{name,object-uri} or
+   {status,job-status-code}. The fields are selected from every
+   object the segments lead to.
+*/
+typedef struct
+{
+  PATH_SEGMENT_TYPE segments[PATH_MAX_SEGMENTS];
+  int segmentCount;
+  char *fields[PATH_MAX_FIELDS];
+  int fieldLens[PATH_MAX_FIELDS];
+  int fieldCount;
+} JSON_PATH_TYPE;
+
+/* A selected value, the handle is only valid until the next parse */
+typedef struct
+{
+  bool found;
+  HWTJ_JTYPE_TYPE type;
+  HWTJ_HANDLE_TYPE value;
+} PATH_VALUE_TYPE;
+
+/* One row per object the path led to, in document order, each row
+   holding fieldCount values. When arena is set the rows and the
+   values copied by selectedView are allocated from it.
+*/
+typedef struct
+{
+  int fieldCount;
+  int rowCount;
+  int rowCapacity;
+  PATH_VALUE_TYPE *values;
+  ARENA_TYPE *arena;
+} PATH_RESULT_TYPE;
+
+/**********************************
+ * Functions
+ *********************************/
+JSON_PATH_TYPE *compilePath(const char *pathText);
+void freePath(JSON_PATH_TYPE *path);
+bool selectPath(JSON_PATH_TYPE *path, HWTJ_HANDLE_TYPE start,
+                PATH_RESULT_TYPE *result);
+PATH_VALUE_TYPE *selectedValue(PATH_RESULT_TYPE *result, int row,
+                               int field);
+char *selectedString(PATH_RESULT_TYPE *result, int row, int field);
+bool selectedView(PATH_RESULT_TYPE *result, int row, int field,
+                  HWTJ_JTYPE_TYPE expected_value_type, JSON_VIEW_TYPE *view);
+void freePathResult(PATH_RESULT_TYPE *result);
+
+#endif
@@ -23,15 +23,96 @@
  *  Header that contains function declarations used by hwijprs.cpp     *
  *                                                                     *
  **********************************************************************/
+#ifndef HWIJPRS_H
+#define HWIJPRS_H
+
 #include <hwtjic.h> /* JSON interface declaration file  */
+#include "hwijbknd.h"
+#include "hwijkidx.h"
+#include "hwirarna.h"
+
+/**********************************
+ * Constants
+ *********************************/
+
+/* released parser contexts a thread keeps initialized for reuse */
+#define JSON_PARSER_POOL_MAX 4
+
+/**********************************
+ * Types
+ *********************************/
+
+/* A parser context: the JSON backend and the parser state it owns,
+   for HWTJ the parser instance, diagnostic area and return code. A
+   context is used by one thread at a time.
+*/
+typedef struct JSON_PARSER
+{
+  JSON_BACKEND_TYPE *backend;
+  void *state;
+  const char *text; /* text of the last parse */
+  int textLen;
+  JSON_KEY_INDEX_TYPE keyIndex; /* of the objects searched lately */
+  struct JSON_PARSER *next; /* in the pool of its thread */
+} JSON_PARSER_TYPE;
 
+/* Parser contexts of a thread. The helpers below work on current,
+   which is acquired on first use in the thread.
+*/
+typedef struct
+{
+  JSON_PARSER_TYPE *current;
+  JSON_PARSER_TYPE *pool;
+  int pooled;
+} JSON_THREAD_PARSERS_TYPE;
+
+/* A string or number value without a copy, it points into the parsed
+   text and is not NUL terminated. A value the backend had to unescape
+   is copied to the arena passed for the view instead.
+*/
+typedef struct
+{
+  const char *text;
+  int len;
+} JSON_VIEW_TYPE;
+
+/**********************************
+ * Functions
+ *********************************/
 extern bool init_parser();
+extern JSON_PARSER_TYPE *acquire_parser();
+extern void release_parser(JSON_PARSER_TYPE *parser);
+extern JSON_PARSER_TYPE *use_parser(JSON_PARSER_TYPE *parser);
+extern JSON_PARSER_TYPE *current_parser();
 extern bool parse_json_text(const char *jtext);
+extern const char *json_backend_name();
 extern bool do_cleanup();
 extern char *find_string(HWTJ_HANDLE_TYPE object, char *search_string);
 extern char *find_number(HWTJ_HANDLE_TYPE object, char *search_string);
 extern void *find_value(HWTJ_HANDLE_TYPE object_to_search, char *name,
                  HWTJ_JTYPE_TYPE expected_value_type);
+extern void *find_optional_value(HWTJ_HANDLE_TYPE object_to_search, char *name,
+                 HWTJ_JTYPE_TYPE expected_value_type);
+extern char *find_optional_string(HWTJ_HANDLE_TYPE object, char *search_string);
+extern char *find_optional_number(HWTJ_HANDLE_TYPE object, char *search_string);
+extern bool find_view(HWTJ_HANDLE_TYPE object, char *name,
+                      HWTJ_JTYPE_TYPE expected_value_type, ARENA_TYPE *arena,
+                      JSON_VIEW_TYPE *view);
+extern bool get_view(HWTJ_HANDLE_TYPE value_handle, ARENA_TYPE *arena,
+                     JSON_VIEW_TYPE *view);
+extern bool view_equals(JSON_VIEW_TYPE *view, const char *text);
+extern int view_to_int(JSON_VIEW_TYPE *view);
+extern bool view_to_int64(JSON_VIEW_TYPE *view, long long *value);
+extern bool view_to_uint64(JSON_VIEW_TYPE *view, unsigned long long *value);
+extern bool view_to_double(JSON_VIEW_TYPE *view, double *value);
+extern bool find_int64(HWTJ_HANDLE_TYPE object, char *name, long long *value);
+extern bool find_uint64(HWTJ_HANDLE_TYPE object, char *name,
+                        unsigned long long *value);
+extern bool find_double(HWTJ_HANDLE_TYPE object, char *name, double *value);
+extern int get_int64_array(HWTJ_HANDLE_TYPE array, long long **values);
+extern int get_double_array(HWTJ_HANDLE_TYPE array, double **values);
+extern void *search_value(HWTJ_HANDLE_TYPE object_to_search, char *name,
+                 HWTJ_JTYPE_TYPE expected_value_type, bool quiet);
 extern void *do_get_value(HWTJ_HANDLE_TYPE *value_handle,
                    HWTJ_JTYPE_TYPE entry_type);
 extern HWTJ_HANDLE_TYPE find_array(HWTJ_HANDLE_TYPE object,
@@ -43,3 +124,5 @@ extern void display_error(char *msg);
 
 int do_get_boolvalue(HWTJ_HANDLE_TYPE value_handle);
 int find_boolvalue(HWTJ_HANDLE_TYPE object_to_search, char *name);
+
+#endif
@@ -0,0 +1,109 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    HEADER NAME= HWIJSIDX                                            *
+ *                                                                     *
+ *  Header that contains the structural index JSON backend             *
+ *  declarations used by hwijsidx.cpp                                  *
+ *                                                                     *
+ **********************************************************************/
+#ifndef HWIJSIDX_H
+#define HWIJSIDX_H
+
+/**********************************
+ * Constants
+ *********************************/
+
+/* bytes classified at a time, one bit per byte of a 64 bit mask */
+#define SIDX_BLOCK 64
+
+/* deepest nesting of objects and arrays accepted */
+#define SIDX_MAX_DEPTH 1024
+
+/* what the grammar check expects next */
+#define SIDX_EXPECT_VALUE 0
+#define SIDX_EXPECT_VALUE_OR_CLOSE 1 /* first entry of an array */
+#define SIDX_EXPECT_KEY 2
+#define SIDX_EXPECT_KEY_OR_CLOSE 3 /* first member of an object */
+#define SIDX_EXPECT_COLON 4
+#define SIDX_EXPECT_COMMA_OR_CLOSE 5
+#define SIDX_EXPECT_END 6
+
+/**********************************
+ * Types
+ *********************************/
+
+/* Characters of one block that matter to the structure of the
+   text, bit i stands for byte i of the block.
+*/
+typedef struct
+{
+  unsigned long long quote;
+  unsigned long long backslash;
+  unsigned long long structural; /* { } [ ] : , */
+  unsigned long long whitespace;
+} SIDX_MASKS_TYPE;
+
+typedef void (*SIDX_CLASSIFY_TYPE)(const char *block, SIDX_MASKS_TYPE *masks);
+
+/* State of one parser, the backend state of a parser context */
+typedef struct
+{
+  /* text of the last parse, it is not copied */
+  const char *text;
+  int len;
+
+  /* offset of each token, and for a bracket the token of its pair */
+  int *tokenPos;
+  int *tokenMatch;
+  int tokenCount;
+  int tokenCapacity;
+
+  /* open brackets while the grammar is checked */
+  int stack[SIDX_MAX_DEPTH];
+
+  /* entry tokens of the array last passed to sidxGetArrayEntry */
+  int entryArray;
+  int *entryTokens;
+  int entryCount;
+  int entryCapacity;
+
+  /* member last returned by sidxGetObjectEntry, its key token */
+  int memberObject;
+  int memberIndex;
+  int memberToken;
+
+  /* unescaped copy of the string last returned by sidxGetValue */
+  char *scratch;
+  int scratchCapacity;
+
+  /* set when the last text holds a backslash anywhere */
+  bool escapes;
+
+  const char *error;
+  int errorPos;
+} SIDX_PARSER_TYPE;
+
+/**********************************
+ * Functions
+ *********************************/
+const char *structuralClassifier();
+
+#endif
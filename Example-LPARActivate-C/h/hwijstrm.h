@@ -0,0 +1,106 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    HEADER NAME= HWIJSTRM                                            *
+ *                                                                     *
+ *  Header that contains the streaming array entry extraction          *
+ *  declarations used by hwijstrm.cpp and its callers                  *
+ *                                                                     *
+ **********************************************************************/
+#ifndef HWIJSTRM_H
+#define HWIJSTRM_H
+
+#include <hwtjic.h> /* JSON interface declaration file  */
+
+/**********************************
+ * Constants
+ *********************************/
+
+/* most fields that can be registered for one array */
+#define STREAM_MAX_FIELDS 16
+
+/* deepest nesting of objects and arrays accepted */
+#define STREAM_MAX_DEPTH 256
+
+/**********************************
+ * Types
+ *********************************/
+
+/* A field of the current entry. text points into the scanned text,
+   or into a buffer of the extraction when the string had escapes,
+   and is only valid during the callback. Strings are without their
+   quotes, objects and arrays are their raw JSON text.
+*/
+typedef struct
+{
+  bool found;
+  HWTJ_JTYPE_TYPE type;
+  const char *text;
+  int len;
+} STREAM_VALUE_TYPE;
+
+/* Called for each entry of the array with the registered fields in
+   registration order, as soon as the entry has been scanned. Entries
+   may have been delivered before the text turns out malformed. Return
+   false to stop the scan.
+*/
+typedef bool (*STREAM_ENTRY_CALLBACK)(int index, STREAM_VALUE_TYPE *values,
+                                      void *userData);
+
+typedef struct
+{
+  /* what to extract */
+  const char *arrayName;
+  const char *fields[STREAM_MAX_FIELDS];
+  int fieldCount;
+  STREAM_ENTRY_CALLBACK onEntry;
+  void *userData;
+
+  /* outcome of the scan */
+  bool arrayFound;
+  bool stopped; /* the callback ended the scan */
+  int entries;
+  const char *error;
+  int errorPos;
+
+  /* scan state */
+  const char *text;
+  int len;
+  int pos;
+  STREAM_VALUE_TYPE values[STREAM_MAX_FIELDS];
+  char *decoded[STREAM_MAX_FIELDS]; /* reused for escaped strings */
+  int decodedCapacity[STREAM_MAX_FIELDS];
+  char *key;
+  int keyCapacity;
+} STREAM_EXTRACT_TYPE;
+
+/**********************************
+ * Functions
+ *********************************/
+void initStreamExtract(STREAM_EXTRACT_TYPE *stream, const char *arrayName,
+                       STREAM_ENTRY_CALLBACK onEntry, void *userData);
+bool streamField(STREAM_EXTRACT_TYPE *stream, const char *name);
+bool streamArrayEntries(STREAM_EXTRACT_TYPE *stream, const char *text,
+                        int textLen);
+char *streamValueString(STREAM_VALUE_TYPE *value);
+void displayStreamError(STREAM_EXTRACT_TYPE *stream, const char *msg);
+void freeStreamExtract(STREAM_EXTRACT_TYPE *stream);
+
+#endif
@@ -0,0 +1,67 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    HEADER NAME= HWIRARNA                                            *
+ *                                                                     *
+ *  Header that contains the storage arena declarations used by        *
+ *  hwirarna.cpp and its callers                                       *
+ *                                                                     *
+ **********************************************************************/
+#ifndef HWIRARNA_H
+#define HWIRARNA_H
+
+/**********************************
+ * Constants
+ *********************************/
+
+/* size of the chunk an arena keeps from one use to the next, larger
+   allocations get a chunk of their own that is freed on reset
+*/
+#define ARENA_CHUNK_LEN 8192
+
+/**********************************
+ * Types
+ *********************************/
+typedef struct ARENA_CHUNK_TYPE
+{
+  struct ARENA_CHUNK_TYPE *next; /* older chunk */
+  int capacity;                  /* bytes following the header */
+} ARENA_CHUNK_TYPE;
+
+/* Storage handed out by bumping a pointer through chunks and given
+   back all at once by resetArena. A zeroed arena is empty.
+*/
+typedef struct
+{
+  ARENA_CHUNK_TYPE *chunks; /* newest first */
+  char *next;               /* free storage of the newest chunk */
+  int left;
+  unsigned long chunkAllocs; /* chunks allocated over its lifetime */
+} ARENA_TYPE;
+
+/**********************************
+ * Functions
+ *********************************/
+void *arenaAlloc(ARENA_TYPE *arena, int len);
+char *arenaString(ARENA_TYPE *arena, const char *text, int len);
+void resetArena(ARENA_TYPE *arena);
+void freeArena(ARENA_TYPE *arena);
+
+#endif
@@ -0,0 +1,128 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    HEADER NAME= HWIRAUDT                                            *
+ *                                                                     *
+ *  Header that contains the LPAR audit declarations used by           *
+ *  hwiraudt.cpp                                                       *
+ *                                                                     *
+ **********************************************************************/
+#ifndef HWIRAUDT_H
+#define HWIRAUDT_H
+
+#include "hwirstc1.h"
+
+/**********************************
+ * Constants
+ *********************************/
+
+/* default number of LPARs queried at a time, -MAX overrides it */
+#define AUDIT_MAX_WORKERS 8
+
+/* storage-element-type values of the central storage allocations */
+#define AUDIT_STORAGE_CENTRAL "central"
+#define AUDIT_STORAGE_RESERVED "reserved"
+
+/* a storage size that was not returned */
+#define AUDIT_STORAGE_NONE -1
+
+/**********************************
+ * Types
+ *********************************/
+
+/* The LPAR properties RXAUDIT1 PrepLPARAttributes names, in its
+   order. The two storage allocation arrays are only bound as present,
+   their entries are read into the storage sizes afterwards.
+*/
+typedef struct
+{
+  char processorUsage[16]; /* shared or dedicated */
+  int generalPurposeProcessors;
+  int reservedGeneralPurposeProcessors;
+  int generalPurposeCores;
+  int reservedGeneralPurposeCores;
+  int ziipProcessors;
+  int reservedZiipProcessors;
+  int ziipCores;
+  int reservedZiipCores;
+  int icfProcessors;
+  int reservedIcfProcessors;
+  int icfCores;
+  int reservedIcfCores;
+  int iflProcessors;
+  int reservedIflProcessors;
+  int iflCores;
+  int reservedIflCores;
+  int initialProcessingWeight;
+  bool initialProcessingWeightCapped;
+  long long initialVfmStorage;
+  long long maximumVfmStorage;
+  bool centralAllocation;
+  bool expandedAllocation;
+
+  /* from the allocation arrays, AUDIT_STORAGE_NONE when missing */
+  long long centralInitial;
+  long long centralCurrent;
+  long long reservedInitial;
+  long long reservedCurrent;
+  long long expandedCurrent;
+} AUDIT_LPAR_TYPE;
+
+/* an entry of storage-central-allocation or -expanded-allocation */
+typedef struct
+{
+  char elementType[16];
+  long long initial;
+  long long current;
+} AUDIT_STORAGE_TYPE;
+
+/* an LPAR to audit, lpar is an entry of the LPAR index of its CPC */
+typedef struct
+{
+  int cpcIndex;
+  LPAR_INFO_TYPE *lpar;
+} AUDIT_ITEM_TYPE;
+
+/* Items are handed to the workers in order through next, rows are
+   written as the LPARs complete. Shared fields are guarded by the
+   audit lock of hwiraudt.cpp.
+*/
+typedef struct
+{
+  char **cpcNames;
+  int cpcCount;
+
+  AUDIT_ITEM_TYPE *items;
+  int itemCount;
+  int itemCapacity;
+
+  int maxWorkers;
+  int next;
+  int queried; /* operating LPARs */
+  int failed;
+  double sumSeconds; /* of the single queries */
+} AUDIT_TYPE;
+
+/**********************************
+ * Functions
+ *********************************/
+bool runAudit(int argc, char **argv);
+
+#endif
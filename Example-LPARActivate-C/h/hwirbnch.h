@@ -0,0 +1,89 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ ***********************************************************************
+ *                                                                     *
+ *    HEADER NAME= HWIRBNCH                                            *
+ *                                                                     *
+ *  Header that contains the benchmark declarations used by            *
+ *  hwirbnch.cpp                                                       *
+ *                                                                     *
+ **********************************************************************/
+#ifndef HWIRBNCH_H
+#define HWIRBNCH_H
+
+/**********************************
+ * Constants
+ *********************************/
+
+/* minimum time each case is run for, -TIME overrides it */
+#define BENCH_MIN_SECONDS 1
+#define BENCH_MIN_ITERATIONS 3
+
+/* each logical-partitions entry of a canned list body is padded
+   to this many bytes
+*/
+#define BENCH_ENTRY_LEN 512
+
+/* members of the canned LPAR properties body, the properties
+   RXAUDIT1 audits are every BENCH_PROPS_SPREAD member of them
+*/
+#define BENCH_PROPS_MEMBERS 160
+#define BENCH_PROPS_SPREAD 7
+
+/**********************************
+ * Types
+ *********************************/
+
+/* a canned response body */
+typedef struct
+{
+  const char *name;
+  int targetLen;
+  char *text;
+  int len;
+  int entries; /* list entries, samples or properties members */
+} BENCH_BODY_TYPE;
+
+/* a member of the canned LPAR properties body and its JSON value */
+typedef struct
+{
+  const char *name;
+  const char *value;
+} BENCH_PROP_TYPE;
+
+/* one benchmark case, run executes a single operation */
+typedef struct
+{
+  const char *name;
+  bool (*run)(BENCH_BODY_TYPE *body);
+  BENCH_BODY_TYPE *body; /* NULL when the case needs none */
+  bool parses;           /* report parse throughput */
+} BENCH_CASE_TYPE;
+
+typedef struct
+{
+  long long iterations;
+  double elapsedSeconds;
+  long long allocBytes;
+  long long allocCalls;
+  long peakRSSKB;
+} BENCH_RESULT_TYPE;
+
+#endif
@@ -0,0 +1,91 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    HEADER NAME= HWIRBUFP                                            *
+ *                                                                     *
+ *  Header that contains the response buffer pool declarations used    *
+ *  by hwirbufp.cpp and its callers                                    *
+ *                                                                     *
+ **********************************************************************/
+#ifndef HWIRBUFP_H
+#define HWIRBUFP_H
+
+#include <hwicic.h>
+#include "hwirarna.h"
+#include "hwirerrb.h"
+
+/**********************************
+ * Constants
+ *********************************/
+
+/* Size classes served by the pool:
+   RESPBUF_SMALL - status queries, async post replies and job polls
+   RESPBUF_LARGE - list operations and full object queries, sized to
+                   the 15MB HWIREST response body maximum
+*/
+#define RESPBUF_SMALL 0
+#define RESPBUF_LARGE 1
+#define RESPBUF_CLASSES 2
+
+#define RESPBUF_SMALL_LEN 65536
+#define RESPBUF_LARGE_LEN 15728640
+
+/* idle buffers kept per size class, extra buffers are freed */
+#define RESPBUF_MAX_IDLE 4
+
+#define RESPBUF_SIDELEN 256
+
+/**********************************
+ * Types
+ *********************************/
+typedef struct RESPBUF_TYPE
+{
+  int sizeClass;
+  int capacity;      /* body length handed to HWIREST */
+  int bodyUsed;      /* bytes written by the last response */
+  int dateUsed;
+  int requestIdUsed;
+  char *responseBody; /* capacity + 1 bytes, always NUL terminated */
+  char responseDate[RESPBUF_SIDELEN];
+  char requestId[RESPBUF_SIDELEN];
+  ARENA_TYPE arena; /* request and response storage, reset on release */
+  RESPONSE_ERROR_TYPE error; /* decoded body of a failed request */
+  struct RESPBUF_TYPE *next; /* idle list link */
+} RESPBUF_TYPE;
+
+typedef struct
+{
+  unsigned long hits[RESPBUF_CLASSES];
+  unsigned long misses[RESPBUF_CLASSES];
+  unsigned long long bytesZeroed;
+} RESPBUF_STATS_TYPE;
+
+/**********************************
+ * Functions
+ *********************************/
+RESPBUF_TYPE *acquireResponseBuffer(int sizeClass);
+void attachResponseBuffer(RESPBUF_TYPE *buf, RESPONSE_PARM_TYPE *response);
+void completeResponseBuffer(RESPBUF_TYPE *buf, RESPONSE_PARM_TYPE *response);
+void releaseResponseBuffer(RESPBUF_TYPE *buf);
+void getResponseBufferStats(RESPBUF_STATS_TYPE *stats);
+void printResponseBufferStats();
+void freeResponseBuffers();
+
+#endif
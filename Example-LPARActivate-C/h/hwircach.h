@@ -0,0 +1,101 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    HEADER NAME= HWIRCACH                                            *
+ *                                                                     *
+ *  Header that contains the URI / target name resolution cache        *
+ *  declarations used by hwircach.cpp and its callers                  *
+ *                                                                     *
+ **********************************************************************/
+#ifndef HWIRCACH_H
+#define HWIRCACH_H
+
+#include <hwicic.h>
+
+/**********************************
+ * Constants
+ *********************************/
+
+/* environment variables naming the cache file and the number of
+   seconds an entry stays valid, e.g.
+   ENVAR("HWIRSTC1_CACHE=/u/user/hwirstc1.cache")
+*/
+#define CACHE_PATH_ENV "HWIRSTC1_CACHE"
+#define CACHE_TTL_ENV "HWIRSTC1_CACHE_TTL"
+#define CACHE_DEFAULT_TTL (24 * 60 * 60)
+
+#define CACHE_EYECATCHER "HWIRCACH"
+#define CACHE_VERSION 2
+#define CACHE_SLOTS 1024 /* power of 2 */
+
+#define CACHE_SCOPELEN 32
+#define CACHE_NAMELEN 16
+#define CACHE_URILEN 160
+#define CACHE_TARGETLEN 64
+
+/* slot states */
+#define CACHE_SLOT_EMPTY 0
+#define CACHE_SLOT_USED 1
+#define CACHE_SLOT_DELETED 2
+
+/**********************************
+ * Types
+ *********************************/
+
+/* Layout of the memory mapped cache file: a header followed by an
+   open addressing hash table of CACHE_SLOTS fixed size slots.
+   CPC entries have an empty scope, LPAR entries use the target name
+   of their CPC as scope.
+*/
+typedef struct
+{
+  char eyecatcher[8];
+  int version;
+  int slotCount;
+  int usedCount;    /* CACHE_SLOT_USED slots, expired or not */
+  int deletedCount; /* CACHE_SLOT_DELETED slots */
+} CACHE_HEADER_TYPE;
+
+typedef struct
+{
+  int state;
+  unsigned int hash;
+  long long storedAt; /* seconds since the epoch */
+  char scope[CACHE_SCOPELEN];
+  char name[CACHE_NAMELEN];
+  char uri[CACHE_URILEN];
+  char targetName[CACHE_TARGETLEN];
+} CACHE_SLOT_TYPE;
+
+/**********************************
+ * Functions
+ *********************************/
+bool openResolutionCache();
+void closeResolutionCache();
+bool cacheLookup(const char *scope, const char *name,
+                 char **uri, char **targetName);
+void cacheStore(const char *scope, const char *name,
+                const char *uri, const char *targetName);
+void cacheCheckResponse(REQUEST_PARM_TYPE *request,
+                        RESPONSE_PARM_TYPE *response);
+int cacheInvalidate(const char *uri, int uriLen,
+                    const char *targetName, int targetNameLen);
+
+#endif
@@ -0,0 +1,130 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    HEADER NAME= HWIRCRYP                                            *
+ *                                                                     *
+ *  Header that contains the crypto inventory declarations used by     *
+ *  hwircryp.cpp                                                       *
+ *                                                                     *
+ **********************************************************************/
+#ifndef HWIRCRYP_H
+#define HWIRCRYP_H
+
+#include "hwirstc1.h"
+
+/**********************************
+ * Constants
+ *********************************/
+
+/* crypto numbers and domain indexes below these are recorded */
+#define CRYPTO_MAX_ADAPTERS 256
+#define CRYPTO_MAX_DOMAINS 256
+#define CRYPTO_SET_WORDS 4 /* 64 bit words of a set of 256 */
+
+/* default number of profiles read at a time, -MAX overrides it */
+#define CRYPTO_MAX_WORKERS 8
+
+/* the LPARs whose profiles are read by default, -STATUS overrides it */
+#define CRYPTO_LPAR_STATUS "operating"
+
+/**********************************
+ * Types
+ *********************************/
+
+/* a set of crypto numbers or domain indexes */
+typedef struct
+{
+  unsigned long long bits[CRYPTO_SET_WORDS];
+} CRYPTO_SET_TYPE;
+
+/* The crypto assignment of the image activation profile of an LPAR,
+   the profile of the same name as the LPAR. An LPAR may use each of
+   its domains on each of its adapters, so the adapters and domains
+   sets stand for their product.
+*/
+typedef struct
+{
+  char *name;
+  char *uri;
+  bool fetched;
+  bool counterAuthorization; /* crypto activity counters */
+  CRYPTO_SET_TYPE adapters;
+  CRYPTO_SET_TYPE candidateAdapters; /* activation-type candidate */
+  CRYPTO_SET_TYPE usageDomains;
+  CRYPTO_SET_TYPE controlDomains; /* control only */
+} CRYPTO_PROFILE_TYPE;
+
+/* what RXCRYPT1 QueryCrypto reads of a profile, the two assignment
+   arrays are then read entry by entry
+*/
+typedef struct
+{
+  bool counterAuthorization;
+  bool cryptos;
+  bool domains;
+} CRYPTO_QUERY_TYPE;
+
+/* an entry of the assigned-cryptos array, number and activation-type,
+   or of the assigned-crypto-domains array, domain-index and
+   access-mode
+*/
+typedef struct
+{
+  int number;
+  char mode[16];
+} CRYPTO_ASSIGNMENT_TYPE;
+
+/* The profiles of the LPARs of a CPC in the requested status and,
+   once all are read, the set of profiles of each adapter and usage
+   domain, lparWords 64 bit words each. The profiles sharing a domain
+   on an adapter are the intersection of the two.
+*/
+typedef struct
+{
+  char *cpcName;
+  char *cpcUri;
+  char *cpcTargetName;
+
+  CRYPTO_PROFILE_TYPE *profiles;
+  int profileCount;
+  int profileCapacity;
+
+  int lparWords;
+  unsigned long long *adapterLpars; /* CRYPTO_MAX_ADAPTERS sets */
+  unsigned long long *domainLpars;  /* CRYPTO_MAX_DOMAINS sets */
+
+  /* handing out of the profiles to the workers, guarded by the
+     crypto lock of hwircryp.cpp
+  */
+  int next;
+  int failed;
+} CRYPTO_INVENTORY_TYPE;
+
+/**********************************
+ * Functions
+ *********************************/
+bool buildCryptoInventory(CRYPTO_INVENTORY_TYPE *inventory, char *cpcName,
+                          const char *lparStatus, int maxWorkers);
+int findSharingLPARs(CRYPTO_INVENTORY_TYPE *inventory, int adapter,
+                     int domain, int *profiles, int maxProfiles);
+void freeCryptoInventory(CRYPTO_INVENTORY_TYPE *inventory);
+bool runCryptoInventory(int argc, char **argv);
+
+#endif
@@ -0,0 +1,73 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    HEADER NAME= HWIRENRG                                            *
+ *                                                                     *
+ *  Header that contains the energy sampler declarations used by       *
+ *  hwirenrg.cpp                                                       *
+ *                                                                     *
+ **********************************************************************/
+#ifndef HWIRENRG_H
+#define HWIRENRG_H
+
+#include "hwirstc1.h"
+#include "hwirtser.h"
+
+/**********************************
+ * Constants
+ *********************************/
+
+/* default seconds between two samples of a CPC, -EVERY overrides it */
+#define ENERGY_EVERY_SEC 60
+
+/* deepest nesting of a complex property that is flattened */
+#define ENERGY_MAX_DEPTH 8
+
+/**********************************
+ * Types
+ *********************************/
+
+/* a sampled CPC, uri and targetName are malloc'd */
+typedef struct
+{
+  char *name;
+  char *uri;
+  char *targetName;
+  int failures;
+} ENERGY_CPC_TYPE;
+
+/* The numeric properties of one sample, flattened to names like
+   CPC1.zcpc-power-supplies.0.input-power. The names live in the arena
+   of the response buffer of the sample.
+*/
+typedef struct
+{
+  SERIES_SAMPLE_TYPE *samples;
+  int count;
+  int capacity;
+} ENERGY_ROUND_TYPE;
+
+/**********************************
+ * Functions
+ *********************************/
+bool runEnergySampler(int argc, char **argv);
+bool runSeriesReport(int argc, char **argv);
+
+#endif
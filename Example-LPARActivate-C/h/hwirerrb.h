@@ -0,0 +1,65 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    HEADER NAME= HWIRERRB                                            *
+ *                                                                     *
+ *  Header that contains the failure response body declarations used   *
+ *  by hwirerrb.cpp and its callers                                    *
+ *                                                                     *
+ **********************************************************************/
+#ifndef HWIRERRB_H
+#define HWIRERRB_H
+
+/**********************************
+ * Constants
+ *********************************/
+
+/* members of a failure body found by scanErrorBody */
+#define ERROR_FOUND_HTTP_STATUS 0x01 /* http-status */
+#define ERROR_FOUND_REASON 0x02      /* reason */
+#define ERROR_FOUND_MESSAGE 0x04     /* message */
+#define ERROR_FOUND_BCPII 0x08       /* bcpii-error */
+
+/**********************************
+ * Types
+ *********************************/
+
+/* The error record of a failed request, e.g.
+   {"http-status":404,"reason":1,"message":"...","bcpii-error":true}.
+   message points into the response body and is not NUL terminated,
+   backslash escapes are left as they are.
+*/
+typedef struct
+{
+  int found; /* ERROR_FOUND_ flags */
+  int httpStatus;
+  int reason;
+  bool bcpiiError;
+  bool messageEscaped; /* message holds backslash escapes */
+  const char *message;
+  int messageLen;
+} RESPONSE_ERROR_TYPE;
+
+/**********************************
+ * Functions
+ *********************************/
+bool scanErrorBody(const char *text, int len, RESPONSE_ERROR_TYPE *error);
+
+#endif
@@ -0,0 +1,90 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    HEADER NAME= HWIRFLET                                            *
+ *                                                                     *
+ *  Header that contains the fleet activation declarations used by     *
+ *  hwirflet.cpp and hwirstc1.cpp                                      *
+ *                                                                     *
+ **********************************************************************/
+#ifndef HWIRFLET_H
+#define HWIRFLET_H
+
+/**********************************
+ * Constants
+ *********************************/
+
+/* default concurrency limits, -MAX and -MAXCPC override them */
+#define FLEET_MAX_ACTIVE 16
+#define FLEET_MAX_ACTIVE_CPC 4
+
+/* fleet item states */
+#define FLEET_WAITING 0
+#define FLEET_ACTIVE 1
+#define FLEET_DONE 2
+
+/**********************************
+ * Types
+ *********************************/
+typedef struct
+{
+  char *name;
+  char *uri;
+  char *targetName;
+  bool resolved;
+  int active; /* activations in flight on this CPC */
+} FLEET_CPC_TYPE;
+
+typedef struct
+{
+  int cpcIndex;
+  char *lparName;
+  char *lparUri;
+  char *lparTargetName;
+  int state;
+  const char *outcome;
+  char *jobStatus;
+  int jobStatusCode;
+  int jobReasonCode;
+  long long startMs;
+  double elapsedSeconds;
+} FLEET_ITEM_TYPE;
+
+typedef struct
+{
+  FLEET_CPC_TYPE *cpcs;
+  int cpcCount;
+  int cpcCapacity;
+
+  FLEET_ITEM_TYPE *items;
+  int itemCount;
+  int itemCapacity;
+
+  int maxActive;
+  int maxActivePerCPC;
+  int active;
+} FLEET_TYPE;
+
+/**********************************
+ * Functions
+ *********************************/
+bool runFleet(int argc, char **argv);
+
+#endif
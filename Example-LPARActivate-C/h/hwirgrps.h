@@ -0,0 +1,147 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    HEADER NAME= HWIRGRPS                                            *
+ *                                                                     *
+ *  Header that contains the custom group reconciliation declarations  *
+ *  used by hwirgrps.cpp and hwirstc1.cpp                              *
+ *                                                                     *
+ **********************************************************************/
+#ifndef HWIRGRPS_H
+#define HWIRGRPS_H
+
+#include "hwirstc1.h"
+
+/**********************************
+ * Constants
+ *********************************/
+
+/* default concurrency limits, -MAX and -MAXCPC override them */
+#define GROUPS_MAX_ACTIVE 16
+#define GROUPS_MAX_ACTIVE_CPC 4
+
+/* task states */
+#define GROUPS_WAITING 0
+#define GROUPS_ACTIVE 1
+#define GROUPS_DONE 2
+
+/* custom group resources and members, as RXUSRGP1 names them */
+#define CUSTOM_USR_GRPS_URI "/api/groups"
+#define GROUP_MEMBERS_URI "/members"
+#define ADD_GROUP_MEMBER_OP "add-member"
+#define RMV_GROUP_MEMBER_OP "remove-member"
+#define GROUPS_LIST_KEY "groups"
+#define GROUP_MEMBERS_KEY "members"
+#define GROUP_NAME_KEY "name"
+#define GROUP_URI_KEY "object-uri"
+
+/* the members that are LPARs, the only ones reconciled */
+#define LPAR_MEMBER_URI "/api/logical-partitions/"
+
+/* membership changes */
+#define GROUPS_OP_ADD 0
+#define GROUPS_OP_REMOVE 1
+
+/**********************************
+ * Types
+ *********************************/
+typedef struct
+{
+  char *name;
+  char *uri;
+  char *targetName;
+  bool resolved;
+  int active; /* requests in flight to the SE of this CPC */
+  int peak;
+} GROUPS_CPC_TYPE;
+
+/* an LPAR, a current member or a desired one once resolved */
+typedef struct
+{
+  char *name;
+  char *uri;
+} GROUPS_MEMBER_TYPE;
+
+typedef struct
+{
+  int cpcIndex;
+  char *name;
+  char *uri;
+  int state;
+  const char *outcome; /* set when the group cannot be reconciled */
+
+  GROUPS_MEMBER_TYPE *desired;
+  int desiredCount;
+  int desiredCapacity;
+
+  GROUPS_MEMBER_TYPE *members; /* current members */
+  int memberCount;
+  int memberCapacity;
+
+  int unchanged;
+} GROUPS_GROUP_TYPE;
+
+typedef struct
+{
+  int groupIndex;
+  int opType;
+  GROUPS_MEMBER_TYPE *lpar; /* entry of desired or members */
+  int state;
+  bool applied;
+  int httpStatus;
+  int reason;
+} GROUPS_OP_TYPE;
+
+/* The groups are read and the operations issued by worker threads,
+   each task is handed out once its CPC is below the per CPC limit.
+   Task states, the active counts and failed are guarded by the lock
+   of hwirgrps.cpp.
+*/
+typedef struct
+{
+  GROUPS_CPC_TYPE *cpcs;
+  int cpcCount;
+  int cpcCapacity;
+
+  GROUPS_GROUP_TYPE *groups;
+  int groupCount;
+  int groupCapacity;
+
+  GROUPS_OP_TYPE *ops;
+  int opCount;
+  int opCapacity;
+
+  int maxActive;
+  int maxActivePerCPC;
+  bool planOnly;
+
+  /* the task list the workers take from, groups or ops */
+  bool applying;
+  int taskCount;
+  int firstWaiting;
+  int failed;
+} GROUPS_TYPE;
+
+/**********************************
+ * Functions
+ *********************************/
+bool runGroupReconcile(int argc, char **argv);
+
+#endif
@@ -0,0 +1,123 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    HEADER NAME= HWIRJOBS                                            *
+ *                                                                     *
+ *  Header that contains the job tracker declarations used by          *
+ *  hwirjobs.cpp and its callers                                       *
+ *                                                                     *
+ **********************************************************************/
+#ifndef HWIRJOBS_H
+#define HWIRJOBS_H
+
+#include "hwirpoll.h"
+
+/**********************************
+ * Constants
+ *********************************/
+
+/* room for the longest job status, cancel-pending */
+#define JOB_STATUS_LEN 32
+
+/**********************************
+ * Types
+ *********************************/
+
+/* result of a single GET of a job uri */
+typedef struct
+{
+  char status[JOB_STATUS_LEN]; /* running, cancel-pending, canceled,
+                                  complete, empty if not returned */
+  int jobStatusCode; /* HTTP status of the operation, -1 if not set */
+  int jobReasonCode; /* reason code of the operation, -1 if not set */
+  bool jobResults;   /* job-results were returned */
+  bool running;      /* status is running or cancel-pending */
+} JOB_STATUS_TYPE;
+
+struct JOB_ENTRY_TYPE;
+
+/* called once for each job when it completes or times out */
+typedef void (*JOB_CALLBACK_TYPE)(struct JOB_ENTRY_TYPE *job,
+                                  void *userData);
+
+typedef struct JOB_ENTRY_TYPE
+{
+  int jobId;          /* order in which the job was tracked */
+  char *jobUri;
+  char *targetName;
+  char *description;
+  int opType;         /* POLL_OP_ACTIVATE, POLL_OP_LOAD, ... */
+  char *status;       /* last job status seen, NULL before the first poll */
+  int jobStatusCode;
+  int jobReasonCode;
+  bool done;          /* job is no longer running or polling timed out */
+  long long startMs;
+  long long nextPollMs;
+  long long deadlineMs; /* 0 = no limit */
+  int intervalMs;
+  POLL_RESULT_TYPE pollResult;
+  JOB_CALLBACK_TYPE callback;
+  void *userData;
+} JOB_ENTRY_TYPE;
+
+typedef struct
+{
+  POLL_POLICY_TYPE *policy;
+
+  JOB_ENTRY_TYPE **jobs; /* every job tracked, in jobId order */
+  int jobCount;
+  int jobCapacity;
+
+  JOB_ENTRY_TYPE **pending; /* running jobs, min-heap on nextPollMs */
+  int pendingCount;
+
+  JOB_ENTRY_TYPE **completed; /* completion queue, oldest first */
+  int completedHead;
+  int completedCount;
+
+  unsigned int jitterSeed; /* rand_r state of the poll jitter */
+} JOB_TRACKER_TYPE;
+
+/**********************************
+ * Functions
+ *********************************/
+JOB_TRACKER_TYPE *createJobTracker(POLL_POLICY_TYPE *policy);
+JOB_ENTRY_TYPE *trackJob(JOB_TRACKER_TYPE *tracker,
+                         char *jobUri,
+                         char *targetName,
+                         char *description,
+                         int opType,
+                         JOB_CALLBACK_TYPE callback,
+                         void *userData);
+JOB_ENTRY_TYPE *asyncPostTracked(JOB_TRACKER_TYPE *tracker,
+                                 char *uriArg,
+                                 char *targetNameArg,
+                                 char *requestBodyArg,
+                                 char *description,
+                                 int opType,
+                                 JOB_CALLBACK_TYPE callback,
+                                 void *userData);
+bool runJobTrackerOnce(JOB_TRACKER_TYPE *tracker);
+void runJobTracker(JOB_TRACKER_TYPE *tracker);
+JOB_ENTRY_TYPE *nextCompletedJob(JOB_TRACKER_TYPE *tracker);
+int pendingJobCount(JOB_TRACKER_TYPE *tracker);
+void freeJobTracker(JOB_TRACKER_TYPE *tracker);
+
+#endif
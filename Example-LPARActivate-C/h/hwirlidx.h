@@ -0,0 +1,61 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ ***********************************************************************
+ *                                                                     *
+ *    HEADER NAME= HWIRLIDX                                            *
+ *                                                                     *
+ *  Header that contains the LPAR name index declarations used by      *
+ *  hwirlidx.cpp and its callers                                       *
+ *                                                                     *
+ **********************************************************************/
+#ifndef HWIRLIDX_H
+#define HWIRLIDX_H
+
+#include "hwirstc1.h"
+
+/**********************************
+ * Types
+ *********************************/
+
+/* All LPARs of one CPC, built from a single List Logical Partitions
+   of CPC response. slots is an open addressing hash table holding
+   index + 1 of the matching lpars entry, 0 marks an empty slot.
+*/
+typedef struct LPAR_INDEX
+{
+  char *cpcTargetName;
+  LPAR_INFO_TYPE *lpars;
+  int lparCount;
+  int *slots;
+  int slotCount; /* power of 2 */
+  int hits;
+  struct LPAR_INDEX *next;
+} LPAR_INDEX_TYPE;
+
+/**********************************
+ * Functions
+ *********************************/
+LPAR_INDEX_TYPE *indexLPARs(char *cpcUri, char *cpcTargetName);
+LPAR_INDEX_TYPE *findLPARIndex(const char *cpcTargetName);
+LPAR_INFO_TYPE *lookupIndexedLPAR(LPAR_INDEX_TYPE *index,
+                                  const char *LPARname);
+void freeLPARIndexes();
+
+#endif
@@ -0,0 +1,92 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    HEADER NAME= HWIRPOLL                                            *
+ *                                                                     *
+ *  Header that contains the job polling policy declarations used by   *
+ *  hwirpoll.cpp and its callers                                       *
+ *                                                                     *
+ **********************************************************************/
+#ifndef HWIRPOLL_H
+#define HWIRPOLL_H
+
+/**********************************
+ * Constants
+ *********************************/
+
+/* operation types, completion times are learned per type */
+#define POLL_OP_ACTIVATE 0
+#define POLL_OP_LOAD 1
+#define POLL_OP_DEACTIVATE 2
+#define POLL_OP_OTHER 3
+#define POLL_OP_TYPES 4
+
+/* environment variable naming the file used to keep learned
+   completion times across runs, e.g. ENVAR("HWIRSTC1_POLLHIST=...")
+*/
+#define POLL_HISTORY_ENV "HWIRSTC1_POLLHIST"
+
+/**********************************
+ * Types
+ *********************************/
+typedef struct
+{
+  int initialIntervalMs; /* first interval when nothing is learned */
+  int maxIntervalMs;     /* ceiling for the backoff */
+  int backoffPct;        /* interval growth per poll, 200 = double */
+  int jitterPct;         /* +/- random spread applied to each interval */
+  int deadlineSec;       /* stop polling after this long, 0 = no limit */
+} POLL_POLICY_TYPE;
+
+typedef struct
+{
+  int polls;                /* job status requests issued */
+  double detectSeconds;     /* poll start until completion was seen */
+  double lastRunningSeconds; /* poll start until the job was last seen running */
+  bool timedOut;            /* deadline reached while still running */
+} POLL_RESULT_TYPE;
+
+/* learned completion time for one operation type */
+typedef struct
+{
+  double avgSeconds;
+  int samples;
+} POLL_HISTORY_TYPE;
+
+extern POLL_POLICY_TYPE pollPolicy;
+
+/**********************************
+ * Functions
+ *********************************/
+const char *pollOpName(int opType);
+int firstPollDelayMs(int opType, POLL_POLICY_TYPE *policy);
+int nextPollDelayMs(int previousMs, POLL_POLICY_TYPE *policy);
+int applyJitterMs(int delayMs, POLL_POLICY_TYPE *policy,
+                  unsigned int *seed);
+void recordPollCompletion(int opType, double seconds);
+bool loadPollHistory();
+bool savePollHistory();
+void printPollResult(const char *jobStatus, POLL_RESULT_TYPE *result);
+
+/* time related */
+long long currentTimeMs();
+void sleepMs(int delayMs);
+
+#endif
@@ -0,0 +1,79 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    HEADER NAME= HWIRPROJ                                            *
+ *                                                                     *
+ *  Header that contains the property projection declarations used by  *
+ *  hwirproj.cpp and its callers                                       *
+ *                                                                     *
+ **********************************************************************/
+#ifndef HWIRPROJ_H
+#define HWIRPROJ_H
+
+#include "hwijbind.h"
+#include "hwirbufp.h"
+
+/**********************************
+ * Constants
+ *********************************/
+
+/* most schemas whose queries are counted */
+#define PROJECTION_MAX_STATS 16
+
+/* when set, the first query of each schema is also sent for the whole
+   object to estimate the bytes the projection saves
+*/
+#define PROJECTION_SAMPLE_ENV "HWIRSTC1_PROJSAMPLE"
+
+/**********************************
+ * Types
+ *********************************/
+
+/* Counters of the projected queries of one schema. With
+   PROJECTION_SAMPLE_ENV set, one object is also received whole and
+   its two sizes are kept.
+*/
+typedef struct
+{
+  JSON_SCHEMA_TYPE *schema;
+  const char *objectClass; /* what is queried, e.g. LPAR */
+  unsigned long requests;
+  unsigned long long bytesReceived;
+  int properties; /* asked for by the last request */
+  bool sampleTaken;
+  unsigned long sampleProjected; /* bytes of the sampled object */
+  unsigned long sampleWhole;     /* bytes of it received whole */
+} PROJECTION_STATS_TYPE;
+
+/**********************************
+ * Functions
+ *********************************/
+int buildProjection(JSON_SCHEMA_TYPE *schema, int fieldMask,
+                    const char *extraParms, char *query, int queryLen);
+bool queryProjected(char *uri, char *targetName, const char *objectClass,
+                    JSON_SCHEMA_TYPE *schema, int fieldMask,
+                    const char *extraParms, RESPBUF_TYPE *respBuf);
+int queryBoundObject(char *uri, char *targetName, const char *objectClass,
+                     JSON_SCHEMA_TYPE *schema, int fieldMask,
+                     const char *extraParms, RESPBUF_TYPE *respBuf,
+                     void *record);
+void printProjectionStats();
+
+#endif
@@ -0,0 +1,114 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ ***********************************************************************
+ *                                                                     *
+ *    HEADER NAME= HWIRSIM                                             *
+ *                                                                     *
+ *  Header that contains the in-process SE simulator declarations      *
+ *  used by hwirsim.cpp and hwirtran.cpp                               *
+ *                                                                     *
+ **********************************************************************/
+#ifndef HWIRSIM_H
+#define HWIRSIM_H
+
+#include <hwicic.h>
+
+/**********************************
+ * Constants
+ *********************************/
+
+/* environment variable holding the simulator settings, a comma
+   separated list of keyword=value pairs, e.g.
+   ENVAR("HWIRSTC1_SIM=cpcs=2,lpars=60,latency=uniform:20:200")
+
+     cpcs=n              CPCs named CPC1, CPC2, ...             (1)
+     lpars=n             LPARs per CPC named LP01, LP02, ...    (8)
+     active=pct          percent of LPARs initially operating   (0)
+     latency=fixed:ms    latency added to every request         (0)
+     latency=uniform:min:max
+     latency=exp:mean:max
+     job=min:max         seconds an operation job runs       (5:20)
+     listbytes=n         pad list responses to about n bytes    (0)
+     groups=n            custom groups per CPC named GRP1, ...  (4)
+     seed=n              random seed, same seed same run        (1)
+*/
+#define SIM_CONFIG_ENV "HWIRSTC1_SIM"
+
+/* latency distributions */
+#define SIM_LATENCY_FIXED 0
+#define SIM_LATENCY_UNIFORM 1
+#define SIM_LATENCY_EXP 2
+
+/**********************************
+ * Types
+ *********************************/
+typedef struct
+{
+  int cpcCount;
+  int lparsPerCPC;
+  int activePct;
+  int latencyDist;
+  int latencyMs;    /* fixed value, uniform minimum or exp mean */
+  int latencyMaxMs; /* uniform maximum or exp ceiling */
+  int jobMinSec;
+  int jobMaxSec;
+  int listBytes;
+  int groupsPerCPC;
+  unsigned int seed;
+} SIM_CONFIG_TYPE;
+
+typedef struct
+{
+  char name[16];
+  char uri[64];
+  char targetName[64];
+  int cpcIndex;
+  const char *status;
+  char nextProfile[16];
+  char loadAddress[8];
+  char loadParm[16];
+} SIM_LPAR_TYPE;
+
+typedef struct
+{
+  int lparIndex;
+  int opType;       /* POLL_OP_ value */
+  long long doneMs; /* time the job completes */
+  bool deleted;
+} SIM_JOB_TYPE;
+
+typedef struct
+{
+  char *data;
+  int len;
+  int capacity;
+} SIM_BODY_TYPE;
+
+extern SIM_CONFIG_TYPE simConfig;
+
+/**********************************
+ * Functions
+ *********************************/
+bool openSimulator();
+void simulateRequest(REQUEST_PARM_TYPE *request,
+                     RESPONSE_PARM_TYPE *response);
+void closeSimulator();
+
+#endif
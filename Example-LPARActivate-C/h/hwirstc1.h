@@ -24,10 +24,18 @@
  *  hwirstc1.cpp                                                       *
  *                                                                     *
  **********************************************************************/
+#ifndef HWIRSTC1_H
+#define HWIRSTC1_H
+
 #include <stdlib.h>
 #include <time.h>
 #include <sys/time.h>
 #include <hwicic.h>
+#include <hwtjic.h>
+#include "hwirbufp.h"
+#include "hwirpoll.h"
+#include "hwirjobs.h"
+#include "hwijstrm.h"
 
 /**********************************
  * Constants
@@ -62,44 +70,142 @@ static const char *nextActProfile = "next-activation-profile-name";
 static const char *cachedAcceptable = "cached-acceptable=true";
 static const char *statusProp = "status";
 
-struct timeval timeDay;
-time_t tvSeconds;
-time_t startTimer;
-time_t endTimer;
+/* LPAR properties that getLPARProperties can fetch in one request,
+   or them together to select the set of properties wanted
+*/
+#define LPAR_PROP_STATUS 0x01           /* status */
+#define LPAR_PROP_NEXT_ACT_PROFILE 0x02 /* next-activation-profile-name */
+#define LPAR_PROP_ACTIVATION_MODE 0x04  /* activation-mode */
+#define LPAR_PROP_LOAD_ADDRESS 0x08     /* last-used-load-address */
+#define LPAR_PROP_LOAD_PARM 0x10        /* last-used-load-parameter */
+
+extern bool traceRequests;
+
+extern struct timeval timeDay;
+extern time_t tvSeconds;
+extern time_t startTimer;
+extern time_t endTimer;
+
+extern struct tm *localTimeREST;
+
+/**********************************
+ * Types
+ *********************************/
+
+/* the routine of the threads started by runRequestWorkers */
+typedef void *(*REQUEST_WORKER_TYPE)(void *data);
+
+/* one entry of a List Logical Partitions of CPC response */
+typedef struct
+{
+  char *name;
+  char *uri;
+  char *targetName;
+  char *status;
+} LPAR_INFO_TYPE;
+
+/* LPAR array built by listLPARs as the response is scanned */
+typedef struct
+{
+  LPAR_INFO_TYPE *lpars;
+  int count;
+  int capacity;
+  bool failed; /* out of storage */
+} LPAR_LIST_TYPE;
+
+/* the CPC or LPAR of a list filtered by name, count is the number
+   of entries the list returned
+*/
+typedef struct
+{
+  int count;
+  char *uri;
+  char *targetName;
+} LISTED_OBJECT_TYPE;
 
-struct tm *localTimeREST;
+/* LPAR properties returned by getLPARProperties, fetched holds the
+   LPAR_PROP_ flags of the fields that were set. The values live in
+   the arena of the response buffer until freeLPARProperties.
+*/
+typedef struct
+{
+  RESPBUF_TYPE *respBuf;
+  int fetched;
+  char *status;
+  char *nextActivationProfile;
+  char *activationMode;
+  char *loadAddress;
+  char *loadParm;
+} LPAR_PROPS_TYPE;
 
 /**********************************
  * Functions
  *********************************/
-bool getNextActivationProfile(char **LPARnextActProfile);
-bool getLPARStatus(char **LPARstatusValue);
+bool getLPARProperties(char *lparUri,
+                       char *lparTargetName,
+                       int propertySet,
+                       LPAR_PROPS_TYPE *props);
+void freeLPARProperties(LPAR_PROPS_TYPE *props);
 bool queryLPAR(char *queryParms,
-               char **responseBody,
-               int responseBodyLen);
+               RESPBUF_TYPE *respBuf);
+bool queryLPARObject(char *lparUri,
+                     char *lparTargetName,
+                     char *queryParms,
+                     RESPBUF_TYPE *respBuf);
 bool getCPCInfo(char *CPCname);
+bool resolveCPC(char *CPCname, char **cpcUri, char **cpcTargetName);
 bool getLPARInfo(char *LPARname);
+bool requestLPARList(char *cpcUri,
+                     char *cpcTargetName,
+                     char *LPARname,
+                     STREAM_EXTRACT_TYPE *stream);
+bool resolveLPAR(char *cpcUri,
+                 char *cpcTargetName,
+                 char *LPARname,
+                 char **lparUri,
+                 char **lparTargetName);
+int listLPARs(char *cpcUri, char *cpcTargetName, LPAR_INFO_TYPE **lparList);
+void freeLPARList(LPAR_INFO_TYPE *lparList, int lparCount);
 bool activateLPAR();
 void printConstTextStr(int len, const char *text, char *description);
-void pollJobUri(char *jobUri, char *jobTargetName, char **jobStatus);
+void printTextStr(int len, char *text, char *description, char **ptrAddr);
+void printTextSlice(int len, const char *text, char *description);
+void pollJobUri(char *jobUri, char *jobTargetName, int opType,
+                char **jobStatus, POLL_RESULT_TYPE *pollResult);
 bool isJobRunning(char *uriArg, char *targetNameArg, char **jobStatus);
+bool getJobStatus(char *uriArg, char *targetNameArg,
+                  JOB_STATUS_TYPE *jobStatus);
 bool asyncPost(char *uriArg,
                char *targetNameArg,
                char *requestBodyArg,
-               char **jobUri);
+               char *jobUri);
+bool syncPost(char *uriArg,
+              char *targetNameArg,
+              char *requestBodyArg,
+              RESPBUF_TYPE *respBuf);
 bool asyncPostWorker(char *uriArg,
                      char *targetNameArg,
                      char *requestBodyArg,
-                     char *description);
-bool isSuccessful(RESPONSE_PARM_TYPE *pParm);
+                     char *description,
+                     int opType);
+void issueRequest(REQUEST_PARM_TYPE *request, RESPONSE_PARM_TYPE *response);
+bool isSuccessful(RESPONSE_PARM_TYPE *pParm, RESPONSE_ERROR_TYPE *error);
+
+/* worker threads issuing requests side by side */
+int runRequestWorkers(const char *caller, int workerCount,
+                      REQUEST_WORKER_TYPE worker, void *data);
 
 /* tracing of request and response */
+bool tracingRequests();
 void traceRequest(REQUEST_PARM_TYPE *pParm,
                   RESPONSE_PARM_TYPE *pParm2);
 void traceSuccessResponse(RESPONSE_PARM_TYPE *pParm);
-void traceFailureResponse(RESPONSE_PARM_TYPE *pParm);
+void traceFailureResponse(RESPONSE_PARM_TYPE *pParm,
+                          RESPONSE_ERROR_TYPE *error);
 
 /* time related */
 char* printTime();
 void startTimeRecorder();
 void endTimeRecorder(char *description);
+
+#endif
@@ -0,0 +1,67 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ ***********************************************************************
+ *                                                                     *
+ *    HEADER NAME= HWIRTRAN                                            *
+ *                                                                     *
+ *  Header that contains the HWIREST transport declarations used by    *
+ *  hwirtran.cpp and hwirstc1.cpp                                      *
+ *                                                                     *
+ **********************************************************************/
+#ifndef HWIRTRAN_H
+#define HWIRTRAN_H
+
+#include <hwicic.h>
+
+/**********************************
+ * Constants
+ *********************************/
+
+/* environment variable selecting the transport by name, e.g.
+   ENVAR("HWIRSTC1_TRANSPORT=SIM"). The default is HWIREST on z/OS
+   and the SE simulator elsewhere.
+*/
+#define TRANSPORT_ENV "HWIRSTC1_TRANSPORT"
+
+/**********************************
+ * Types
+ *********************************/
+
+/* A transport carries HWIREST requests to an SE. open and close may
+   be NULL when the transport needs no setup.
+*/
+typedef struct
+{
+  const char *name;
+  bool (*open)();
+  void (*issue)(REQUEST_PARM_TYPE *request, RESPONSE_PARM_TYPE *response);
+  void (*close)();
+} TRANSPORT_TYPE;
+
+/**********************************
+ * Functions
+ *********************************/
+bool openTransport();
+void closeTransport();
+void transportRequest(REQUEST_PARM_TYPE *request,
+                      RESPONSE_PARM_TYPE *response);
+const char *transportName();
+
+#endif
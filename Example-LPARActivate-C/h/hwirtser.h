@@ -0,0 +1,159 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ *                                                                     *
+ *    HEADER NAME= HWIRTSER                                            *
+ *                                                                     *
+ *  Header that contains the time-series file declarations used by     *
+ *  hwirtser.cpp and its callers                                       *
+ *                                                                     *
+ **********************************************************************/
+#ifndef HWIRTSER_H
+#define HWIRTSER_H
+
+#include <stdio.h>
+
+/**********************************
+ * Constants
+ *********************************/
+
+/* first bytes of a time-series file */
+#define SERIES_MAGIC "HWIRTS01"
+#define SERIES_MAGIC_LEN 8
+
+/* A block starts with a fixed header, big endian:
+     4 bytes payload length
+     4 bytes rounds in the block
+     8 bytes time of the first round, ms since the epoch
+     8 bytes time of the last round
+   followed by its rounds. A scan skips the blocks outside of the time
+   range by their header and decodes the others from their start.
+*/
+#define SERIES_BLOCK_HEADER_LEN 24
+
+/* rounds written to a block before the next one is started */
+#define SERIES_BLOCK_ROUNDS 256
+
+/* values are stored as integer thousandths */
+#define SERIES_SCALE 1000.0
+
+/* longest series name, longer flattened names are not stored */
+#define SERIES_MAX_NAME 256
+
+/**********************************
+ * Types
+ *********************************/
+
+/* one value of a round */
+typedef struct
+{
+  const char *name;
+  double value;
+} SERIES_SAMPLE_TYPE;
+
+/* Appends rounds of samples to a time-series file. A round is
+     varint time since the previous round of the block
+     varint number of values
+   and for each value
+     varint series number within the block, a number one past the
+            last series of the block defines a new series and is
+            followed by varint name length and the name
+     varint value minus the previous value of the series in the
+            block, 0 for its first value, in thousandths, zigzag
+            coded and divided by the largest of 1, 10, 100 and 1000
+            that divides it, the 2 low bits tell which
+*/
+typedef struct
+{
+  FILE *file;
+  long blockOffset; /* header of the open block, -1 when none */
+  int blockLen;
+  int blockRounds;
+  long long firstMs;
+  long long lastMs;
+
+  /* series of the open block and their last scaled value */
+  char **names;
+  long long *previous;
+  int seriesCount;
+  int seriesCapacity;
+
+  /* encoding of the round being appended */
+  unsigned char *round;
+  int roundCapacity;
+
+  long long values;  /* appended since open */
+  long long skipped; /* not representable or name too long */
+  long long bytes;   /* written since open */
+} SERIES_WRITER_TYPE;
+
+/* a value found by a scan, name and series are those of the block */
+typedef struct
+{
+  const char *name;
+  int block;
+  int series;
+  long long timeMs;
+  double value;
+} SERIES_POINT_TYPE;
+
+/* return false to stop the scan */
+typedef bool (*SERIES_POINT_CALLBACK)(const SERIES_POINT_TYPE *point,
+                                      void *userData);
+
+/* aggregate of the values of a series within one window */
+typedef struct
+{
+  const char *name;
+  long long windowMs; /* start of the window */
+  double min;
+  double max;
+  double sum;
+  int count;
+} SERIES_WINDOW_TYPE;
+
+typedef bool (*SERIES_WINDOW_CALLBACK)(const SERIES_WINDOW_TYPE *window,
+                                       void *userData);
+
+/* outcome of a scan */
+typedef struct
+{
+  int blocks;
+  int blocksSkipped; /* outside of the time range */
+  long long valuesDecoded;
+  long long valuesMatched;
+  bool damaged; /* the file ends in a partial block */
+} SERIES_SCAN_STATS_TYPE;
+
+/**********************************
+ * Functions
+ *********************************/
+bool openSeriesWriter(SERIES_WRITER_TYPE *writer, const char *path);
+bool appendSeriesRound(SERIES_WRITER_TYPE *writer, long long timeMs,
+                       SERIES_SAMPLE_TYPE *samples, int count);
+void closeSeriesWriter(SERIES_WRITER_TYPE *writer);
+bool scanSeries(const char *path, const char *pattern, long long fromMs,
+                long long toMs, SERIES_POINT_CALLBACK onPoint,
+                void *userData, SERIES_SCAN_STATS_TYPE *stats);
+bool aggregateSeries(const char *path, const char *pattern,
+                     long long fromMs, long long toMs, long long windowMs,
+                     SERIES_WINDOW_CALLBACK onWindow, void *userData,
+                     SERIES_SCAN_STATS_TYPE *stats);
+
+#endif
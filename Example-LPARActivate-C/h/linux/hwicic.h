@@ -0,0 +1,83 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ ***********************************************************************
+ *                                                                     *
+ *    HEADER NAME= HWICIC (off z/OS)                                   *
+ *                                                                     *
+ *  Declarations of the parts of the HWIREST interface used by the    *
+ *  sample, for building and running it off z/OS against the SE       *
+ *  simulator (hwirsim.cpp). On z/OS the system copy of HWICIC in     *
+ *  SYS1.SIEAHDRV.H is used instead, do not put this directory on     *
+ *  the include path there.                                           *
+ *                                                                     *
+ **********************************************************************/
+#ifndef HWICIC_H
+#define HWICIC_H
+
+#ifdef __MVS__
+#error "use the HWICIC header shipped in SYS1.SIEAHDRV.H on z/OS"
+#endif
+
+/**********************************
+ * Constants
+ *********************************/
+
+/* HTTP methods */
+#define HWI_REST_GET 1
+#define HWI_REST_PUT 2
+#define HWI_REST_POST 3
+#define HWI_REST_DELETE 4
+
+/* request body encoding */
+#define HWI_REST_ENCODING_NONE 0
+
+/**********************************
+ * Types
+ *********************************/
+typedef struct
+{
+  int httpMethod;
+  char *uri;
+  int uriLen;
+  char *targetName;
+  int targetNameLen;
+  char *requestBody;
+  int requestBodyLen;
+  char *clientCorrelator;
+  int clientCorrelatorLen;
+  int encoding;
+  int requestTimeout;
+} REQUEST_PARM_TYPE;
+
+typedef struct
+{
+  int httpStatus;
+  void *responseBody;
+  int responseBodyLen;
+  char *responseDate;
+  int responseDateLen;
+  char *requestId;
+  int requestIdLen;
+  char *location;
+  int locationLen;
+  int reasonCode;
+} RESPONSE_PARM_TYPE;
+
+#endif
@@ -0,0 +1,64 @@
+/* START OF SPECIFICATIONS *********************************************
+ * Beginning of Copyright and License                                  *
+ *                                                                     *
+ * Copyright IBM Corp. 2021, 2024                                      *
+ *                                                                     *
+ * Licensed under the Apache License, Version 2.0 (the "License");     *
+ * you may not use this file except in compliance with the License.    *
+ * You may obtain a copy of the License at                             *
+ *                                                                     *
+ * http://www.apache.org/licenses/LICENSE-2.0                          *
+ *                                                                     *
+ * Unless required by applicable law or agreed to in writing,          *
+ * software distributed under the License is distributed on an         *
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,        *
+ * either express or implied.  See the License for the specific        *
+ * language governing permissions and limitations under the License.   *
+ *                                                                     *
+ * End of Copyright and License                                        *
+ ***********************************************************************
+ ***********************************************************************
+ *                                                                     *
+ *    HEADER NAME= HWTJIC (off z/OS)                                   *
+ *                                                                     *
+ *  Declarations of the types and constants of the z/OS JSON parser   *
+ *  interface used by the sample, for building and running it off     *
+ *  z/OS with the native JSON backend (hwijnatv.cpp). The parser      *
+ *  services themselves only exist on z/OS, where the system copy of  *
+ *  HWTJIC in SYS1.SIEAHDRV.H is used instead.                        *
+ *                                                                     *
+ **********************************************************************/
+#ifndef HWTJIC_H
+#define HWTJIC_H
+
+#ifdef __MVS__
+#error "use the HWTJIC header shipped in SYS1.SIEAHDRV.H on z/OS"
+#endif
+
+/**********************************
+ * Constants
+ *********************************/
+
+/* return codes */
+#define HWTJ_OK 0
+
+/* JSON types */
+#define HWTJ_OBJECT_TYPE 1
+#define HWTJ_ARRAY_TYPE 2
+#define HWTJ_STRING_TYPE 3
+#define HWTJ_NUMBER_TYPE 4
+#define HWTJ_BOOLEAN_TYPE 5
+#define HWTJ_NULL_TYPE 6
+
+/* boolean values */
+#define HWTJ_FALSE 0
+#define HWTJ_TRUE 1
+
+/**********************************
+ * Types
+ *********************************/
+typedef int HWTJ_HANDLE_TYPE;
+typedef int HWTJ_JTYPE_TYPE;
+typedef int HWTJ_BOOLEANVALUE_TYPE;
+
+#endif